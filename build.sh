@@ -7,6 +7,7 @@
 PROJECT_ROOT_DIR=$(pwd)     # Project root directory
 BUILD_TYPE=Release          # Build type (Release | Debug)
 BUILD_TEST=Off              # Build test files (Off | On)
+SANITIZE_THREAD=Off         # ThreadSanitizer (Off | On)
 
 
 ####################
@@ -18,6 +19,7 @@ usage() {
     echo " -h, --help       Display this help message"
     echo " -d, --debug      Change build type to Debug"
     echo " -t, --test       Compile test files and build test executable"
+    echo " -s, --tsan       Instrument the build with ThreadSanitizer"
 }
 
 
@@ -37,6 +39,9 @@ handle_flags() {
         -t | --test)
             BUILD_TEST=ON
             ;;
+        -s | --tsan)
+            SANITIZE_THREAD=ON
+            ;;
         *)
             echo "Invalid option: $1" >&2
             usage
@@ -55,6 +60,7 @@ handle_flags "$@"
 cmake                                       \
     -DCMAKE_BUILD_TYPE=${BUILD_TYPE}        \
     -DBUILD_TEST=${BUILD_TEST}              \
+    -DSANITIZE_THREAD=${SANITIZE_THREAD}    \
     -S $PROJECT_ROOT_DIR                    \
     -B ${PROJECT_ROOT_DIR}/output/build
 
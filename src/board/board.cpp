@@ -36,6 +36,28 @@ ErrorCode Board::BuildBoardByFEN(
         return NULL_CLIENT_PTR;
     }
 
+    auto newBoard = std::make_shared<Board>(mode, client);
+    ErrorCode err = newBoard->SetPosition(fen);
+    if (UNLIKELY(err != SUCCESS)) {
+        return err;
+    }
+    board = newBoard;
+    return SUCCESS;
+}
+
+ErrorCode Board::BuildBoardByFEN(std::shared_ptr<Board> &board, std::string fen)
+{
+    return BuildBoardByFEN(board, fen, GameMode::OFFLINE, nullptr);
+}
+
+/**************************************************
+ * @details
+ *      - Parse the piece placement of @param fen
+ *              @return INVALID_FEN
+ *      - Replace the pieces on board, white to move
+ **************************************************/
+ErrorCode Board::SetPosition(std::string fen)
+{
     // Split the first token by space
     // e.g. "8/8/8/8/8/8/8/8 w - - 0 1" => "8/8/8/8/8/8/8/8"
     size_t first_space = fen.find_first_of(' ');
@@ -73,8 +95,15 @@ ErrorCode Board::BuildBoardByFEN(
         }
     }
 
+    // Clear the board
+    for (auto &column : m_pieces) {
+        column.fill(nullptr);
+    }
+    m_pieceSet.clear();
+    m_playerTurn = PieceColor::WHITE;
+    m_lastMove = NULL_MOVE;
+
     // Set pieces on board
-    auto newBoard = std::make_shared<Board>(mode, client);
     for (uint8_t y{ 0 }; y < BOARD_SIZE; y++) {
         // First row in FEN corresponds to the 8th rank
         const auto &_row = rows[BOARD_SIZE - 1 - y];
@@ -93,7 +122,7 @@ ErrorCode Board::BuildBoardByFEN(
                 return INVALID_FEN;
             }
             // Set piece on square
-            auto error = newBoard->SetPieceOnSquare(
+            auto error = SetPieceOnSquare(
                 fenItr->second.type, fenItr->second.color, Square{ x, y });
             if (UNLIKELY(error != SUCCESS)) {
                 return INVALID_FEN;
@@ -102,16 +131,9 @@ ErrorCode Board::BuildBoardByFEN(
             x++;
         }
     }
-
-    board = newBoard;
     return SUCCESS;
 }
 
-ErrorCode Board::BuildBoardByFEN(std::shared_ptr<Board> &board, std::string fen)
-{
-    return BuildBoardByFEN(board, fen, GameMode::OFFLINE, nullptr);
-}
-
 /**************************************************
  * @details
  *      - Check @param src square is not empty.
@@ -183,6 +205,24 @@ ErrorCode Board::MovePiece(Move move)
     return MovePiece(move.first, move.second);
 }
 
+/**************************************************
+ * @details
+ *      - Reset the board to the standard position
+ *      - Play @param moves in order until one fails
+ *              @return its error
+ **************************************************/
+ErrorCode Board::ReplayGame(const std::vector<Move> &moves)
+{
+    ErrorCode err = SetPosition(STANDARD_POSITION_FEN);
+    for (const Move &move : moves) {
+        if (UNLIKELY(err != SUCCESS)) {
+            break;
+        }
+        err = MovePiece(move);
+    }
+    return err;
+}
+
 /**************************************************
  * @details
  *      - Check @param square is empty
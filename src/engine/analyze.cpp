@@ -0,0 +1,329 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Batch position analysis Implementation
+ **************************************************/
+
+#include <sstream>
+#include "analyze.h"
+#include "bounded_queue.h"
+#include "reorder_buffer.h"
+
+namespace Shohih {
+
+namespace {
+
+constexpr char PIECE_CHARS[]{ "PNBRQKpnbrqk" };   // by piece code
+
+constexpr size_t MAX_PACKED_PIECES{ 32 };
+constexpr size_t PIECE_BYTES_OFFSET{ 8 };
+constexpr size_t STATE_BYTE{ 24 };
+constexpr size_t EP_BYTE{ 25 };
+constexpr size_t HALFMOVE_BYTE{ 26 };
+constexpr size_t FULLMOVE_BYTE{ 27 };
+
+// Results waiting for an earlier position, per worker
+constexpr size_t DEFAULT_WINDOW_PER_THREAD{ 4 };
+
+struct Job {
+    size_t index{ 0 };
+    std::string input{};
+};
+
+std::string JsonEscape(const std::string &text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            escaped += ' ';
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+//--------------------------------------------------
+// Search one position with the worker's own search
+//--------------------------------------------------
+AnalysisResult Analyze(const Job &job, Search &search, TranspositionTable &tt,
+    const SearchLimits &limits, SearchInfo &lastInfo)
+{
+    AnalysisResult result;
+    result.index = job.index;
+    result.input = job.input;
+
+    Position pos;
+    if (job.input.empty() || pos.SetFEN(job.input) != SUCCESS) {
+        return result;
+    }
+    result.fen = pos.GetFEN();
+
+    MoveList legal;
+    pos.GenerateLegalMoves(legal);
+    if (legal.Empty()) {
+        result.score = pos.InCheck() ? -VALUE_MATE : 0;
+        return result;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    tt.NewSearch();
+    lastInfo = SearchInfo{};
+    const SearchResult searched = search.Run(pos, limits);
+    result.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    result.bestMove = searched.bestMove.IsNull() ? legal[0].move : searched.bestMove;
+    result.score = searched.score;
+    result.depth = searched.depth;
+    result.selDepth = lastInfo.selDepth;
+    result.nodes = searched.nodes;
+    if (!lastInfo.pv.empty() && lastInfo.pv[0] == result.bestMove) {
+        result.pv = std::move(lastInfo.pv);
+    } else {
+        result.pv.push_back(result.bestMove);
+    }
+    return result;
+}
+
+} // namespace
+
+/**************************************************
+ * @details
+ *      Piece codes fit a nibble (NO_PIECE = 12);
+ *      only occupied squares are stored.
+ **************************************************/
+ErrorCode PackPosition(const Position &pos, PackedPosition &packed)
+{
+    packed.fill(0);
+    const Bitboard occupied = pos.GetOccupied();
+    if (UNLIKELY(PopCount(occupied) > static_cast<int>(MAX_PACKED_PIECES))) {
+        ERROR_LOG("Too many pieces to pack: " << pos.GetFEN());
+        return INVALID_FEN;
+    }
+    for (size_t i{ 0 }; i < 8; i++) {
+        packed[i] = static_cast<uint8_t>(occupied >> (8 * i));
+    }
+    size_t n{ 0 };
+    for (Bitboard bb = occupied; bb; bb &= bb - 1, n++) {
+        const PieceCode pc = pos.GetPieceOn(Lsb(bb));
+        packed[PIECE_BYTES_OFFSET + n / 2] |= static_cast<uint8_t>(pc << (4 * (n % 2)));
+    }
+    packed[STATE_BYTE] = static_cast<uint8_t>(
+        (pos.GetSideToMove() == PieceColor::BLACK ? 1 : 0) | (pos.GetCastlingRights() << 1));
+    packed[EP_BYTE] = static_cast<uint8_t>(pos.GetEnPassantSquare());
+    packed[HALFMOVE_BYTE] = static_cast<uint8_t>(std::min<uint16_t>(pos.GetHalfmoveClock(), 255));
+    packed[FULLMOVE_BYTE] = static_cast<uint8_t>(pos.GetFullmoveNumber() & 0xFF);
+    packed[FULLMOVE_BYTE + 1] = static_cast<uint8_t>(pos.GetFullmoveNumber() >> 8);
+    return SUCCESS;
+}
+
+/**************************************************
+ * @details
+ *      The record is turned back into a FEN, so it
+ *      goes through the same validation as text
+ *      input.
+ **************************************************/
+ErrorCode UnpackPosition(const PackedPosition &packed, Position &pos)
+{
+    Bitboard occupied{ 0 };
+    for (size_t i{ 0 }; i < 8; i++) {
+        occupied |= static_cast<Bitboard>(packed[i]) << (8 * i);
+    }
+    if (UNLIKELY(PopCount(occupied) > static_cast<int>(MAX_PACKED_PIECES))) {
+        ERROR_LOG("Invalid packed position: too many pieces");
+        return INVALID_FEN;
+    }
+
+    std::array<PieceCode, NUM_SQUARES> board;
+    board.fill(NO_PIECE);
+    size_t n{ 0 };
+    for (Bitboard bb = occupied; bb; bb &= bb - 1, n++) {
+        const PieceCode pc = (packed[PIECE_BYTES_OFFSET + n / 2] >> (4 * (n % 2))) & 0xF;
+        if (UNLIKELY(pc >= NO_PIECE)) {
+            ERROR_LOG("Invalid packed position: piece code " << static_cast<int>(pc));
+            return INVALID_FEN;
+        }
+        board[Lsb(bb)] = pc;
+    }
+
+    std::ostringstream fen;
+    for (int y{ BOARD_SIZE - 1 }; y >= 0; y--) {
+        int empty{ 0 };
+        for (int x{ 0 }; x < BOARD_SIZE; x++) {
+            const PieceCode pc = board[y * BOARD_SIZE + x];
+            if (pc == NO_PIECE) {
+                empty++;
+                continue;
+            }
+            if (empty > 0) {
+                fen << empty;
+                empty = 0;
+            }
+            fen << PIECE_CHARS[pc];
+        }
+        if (empty > 0) {
+            fen << empty;
+        }
+        if (y > 0) {
+            fen << '/';
+        }
+    }
+    const uint8_t state = packed[STATE_BYTE];
+    const uint8_t castling = (state >> 1) & ALL_CASTLING;
+    fen << ((state & 1) ? " b " : " w ");
+    if (castling == 0) fen << '-';
+    if (castling & WHITE_OO) fen << 'K';
+    if (castling & WHITE_OOO) fen << 'Q';
+    if (castling & BLACK_OO) fen << 'k';
+    if (castling & BLACK_OOO) fen << 'q';
+    const SquareId ep = packed[EP_BYTE];
+    fen << ' ' << (ep < NUM_SQUARES ? ToSquare(ep).GetSquareName() : "-")
+        << ' ' << static_cast<int>(packed[HALFMOVE_BYTE])
+        << ' ' << (packed[FULLMOVE_BYTE] | (packed[FULLMOVE_BYTE + 1] << 8));
+    return pos.SetFEN(fen.str());
+}
+
+bool PositionReader::Next(std::string &input)
+{
+    if (m_format == InputFormat::PACKED) {
+        PackedPosition packed;
+        if (!m_in.read(reinterpret_cast<char *>(packed.data()), PACKED_POSITION_SIZE)) {
+            if (m_in.gcount() > 0) {
+                WARNING_LOG("Ignored a truncated packed record of " << m_in.gcount() << " bytes");
+            }
+            return false;
+        }
+        Position pos;
+        input = (UnpackPosition(packed, pos) == SUCCESS) ? pos.GetFEN() : std::string{};
+        return true;
+    }
+
+    std::string line;
+    while (std::getline(m_in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        input = std::move(line);
+        return true;
+    }
+    return false;
+}
+
+std::string FormatJson(const AnalysisResult &result)
+{
+    std::ostringstream json;
+    json << "{\"index\":" << result.index;
+    if (!result.IsValid()) {
+        json << ",\"input\":\"" << JsonEscape(result.input) << "\",\"error\":\"invalid position\"}";
+        return json.str();
+    }
+    json << ",\"fen\":\"" << result.fen << "\",\"bestmove\":";
+    if (result.bestMove.IsNull()) {
+        json << "null";
+    } else {
+        json << '"' << result.bestMove.ToUci() << '"';
+    }
+    json << ",\"score\":{";
+    if (result.score >= VALUE_MATE_IN_MAX_PLY) {
+        json << "\"mate\":" << (VALUE_MATE - result.score + 1) / 2;
+    } else if (result.score <= -VALUE_MATE_IN_MAX_PLY) {
+        json << "\"mate\":" << -(VALUE_MATE + result.score) / 2;
+    } else {
+        json << "\"cp\":" << result.score;
+    }
+    json << "},\"depth\":" << result.depth << ",\"seldepth\":" << result.selDepth
+         << ",\"nodes\":" << result.nodes << ",\"time\":" << result.elapsedMs << ",\"pv\":[";
+    for (size_t i{ 0 }; i < result.pv.size(); i++) {
+        json << (i ? ",\"" : "\"") << result.pv[i].ToUci() << '"';
+    }
+    json << "]}";
+    return json.str();
+}
+
+double AnalyzeStats::PositionsPerHour() const
+{
+    return static_cast<double>(positions) * 3600000.0 / static_cast<double>(std::max<int64_t>(elapsedMs, 1));
+}
+
+/**************************************************
+ * @details
+ *      The calling thread reads, the workers search
+ *      (one single-threaded search each) and a writer
+ *      thread hands the results on in order:
+ *        reader -> job queue -> workers
+ *               -> reorder buffer -> writer
+ *      Each worker keeps its hash between positions
+ *      (aged, not cleared), which costs nothing for
+ *      unrelated positions and helps related ones.
+ **************************************************/
+AnalyzeStats AnalyzePositions(PositionReader &reader, const AnalyzeOptions &options,
+    ResultCallback onResult)
+{
+    SearchLimits limits;
+    limits.nodes = options.nodes;
+    limits.moveTime = options.timeMs;
+    if (options.depth > 0) {
+        limits.depth = std::min(options.depth, MAX_DEPTH);
+    } else if (options.nodes == 0 && options.timeMs == 0) {
+        limits.nodes = AnalyzeOptions{}.nodes;
+    }
+
+    const size_t threads = std::max<size_t>(1, options.threads);
+    BoundedQueue<Job> jobs(2 * threads);
+    ReorderBuffer<AnalysisResult> results(
+        options.window > 0 ? options.window : DEFAULT_WINDOW_PER_THREAD * threads);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t i{ 0 }; i < threads; i++) {
+        workers.emplace_back([&options, &limits, &jobs, &results]() {
+            TranspositionTable tt(options.hashMb);
+            auto search = std::make_unique<Search>(tt);
+            search->SetConfig(options.config);
+            SearchInfo lastInfo;
+            search->SetInfoCallback([&lastInfo](const SearchInfo &info) { lastInfo = info; });
+            Job job;
+            while (jobs.Pop(job)) {
+                results.Put(job.index, Analyze(job, *search, tt, limits, lastInfo));
+            }
+        });
+    }
+
+    AnalyzeStats stats;
+    std::thread writer([&results, &stats, &onResult]() {
+        AnalysisResult result;
+        while (results.Pop(result)) {
+            stats.positions++;
+            stats.invalid += result.IsValid() ? 0 : 1;
+            stats.nodes += result.nodes;
+            if (onResult) {
+                onResult(result);
+            }
+        }
+    });
+
+    size_t index{ 0 };
+    std::string input;
+    while (reader.Next(input)) {
+        jobs.Push(Job{ index++, std::move(input) });
+    }
+    jobs.Close();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    results.Close();
+    writer.join();
+
+    stats.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+} // namespace Shohih
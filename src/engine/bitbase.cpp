@@ -0,0 +1,253 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   KPK bitbase Implementation
+ **************************************************/
+
+#include <mutex>
+#include <cstdlib>
+#include <chrono>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <condition_variable>
+#include "bitbase.h"
+
+namespace Shohih {
+namespace Kpk {
+
+namespace {
+
+std::array<uint32_t, MAX_INDEX / 32> g_bits{};
+bool g_ready{ false };
+
+//--------------------------------------------------
+// Classification bits: a position's successors are
+// OR-ed together
+//--------------------------------------------------
+constexpr uint8_t INVALID{ 0 };
+constexpr uint8_t UNKNOWN{ 1 };
+constexpr uint8_t DRAW{ 2 };
+constexpr uint8_t WIN{ 4 };
+
+constexpr int NORTH{ BOARD_SIZE };
+
+size_t Index(PieceColor stm, SquareId blackKing, SquareId whiteKing, SquareId pawn)
+{
+    return static_cast<size_t>(whiteKing | (blackKing << 6) | (static_cast<int>(stm) << 12) |
+        (FileOf(pawn) << 13) | ((6 - RankOf(pawn)) << 15));
+}
+
+int Distance(SquareId a, SquareId b)
+{
+    return std::max(std::abs(FileOf(a) - FileOf(b)), std::abs(RankOf(a) - RankOf(b)));
+}
+
+struct KpkPosition {
+    SquareId whiteKing;
+    SquareId blackKing;
+    SquareId pawn;
+    PieceColor stm;
+
+    explicit KpkPosition(size_t idx)
+        : whiteKing(static_cast<SquareId>(idx & 0x3F)),
+          blackKing(static_cast<SquareId>((idx >> 6) & 0x3F)),
+          pawn(static_cast<SquareId>((6 - ((idx >> 15) & 7)) * BOARD_SIZE + ((idx >> 13) & 3))),
+          stm(static_cast<PieceColor>((idx >> 12) & 1)) {}
+
+    /**************************************************
+     * Positions decided without looking at successors
+     **************************************************/
+    uint8_t InitialResult() const
+    {
+        const bool whiteToMove = (stm == PieceColor::WHITE);
+        // Overlapping pieces or a king that can be captured
+        if (Distance(whiteKing, blackKing) <= 1 || whiteKing == pawn || blackKing == pawn ||
+            (whiteToMove && (PawnAttacks(PieceColor::WHITE, pawn) & SquareBB(blackKing)))) {
+            return INVALID;
+        }
+        // Safe promotion
+        const SquareId promotion = static_cast<SquareId>(pawn + NORTH);
+        if (whiteToMove && RankOf(pawn) == 6 && whiteKing != promotion &&
+            (Distance(blackKing, promotion) > 1 || Distance(whiteKing, promotion) == 1)) {
+            return WIN;
+        }
+        // Stalemate, or the pawn can be taken
+        const Bitboard blackMoves = KingAttacks(blackKing);
+        const Bitboard guarded = KingAttacks(whiteKing) | PawnAttacks(PieceColor::WHITE, pawn);
+        if (!whiteToMove && (!(blackMoves & ~guarded) ||
+            (blackMoves & SquareBB(pawn) & ~KingAttacks(whiteKing)))) {
+            return DRAW;
+        }
+        return UNKNOWN;
+    }
+
+    /**************************************************
+     * White to move wins if any move wins and draws if
+     * all moves draw; black to move draws if any move
+     * draws and loses if all moves lose.
+     **************************************************/
+    uint8_t Classify(const std::atomic<uint8_t> *db) const
+    {
+        const bool whiteToMove = (stm == PieceColor::WHITE);
+        const uint8_t good = whiteToMove ? WIN : DRAW;
+        const uint8_t bad = whiteToMove ? DRAW : WIN;
+        uint8_t r{ INVALID };
+
+        Bitboard moves = KingAttacks(whiteToMove ? whiteKing : blackKing);
+        while (moves) {
+            const SquareId to = PopLsb(moves);
+            r |= whiteToMove ? db[Index(PieceColor::BLACK, blackKing, to, pawn)].load(std::memory_order_relaxed)
+                             : db[Index(PieceColor::WHITE, to, whiteKing, pawn)].load(std::memory_order_relaxed);
+        }
+        if (whiteToMove) {
+            const SquareId push = static_cast<SquareId>(pawn + NORTH);
+            if (RankOf(pawn) < 6) {
+                r |= db[Index(PieceColor::BLACK, blackKing, whiteKing, push)].load(std::memory_order_relaxed);
+            }
+            if (RankOf(pawn) == 1 && push != whiteKing && push != blackKing) {
+                r |= db[Index(PieceColor::BLACK, blackKing, whiteKing,
+                    static_cast<SquareId>(push + NORTH))].load(std::memory_order_relaxed);
+            }
+        }
+        return (r & good) ? good : (r & UNKNOWN) ? UNKNOWN : bad;
+    }
+};
+
+//--------------------------------------------------
+// Reusable barrier; the last thread to arrive runs
+// @param completion before releasing the others
+//--------------------------------------------------
+class Barrier {
+public:
+    explicit Barrier(size_t count) : m_count(count) {}
+
+    void Wait(const std::function<void()> &completion)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        const size_t generation = m_generation;
+        if (++m_waiting == m_count) {
+            m_waiting = 0;
+            completion();
+            m_generation++;
+            m_cv.notify_all();
+        } else {
+            m_cv.wait(lock, [this, generation]() { return generation != m_generation; });
+        }
+    }
+
+private:
+    const size_t m_count;
+    size_t m_waiting{ 0 };
+    size_t m_generation{ 0 };
+    std::mutex m_mutex{};
+    std::condition_variable m_cv{};
+};
+
+} // namespace
+
+/**************************************************
+ * @details
+ *      Results only ever change from UNKNOWN to WIN
+ *      or DRAW, so the threads update the table in
+ *      place (relaxed atomics) and reach the same fixed
+ *      point in any order. A pass in which no thread
+ *      changes anything ends the iteration.
+ **************************************************/
+int64_t Init(size_t threads)
+{
+    const auto start = std::chrono::steady_clock::now();
+    threads = std::max<size_t>(threads, 1);
+    std::unique_ptr<std::atomic<uint8_t>[]> db(new std::atomic<uint8_t>[MAX_INDEX]);
+
+    std::atomic<bool> changed{ false };
+    bool done{ false };
+    Barrier barrier(threads);
+    auto worker = [&](size_t id) {
+        const size_t begin = MAX_INDEX * id / threads;
+        const size_t end = MAX_INDEX * (id + 1) / threads;
+        for (size_t idx{ begin }; idx < end; idx++) {
+            db[idx].store(KpkPosition(idx).InitialResult(), std::memory_order_relaxed);
+        }
+        barrier.Wait([]() {});
+        while (true) {
+            bool localChanged{ false };
+            for (size_t idx{ begin }; idx < end; idx++) {
+                if (db[idx].load(std::memory_order_relaxed) != UNKNOWN) {
+                    continue;
+                }
+                const uint8_t result = KpkPosition(idx).Classify(db.get());
+                if (result != UNKNOWN) {
+                    db[idx].store(result, std::memory_order_relaxed);
+                    localChanged = true;
+                }
+            }
+            if (localChanged) {
+                changed.store(true, std::memory_order_relaxed);
+            }
+            barrier.Wait([&]() {
+                done = !changed.load(std::memory_order_relaxed);
+                changed.store(false, std::memory_order_relaxed);
+            });
+            if (done) {
+                break;
+            }
+        }
+    };
+
+    std::vector<std::thread> helpers;
+    for (size_t id{ 1 }; id < threads; id++) {
+        helpers.emplace_back(worker, id);
+    }
+    worker(0);
+    for (auto &helper : helpers) {
+        helper.join();
+    }
+
+    // Remaining unknown positions are draws
+    g_bits.fill(0);
+    for (size_t idx{ 0 }; idx < MAX_INDEX; idx++) {
+        if (db[idx].load(std::memory_order_relaxed) == WIN) {
+            g_bits[idx / 32] |= 1u << (idx % 32);
+        }
+    }
+    g_ready = true;
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+bool IsReady()
+{
+    return g_ready;
+}
+
+bool Probe(SquareId whiteKing, SquareId pawn, SquareId blackKing, PieceColor stm)
+{
+    const size_t idx = Index(stm, blackKing, whiteKing, pawn);
+    return (g_bits[idx / 32] >> (idx % 32)) & 1;
+}
+
+/**************************************************
+ * @details
+ *      Flip the board so that the strong side is
+ *      white, then mirror the pawn onto files a-d.
+ **************************************************/
+bool Probe(const Position &pos)
+{
+    const PieceColor strong = pos.GetPieces(PieceColor::WHITE, PieceType::PAWN)
+        ? PieceColor::WHITE : PieceColor::BLACK;
+    const int flip = (strong == PieceColor::WHITE) ? 0 : 56;
+    SquareId strongKing = pos.GetKingSquare(strong) ^ flip;
+    SquareId weakKing = pos.GetKingSquare(Opposite(strong)) ^ flip;
+    SquareId pawn = Lsb(pos.GetPieces(strong, PieceType::PAWN)) ^ flip;
+    if (FileOf(pawn) > 3) {
+        strongKing ^= 7;
+        weakKing ^= 7;
+        pawn ^= 7;
+    }
+    return Probe(strongKing, pawn, weakKing,
+        pos.GetSideToMove() == strong ? PieceColor::WHITE : PieceColor::BLACK);
+}
+
+} // namespace Kpk
+} // namespace Shohih
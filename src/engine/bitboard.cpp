@@ -0,0 +1,78 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Attack tables Implementation
+ **************************************************/
+
+#include "bitboard.h"
+
+namespace Shohih {
+
+/**************************************************
+ * Attack tables are built during static initialization
+ * and are read-only afterwards.
+ **************************************************/
+const AttackTables g_attacks{};
+
+/**************************************************
+ * @details
+ *      Build step attacks (pawn, knight, king),
+ *      sliding rays and between/line tables.
+ **************************************************/
+AttackTables::AttackTables()
+{
+    static const int rayDx[8]{ 0, 1, 1, 1, 0, -1, -1, -1 };
+    static const int rayDy[8]{ 1, 1, 0, -1, -1, -1, 0, 1 };
+    static const int knightDx[8]{ 1, 2, 2, 1, -1, -2, -2, -1 };
+    static const int knightDy[8]{ 2, 1, -1, -2, -2, -1, 1, 2 };
+
+    auto onBoard = [](int x, int y) {
+        return x >= 0 && x < BOARD_SIZE && y >= 0 && y < BOARD_SIZE;
+    };
+    auto bit = [](int x, int y) { return 1ULL << (y * BOARD_SIZE + x); };
+
+    for (SquareId sq{ 0 }; sq < NUM_SQUARES; sq++) {
+        int x = FileOf(sq), y = RankOf(sq);
+
+        // Rays, king and knight steps
+        for (uint8_t dir{ 0 }; dir < 8; dir++) {
+            for (int nx = x + rayDx[dir], ny = y + rayDy[dir];
+                 onBoard(nx, ny); nx += rayDx[dir], ny += rayDy[dir]) {
+                rays[dir][sq] |= bit(nx, ny);
+            }
+            if (onBoard(x + rayDx[dir], y + rayDy[dir])) {
+                king[sq] |= bit(x + rayDx[dir], y + rayDy[dir]);
+            }
+            if (onBoard(x + knightDx[dir], y + knightDy[dir])) {
+                knight[sq] |= bit(x + knightDx[dir], y + knightDy[dir]);
+            }
+        }
+
+        // Pawn captures
+        for (int dx : { -1, 1 }) {
+            if (onBoard(x + dx, y + 1)) {
+                pawn[static_cast<uint8_t>(PieceColor::WHITE)][sq] |= bit(x + dx, y + 1);
+            }
+            if (onBoard(x + dx, y - 1)) {
+                pawn[static_cast<uint8_t>(PieceColor::BLACK)][sq] |= bit(x + dx, y - 1);
+            }
+        }
+
+        bishopEmpty[sq] = rays[1][sq] | rays[3][sq] | rays[5][sq] | rays[7][sq];
+        rookEmpty[sq] = rays[0][sq] | rays[2][sq] | rays[4][sq] | rays[6][sq];
+    }
+
+    // Between & line tables
+    for (SquareId a{ 0 }; a < NUM_SQUARES; a++) {
+        for (uint8_t dir{ 0 }; dir < 8; dir++) {
+            Bitboard ray = rays[dir][a];
+            Bitboard full = ray | rays[(dir + 4) % 8][a] | SquareBB(a);
+            for (Bitboard b = ray; b; ) {
+                SquareId target = PopLsb(b);
+                between[a][target] = ray & ~rays[dir][target] & ~SquareBB(target);
+                line[a][target] = full;
+            }
+        }
+    }
+}
+
+} // namespace Shohih
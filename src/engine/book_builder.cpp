@@ -0,0 +1,295 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Opening book builder Implementation
+ **************************************************/
+
+#include <queue>
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+#include "book_builder.h"
+#include "bounded_queue.h"
+
+namespace Shohih {
+
+namespace {
+
+constexpr size_t GAMES_PER_BATCH{ 256 };
+constexpr uint32_t MAX_WEIGHT{ 0xFFFF };
+
+template <typename T>
+void WriteRaw(std::ostream &file, const T &value)
+{
+    file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadRaw(std::istream &file, T &value)
+{
+    return static_cast<bool>(file.read(reinterpret_cast<char *>(&value), sizeof(T)));
+}
+
+} // namespace
+
+constexpr size_t BookBuilder::NUM_SHARDS;
+
+BookBuilder::BookBuilder(const Options &options) : m_options(options)
+{
+    m_options.threads = std::max<size_t>(m_options.threads, 1);
+    m_options.maxEntries = std::max<size_t>(m_options.maxEntries, 1);
+}
+
+BookBuilder::~BookBuilder()
+{
+    for (const auto &path : m_runFiles) {
+        std::remove(path.c_str());
+    }
+}
+
+ErrorCode BookBuilder::AddPgnFile(const std::string &path)
+{
+    std::ifstream file(path);
+    if (UNLIKELY(!file)) {
+        ERROR_LOG("Cannot open PGN file: " << path);
+        return FILE_OPEN_ERROR;
+    }
+    return AddPgn(file);
+}
+
+/**************************************************
+ * @details
+ *      The calling thread splits the input into games;
+ *      workers parse the moves and update the shards.
+ *      The queue holds a few batches per worker, so
+ *      reading never runs far ahead of parsing.
+ **************************************************/
+ErrorCode BookBuilder::AddPgn(std::istream &in)
+{
+    BoundedQueue<std::vector<PgnGame>> queue(2 * m_options.threads);
+    std::vector<std::thread> workers;
+    for (size_t i{ 0 }; i < m_options.threads; i++) {
+        workers.emplace_back([this, &queue]() {
+            Position pos;
+            std::vector<PgnGame> batch;
+            while (queue.Pop(batch)) {
+                for (const auto &game : batch) {
+                    ProcessGame(game, pos);
+                }
+            }
+        });
+    }
+
+    PgnReader reader(in);
+    std::vector<PgnGame> batch;
+    PgnGame game;
+    while (reader.NextGame(game)) {
+        batch.push_back(std::move(game));
+        if (batch.size() == GAMES_PER_BATCH) {
+            queue.Push(std::move(batch));
+            batch.clear();
+        }
+    }
+    if (!batch.empty()) {
+        queue.Push(std::move(batch));
+    }
+    queue.Close();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+    return m_spillFailed.load() ? FILE_OPEN_ERROR : SUCCESS;
+}
+
+/**************************************************
+ * @details
+ *      The first maxPly moves are validated before
+ *      anything is counted, so a broken game adds
+ *      nothing to the statistics.
+ **************************************************/
+void BookBuilder::ProcessGame(const PgnGame &game, Position &pos)
+{
+    const GameResult result = game.GetResult();
+    const std::string fen = game.GetTag("FEN");
+    if (result == GameResult::UNKNOWN ||
+        pos.SetFEN(fen.empty() ? STANDARD_POSITION_FEN : fen) != SUCCESS) {
+        m_skipped++;
+        return;
+    }
+
+    std::vector<std::pair<MoveKey, int>> updates;
+    const std::vector<std::string> tokens = PgnReader::Tokenize(game.moveText);
+    const size_t plies = std::min(tokens.size(), static_cast<size_t>(std::max(m_options.maxPly, 0)));
+    for (size_t ply{ 0 }; ply < plies; ply++) {
+        PackedMove move = pos.ParseSanMove(tokens[ply]);
+        if (move.IsNull()) {
+            m_skipped++;
+            return;
+        }
+        // 2 = win, 1 = draw, 0 = loss for the side to move
+        int score = (result == GameResult::DRAW) ? 1
+            : ((result == GameResult::WHITE_WIN) == (pos.GetSideToMove() == PieceColor::WHITE)) ? 2 : 0;
+        updates.emplace_back(MoveKey{ OpeningBook::PolyglotKey(pos), OpeningBook::EncodeMove(move) }, score);
+        pos.MakeMove(move);
+    }
+
+    for (const auto &update : updates) {
+        Insert(update.first, update.second);
+    }
+    m_games++;
+    m_positions += updates.size();
+    if (m_entries.load(std::memory_order_relaxed) >= m_options.maxEntries) {
+        SpillRun();
+    }
+}
+
+void BookBuilder::Insert(const MoveKey &key, int score)
+{
+    Shard &shard = m_shards[MoveKeyHash{}(key) % NUM_SHARDS];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto result = shard.map.emplace(key, MoveStats{});
+    if (result.second) {
+        m_entries.fetch_add(1, std::memory_order_relaxed);
+    }
+    MoveStats &stats = result.first->second;
+    (score == 2 ? stats.wins : score == 1 ? stats.draws : stats.losses)++;
+}
+
+/**************************************************
+ * @details
+ *      Empty every shard into one sorted vector. Keys
+ *      never repeat across shards, so the result has no
+ *      duplicates.
+ **************************************************/
+std::vector<BookBuilder::Record> BookBuilder::DrainShards()
+{
+    std::vector<Record> records;
+    for (auto &shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto &item : shard.map) {
+            records.push_back(Record{ item.first, item.second });
+        }
+        m_entries.fetch_sub(shard.map.size(), std::memory_order_relaxed);
+        shard.map.clear();
+    }
+    std::sort(records.begin(), records.end(),
+        [](const Record &a, const Record &b) { return a.key < b.key; });
+    return records;
+}
+
+/**************************************************
+ * @details
+ *      Only one thread spills at a time; the others
+ *      keep inserting into the emptied shards.
+ **************************************************/
+ErrorCode BookBuilder::SpillRun()
+{
+    std::unique_lock<std::mutex> lock(m_spillMutex, std::try_to_lock);
+    if (!lock.owns_lock() || m_entries.load() < m_options.maxEntries) {
+        return SUCCESS;
+    }
+    std::vector<Record> records = DrainShards();
+    const std::string path = m_options.tempDir + "/shohih_book_" + std::to_string(getpid()) +
+        "_" + std::to_string(reinterpret_cast<uintptr_t>(this)) +
+        "_" + std::to_string(m_runFiles.size()) + ".run";
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    for (const auto &record : records) {
+        WriteRaw(file, record.key.key);
+        WriteRaw(file, record.key.move);
+        WriteRaw(file, record.stats);
+    }
+    if (UNLIKELY(!file)) {
+        ERROR_LOG("Cannot write book run: " << path);
+        m_spillFailed = true;
+        return FILE_OPEN_ERROR;
+    }
+    m_runFiles.push_back(path);
+    return SUCCESS;
+}
+
+/**************************************************
+ * @details
+ *      K-way merge of the runs and the in-memory
+ *      records. Equal (position, move) pairs are
+ *      summed; each finished position is weighted and
+ *      written, so memory stays at one position.
+ **************************************************/
+ErrorCode BookBuilder::Write(const std::string &path)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (UNLIKELY(!out)) {
+        ERROR_LOG("Cannot create book: " << path);
+        return FILE_OPEN_ERROR;
+    }
+
+    // Sources: one reader per run + the records still in memory
+    const std::vector<Record> memory = DrainShards();
+    std::vector<std::unique_ptr<std::ifstream>> runs;
+    for (const auto &runPath : m_runFiles) {
+        runs.push_back(std::make_unique<std::ifstream>(runPath, std::ios::binary));
+    }
+    size_t memoryIndex{ 0 };
+    std::vector<Record> heads(runs.size() + 1);
+    auto advance = [&](size_t source) {
+        if (source == runs.size()) {
+            if (memoryIndex >= memory.size()) {
+                return false;
+            }
+            heads[source] = memory[memoryIndex++];
+            return true;
+        }
+        std::ifstream &file = *runs[source];
+        Record &record = heads[source];
+        return ReadRaw(file, record.key.key) && ReadRaw(file, record.key.move) &&
+            ReadRaw(file, record.stats);
+    };
+    auto greater = [&heads](size_t a, size_t b) { return heads[b].key < heads[a].key; };
+    std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> heap(greater);
+    for (size_t source{ 0 }; source < heads.size(); source++) {
+        if (advance(source)) {
+            heap.push(source);
+        }
+    }
+
+    m_bookEntries = 0;
+    std::vector<Record> group;
+    auto flushGroup = [this, &group, &out]() {
+        uint32_t maxScore{ 0 };
+        for (const auto &record : group) {
+            maxScore = std::max(maxScore, 2 * record.stats.wins + record.stats.draws);
+        }
+        for (const auto &record : group) {
+            const MoveStats &stats = record.stats;
+            const uint64_t score = 2ULL * stats.wins + stats.draws;
+            if (score == 0 || stats.wins + stats.draws + stats.losses < m_options.minGames) {
+                continue;
+            }
+            uint64_t weight = maxScore > MAX_WEIGHT ? std::max<uint64_t>(score * MAX_WEIGHT / maxScore, 1) : score;
+            OpeningBook::WriteEntry(out, BookEntry{ record.key.key, record.key.move,
+                static_cast<uint16_t>(weight), 0 });
+            m_bookEntries++;
+        }
+        group.clear();
+    };
+
+    while (!heap.empty()) {
+        const size_t source = heap.top();
+        heap.pop();
+        const Record record = heads[source];
+        if (advance(source)) {
+            heap.push(source);
+        }
+        if (!group.empty() && group.back().key == record.key) {
+            group.back().stats.wins += record.stats.wins;
+            group.back().stats.draws += record.stats.draws;
+            group.back().stats.losses += record.stats.losses;
+            continue;
+        }
+        if (!group.empty() && group.back().key.key != record.key.key) {
+            flushGroup();
+        }
+        group.push_back(record);
+    }
+    flushGroup();
+    return out ? SUCCESS : FILE_OPEN_ERROR;
+}
+
+} // namespace Shohih
@@ -0,0 +1,107 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Static evaluation Implementation
+ **************************************************/
+
+#include <algorithm>
+#include "evaluate.h"
+#include "bitbase.h"
+
+namespace Shohih {
+
+namespace {
+
+//--------------------------------------------------
+// KPK: won positions keep the classical score plus a
+// bonus for the pawn's progress, staying below a
+// queen up so that promoting is still preferred
+//--------------------------------------------------
+constexpr int KPK_WIN_BONUS{ 400 };
+constexpr int KPK_RANK_BONUS{ 20 };
+
+bool IsKpk(const Position &pos)
+{
+    return pos.GetPhase() == 0 && PopCount(pos.GetOccupied()) == 3 &&
+        pos.GetPieces(PieceType::PAWN) != 0;
+}
+
+int EvaluateKpk(const Position &pos)
+{
+    if (!Kpk::Probe(pos)) {
+        return 0;
+    }
+    const PieceColor strong = pos.GetPieces(PieceColor::WHITE, PieceType::PAWN)
+        ? PieceColor::WHITE : PieceColor::BLACK;
+    const SquareId pawn = Lsb(pos.GetPieces(strong, PieceType::PAWN));
+    const int rank = (strong == PieceColor::WHITE) ? RankOf(pawn) : 7 - RankOf(pawn);
+    const int bonus = KPK_WIN_BONUS + KPK_RANK_BONUS * rank;
+    const int score = EvaluateClassical(pos);
+    return pos.GetSideToMove() == strong ? score + bonus : score - bonus;
+}
+
+/**************************************************
+ * @details
+ *      Interpolate between the middlegame and the
+ *      endgame score by the remaining non-pawn
+ *      material, then flip to the side to move.
+ **************************************************/
+int Taper(const Position &pos, const EvalScore &pawns)
+{
+    EvalScore total = pos.GetPsqScore();
+    total += pawns;
+    const int phase = std::min(pos.GetPhase(), MAX_PHASE);
+    const int score = (total.mg * phase + total.eg * (MAX_PHASE - phase)) / MAX_PHASE;
+    return pos.GetSideToMove() == PieceColor::WHITE ? score : -score;
+}
+
+} // namespace
+
+int Evaluate(const Position &pos, PawnHashTable *pawns)
+{
+    if (UNLIKELY(IsKpk(pos) && Kpk::IsReady())) {
+        return EvaluateKpk(pos);
+    }
+    if (Nnue::IsEnabled()) {
+        return EvaluateNnue(pos);
+    }
+    return pawns ? EvaluateClassical(pos, *pawns) : EvaluateClassical(pos);
+}
+
+int EvaluateClassical(const Position &pos)
+{
+    return Taper(pos, EvaluatePawns(pos));
+}
+
+int EvaluateClassical(const Position &pos, PawnHashTable &pawns)
+{
+    return Taper(pos, pawns.Evaluate(pos));
+}
+
+int EvaluateNnue(const Position &pos)
+{
+    return Nnue::g_network.Evaluate(pos.GetAccumulator(), pos.GetSideToMove());
+}
+
+EvalScore ComputePsqScore(const Position &pos)
+{
+    EvalScore score{};
+    for (SquareId sq{ 0 }; sq < NUM_SQUARES; sq++) {
+        if (pos.GetPieceOn(sq) != NO_PIECE) {
+            score += PsqScore(pos.GetPieceOn(sq), sq);
+        }
+    }
+    return score;
+}
+
+int ComputePhase(const Position &pos)
+{
+    int phase{ 0 };
+    for (SquareId sq{ 0 }; sq < NUM_SQUARES; sq++) {
+        if (pos.GetPieceOn(sq) != NO_PIECE) {
+            phase += PhaseWeight(pos.GetPieceOn(sq));
+        }
+    }
+    return phase;
+}
+
+} // namespace Shohih
@@ -0,0 +1,372 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   DFPN mate solver Implementation
+ **************************************************/
+
+#include <fstream>
+#include "mate_solver.h"
+
+namespace Shohih {
+
+namespace {
+
+// Proof/disproof numbers saturate here
+constexpr uint32_t PN_INFINITE{ 1u << 30 };
+
+uint32_t Saturate(uint64_t value)
+{
+    return static_cast<uint32_t>(std::min<uint64_t>(value, PN_INFINITE));
+}
+
+} // namespace
+
+void MateSolver::Resize(size_t megabytes)
+{
+    size_t bytes = std::max<size_t>(megabytes, 1) * 1024 * 1024;
+    size_t clusters{ 1 };
+    while (clusters * 2 * CLUSTER_SIZE * sizeof(Entry) <= bytes) {
+        clusters *= 2;
+    }
+    m_entries.reset(new Entry[clusters * CLUSTER_SIZE]);
+    m_numClusters = clusters;
+    Clear();
+}
+
+void MateSolver::Clear()
+{
+    for (size_t i{ 0 }; i < m_numClusters * CLUSTER_SIZE; i++) {
+        m_entries[i] = Entry{ 0, 0, 0, 0 };
+    }
+}
+
+uint64_t MateSolver::NodeKey(uint64_t positionKey, int depth)
+{
+    return positionKey ^ (static_cast<uint64_t>(depth + 1) * 0x9E3779B97F4A7C15ULL);
+}
+
+/**************************************************
+ * @details
+ *      Unknown nodes start at pn = dn = 1.
+ **************************************************/
+void MateSolver::Lookup(uint64_t key, uint32_t &pn, uint32_t &dn) const
+{
+    const Entry *cluster = &m_entries[(key & (m_numClusters - 1)) * CLUSTER_SIZE];
+    for (size_t i{ 0 }; i < CLUSTER_SIZE; i++) {
+        if (cluster[i].key == key && cluster[i].work != 0) {
+            pn = cluster[i].pn;
+            dn = cluster[i].dn;
+            return;
+        }
+    }
+    pn = 1;
+    dn = 1;
+}
+
+/**************************************************
+ * @details
+ *      Replace the entry with the same key, otherwise
+ *      the one with the least work behind it.
+ **************************************************/
+void MateSolver::Store(uint64_t key, uint32_t pn, uint32_t dn, uint64_t work)
+{
+    Entry *cluster = &m_entries[(key & (m_numClusters - 1)) * CLUSTER_SIZE];
+    Entry *replace = cluster;
+    for (size_t i{ 0 }; i < CLUSTER_SIZE; i++) {
+        if (cluster[i].key == key) {
+            replace = &cluster[i];
+            work += cluster[i].work;
+            break;
+        }
+        if (cluster[i].work < replace->work) {
+            replace = &cluster[i];
+        }
+    }
+    *replace = Entry{ key, pn, dn, static_cast<uint32_t>(std::min<uint64_t>(std::max<uint64_t>(work, 1), UINT32_MAX)) };
+}
+
+bool MateSolver::ShouldStop()
+{
+    if (m_stop.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    if (m_limits.nodes != 0 && m_nodes >= m_limits.nodes) {
+        m_stop.store(true, std::memory_order_relaxed);
+        return true;
+    }
+    if (m_limits.timeMs != 0 && (m_nodes & 1023) == 0) {
+        const int64_t elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - m_startTime).count();
+        if (elapsed >= m_limits.timeMs) {
+            m_stop.store(true, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**************************************************
+ * @details
+ *      Multiple iterative deepening (Nagai's DFPN).
+ *      Odd remaining depths are OR nodes (attacker to
+ *      move): pn = min over children, dn = sum. AND
+ *      nodes swap the two. The most-proving child is
+ *      searched with thresholds that return control as
+ *      soon as another child becomes more promising.
+ **************************************************/
+void MateSolver::Mid(uint64_t key, int depth, uint32_t thPn, uint32_t thDn)
+{
+    m_nodes++;
+    const uint64_t startNodes = m_nodes;
+    const bool orNode = (depth & 1) != 0;
+
+    MoveList moves;
+    m_pos.GenerateLegalMoves(moves);
+    if (moves.Empty()) {
+        // Mate proves an AND node; stalemate or a mated attacker disproves
+        const bool proven = !orNode && m_pos.InCheck();
+        Store(key, proven ? 0 : PN_INFINITE, proven ? PN_INFINITE : 0, 1);
+        return;
+    }
+    if (depth == 0) {
+        Store(key, PN_INFINITE, 0, 1);
+        return;
+    }
+
+    std::array<uint64_t, MAX_MOVES> childKeys;
+    for (size_t i{ 0 }; i < moves.Size(); i++) {
+        m_pos.MakeMove(moves[i].move);
+        childKeys[i] = NodeKey(m_pos.GetKey(), depth - 1);
+        m_pos.UnmakeMove(moves[i].move);
+    }
+
+    uint32_t pn{ 0 }, dn{ 0 };
+    while (true) {
+        // Combine the children: "min" is the number the node's
+        // type minimizes (pn at OR nodes), "sum" the other one
+        uint32_t minValue{ PN_INFINITE }, secondMin{ PN_INFINITE };
+        uint32_t bestPn{ 0 }, bestDn{ 0 };
+        uint64_t sum{ 0 };
+        size_t best{ 0 };
+        for (size_t i{ 0 }; i < moves.Size(); i++) {
+            uint32_t childPn, childDn;
+            Lookup(childKeys[i], childPn, childDn);
+            const uint32_t minPart = orNode ? childPn : childDn;
+            sum += orNode ? childDn : childPn;
+            if (minPart < minValue) {
+                secondMin = minValue;
+                minValue = minPart;
+                best = i;
+                bestPn = childPn;
+                bestDn = childDn;
+            } else if (minPart < secondMin) {
+                secondMin = minPart;
+            }
+        }
+        pn = orNode ? minValue : Saturate(sum);
+        dn = orNode ? Saturate(sum) : minValue;
+        if (pn >= thPn || dn >= thDn || ShouldStop()) {
+            break;
+        }
+
+        uint32_t childThPn, childThDn;
+        if (orNode) {
+            childThPn = std::min(thPn, Saturate(static_cast<uint64_t>(secondMin) + 1));
+            childThDn = Saturate(static_cast<uint64_t>(thDn) - dn + bestDn);
+        } else {
+            childThPn = Saturate(static_cast<uint64_t>(thPn) - pn + bestPn);
+            childThDn = std::min(thDn, Saturate(static_cast<uint64_t>(secondMin) + 1));
+        }
+        m_pos.MakeMove(moves[best].move);
+        Mid(childKeys[best], depth - 1, childThPn, childThDn);
+        m_pos.UnmakeMove(moves[best].move);
+    }
+    Store(key, pn, dn, m_nodes - startNodes + 1);
+}
+
+/**************************************************
+ * @details
+ *      Shortest proof of the current position among
+ *      the remaining depths @param first, first + 2, ...
+ *      @param last. @return -1 if none (or stopped).
+ **************************************************/
+int MateSolver::ProvenDepth(int first, int last)
+{
+    for (int depth{ first }; depth <= last; depth += 2) {
+        const uint64_t key = NodeKey(m_pos.GetKey(), depth);
+        uint32_t pn, dn;
+        Lookup(key, pn, dn);
+        if (pn != 0 && dn != 0) {
+            Mid(key, depth, PN_INFINITE, PN_INFINITE);
+            Lookup(key, pn, dn);
+        }
+        if (pn == 0) {
+            return depth;
+        }
+        if (dn != 0) {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+/**************************************************
+ * @details
+ *      The attacker plays the move with the shortest
+ *      proof, the defender the reply with the longest
+ *      one. Proofs at shorter depths are mostly found
+ *      in the table from the earlier iterations.
+ **************************************************/
+bool MateSolver::ExtractLine(int depth, std::vector<PackedMove> &line)
+{
+    const Position root = m_pos;
+    while (depth > 0) {
+        const bool orNode = (depth & 1) != 0;
+        MoveList moves;
+        m_pos.GenerateLegalMoves(moves);
+        PackedMove chosen{};
+        int chosenDepth{ -1 };
+        // Attacker: only refine moves already proven at full depth
+        bool anyProven{ false };
+        std::array<bool, MAX_MOVES> candidate;
+        for (size_t i{ 0 }; i < moves.Size(); i++) {
+            uint32_t pn{ 0 }, dn{ 0 };
+            if (orNode) {
+                m_pos.MakeMove(moves[i].move);
+                Lookup(NodeKey(m_pos.GetKey(), depth - 1), pn, dn);
+                m_pos.UnmakeMove(moves[i].move);
+            }
+            candidate[i] = (pn == 0);
+            anyProven |= candidate[i];
+        }
+        for (size_t i{ 0 }; i < moves.Size(); i++) {
+            if (anyProven && !candidate[i]) {
+                continue;
+            }
+            const ScoredMove &m = moves[i];
+            m_pos.MakeMove(m.move);
+            const int childDepth = ProvenDepth(orNode ? 0 : 1, depth - 1);
+            m_pos.UnmakeMove(m.move);
+            if (childDepth >= 0 && (chosen.IsNull() ||
+                (orNode ? childDepth < chosenDepth : childDepth > chosenDepth))) {
+                chosen = m.move;
+                chosenDepth = childDepth;
+            }
+        }
+        if (chosen.IsNull() || m_stop.load(std::memory_order_relaxed)) {
+            break;
+        }
+        line.push_back(chosen);
+        m_pos.MakeMove(chosen);
+        depth = chosenDepth;
+    }
+    MoveList replies;
+    m_pos.GenerateLegalMoves(replies);
+    const bool mated = m_pos.InCheck() && replies.Empty();
+    m_pos = root;
+    return mated;
+}
+
+/**************************************************
+ * @details
+ *      Mate in n needs 2n - 1 plies. Each length is
+ *      proven or disproven before trying the next, so
+ *      the first proof is the shortest mate.
+ **************************************************/
+MateResult MateSolver::Solve(const Position &pos, const MateLimits &limits)
+{
+    MateResult result{};
+    m_pos = pos;
+    m_limits = limits;
+    m_nodes = 0;
+    m_startTime = std::chrono::steady_clock::now();
+    m_stop.store(false, std::memory_order_relaxed);
+
+    result.status = MateStatus::NO_MATE;
+    for (int n{ 1 }; n <= limits.maxMoves; n++) {
+        const int depth = 2 * n - 1;
+        const uint64_t rootKey = NodeKey(m_pos.GetKey(), depth);
+        Mid(rootKey, depth, PN_INFINITE, PN_INFINITE);
+
+        uint32_t pn, dn;
+        Lookup(rootKey, pn, dn);
+        if (pn == 0) {
+            if (!ExtractLine(depth, result.line)) {
+                WARNING_LOG("Mate in " << n << " proven, line cut short by the limits");
+            }
+            result.status = MateStatus::MATE;
+            result.mateIn = n;
+            break;
+        }
+        if (dn != 0 || m_stop.load(std::memory_order_relaxed)) {
+            result.status = MateStatus::UNKNOWN;
+            break;
+        }
+    }
+    if (result.status != MateStatus::MATE) {
+        result.line.clear();
+        result.mateIn = 0;
+    }
+    result.nodes = m_nodes;
+    result.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - m_startTime).count();
+    return result;
+}
+
+/**************************************************
+ * @details
+ *      Workers take the next unsolved position from a
+ *      shared counter, so long proofs do not hold up
+ *      the rest of the batch.
+ **************************************************/
+std::vector<MateResult> SolveMateBatch(const std::vector<std::string> &fens, const MateLimits &limits,
+    size_t threads, size_t megabytes)
+{
+    std::vector<MateResult> results(fens.size());
+    std::atomic<size_t> next{ 0 };
+    auto worker = [&]() {
+        MateSolver solver(megabytes);
+        Position pos;
+        for (size_t i = next++; i < fens.size(); i = next++) {
+            if (pos.SetFEN(fens[i]) != SUCCESS) {
+                continue;
+            }
+            results[i] = solver.Solve(pos, limits);
+        }
+    };
+
+    threads = std::max<size_t>(1, std::min(threads, fens.size()));
+    std::vector<std::thread> helpers;
+    for (size_t i{ 1 }; i < threads; i++) {
+        helpers.emplace_back(worker);
+    }
+    worker();
+    for (auto &helper : helpers) {
+        helper.join();
+    }
+    return results;
+}
+
+ErrorCode SolveMateFile(const std::string &path, const MateLimits &limits, size_t threads,
+    size_t megabytes, std::vector<std::string> &fens, std::vector<MateResult> &results)
+{
+    std::ifstream file(path);
+    if (UNLIKELY(!file.is_open())) {
+        ERROR_LOG("Could not open " << path);
+        return FILE_OPEN_ERROR;
+    }
+    fens.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        fens.push_back(line);
+    }
+    results = SolveMateBatch(fens, limits, threads, megabytes);
+    return SUCCESS;
+}
+
+} // namespace Shohih
@@ -0,0 +1,556 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Monte Carlo tree search Implementation
+ **************************************************/
+
+#include <cmath>
+#include <thread>
+#include <algorithm>
+#include "mcts.h"
+#include "evaluate.h"
+
+namespace Shohih {
+
+namespace {
+
+constexpr uint32_t NO_NODE{ UINT32_MAX };
+
+// Centipawns <-> expected result in [-1, 1]
+constexpr double VALUE_SCALE_CP{ 400.0 };
+
+// Unvisited PUCT children start slightly below their parent
+constexpr double FIRST_PLAY_URGENCY_REDUCTION{ 0.1 };
+
+// Progress reports from the main thread
+constexpr int64_t INFO_INTERVAL_MS{ 1000 };
+
+uint64_t NextRandom(uint64_t &state)
+{
+    state ^= state >> 12;
+    state ^= state << 25;
+    state ^= state >> 27;
+    return state * 0x2545F4914F6CDD1DULL;
+}
+
+double ValueFromCp(int cp)
+{
+    return 2.0 / (1.0 + std::exp(-cp / VALUE_SCALE_CP)) - 1.0;
+}
+
+int CpFromValue(double value)
+{
+    value = std::max(-0.999, std::min(0.999, value));
+    return static_cast<int>(VALUE_SCALE_CP * std::log((1.0 + value) / (1.0 - value)));
+}
+
+} // namespace
+
+Mcts::Mcts(const MctsOptions &options)
+{
+    SetOptions(options);
+}
+
+/**************************************************
+ * @details
+ *      The arena is allocated by the first Run(), so
+ *      an idle instance costs no memory.
+ **************************************************/
+void Mcts::SetOptions(const MctsOptions &options)
+{
+    if (options.megabytes != m_options.megabytes || m_capacity == 0) {
+        m_nodes.reset();
+        m_capacity = std::max<size_t>(options.megabytes, 1) * 1024 * 1024 / sizeof(Node);
+        m_capacity = std::min<size_t>(m_capacity, NO_NODE);
+        m_hasTree = false;
+    }
+    m_options = options;
+    m_rng = options.seed ? options.seed : 1;
+}
+
+void Mcts::Clear()
+{
+    m_hasTree = false;
+    m_size.store(0, std::memory_order_relaxed);
+}
+
+int64_t Mcts::ElapsedMs() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - m_startTime).count();
+}
+
+bool Mcts::Allocate(size_t count, uint32_t &first)
+{
+    const size_t index = m_size.fetch_add(count, std::memory_order_relaxed);
+    if (index + count > m_capacity) {
+        return false;
+    }
+    first = static_cast<uint32_t>(index);
+    return true;
+}
+
+void Mcts::ResetNode(Node &node, PackedMove move, float prior)
+{
+    node.visits.store(0, std::memory_order_relaxed);
+    node.valueSum.store(0, std::memory_order_relaxed);
+    node.firstChild = NO_NODE;
+    node.numChildren = 0;
+    node.result = 0;
+    node.move = move;
+    node.prior = prior;
+    node.state.store(UNEXPANDED, std::memory_order_release);
+}
+
+/**************************************************
+ * @details
+ *      A node in flight counts as visited and lost for
+ *      the side that moved into it, which steers the
+ *      other threads to different branches.
+ **************************************************/
+void Mcts::AddVirtualLoss(Node &node) const
+{
+    node.visits.fetch_add(static_cast<uint32_t>(m_options.virtualLoss), std::memory_order_relaxed);
+    node.valueSum.fetch_sub(m_options.virtualLoss * VALUE_ONE, std::memory_order_relaxed);
+}
+
+/**************************************************
+ * @details
+ *      PUCT: Q + c * P * sqrt(N) / (1 + n)
+ *      UCT:  Q + c * sqrt(ln(N) / n), unvisited first
+ *      A child that mates is always taken.
+ **************************************************/
+uint32_t Mcts::SelectChild(const Node &node) const
+{
+    const uint32_t parentVisits = std::max<uint32_t>(node.visits.load(std::memory_order_relaxed), 1);
+    const double sqrtParent = std::sqrt(static_cast<double>(parentVisits));
+    const double logParent = std::log(static_cast<double>(parentVisits));
+    // The parent's statistics are from the other side's view
+    const double parentQ = -static_cast<double>(node.valueSum.load(std::memory_order_relaxed)) /
+        (static_cast<double>(VALUE_ONE) * parentVisits);
+    const double fpu = parentQ - FIRST_PLAY_URGENCY_REDUCTION;
+
+    uint32_t best = node.firstChild;
+    double bestScore = -1e9;
+    for (uint32_t i{ node.firstChild }; i < node.firstChild + node.numChildren; i++) {
+        const Node &child = m_nodes[i];
+        if (child.state.load(std::memory_order_acquire) == TERMINAL && child.result < 0) {
+            return i;
+        }
+        const uint32_t visits = child.visits.load(std::memory_order_relaxed);
+        if (!m_options.puct && visits == 0) {
+            return i;
+        }
+        const double q = visits == 0 ? fpu :
+            static_cast<double>(child.valueSum.load(std::memory_order_relaxed)) /
+            (static_cast<double>(VALUE_ONE) * visits);
+        const double u = m_options.puct
+            ? m_options.exploration * child.prior * sqrtParent / (1.0 + visits)
+            : m_options.exploration * std::sqrt(logParent / visits);
+        if (q + u > bestScore) {
+            bestScore = q + u;
+            best = i;
+        }
+    }
+    return best;
+}
+
+/**************************************************
+ * @details
+ *      Priors: softmax over cheap move features
+ *      (exchange value of captures, promotions).
+ *      - @return false if another thread is expanding
+ *          the node or the arena is full
+ **************************************************/
+bool Mcts::Expand(Node &node, Position &pos)
+{
+    uint8_t expected{ UNEXPANDED };
+    if (!node.state.compare_exchange_strong(expected, EXPANDING, std::memory_order_acq_rel)) {
+        return false;
+    }
+    MoveList moves;
+    pos.GenerateLegalMoves(moves);
+    if (moves.Empty()) {
+        node.result = pos.InCheck() ? -1 : 0;
+        node.state.store(TERMINAL, std::memory_order_release);
+        return true;
+    }
+    uint32_t first{ 0 };
+    if (!Allocate(moves.Size(), first)) {
+        node.state.store(UNEXPANDED, std::memory_order_release);
+        return false;
+    }
+
+    std::array<double, MAX_MOVES> weights;
+    double total{ 0 };
+    for (size_t i{ 0 }; i < moves.Size(); i++) {
+        const PackedMove move = moves[i].move;
+        double logit{ 0 };
+        if (move.IsCapture()) {
+            logit += 0.5 + std::max(-2.0, std::min(2.0, pos.See(move) / 200.0));
+        }
+        if (move.IsPromotion()) {
+            logit += move.PromotionType() == PieceType::QUEEN ? 2.0 : -2.0;
+        }
+        weights[i] = std::exp(logit);
+        total += weights[i];
+    }
+    for (size_t i{ 0 }; i < moves.Size(); i++) {
+        ResetNode(m_nodes[first + i], moves[i].move, static_cast<float>(weights[i] / total));
+    }
+    node.firstChild = first;
+    node.numChildren = static_cast<uint16_t>(moves.Size());
+    node.state.store(EXPANDED, std::memory_order_release);
+    return true;
+}
+
+/**************************************************
+ * @details
+ *      Light playout: take the best winning capture if
+ *      there is one, else a random legal move. The
+ *      final position is scored by the static
+ *      evaluation. @return the value for the side to
+ *      move at @param pos (restored on return).
+ **************************************************/
+double Mcts::Rollout(Position &pos, uint64_t &rng)
+{
+    std::array<PackedMove, MAX_PLY> played;
+    int plies{ 0 };
+    double value{ 0 };
+    bool terminal{ false };
+    for (; plies < std::min(m_options.rolloutPlies, MAX_PLY); plies++) {
+        MoveList moves;
+        pos.GenerateLegalMoves(moves);
+        if (moves.Empty()) {
+            value = pos.InCheck() ? -1.0 : 0.0;
+            terminal = true;
+            break;
+        }
+        PackedMove chosen{};
+        int bestSee{ 0 };
+        for (const auto &m : moves) {
+            if (m.move.IsCapture()) {
+                const int see = pos.See(m.move);
+                if (see > bestSee) {
+                    bestSee = see;
+                    chosen = m.move;
+                }
+            }
+        }
+        if (chosen.IsNull()) {
+            chosen = moves[NextRandom(rng) % moves.Size()].move;
+        }
+        pos.MakeMove(chosen);
+        played[plies] = chosen;
+        if (pos.IsDraw()) {
+            plies++;
+            terminal = true;
+            break;
+        }
+    }
+    if (!terminal) {
+        value = ValueFromCp(Evaluate(pos));
+    }
+    // Back to the side to move at the start
+    if (plies % 2 != 0) {
+        value = -value;
+    }
+    while (plies > 0) {
+        pos.UnmakeMove(played[--plies]);
+    }
+    return value;
+}
+
+/**************************************************
+ * @details
+ *      Select down to a leaf with virtual losses,
+ *      expand it, evaluate and back the value up,
+ *      replacing each virtual loss by the real result.
+ **************************************************/
+void Mcts::Playout(Position &pos, uint64_t &rng)
+{
+    std::array<uint32_t, MAX_PLY + 1> path;
+    size_t length{ 0 };
+    uint32_t index = m_root;
+    AddVirtualLoss(m_nodes[index]);
+    path[length++] = index;
+
+    double value{ 0 };  // for the side to move at the leaf
+    while (true) {
+        Node &node = m_nodes[index];
+        const uint8_t state = node.state.load(std::memory_order_acquire);
+        if (state == TERMINAL) {
+            value = node.result;
+            break;
+        }
+        if (state != EXPANDED || length > MAX_PLY) {
+            if (state == UNEXPANDED && Expand(node, pos) &&
+                node.state.load(std::memory_order_acquire) == TERMINAL) {
+                value = node.result;
+            } else {
+                value = Rollout(pos, rng);
+            }
+            break;
+        }
+        index = SelectChild(node);
+        AddVirtualLoss(m_nodes[index]);
+        pos.MakeMove(m_nodes[index].move);
+        path[length++] = index;
+        if (pos.IsDraw()) {
+            value = 0;
+            break;
+        }
+    }
+
+    int selDepth = m_selDepth.load(std::memory_order_relaxed);
+    while (static_cast<int>(length) - 1 > selDepth &&
+           !m_selDepth.compare_exchange_weak(selDepth, static_cast<int>(length) - 1)) {}
+
+    // Each node holds the value for the side that moved into it
+    const int64_t virtualLoss = m_options.virtualLoss;
+    for (size_t i{ length }; i-- > 0;) {
+        value = -value;
+        Node &node = m_nodes[path[i]];
+        node.valueSum.fetch_add(static_cast<int64_t>(std::llround(value * VALUE_ONE)) + virtualLoss * VALUE_ONE,
+            std::memory_order_relaxed);
+        node.visits.fetch_sub(static_cast<uint32_t>(virtualLoss - 1), std::memory_order_relaxed);
+    }
+    for (size_t i{ length - 1 }; i > 0; i--) {
+        pos.UnmakeMove(m_nodes[path[i]].move);
+    }
+}
+
+/**************************************************
+ * @details
+ *      The clock is read every 64 playouts per thread
+ *      and ignored while pondering. A full arena ends
+ *      the search.
+ **************************************************/
+bool Mcts::ShouldStop(uint64_t localPlayouts)
+{
+    if (m_signals->stop.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    if ((m_limits.nodes != 0 && GetNodes() >= m_limits.nodes) ||
+        m_size.load(std::memory_order_relaxed) + MAX_MOVES > m_capacity ||
+        ((localPlayouts & 63) == 0 && m_optimumMs != 0 &&
+         !m_signals->ponder.load(std::memory_order_relaxed) && ElapsedMs() >= m_optimumMs)) {
+        Stop();
+        return true;
+    }
+    return false;
+}
+
+void Mcts::Worker(size_t threadId)
+{
+    Position pos = m_rootPos;
+    uint64_t rng = m_rng ^ (0x9E3779B97F4A7C15ULL * (threadId + 1));
+    int64_t nextInfo{ INFO_INTERVAL_MS };
+    for (uint64_t playouts{ 0 }; !ShouldStop(playouts); playouts++) {
+        Playout(pos, rng);
+        m_playouts.fetch_add(1, std::memory_order_relaxed);
+        if (threadId == 0 && m_infoCallback && (playouts & 255) == 0 && ElapsedMs() >= nextInfo) {
+            SendInfo();
+            nextInfo += INFO_INTERVAL_MS;
+        }
+    }
+}
+
+/**************************************************
+ * @details
+ *      Look for @param pos among the children and
+ *      grandchildren of the previous root (our move
+ *      and the reply). The arena is not compacted, so
+ *      a tree that fills half of it is dropped instead.
+ **************************************************/
+bool Mcts::ReuseTree(const Position &pos)
+{
+    if (!m_hasTree || m_nodes == nullptr || m_size.load(std::memory_order_relaxed) * 2 > m_capacity) {
+        return false;
+    }
+    if (m_rootPos.GetKey() == pos.GetKey()) {
+        return true;
+    }
+    Position walk = m_rootPos;
+    const Node &root = m_nodes[m_root];
+    if (root.state.load(std::memory_order_acquire) != EXPANDED) {
+        return false;
+    }
+    for (uint32_t i{ root.firstChild }; i < root.firstChild + root.numChildren; i++) {
+        const Node &child = m_nodes[i];
+        walk.MakeMove(child.move);
+        if (walk.GetKey() == pos.GetKey()) {
+            m_root = i;
+            return true;
+        }
+        if (child.state.load(std::memory_order_acquire) == EXPANDED) {
+            for (uint32_t j{ child.firstChild }; j < child.firstChild + child.numChildren; j++) {
+                walk.MakeMove(m_nodes[j].move);
+                const bool found = (walk.GetKey() == pos.GetKey());
+                walk.UnmakeMove(m_nodes[j].move);
+                if (found) {
+                    m_root = j;
+                    return true;
+                }
+            }
+        }
+        walk.UnmakeMove(child.move);
+    }
+    return false;
+}
+
+uint32_t Mcts::MostVisitedChild(uint32_t index) const
+{
+    const Node &node = m_nodes[index];
+    if (node.state.load(std::memory_order_acquire) != EXPANDED) {
+        return NO_NODE;
+    }
+    uint32_t best{ NO_NODE };
+    uint32_t bestVisits{ 0 };
+    for (uint32_t i{ node.firstChild }; i < node.firstChild + node.numChildren; i++) {
+        const Node &child = m_nodes[i];
+        if (child.state.load(std::memory_order_acquire) == TERMINAL && child.result < 0) {
+            return i;
+        }
+        const uint32_t visits = child.visits.load(std::memory_order_relaxed);
+        if (best == NO_NODE || visits > bestVisits) {
+            best = i;
+            bestVisits = visits;
+        }
+    }
+    return best;
+}
+
+std::vector<PackedMove> Mcts::GetPv() const
+{
+    std::vector<PackedMove> pv;
+    for (uint32_t index = MostVisitedChild(m_root); index != NO_NODE && pv.size() < MAX_PLY;
+         index = MostVisitedChild(index)) {
+        if (m_nodes[index].visits.load(std::memory_order_relaxed) == 0) {
+            break;
+        }
+        pv.push_back(m_nodes[index].move);
+    }
+    return pv;
+}
+
+/**************************************************
+ * @details
+ *      With a temperature, moves are sampled in
+ *      proportion to visits^(1/T): higher values give
+ *      weaker, more varied play.
+ **************************************************/
+uint32_t Mcts::ChooseChild(uint64_t &rng) const
+{
+    const uint32_t best = MostVisitedChild(m_root);
+    if (best == NO_NODE || m_options.temperature <= 0 ||
+        (m_nodes[best].state.load(std::memory_order_acquire) == TERMINAL && m_nodes[best].result < 0)) {
+        return best;
+    }
+    const Node &root = m_nodes[m_root];
+    std::vector<double> weights(root.numChildren);
+    double total{ 0 };
+    for (uint32_t i{ 0 }; i < root.numChildren; i++) {
+        const double visits = m_nodes[root.firstChild + i].visits.load(std::memory_order_relaxed);
+        weights[i] = std::pow(visits, 1.0 / m_options.temperature);
+        total += weights[i];
+    }
+    double pick = static_cast<double>(NextRandom(rng) >> 11) / static_cast<double>(1ULL << 53) * total;
+    for (uint32_t i{ 0 }; i < root.numChildren; i++) {
+        pick -= weights[i];
+        if (pick < 0) {
+            return root.firstChild + i;
+        }
+    }
+    return best;
+}
+
+int Mcts::Score(uint32_t index) const
+{
+    const Node &node = m_nodes[index];
+    if (node.state.load(std::memory_order_acquire) == TERMINAL && node.result < 0) {
+        return VALUE_MATE - 1;
+    }
+    const uint32_t visits = std::max<uint32_t>(node.visits.load(std::memory_order_relaxed), 1);
+    return CpFromValue(static_cast<double>(node.valueSum.load(std::memory_order_relaxed)) /
+                       (static_cast<double>(VALUE_ONE) * visits));
+}
+
+void Mcts::SendInfo()
+{
+    const uint32_t best = MostVisitedChild(m_root);
+    if (best == NO_NODE) {
+        return;
+    }
+    SearchInfo info;
+    info.pv = GetPv();
+    info.depth = static_cast<int>(info.pv.size());
+    info.selDepth = m_selDepth.load(std::memory_order_relaxed);
+    info.score = Score(best);
+    info.nodes = GetNodes();
+    info.elapsedMs = ElapsedMs();
+    m_infoCallback(info);
+}
+
+SearchResult Mcts::Run(const Position &pos, const SearchLimits &limits)
+{
+    m_startTime = std::chrono::steady_clock::now();
+    m_limits = limits;
+    if (m_signals == &m_ownSignals) {
+        m_ownSignals.stop.store(false, std::memory_order_relaxed);
+        m_ownSignals.ponder.store(limits.ponder, std::memory_order_relaxed);
+    }
+    m_playouts.store(0, std::memory_order_relaxed);
+    m_selDepth.store(0, std::memory_order_relaxed);
+    int64_t maximumMs{ 0 };
+    ComputeTimeLimits(limits, pos.GetSideToMove(), m_optimumMs, maximumMs);
+    if (m_optimumMs == 0) {
+        m_optimumMs = maximumMs;
+    }
+
+    SearchResult result{};
+    MoveList legalMoves;
+    pos.GenerateLegalMoves(legalMoves);
+    if (legalMoves.Empty()) {
+        result.score = pos.InCheck() ? -VALUE_MATE : VALUE_DRAW;
+        return result;
+    }
+    result.bestMove = legalMoves[0].move;
+
+    if (m_nodes == nullptr) {
+        m_nodes.reset(new Node[m_capacity]);
+        m_hasTree = false;
+    }
+    if (!ReuseTree(pos)) {
+        m_size.store(0, std::memory_order_relaxed);
+        Allocate(1, m_root);
+        ResetNode(m_nodes[m_root], NULL_PACKED_MOVE, 1.0f);
+    }
+    m_rootPos = pos;
+    m_rootPos.RefreshAccumulator();
+    m_hasTree = true;
+
+    std::vector<std::thread> helpers;
+    for (size_t i{ 1 }; i < m_numThreads; i++) {
+        helpers.emplace_back(&Mcts::Worker, this, i);
+    }
+    Worker(0);
+    for (auto &helper : helpers) {
+        helper.join();
+    }
+
+    const uint32_t chosen = ChooseChild(m_rng);
+    if (chosen != NO_NODE) {
+        const uint32_t reply = MostVisitedChild(chosen);
+        result.bestMove = m_nodes[chosen].move;
+        result.ponderMove = (reply == NO_NODE) ? NULL_PACKED_MOVE : m_nodes[reply].move;
+        result.score = Score(chosen);
+    }
+    result.depth = static_cast<int>(GetPv().size());
+    result.nodes = GetNodes();
+    if (m_infoCallback) {
+        SendInfo();
+    }
+    return result;
+}
+
+} // namespace Shohih
@@ -0,0 +1,217 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Staged move picker Implementation
+ **************************************************/
+
+#include <cstdlib>
+#include "movepick.h"
+
+namespace Shohih {
+
+constexpr int HistoryTable::MAX_SCORE;
+
+void HistoryTable::Update(PieceColor color, PackedMove move, int bonus)
+{
+    bonus = std::max(-MAX_SCORE, std::min(MAX_SCORE, bonus));
+    int16_t &entry = m_table[static_cast<uint8_t>(color)][Index(move)];
+    entry = static_cast<int16_t>(entry + bonus - entry * std::abs(bonus) / MAX_SCORE);
+}
+
+/**************************************************
+ * @details
+ *      Main search constructor. The TT move is only
+ *      used if it is pseudo-legal in @param pos
+ *      (hash collisions may return any move).
+ **************************************************/
+MovePicker::MovePicker(const Position &pos, PackedMove ttMove,
+    const KillerMoves &killers, const HistoryTable &history)
+    : m_pos(pos), m_history(history), m_killers(killers)
+{
+    m_ttMove = (!ttMove.IsNull() && pos.IsPseudoLegal(ttMove)) ? ttMove : NULL_PACKED_MOVE;
+    m_stage = m_ttMove.IsNull() ? Stage::INIT_CAPTURES : Stage::TT_MOVE;
+}
+
+/**************************************************
+ * @details
+ *      Quiescence constructor. Only captures and
+ *      promotions are returned.
+ **************************************************/
+MovePicker::MovePicker(const Position &pos, PackedMove ttMove, const HistoryTable &history)
+    : m_pos(pos), m_history(history)
+{
+    m_ttMove = (!ttMove.IsNull() && !ttMove.IsQuiet() && pos.IsPseudoLegal(ttMove))
+        ? ttMove : NULL_PACKED_MOVE;
+    m_stage = m_ttMove.IsNull() ? Stage::QS_INIT_CAPTURES : Stage::QS_TT_MOVE;
+}
+
+/**************************************************
+ * @details
+ *      MVV-LVA: most valuable victim first, then
+ *      least valuable attacker. Promotions count the
+ *      promoted piece as gained material.
+ **************************************************/
+void MovePicker::ScoreCaptures()
+{
+    for (auto &item : m_moves) {
+        const PackedMove move = item.move;
+        const PieceType attacker = TypeOf(m_pos.GetPieceOn(move.From()));
+        int score{ 0 };
+        if (move.Flags() == PackedMove::EN_PASSANT) {
+            score = 10 * PieceValue(PieceType::PAWN);
+        } else if (move.IsCapture()) {
+            score = 10 * PieceValue(TypeOf(m_pos.GetPieceOn(move.To())));
+        }
+        if (move.IsPromotion()) {
+            score += PieceValue(move.PromotionType());
+        }
+        item.score = score - static_cast<int>(attacker);
+    }
+}
+
+/**************************************************
+ * @details
+ *      Quiets are ordered by butterfly history and
+ *      fully sorted (insertion sort keeps generation
+ *      order on ties so the search is deterministic).
+ **************************************************/
+void MovePicker::ScoreQuiets()
+{
+    const PieceColor us = m_pos.GetSideToMove();
+    for (auto &item : m_moves) {
+        item.score = m_history.Get(us, item.move);
+    }
+    for (size_t i{ 1 }; i < m_moves.Size(); i++) {
+        ScoredMove tmp = m_moves[i];
+        size_t j = i;
+        for (; j > 0 && m_moves[j - 1].score < tmp.score; j--) {
+            m_moves[j] = m_moves[j - 1];
+        }
+        m_moves[j] = tmp;
+    }
+}
+
+/**************************************************
+ * @details
+ *      Selection step: swap the best remaining move
+ *      to the front (cheaper than a full sort when
+ *      a cutoff happens early).
+ **************************************************/
+PackedMove MovePicker::PickBest()
+{
+    size_t best = m_current;
+    for (size_t i{ m_current + 1 }; i < m_moves.Size(); i++) {
+        if (m_moves[i].score > m_moves[best].score) {
+            best = i;
+        }
+    }
+    std::swap(m_moves[best], m_moves[m_current]);
+    return m_moves[m_current++].move;
+}
+
+bool MovePicker::IsSpecial(PackedMove move) const
+{
+    return move == m_ttMove || move == m_killers[0] || move == m_killers[1];
+}
+
+PackedMove MovePicker::NextMove()
+{
+    switch (m_stage) {
+    case Stage::TT_MOVE:
+        m_stage = Stage::INIT_CAPTURES;
+        return m_ttMove;
+
+    case Stage::INIT_CAPTURES:
+        m_moves.Clear();
+        m_pos.GenerateMoves(m_moves, GenType::CAPTURES);
+        ScoreCaptures();
+        m_current = 0;
+        m_stage = Stage::CAPTURES;
+        // Fall through
+
+    case Stage::CAPTURES:
+        while (m_current < m_moves.Size()) {
+            PackedMove move = PickBest();
+            if (move == m_ttMove) {
+                continue;
+            }
+            // Losing captures are tried after the quiets
+            if (m_pos.See(move) < 0) {
+                m_badCaptures.Add(move);
+                continue;
+            }
+            return move;
+        }
+        m_stage = Stage::KILLER_1;
+        // Fall through
+
+    case Stage::KILLER_1:
+        m_stage = Stage::KILLER_2;
+        if (!m_killers[0].IsNull() && m_killers[0] != m_ttMove &&
+            m_killers[0].IsQuiet() && m_pos.IsPseudoLegal(m_killers[0])) {
+            return m_killers[0];
+        }
+        // Fall through
+
+    case Stage::KILLER_2:
+        m_stage = Stage::INIT_QUIETS;
+        if (!m_killers[1].IsNull() && m_killers[1] != m_ttMove &&
+            m_killers[1] != m_killers[0] &&
+            m_killers[1].IsQuiet() && m_pos.IsPseudoLegal(m_killers[1])) {
+            return m_killers[1];
+        }
+        // Fall through
+
+    case Stage::INIT_QUIETS:
+        m_moves.Clear();
+        m_pos.GenerateMoves(m_moves, GenType::QUIETS);
+        ScoreQuiets();
+        m_current = 0;
+        m_stage = Stage::QUIETS;
+        // Fall through
+
+    case Stage::QUIETS:
+        while (m_current < m_moves.Size()) {
+            PackedMove move = m_moves[m_current++].move;
+            if (!IsSpecial(move)) {
+                return move;
+            }
+        }
+        m_stage = Stage::BAD_CAPTURES;
+        // Fall through
+
+    case Stage::BAD_CAPTURES:
+        if (m_badCurrent < m_badCaptures.Size()) {
+            return m_badCaptures[m_badCurrent++].move;
+        }
+        m_stage = Stage::END;
+        return NULL_PACKED_MOVE;
+
+    case Stage::QS_TT_MOVE:
+        m_stage = Stage::QS_INIT_CAPTURES;
+        return m_ttMove;
+
+    case Stage::QS_INIT_CAPTURES:
+        m_moves.Clear();
+        m_pos.GenerateMoves(m_moves, GenType::CAPTURES);
+        ScoreCaptures();
+        m_current = 0;
+        m_stage = Stage::QS_CAPTURES;
+        // Fall through
+
+    case Stage::QS_CAPTURES:
+        while (m_current < m_moves.Size()) {
+            PackedMove move = PickBest();
+            if (move != m_ttMove) {
+                return move;
+            }
+        }
+        m_stage = Stage::END;
+        return NULL_PACKED_MOVE;
+
+    case Stage::END:
+    default:
+        return NULL_PACKED_MOVE;
+    }
+}
+
+} // namespace Shohih
@@ -0,0 +1,434 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   NNUE evaluation Implementation
+ **************************************************/
+
+#include <fstream>
+#include <algorithm>
+#include <type_traits>
+#include "nnue.h"
+
+// SIMD kernels are compiled per function with target
+// attributes, so the binary runs on any x86-64 CPU
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define NNUE_X86_SIMD 1
+    #include <immintrin.h>
+    #define TARGET_AVX2 __attribute__((target("avx2")))
+    #define TARGET_SSE41 __attribute__((target("sse4.1")))
+#else
+    #define NNUE_X86_SIMD 0
+#endif
+
+namespace Shohih {
+namespace Nnue {
+
+Network g_network{};
+bool g_enabled{ false };
+
+namespace {
+
+constexpr uint32_t FILE_MAGIC{ 0x4E4E4853 };    // "SHNN"
+constexpr uint32_t FILE_VERSION{ 1 };
+
+//--------------------------------------------------
+// Kernel table
+//  - addRow/subRow: acc[L1_SIZE] +-= row
+//  - clip: clamp acc[L1_SIZE] to [0, ACTIVATION_MAX]
+//  - dot: sum(in[i] * w[i]), n multiple of 32
+//--------------------------------------------------
+struct Kernels {
+    void (*addRow)(int16_t *acc, const int16_t *row);
+    void (*subRow)(int16_t *acc, const int16_t *row);
+    void (*clip)(const int16_t *acc, uint8_t *out);
+    int32_t (*dot)(const uint8_t *in, const int8_t *weights, size_t n);
+};
+
+void AddRowScalar(int16_t *acc, const int16_t *row)
+{
+    for (size_t i{ 0 }; i < L1_SIZE; i++) {
+        acc[i] = static_cast<int16_t>(acc[i] + row[i]);
+    }
+}
+
+void SubRowScalar(int16_t *acc, const int16_t *row)
+{
+    for (size_t i{ 0 }; i < L1_SIZE; i++) {
+        acc[i] = static_cast<int16_t>(acc[i] - row[i]);
+    }
+}
+
+void ClipScalar(const int16_t *acc, uint8_t *out)
+{
+    for (size_t i{ 0 }; i < L1_SIZE; i++) {
+        out[i] = static_cast<uint8_t>(std::min<int>(std::max<int>(acc[i], 0), ACTIVATION_MAX));
+    }
+}
+
+int32_t DotScalar(const uint8_t *in, const int8_t *weights, size_t n)
+{
+    int32_t sum{ 0 };
+    for (size_t i{ 0 }; i < n; i++) {
+        sum += in[i] * weights[i];
+    }
+    return sum;
+}
+
+#if NNUE_X86_SIMD
+//--------------------------------------------------
+// AVX2: 16 x int16 / 32 x uint8 per register.
+// maddubs cannot saturate: |127 * -128 * 2| < 32767.
+//--------------------------------------------------
+TARGET_AVX2 void AddRowAvx2(int16_t *acc, const int16_t *row)
+{
+    for (size_t i{ 0 }; i < L1_SIZE; i += 16) {
+        __m256i *dst = reinterpret_cast<__m256i *>(acc + i);
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + i));
+        _mm256_storeu_si256(dst, _mm256_add_epi16(_mm256_loadu_si256(dst), w));
+    }
+}
+
+TARGET_AVX2 void SubRowAvx2(int16_t *acc, const int16_t *row)
+{
+    for (size_t i{ 0 }; i < L1_SIZE; i += 16) {
+        __m256i *dst = reinterpret_cast<__m256i *>(acc + i);
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + i));
+        _mm256_storeu_si256(dst, _mm256_sub_epi16(_mm256_loadu_si256(dst), w));
+    }
+}
+
+TARGET_AVX2 void ClipAvx2(const int16_t *acc, uint8_t *out)
+{
+    const __m256i max = _mm256_set1_epi8(ACTIVATION_MAX);
+    for (size_t i{ 0 }; i < L1_SIZE; i += 32) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc + i + 16));
+        // packus works per 128-bit lane: restore the element order
+        __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_min_epu8(packed, max));
+    }
+}
+
+TARGET_AVX2 int32_t DotAvx2(const uint8_t *in, const int8_t *weights, size_t n)
+{
+    const __m256i ones = _mm256_set1_epi16(1);
+    __m256i sum = _mm256_setzero_si256();
+    for (size_t i{ 0 }; i < n; i += 32) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(weights + i));
+        __m256i products = _mm256_madd_epi16(_mm256_maddubs_epi16(x, w), ones);
+        sum = _mm256_add_epi32(sum, products);
+    }
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4E));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xB1));
+    return _mm_cvtsi128_si32(s);
+}
+
+//--------------------------------------------------
+// SSE4.1: 8 x int16 / 16 x uint8 per register
+//--------------------------------------------------
+TARGET_SSE41 void AddRowSse41(int16_t *acc, const int16_t *row)
+{
+    for (size_t i{ 0 }; i < L1_SIZE; i += 8) {
+        __m128i *dst = reinterpret_cast<__m128i *>(acc + i);
+        __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i));
+        _mm_storeu_si128(dst, _mm_add_epi16(_mm_loadu_si128(dst), w));
+    }
+}
+
+TARGET_SSE41 void SubRowSse41(int16_t *acc, const int16_t *row)
+{
+    for (size_t i{ 0 }; i < L1_SIZE; i += 8) {
+        __m128i *dst = reinterpret_cast<__m128i *>(acc + i);
+        __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + i));
+        _mm_storeu_si128(dst, _mm_sub_epi16(_mm_loadu_si128(dst), w));
+    }
+}
+
+TARGET_SSE41 void ClipSse41(const int16_t *acc, uint8_t *out)
+{
+    const __m128i max = _mm_set1_epi8(ACTIVATION_MAX);
+    for (size_t i{ 0 }; i < L1_SIZE; i += 16) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(acc + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(acc + i + 8));
+        __m128i packed = _mm_packus_epi16(a, b);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_min_epu8(packed, max));
+    }
+}
+
+TARGET_SSE41 int32_t DotSse41(const uint8_t *in, const int8_t *weights, size_t n)
+{
+    const __m128i ones = _mm_set1_epi16(1);
+    __m128i sum = _mm_setzero_si128();
+    for (size_t i{ 0 }; i < n; i += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+        __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i *>(weights + i));
+        sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_maddubs_epi16(x, w), ones));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4E));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xB1));
+    return _mm_cvtsi128_si32(sum);
+}
+#endif // NNUE_X86_SIMD
+
+Kernels MakeKernels(SimdLevel level)
+{
+#if NNUE_X86_SIMD
+    switch (level) {
+    case SimdLevel::AVX2:
+        return Kernels{ AddRowAvx2, SubRowAvx2, ClipAvx2, DotAvx2 };
+    case SimdLevel::SSE41:
+        return Kernels{ AddRowSse41, SubRowSse41, ClipSse41, DotSse41 };
+    default:
+        break;
+    }
+#else
+    (void)level;
+#endif
+    return Kernels{ AddRowScalar, SubRowScalar, ClipScalar, DotScalar };
+}
+
+SimdLevel DetectSimdLevel()
+{
+#if NNUE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return SimdLevel::SSE41;
+    }
+#endif
+    return SimdLevel::SCALAR;
+}
+
+const SimdLevel g_supportedLevel{ DetectSimdLevel() };
+SimdLevel g_level{ g_supportedLevel };
+Kernels g_kernels{ MakeKernels(g_supportedLevel) };
+
+inline uint8_t ClippedRelu(int32_t sum)
+{
+    return static_cast<uint8_t>(sum <= 0 ? 0 : std::min(sum >> WEIGHT_SHIFT, ACTIVATION_MAX));
+}
+
+template <typename T>
+bool ReadValues(std::ifstream &file, std::vector<T> &values, size_t count)
+{
+    values.resize(count);
+    file.read(reinterpret_cast<char *>(values.data()),
+              static_cast<std::streamsize>(count * sizeof(T)));
+    return static_cast<bool>(file);
+}
+
+template <typename T>
+void WriteValues(std::ofstream &file, const std::vector<T> &values)
+{
+    file.write(reinterpret_cast<const char *>(values.data()),
+               static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+} // namespace
+
+SimdLevel GetSupportedSimdLevel() { return g_supportedLevel; }
+SimdLevel GetSimdLevel() { return g_level; }
+
+void SetSimdLevel(SimdLevel level)
+{
+    g_level = std::min(level, g_supportedLevel);
+    g_kernels = MakeKernels(g_level);
+}
+
+const char *SimdLevelName(SimdLevel level)
+{
+    switch (level) {
+    case SimdLevel::AVX2:
+        return "avx2";
+    case SimdLevel::SSE41:
+        return "sse4.1";
+    default:
+        return "scalar";
+    }
+}
+
+/**************************************************
+ * @details
+ *      Read into a temporary network so a bad file
+ *      leaves the current weights untouched.
+ *      - @return FILE_OPEN_ERROR / INVALID_FILE_FORMAT
+ **************************************************/
+ErrorCode Network::Load(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (UNLIKELY(!file)) {
+        ERROR_LOG("Cannot open NNUE file: " << path);
+        return FILE_OPEN_ERROR;
+    }
+    std::vector<uint32_t> header;
+    const std::vector<uint32_t> expected{ FILE_MAGIC, FILE_VERSION,
+        NUM_FEATURES, L1_SIZE, L2_SIZE, L3_SIZE };
+    if (UNLIKELY(!ReadValues(file, header, expected.size()) || header != expected)) {
+        ERROR_LOG("Invalid NNUE header or architecture: " << path);
+        return INVALID_FILE_FORMAT;
+    }
+
+    Network net;
+    std::vector<int32_t> outBias;
+    bool ok = ReadValues(file, net.m_ftWeights, NUM_FEATURES * L1_SIZE) &&
+        ReadValues(file, net.m_ftBiases, L1_SIZE) &&
+        ReadValues(file, net.m_l1Weights, L2_SIZE * 2 * L1_SIZE) &&
+        ReadValues(file, net.m_l1Biases, L2_SIZE) &&
+        ReadValues(file, net.m_l2Weights, L3_SIZE * L2_SIZE) &&
+        ReadValues(file, net.m_l2Biases, L3_SIZE) &&
+        ReadValues(file, net.m_outWeights, L3_SIZE) &&
+        ReadValues(file, outBias, 1);
+    if (UNLIKELY(!ok || file.peek() != std::ifstream::traits_type::eof())) {
+        ERROR_LOG("Truncated or oversized NNUE file: " << path);
+        return INVALID_FILE_FORMAT;
+    }
+    net.m_outBias = outBias.front();
+    net.m_loaded = true;
+    *this = std::move(net);
+    return SUCCESS;
+}
+
+ErrorCode Network::Save(const std::string &path) const
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (UNLIKELY(!file)) {
+        ERROR_LOG("Cannot create NNUE file: " << path);
+        return FILE_OPEN_ERROR;
+    }
+    WriteValues(file, std::vector<uint32_t>{ FILE_MAGIC, FILE_VERSION,
+        NUM_FEATURES, L1_SIZE, L2_SIZE, L3_SIZE });
+    WriteValues(file, m_ftWeights);
+    WriteValues(file, m_ftBiases);
+    WriteValues(file, m_l1Weights);
+    WriteValues(file, m_l1Biases);
+    WriteValues(file, m_l2Weights);
+    WriteValues(file, m_l2Biases);
+    WriteValues(file, m_outWeights);
+    WriteValues(file, std::vector<int32_t>{ m_outBias });
+    return file ? SUCCESS : FILE_OPEN_ERROR;
+}
+
+/**************************************************
+ * @details
+ *      Weights are small enough that accumulators
+ *      cannot overflow int16 (32 pieces * 16).
+ **************************************************/
+void Network::Randomize(uint64_t seed)
+{
+    uint64_t state = seed | 1;
+    auto next = [&state](int range) {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return static_cast<int>((state * 0x2545F4914F6CDD1DULL) >> 33) % (2 * range + 1) - range;
+    };
+    auto fill = [&next](auto &values, size_t count, int range) {
+        values.resize(count);
+        for (auto &value : values) {
+            value = static_cast<typename std::decay<decltype(value)>::type>(next(range));
+        }
+    };
+    fill(m_ftWeights, NUM_FEATURES * L1_SIZE, 16);
+    fill(m_ftBiases, L1_SIZE, 32);
+    fill(m_l1Weights, L2_SIZE * 2 * L1_SIZE, 32);
+    fill(m_l1Biases, L2_SIZE, 1024);
+    fill(m_l2Weights, L3_SIZE * L2_SIZE, 64);
+    fill(m_l2Biases, L3_SIZE, 1024);
+    fill(m_outWeights, L3_SIZE, 127);
+    m_outBias = 0;
+    m_loaded = true;
+}
+
+/**************************************************
+ * @details
+ *      Own pieces come first; black's view mirrors
+ *      the board vertically so both perspectives
+ *      share the weights.
+ **************************************************/
+size_t Network::FeatureIndex(PieceColor perspective, uint8_t pieceCode, SquareId sq)
+{
+    const uint8_t color = pieceCode / NUM_PIECE_TYPES, type = pieceCode % NUM_PIECE_TYPES;
+    const size_t relative = (color == static_cast<uint8_t>(perspective)) ? 0 : 1;
+    const SquareId square = (perspective == PieceColor::WHITE) ? sq : static_cast<SquareId>(sq ^ 56);
+    return (relative * NUM_PIECE_TYPES + type) * 64 + square;
+}
+
+void Network::ResetAccumulator(Accumulator &acc) const
+{
+    for (auto &values : acc.values) {
+        std::copy(m_ftBiases.begin(), m_ftBiases.end(), values.begin());
+    }
+}
+
+void Network::AddFeature(Accumulator &acc, uint8_t pieceCode, SquareId sq) const
+{
+    for (uint8_t p{ 0 }; p < NUM_PIECE_COLORS; p++) {
+        g_kernels.addRow(acc.values[p].data(),
+            FeatureWeights(FeatureIndex(static_cast<PieceColor>(p), pieceCode, sq)));
+    }
+}
+
+void Network::RemoveFeature(Accumulator &acc, uint8_t pieceCode, SquareId sq) const
+{
+    for (uint8_t p{ 0 }; p < NUM_PIECE_COLORS; p++) {
+        g_kernels.subRow(acc.values[p].data(),
+            FeatureWeights(FeatureIndex(static_cast<PieceColor>(p), pieceCode, sq)));
+    }
+}
+
+void Network::MoveFeature(Accumulator &acc, uint8_t pieceCode, SquareId from, SquareId to) const
+{
+    for (uint8_t p{ 0 }; p < NUM_PIECE_COLORS; p++) {
+        const PieceColor perspective = static_cast<PieceColor>(p);
+        g_kernels.subRow(acc.values[p].data(),
+            FeatureWeights(FeatureIndex(perspective, pieceCode, from)));
+        g_kernels.addRow(acc.values[p].data(),
+            FeatureWeights(FeatureIndex(perspective, pieceCode, to)));
+    }
+}
+
+/**************************************************
+ * @details
+ *      Side to move's half of the accumulator comes
+ *      first so the network sees "us" and "them".
+ **************************************************/
+int Network::Evaluate(const Accumulator &acc, PieceColor sideToMove) const
+{
+    const uint8_t us = static_cast<uint8_t>(sideToMove), them = us ^ 1;
+    uint8_t input[2 * L1_SIZE];
+    g_kernels.clip(acc.values[us].data(), input);
+    g_kernels.clip(acc.values[them].data(), input + L1_SIZE);
+
+    uint8_t hidden1[L2_SIZE];
+    for (size_t o{ 0 }; o < L2_SIZE; o++) {
+        hidden1[o] = ClippedRelu(m_l1Biases[o] +
+            g_kernels.dot(input, &m_l1Weights[o * 2 * L1_SIZE], 2 * L1_SIZE));
+    }
+    uint8_t hidden2[L3_SIZE];
+    for (size_t o{ 0 }; o < L3_SIZE; o++) {
+        hidden2[o] = ClippedRelu(m_l2Biases[o] +
+            g_kernels.dot(hidden1, &m_l2Weights[o * L2_SIZE], L2_SIZE));
+    }
+    const int32_t output = m_outBias + g_kernels.dot(hidden2, m_outWeights.data(), L3_SIZE);
+    return output / OUTPUT_SCALE;
+}
+
+ErrorCode LoadNetwork(const std::string &path)
+{
+    ErrorCode err = g_network.Load(path);
+    if (err == SUCCESS) {
+        g_enabled = true;
+    }
+    return err;
+}
+
+void SetEnabled(bool enabled)
+{
+    g_enabled = enabled && g_network.IsLoaded();
+}
+
+} // namespace Nnue
+} // namespace Shohih
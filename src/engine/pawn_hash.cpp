@@ -0,0 +1,199 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Pawn structure evaluation Implementation
+ **************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include "pawn_hash.h"
+
+namespace Shohih {
+
+namespace {
+
+constexpr EvalScore DOUBLED_PENALTY{ 10, 25 };
+constexpr EvalScore ISOLATED_PENALTY{ 5, 15 };
+constexpr EvalScore BACKWARD_PENALTY{ 9, 22 };
+
+// Passed pawn bonus by relative rank
+constexpr std::array<EvalScore, BOARD_SIZE> PASSED_BONUS{ {
+    { 0, 0 }, { 0, 10 }, { 5, 15 }, { 10, 25 }, { 20, 45 }, { 35, 75 }, { 60, 120 }, { 0, 0 }
+} };
+
+// Shield pawn on the king's or an adjacent file, one or two
+// ranks ahead of the king; files without one are penalised
+constexpr int SHIELD_NEAR{ 15 };
+constexpr int SHIELD_FAR{ 8 };
+constexpr int SHIELD_MISSING{ -12 };
+
+//--------------------------------------------------
+// Masks per [color][square], "ahead" from the
+// color's point of view
+//--------------------------------------------------
+struct PawnMasks {
+    PawnMasks()
+    {
+        for (uint8_t file{ 0 }; file < BOARD_SIZE; file++) {
+            adjacentFiles[file] = (file > 0 ? FILE_A_BB << (file - 1) : 0) |
+                                  (file < BOARD_SIZE - 1 ? FILE_A_BB << (file + 1) : 0);
+        }
+        for (uint8_t rank{ 0 }; rank < BOARD_SIZE; rank++) {
+            const Bitboard above = (rank < BOARD_SIZE - 1) ? ~0ULL << (8 * (rank + 1)) : 0;
+            const Bitboard below = (rank > 0) ? ~0ULL >> (8 * (BOARD_SIZE - rank)) : 0;
+            ranksAhead[0][rank] = above;
+            ranksAhead[1][rank] = below;
+        }
+        for (SquareId sq{ 0 }; sq < NUM_SQUARES; sq++) {
+            for (int color{ 0 }; color < NUM_PIECE_COLORS; color++) {
+                const Bitboard ahead = ranksAhead[color][RankOf(sq)];
+                fileAhead[color][sq] = ahead & (FILE_A_BB << FileOf(sq));
+                passedSpan[color][sq] = ahead & ((FILE_A_BB << FileOf(sq)) | adjacentFiles[FileOf(sq)]);
+            }
+        }
+    }
+    std::array<Bitboard, BOARD_SIZE> adjacentFiles{};
+    std::array<std::array<Bitboard, BOARD_SIZE>, NUM_PIECE_COLORS> ranksAhead{};
+    std::array<std::array<Bitboard, NUM_SQUARES>, NUM_PIECE_COLORS> fileAhead{};
+    std::array<std::array<Bitboard, NUM_SQUARES>, NUM_PIECE_COLORS> passedSpan{};
+};
+const PawnMasks g_masks{};
+
+//--------------------------------------------------
+// Structure terms of @param us (positive = good)
+//--------------------------------------------------
+EvalScore EvaluateStructure(const Position &pos, PieceColor us)
+{
+    const int c = static_cast<int>(us);
+    const Bitboard ours = pos.GetPieces(us, PieceType::PAWN);
+    const Bitboard theirs = pos.GetPieces(Opposite(us), PieceType::PAWN);
+
+    EvalScore score{};
+    Bitboard pawns = ours;
+    while (pawns) {
+        const SquareId sq = PopLsb(pawns);
+        const uint8_t file = FileOf(sq);
+        const bool doubled = (g_masks.fileAhead[c][sq] & ours) != 0;
+        const bool isolated = (g_masks.adjacentFiles[file] & ours) == 0;
+
+        if (doubled) {
+            score -= DOUBLED_PENALTY;
+        }
+        if (isolated) {
+            score -= ISOLATED_PENALTY;
+        } else {
+            // No neighbour can come level and the stop square is
+            // guarded by an enemy pawn
+            const Bitboard supporters = g_masks.adjacentFiles[file] & ours &
+                ~g_masks.ranksAhead[c][RankOf(sq)];
+            const SquareId stop = (us == PieceColor::WHITE) ? sq + 8 : sq - 8;
+            if (!supporters && (PawnAttacks(us, stop) & theirs)) {
+                score -= BACKWARD_PENALTY;
+            }
+        }
+        if (!doubled && !(g_masks.passedSpan[c][sq] & theirs)) {
+            score += PASSED_BONUS[us == PieceColor::WHITE ? RankOf(sq) : 7 - RankOf(sq)];
+        }
+    }
+    return score;
+}
+
+//--------------------------------------------------
+// Pawn shield of the king of @param us on @param ksq
+// (the king's file and its neighbours, kept on the
+// board at the edges)
+//--------------------------------------------------
+int EvaluateShield(const Position &pos, PieceColor us, SquareId ksq)
+{
+    const int c = static_cast<int>(us);
+    const Bitboard ours = pos.GetPieces(us, PieceType::PAWN) & g_masks.ranksAhead[c][RankOf(ksq)];
+    const int center = std::min(std::max<int>(FileOf(ksq), 1), BOARD_SIZE - 2);
+
+    int shield{ 0 };
+    for (int file{ center - 1 }; file <= center + 1; file++) {
+        const Bitboard onFile = ours & (FILE_A_BB << file);
+        if (!onFile) {
+            shield += SHIELD_MISSING;
+            continue;
+        }
+        const SquareId nearest = (us == PieceColor::WHITE) ? Lsb(onFile) : Msb(onFile);
+        const int distance = std::abs(RankOf(nearest) - RankOf(ksq));
+        shield += (distance == 1) ? SHIELD_NEAR : (distance == 2) ? SHIELD_FAR : SHIELD_MISSING;
+    }
+    return shield;
+}
+
+EvalScore Combine(const EvalScore &structure, int whiteShield, int blackShield)
+{
+    EvalScore score{ structure };
+    score.mg += whiteShield - blackShield;
+    return score;
+}
+
+} // namespace
+
+EvalScore EvaluatePawns(const Position &pos)
+{
+    EvalScore structure = EvaluateStructure(pos, PieceColor::WHITE);
+    structure -= EvaluateStructure(pos, PieceColor::BLACK);
+    return Combine(structure,
+        EvaluateShield(pos, PieceColor::WHITE, pos.GetKingSquare(PieceColor::WHITE)),
+        EvaluateShield(pos, PieceColor::BLACK, pos.GetKingSquare(PieceColor::BLACK)));
+}
+
+void PawnHashTable::Resize(size_t entries)
+{
+    size_t size{ 1 };
+    while (size * 2 <= std::max<size_t>(entries, 1)) {
+        size *= 2;
+    }
+    m_entries.reset(new Entry[size]);
+    m_mask = size - 1;
+    Clear();
+}
+
+void PawnHashTable::Clear()
+{
+    for (size_t i{ 0 }; i <= m_mask; i++) {
+        // Never matches a key, also not the pawnless key 0
+        m_entries[i].key = ~0ULL;
+        m_entries[i].structure = EvalScore{};
+        m_entries[i].kingSquares.fill(NO_SQUARE);
+        m_entries[i].shields.fill(0);
+    }
+    m_probes = 0;
+    m_hits = 0;
+}
+
+/**************************************************
+ * @details
+ *      The structure only depends on the pawns and
+ *      is recomputed on a key miss (always replace).
+ *      A shield is recomputed when its king has left
+ *      the square it was computed for.
+ **************************************************/
+EvalScore PawnHashTable::Evaluate(const Position &pos)
+{
+    const uint64_t key = pos.GetPawnKey();
+    Entry &entry = m_entries[key & m_mask];
+    m_probes++;
+    if (LIKELY(entry.key == key)) {
+        m_hits++;
+    } else {
+        entry.key = key;
+        entry.structure = EvaluateStructure(pos, PieceColor::WHITE);
+        entry.structure -= EvaluateStructure(pos, PieceColor::BLACK);
+        entry.kingSquares.fill(NO_SQUARE);
+    }
+
+    for (PieceColor color : { PieceColor::WHITE, PieceColor::BLACK }) {
+        const int c = static_cast<int>(color);
+        const SquareId ksq = pos.GetKingSquare(color);
+        if (entry.kingSquares[c] != ksq) {
+            entry.kingSquares[c] = ksq;
+            entry.shields[c] = EvaluateShield(pos, color, ksq);
+        }
+    }
+    return Combine(entry.structure, entry.shields[0], entry.shields[1]);
+}
+
+} // namespace Shohih
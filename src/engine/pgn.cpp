@@ -0,0 +1,150 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Streaming PGN reader Implementation
+ **************************************************/
+
+#include <cctype>
+#include <algorithm>
+#include "pgn.h"
+
+namespace Shohih {
+
+std::string PgnGame::GetTag(const std::string &name) const
+{
+    auto it = tags.find(name);
+    return it == tags.end() ? std::string{} : it->second;
+}
+
+GameResult PgnGame::GetResult() const
+{
+    const std::string result = GetTag("Result");
+    if (result == "1-0") {
+        return GameResult::WHITE_WIN;
+    }
+    if (result == "0-1") {
+        return GameResult::BLACK_WIN;
+    }
+    if (result == "1/2-1/2") {
+        return GameResult::DRAW;
+    }
+    return GameResult::UNKNOWN;
+}
+
+ErrorCode PgnGame::ParseMoves(Position &pos, std::vector<PackedMove> &moves) const
+{
+    const std::string fen = GetTag("FEN");
+    if (pos.SetFEN(fen.empty() ? STANDARD_POSITION_FEN : fen) != SUCCESS) {
+        return INVALID_FEN;
+    }
+    moves.clear();
+    for (const auto &san : PgnReader::Tokenize(moveText)) {
+        PackedMove move = pos.ParseSanMove(san);
+        if (move.IsNull()) {
+            return INVALID_MOVE;
+        }
+        pos.MakeMove(move);
+        moves.push_back(move);
+    }
+    return SUCCESS;
+}
+
+/**************************************************
+ * @details
+ *      A game is its tag section followed by move
+ *      text; the next tag line after move text starts
+ *      a new game. Games without tags are accepted.
+ **************************************************/
+bool PgnReader::NextGame(PgnGame &game)
+{
+    game.tags.clear();
+    game.moveText.clear();
+    bool inMoveText{ false };
+    std::string line;
+    while (true) {
+        if (m_hasPendingLine) {
+            line = m_pendingLine;
+            m_hasPendingLine = false;
+        } else if (!std::getline(m_in, line)) {
+            break;
+        }
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        const size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos || line[start] == '%') {
+            continue;   // blank line or escape
+        }
+        if (line[start] == '[') {
+            if (inMoveText) {
+                m_pendingLine = line;
+                m_hasPendingLine = true;
+                return true;
+            }
+            // [Name "Value"]
+            size_t nameEnd = line.find_first_of(" \t", start);
+            size_t open = line.find('"', start), close = line.rfind('"');
+            if (nameEnd != std::string::npos && open != std::string::npos && close > open) {
+                game.tags[line.substr(start + 1, nameEnd - start - 1)] =
+                    line.substr(open + 1, close - open - 1);
+            }
+            continue;
+        }
+        inMoveText = true;
+        game.moveText += line;
+        game.moveText += '\n';
+    }
+    return inMoveText || !game.tags.empty();
+}
+
+std::vector<std::string> PgnReader::Tokenize(const std::string &moveText)
+{
+    std::vector<std::string> tokens;
+    int variationDepth{ 0 };
+    std::string token;
+    auto flush = [&tokens, &token]() {
+        // Strip move numbers ("12." / "12..." also glued to the move)
+        size_t i{ 0 };
+        while (i < token.size() && isdigit(token[i])) { i++; }
+        if (i < token.size() && token[i] == '.') {
+            while (i < token.size() && token[i] == '.') { i++; }
+            token.erase(0, i);
+        }
+        if (!token.empty() && token != "1-0" && token != "0-1" &&
+            token != "1/2-1/2" && token != "*") {
+            tokens.push_back(token);
+        }
+        token.clear();
+    };
+
+    for (size_t i{ 0 }; i < moveText.size(); i++) {
+        const char c = moveText[i];
+        if (c == '{') {
+            flush();
+            size_t end = moveText.find('}', i);
+            i = (end == std::string::npos) ? moveText.size() : end;
+        } else if (c == ';') {
+            flush();
+            size_t end = moveText.find('\n', i);
+            i = (end == std::string::npos) ? moveText.size() : end;
+        } else if (c == '(') {
+            flush();
+            variationDepth++;
+        } else if (c == ')') {
+            token.clear();
+            variationDepth = std::max(variationDepth - 1, 0);
+        } else if (variationDepth > 0) {
+            continue;
+        } else if (c == '$') {
+            flush();
+            while (i + 1 < moveText.size() && isdigit(moveText[i + 1])) { i++; }
+        } else if (isspace(static_cast<unsigned char>(c))) {
+            flush();
+        } else {
+            token += c;
+        }
+    }
+    flush();
+    return tokens;
+}
+
+} // namespace Shohih
@@ -0,0 +1,1074 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Engine position Implementation
+ **************************************************/
+
+#include <cctype>
+#include <cstring>
+#include <sstream>
+#include "position.h"
+
+namespace Shohih {
+
+namespace {
+
+//--------------------------------------------------
+// Zobrist hashing keys (fixed seed => reproducible keys)
+//--------------------------------------------------
+struct ZobristKeys {
+    ZobristKeys()
+    {
+        uint64_t seed{ 0x5348484948ULL };  // "SHOHI"
+        auto next = [&seed]() {
+            // xorshift64*
+            seed ^= seed >> 12;
+            seed ^= seed << 25;
+            seed ^= seed >> 27;
+            return seed * 2685821657736338717ULL;
+        };
+        for (auto &pieceKeys : pieces) {
+            for (auto &key : pieceKeys) { key = next(); }
+        }
+        for (auto &key : castling) { key = next(); }
+        for (auto &key : enPassant) { key = next(); }
+        side = next();
+    }
+    std::array<std::array<uint64_t, NUM_SQUARES>, NO_PIECE> pieces{};
+    std::array<uint64_t, ALL_CASTLING + 1> castling{};
+    std::array<uint64_t, BOARD_SIZE> enPassant{};
+    uint64_t side{ 0 };
+};
+const ZobristKeys g_zobrist{};
+
+//--------------------------------------------------
+// Castling rights kept after a move touches a square
+//--------------------------------------------------
+struct CastlingMasks {
+    CastlingMasks()
+    {
+        masks.fill(ALL_CASTLING);
+        masks[0]  = static_cast<uint8_t>(ALL_CASTLING & ~WHITE_OOO);            // a1
+        masks[4]  = static_cast<uint8_t>(ALL_CASTLING & ~(WHITE_OO | WHITE_OOO)); // e1
+        masks[7]  = static_cast<uint8_t>(ALL_CASTLING & ~WHITE_OO);             // h1
+        masks[56] = static_cast<uint8_t>(ALL_CASTLING & ~BLACK_OOO);            // a8
+        masks[60] = static_cast<uint8_t>(ALL_CASTLING & ~(BLACK_OO | BLACK_OOO)); // e8
+        masks[63] = static_cast<uint8_t>(ALL_CASTLING & ~BLACK_OO);             // h8
+    }
+    std::array<uint8_t, NUM_SQUARES> masks{};
+};
+const CastlingMasks g_castlingMasks{};
+
+constexpr char PIECE_CHARS[]{ "PNBRQKpnbrqk" };
+
+inline Bitboard ShiftForward(Bitboard b, PieceColor color)
+{
+    return (color == PieceColor::WHITE) ? (b << 8) : (b >> 8);
+}
+
+inline int ForwardStep(PieceColor color)
+{
+    return (color == PieceColor::WHITE) ? 8 : -8;
+}
+
+} // namespace
+
+//--------------------------------------------------
+// PackedMove & MoveList
+//--------------------------------------------------
+constexpr uint8_t PackedMove::QUIET;
+constexpr uint8_t PackedMove::DOUBLE_PUSH;
+constexpr uint8_t PackedMove::KING_CASTLE;
+constexpr uint8_t PackedMove::QUEEN_CASTLE;
+constexpr uint8_t PackedMove::CAPTURE;
+constexpr uint8_t PackedMove::EN_PASSANT;
+constexpr uint8_t PackedMove::PROMOTION;
+
+std::string PackedMove::ToUci() const
+{
+    if (IsNull()) {
+        return "0000";
+    }
+    std::string uci = ToSquare(From()).GetSquareName() + ToSquare(To()).GetSquareName();
+    if (IsPromotion()) {
+        uci += "nbrq"[static_cast<uint8_t>(PromotionType()) - 1];
+    }
+    return uci;
+}
+
+bool MoveList::Contains(PackedMove move) const
+{
+    for (const auto &item : *this) {
+        if (item.move == move) { return true; }
+    }
+    return false;
+}
+
+/**************************************************
+ * @details
+ *      Position constructor. Sets up the standard
+ *      starting position.
+ **************************************************/
+Position::Position(size_t historyPlies)
+{
+    m_history.reserve(historyPlies);
+    SetFEN(STANDARD_POSITION_FEN);
+}
+
+void Position::Clear()
+{
+    m_mailbox.fill(NO_PIECE);
+    m_pieceBB.fill(0);
+    m_colorBB.fill(0);
+    m_psq = EvalScore{};
+    m_phase = 0;
+    if (Nnue::IsEnabled()) {
+        Nnue::g_network.ResetAccumulator(m_acc);
+    }
+    m_sideToMove = PieceColor::WHITE;
+    m_fullmoveNumber = 1;
+    m_st = StateInfo{};
+    m_history.clear();
+}
+
+/**************************************************
+ * @details
+ *      Parse all six FEN fields. Halfmove clock and
+ *      fullmove number are optional.
+ *      - @return INVALID_FEN on malformed input
+ *          (the position is left cleared)
+ **************************************************/
+ErrorCode Position::SetFEN(const std::string &fen)
+{
+    Clear();
+    std::istringstream ss(fen);
+    std::string placement, side, castling, enPassant;
+    ss >> placement >> side >> castling >> enPassant;
+    if (UNLIKELY(placement.empty() || side.empty())) {
+        ERROR_LOG("Invalid FEN: " << fen);
+        return INVALID_FEN;
+    }
+
+    // Piece placement starts from a8
+    int x{ 0 }, y{ BOARD_SIZE - 1 };
+    for (const char c : placement) {
+        if (c == '/') {
+            if (UNLIKELY(x != BOARD_SIZE || y == 0)) {
+                ERROR_LOG("Invalid FEN rank: " << fen);
+                Clear();
+                return INVALID_FEN;
+            }
+            x = 0;
+            y--;
+        } else if (c >= '1' && c <= '8') {
+            x += c - '0';
+        } else {
+            const char *pieceChar = std::strchr(PIECE_CHARS, c);
+            if (UNLIKELY(pieceChar == nullptr || x >= BOARD_SIZE)) {
+                ERROR_LOG("Invalid FEN piece: " << fen);
+                Clear();
+                return INVALID_FEN;
+            }
+            PutPiece(static_cast<PieceCode>(pieceChar - PIECE_CHARS),
+                static_cast<SquareId>(y * BOARD_SIZE + x));
+            x++;
+        }
+    }
+    if (UNLIKELY(x != BOARD_SIZE || y != 0 ||
+        PopCount(GetPieces(PieceColor::WHITE, PieceType::KING)) != 1 ||
+        PopCount(GetPieces(PieceColor::BLACK, PieceType::KING)) != 1)) {
+        ERROR_LOG("Invalid FEN placement: " << fen);
+        Clear();
+        return INVALID_FEN;
+    }
+
+    // Side to move
+    if (side == "w") {
+        m_sideToMove = PieceColor::WHITE;
+    } else if (side == "b") {
+        m_sideToMove = PieceColor::BLACK;
+    } else {
+        ERROR_LOG("Invalid FEN side to move: " << fen);
+        Clear();
+        return INVALID_FEN;
+    }
+
+    // Castling rights (only kept if king & rook are on their squares)
+    auto hasPiece = [this](PieceColor color, PieceType type, SquareId sq) {
+        return m_mailbox[sq] == MakePieceCode(color, type);
+    };
+    for (const char c : castling) {
+        switch (c) {
+        case 'K': m_st.castling |= WHITE_OO; break;
+        case 'Q': m_st.castling |= WHITE_OOO; break;
+        case 'k': m_st.castling |= BLACK_OO; break;
+        case 'q': m_st.castling |= BLACK_OOO; break;
+        default: break;
+        }
+    }
+    if (!hasPiece(PieceColor::WHITE, PieceType::KING, 4)) m_st.castling &= ~(WHITE_OO | WHITE_OOO);
+    if (!hasPiece(PieceColor::BLACK, PieceType::KING, 60)) m_st.castling &= ~(BLACK_OO | BLACK_OOO);
+    if (!hasPiece(PieceColor::WHITE, PieceType::ROOK, 7)) m_st.castling &= ~WHITE_OO;
+    if (!hasPiece(PieceColor::WHITE, PieceType::ROOK, 0)) m_st.castling &= ~WHITE_OOO;
+    if (!hasPiece(PieceColor::BLACK, PieceType::ROOK, 63)) m_st.castling &= ~BLACK_OO;
+    if (!hasPiece(PieceColor::BLACK, PieceType::ROOK, 56)) m_st.castling &= ~BLACK_OOO;
+
+    // En passant square (only kept if a capture is possible)
+    const char epRank = (m_sideToMove == PieceColor::WHITE) ? '6' : '3';
+    if (enPassant.size() == 2 && enPassant[0] >= 'a' && enPassant[0] <= 'h' &&
+        enPassant[1] == epRank) {
+        SquareId ep = ToSquareId(Square::GetSquareByName(enPassant));
+        if (PawnAttacks(Opposite(m_sideToMove), ep) & GetPieces(m_sideToMove, PieceType::PAWN)) {
+            m_st.epSquare = ep;
+        }
+    }
+
+    // Move counters (optional)
+    int halfmove{ 0 }, fullmove{ 1 };
+    if (ss >> halfmove) {
+        ss >> fullmove;
+    }
+    m_st.halfmoveClock = static_cast<uint16_t>(std::max(halfmove, 0));
+    m_fullmoveNumber = static_cast<uint16_t>(std::max(fullmove, 1));
+
+    m_st.key = ComputeKey();
+    m_st.pawnKey = ComputePawnKey();
+    UpdateCheckInfo();
+
+    // The side that just moved cannot be left in check
+    if (UNLIKELY(IsSquareAttacked(GetKingSquare(Opposite(m_sideToMove)), m_sideToMove))) {
+        ERROR_LOG("Invalid FEN (side not to move is in check): " << fen);
+        Clear();
+        return INVALID_FEN;
+    }
+    return SUCCESS;
+}
+
+std::string Position::GetFEN() const
+{
+    std::string fen{};
+    for (int y{ BOARD_SIZE - 1 }; y >= 0; y--) {
+        int empty{ 0 };
+        for (int x{ 0 }; x < BOARD_SIZE; x++) {
+            PieceCode pc = m_mailbox[y * BOARD_SIZE + x];
+            if (pc == NO_PIECE) {
+                empty++;
+                continue;
+            }
+            if (empty > 0) {
+                fen += static_cast<char>('0' + empty);
+                empty = 0;
+            }
+            fen += PIECE_CHARS[pc];
+        }
+        if (empty > 0) {
+            fen += static_cast<char>('0' + empty);
+        }
+        if (y > 0) {
+            fen += '/';
+        }
+    }
+    fen += (m_sideToMove == PieceColor::WHITE) ? " w " : " b ";
+    if (m_st.castling == 0) {
+        fen += '-';
+    }
+    if (m_st.castling & WHITE_OO) fen += 'K';
+    if (m_st.castling & WHITE_OOO) fen += 'Q';
+    if (m_st.castling & BLACK_OO) fen += 'k';
+    if (m_st.castling & BLACK_OOO) fen += 'q';
+    fen += ' ';
+    fen += (m_st.epSquare == NO_SQUARE) ? "-" : ToSquare(m_st.epSquare).GetSquareName();
+    fen += ' ' + std::to_string(m_st.halfmoveClock) + ' ' + std::to_string(m_fullmoveNumber);
+    return fen;
+}
+
+//--------------------------------------------------
+// Board updates
+//--------------------------------------------------
+void Position::PutPiece(PieceCode pc, SquareId sq)
+{
+    m_mailbox[sq] = pc;
+    m_pieceBB[pc] |= SquareBB(sq);
+    m_colorBB[static_cast<uint8_t>(ColorOf(pc))] |= SquareBB(sq);
+    m_psq += PsqScore(pc, sq);
+    m_phase += PhaseWeight(pc);
+    if (Nnue::IsEnabled()) {
+        Nnue::g_network.AddFeature(m_acc, pc, sq);
+    }
+}
+
+void Position::RemovePiece(SquareId sq)
+{
+    PieceCode pc = m_mailbox[sq];
+    m_pieceBB[pc] ^= SquareBB(sq);
+    m_colorBB[static_cast<uint8_t>(ColorOf(pc))] ^= SquareBB(sq);
+    m_mailbox[sq] = NO_PIECE;
+    m_psq -= PsqScore(pc, sq);
+    m_phase -= PhaseWeight(pc);
+    if (Nnue::IsEnabled()) {
+        Nnue::g_network.RemoveFeature(m_acc, pc, sq);
+    }
+}
+
+void Position::MovePieceTo(SquareId from, SquareId to)
+{
+    PieceCode pc = m_mailbox[from];
+    Bitboard fromTo = SquareBB(from) | SquareBB(to);
+    m_pieceBB[pc] ^= fromTo;
+    m_colorBB[static_cast<uint8_t>(ColorOf(pc))] ^= fromTo;
+    m_mailbox[from] = NO_PIECE;
+    m_mailbox[to] = pc;
+    m_psq += PsqScore(pc, to);
+    m_psq -= PsqScore(pc, from);
+    if (Nnue::IsEnabled()) {
+        Nnue::g_network.MoveFeature(m_acc, pc, from, to);
+    }
+}
+
+void Position::RefreshAccumulator()
+{
+    if (!Nnue::IsEnabled()) {
+        return;
+    }
+    Nnue::g_network.ResetAccumulator(m_acc);
+    for (SquareId sq{ 0 }; sq < NUM_SQUARES; sq++) {
+        if (m_mailbox[sq] != NO_PIECE) {
+            Nnue::g_network.AddFeature(m_acc, m_mailbox[sq], sq);
+        }
+    }
+}
+
+uint64_t Position::ComputeKey() const
+{
+    uint64_t key{ 0 };
+    for (SquareId sq{ 0 }; sq < NUM_SQUARES; sq++) {
+        if (m_mailbox[sq] != NO_PIECE) {
+            key ^= g_zobrist.pieces[m_mailbox[sq]][sq];
+        }
+    }
+    key ^= g_zobrist.castling[m_st.castling];
+    if (m_st.epSquare != NO_SQUARE) {
+        key ^= g_zobrist.enPassant[FileOf(m_st.epSquare)];
+    }
+    if (m_sideToMove == PieceColor::BLACK) {
+        key ^= g_zobrist.side;
+    }
+    return key;
+}
+
+uint64_t Position::ComputePawnKey() const
+{
+    uint64_t key{ 0 };
+    for (PieceColor color : { PieceColor::WHITE, PieceColor::BLACK }) {
+        const PieceCode pawn = MakePieceCode(color, PieceType::PAWN);
+        Bitboard pawns = m_pieceBB[pawn];
+        while (pawns) {
+            key ^= g_zobrist.pieces[pawn][PopLsb(pawns)];
+        }
+    }
+    return key;
+}
+
+/**************************************************
+ * @details
+ *      Refresh checkers of the side to move and
+ *      its pieces pinned to the king.
+ **************************************************/
+void Position::UpdateCheckInfo()
+{
+    PieceColor us = m_sideToMove, them = Opposite(us);
+    SquareId ksq = GetKingSquare(us);
+    Bitboard occupied = GetOccupied();
+
+    m_st.checkers = AttackersTo(ksq, occupied) & GetPieces(them);
+    m_st.pinned = 0;
+
+    Bitboard snipers =
+        (g_attacks.rookEmpty[ksq] &
+            (GetPieces(them, PieceType::ROOK) | GetPieces(them, PieceType::QUEEN))) |
+        (g_attacks.bishopEmpty[ksq] &
+            (GetPieces(them, PieceType::BISHOP) | GetPieces(them, PieceType::QUEEN)));
+    while (snipers) {
+        Bitboard blockers = Between(ksq, PopLsb(snipers)) & occupied;
+        if (blockers && !MoreThanOne(blockers) && (blockers & GetPieces(us))) {
+            m_st.pinned |= blockers;
+        }
+    }
+}
+
+//--------------------------------------------------
+// Make/unmake
+//--------------------------------------------------
+void Position::MakeMove(PackedMove move)
+{
+    const PieceColor us = m_sideToMove, them = Opposite(us);
+    const SquareId from = move.From(), to = move.To();
+    const PieceCode pc = m_mailbox[from];
+    const PieceType type = TypeOf(pc);
+
+    m_history.push_back(m_st);
+    m_st.captured = NO_PIECE;
+    m_st.halfmoveClock++;
+    m_st.pliesFromNull++;
+    m_st.key ^= g_zobrist.side;
+    if (m_st.epSquare != NO_SQUARE) {
+        m_st.key ^= g_zobrist.enPassant[FileOf(m_st.epSquare)];
+        m_st.epSquare = NO_SQUARE;
+    }
+
+    if (move.IsCastle()) {
+        // King moves two squares, the rook jumps over it
+        bool kingSide = move.Flags() == PackedMove::KING_CASTLE;
+        SquareId rookFrom = kingSide ? from + 3 : from - 4;
+        SquareId rookTo = kingSide ? from + 1 : from - 1;
+        PieceCode rook = m_mailbox[rookFrom];
+        MovePieceTo(from, to);
+        MovePieceTo(rookFrom, rookTo);
+        m_st.key ^= g_zobrist.pieces[pc][from] ^ g_zobrist.pieces[pc][to] ^
+                    g_zobrist.pieces[rook][rookFrom] ^ g_zobrist.pieces[rook][rookTo];
+    } else {
+        if (move.IsCapture()) {
+            SquareId capSq = (move.Flags() == PackedMove::EN_PASSANT)
+                ? static_cast<SquareId>(to - ForwardStep(us)) : to;
+            m_st.captured = m_mailbox[capSq];
+            m_st.key ^= g_zobrist.pieces[m_st.captured][capSq];
+            if (TypeOf(m_st.captured) == PieceType::PAWN) {
+                m_st.pawnKey ^= g_zobrist.pieces[m_st.captured][capSq];
+            }
+            RemovePiece(capSq);
+            m_st.halfmoveClock = 0;
+        }
+
+        MovePieceTo(from, to);
+        m_st.key ^= g_zobrist.pieces[pc][from] ^ g_zobrist.pieces[pc][to];
+
+        if (type == PieceType::PAWN) {
+            m_st.halfmoveClock = 0;
+            m_st.pawnKey ^= g_zobrist.pieces[pc][from] ^ g_zobrist.pieces[pc][to];
+            if (move.Flags() == PackedMove::DOUBLE_PUSH) {
+                // Only record en passant if it can be captured
+                SquareId ep = static_cast<SquareId>(from + ForwardStep(us));
+                if (PawnAttacks(us, ep) & GetPieces(them, PieceType::PAWN)) {
+                    m_st.epSquare = ep;
+                    m_st.key ^= g_zobrist.enPassant[FileOf(ep)];
+                }
+            } else if (move.IsPromotion()) {
+                PieceCode promoted = MakePieceCode(us, move.PromotionType());
+                RemovePiece(to);
+                PutPiece(promoted, to);
+                m_st.key ^= g_zobrist.pieces[pc][to] ^ g_zobrist.pieces[promoted][to];
+                m_st.pawnKey ^= g_zobrist.pieces[pc][to];
+            }
+        }
+    }
+
+    // Castling rights
+    uint8_t castling = m_st.castling &
+        g_castlingMasks.masks[from] & g_castlingMasks.masks[to];
+    if (castling != m_st.castling) {
+        m_st.key ^= g_zobrist.castling[m_st.castling] ^ g_zobrist.castling[castling];
+        m_st.castling = castling;
+    }
+
+    if (us == PieceColor::BLACK) {
+        m_fullmoveNumber++;
+    }
+    m_sideToMove = them;
+    UpdateCheckInfo();
+}
+
+void Position::UnmakeMove(PackedMove move)
+{
+    const PieceColor us = Opposite(m_sideToMove);
+    const SquareId from = move.From(), to = move.To();
+    m_sideToMove = us;
+    if (us == PieceColor::BLACK) {
+        m_fullmoveNumber--;
+    }
+
+    if (move.IsCastle()) {
+        bool kingSide = move.Flags() == PackedMove::KING_CASTLE;
+        MovePieceTo(to, from);
+        MovePieceTo(kingSide ? from + 1 : from - 1, kingSide ? from + 3 : from - 4);
+    } else {
+        if (move.IsPromotion()) {
+            RemovePiece(to);
+            PutPiece(MakePieceCode(us, PieceType::PAWN), to);
+        }
+        MovePieceTo(to, from);
+        if (move.IsCapture()) {
+            SquareId capSq = (move.Flags() == PackedMove::EN_PASSANT)
+                ? static_cast<SquareId>(to - ForwardStep(us)) : to;
+            PutPiece(m_st.captured, capSq);
+        }
+    }
+
+    m_st = m_history.back();
+    m_history.pop_back();
+}
+
+void Position::MakeNullMove()
+{
+    m_history.push_back(m_st);
+    m_st.key ^= g_zobrist.side;
+    if (m_st.epSquare != NO_SQUARE) {
+        m_st.key ^= g_zobrist.enPassant[FileOf(m_st.epSquare)];
+        m_st.epSquare = NO_SQUARE;
+    }
+    m_st.captured = NO_PIECE;
+    m_st.halfmoveClock++;
+    m_st.pliesFromNull = 0;
+    m_sideToMove = Opposite(m_sideToMove);
+    UpdateCheckInfo();
+}
+
+void Position::UnmakeNullMove()
+{
+    m_sideToMove = Opposite(m_sideToMove);
+    m_st = m_history.back();
+    m_history.pop_back();
+}
+
+//--------------------------------------------------
+// Attacks
+//--------------------------------------------------
+Bitboard Position::AttackersTo(SquareId sq, Bitboard occupied) const
+{
+    Bitboard rooksQueens = GetPieces(PieceType::ROOK) | GetPieces(PieceType::QUEEN);
+    Bitboard bishopsQueens = GetPieces(PieceType::BISHOP) | GetPieces(PieceType::QUEEN);
+    return (PawnAttacks(PieceColor::BLACK, sq) & GetPieces(PieceColor::WHITE, PieceType::PAWN)) |
+           (PawnAttacks(PieceColor::WHITE, sq) & GetPieces(PieceColor::BLACK, PieceType::PAWN)) |
+           (KnightAttacks(sq) & GetPieces(PieceType::KNIGHT)) |
+           (KingAttacks(sq) & GetPieces(PieceType::KING)) |
+           (RookAttacks(sq, occupied) & rooksQueens) |
+           (BishopAttacks(sq, occupied) & bishopsQueens);
+}
+
+bool Position::IsSquareAttacked(SquareId sq, PieceColor byColor) const
+{
+    return (AttackersTo(sq, GetOccupied()) & GetPieces(byColor)) != 0;
+}
+
+/**************************************************
+ * @details
+ *      Swap-list SEE. Both sides capture on the target
+ *      square with their least valuable attacker and
+ *      may stop whenever continuing would lose material.
+ *      Sliders behind a capturing piece join in as it
+ *      leaves the square's lines.
+ **************************************************/
+int Position::See(PackedMove move) const
+{
+    if (move.IsCastle()) {
+        return 0;
+    }
+    const SquareId from = move.From(), to = move.To();
+    Bitboard occupied = GetOccupied() ^ SquareBB(from);
+    std::array<int, 32> gain{};
+
+    // Initial capture
+    PieceType attacker = TypeOf(m_mailbox[from]);
+    if (move.Flags() == PackedMove::EN_PASSANT) {
+        gain[0] = PieceValue(PieceType::PAWN);
+        occupied ^= SquareBB(static_cast<SquareId>(to - ForwardStep(m_sideToMove)));
+    } else if (m_mailbox[to] != NO_PIECE) {
+        gain[0] = PieceValue(TypeOf(m_mailbox[to]));
+    }
+    if (move.IsPromotion()) {
+        attacker = move.PromotionType();
+        gain[0] += PieceValue(attacker) - PieceValue(PieceType::PAWN);
+    }
+
+    const Bitboard bishopsQueens = GetPieces(PieceType::BISHOP) | GetPieces(PieceType::QUEEN);
+    const Bitboard rooksQueens = GetPieces(PieceType::ROOK) | GetPieces(PieceType::QUEEN);
+    Bitboard attackers = AttackersTo(to, occupied) & occupied;
+    PieceColor side = Opposite(m_sideToMove);
+    int victimValue = PieceValue(attacker);
+    size_t depth{ 0 };
+
+    while (depth + 1 < gain.size()) {
+        Bitboard ourAttackers = attackers & GetPieces(side);
+        if (!ourAttackers) {
+            break;
+        }
+
+        // Least valuable attacker
+        PieceType type{ PieceType::PAWN };
+        Bitboard candidates{ 0 };
+        for (uint8_t t{ 0 }; t <= static_cast<uint8_t>(PieceType::KING); t++) {
+            type = static_cast<PieceType>(t);
+            candidates = ourAttackers & GetPieces(side, type);
+            if (candidates) {
+                break;
+            }
+        }
+
+        // The king may only capture if the square is no longer defended
+        if (type == PieceType::KING && (attackers & GetPieces(Opposite(side)))) {
+            break;
+        }
+
+        depth++;
+        gain[depth] = victimValue - gain[depth - 1];
+        victimValue = PieceValue(type);
+
+        // Remove the attacker and reveal x-rays behind it
+        occupied ^= SquareBB(Lsb(candidates));
+        attackers |= (BishopAttacks(to, occupied) & bishopsQueens) |
+                     (RookAttacks(to, occupied) & rooksQueens);
+        attackers &= occupied;
+        side = Opposite(side);
+    }
+
+    while (depth > 0) {
+        gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+        depth--;
+    }
+    return gain[0];
+}
+
+//--------------------------------------------------
+// Move generation
+//--------------------------------------------------
+void Position::GenerateMoves(MoveList &list, GenType type) const
+{
+    const PieceColor us = m_sideToMove, them = Opposite(us);
+    const Bitboard occupied = GetOccupied();
+    const Bitboard enemies = GetPieces(them);
+    const Bitboard empty = ~occupied;
+    const int up = ForwardStep(us);
+    const bool captures = (type != GenType::QUIETS);
+    const bool quiets = (type != GenType::CAPTURES);
+
+    //------------------ Pawns ------------------
+    const Bitboard pawns = GetPieces(us, PieceType::PAWN);
+    const Bitboard seventh = (us == PieceColor::WHITE) ? RANK_7_BB : (RANK_2_BB);
+    const Bitboard third = (us == PieceColor::WHITE) ? (RANK_2_BB << 8) : (RANK_7_BB >> 8);
+
+    auto addPromotions = [&list](SquareId from, SquareId to, uint8_t capture) {
+        for (int promo{ 3 }; promo >= 0; promo--) {  // Queen first
+            list.Add(PackedMove(from, to, PackedMove::PROMOTION | capture | promo));
+        }
+    };
+
+    if (captures) {
+        // Promotions (pushes and captures)
+        for (Bitboard b = pawns & seventh; b; ) {
+            SquareId from = PopLsb(b);
+            SquareId push = static_cast<SquareId>(from + up);
+            if (empty & SquareBB(push)) {
+                addPromotions(from, push, 0);
+            }
+            for (Bitboard att = PawnAttacks(us, from) & enemies; att; ) {
+                addPromotions(from, PopLsb(att), PackedMove::CAPTURE);
+            }
+        }
+        // Regular captures
+        for (Bitboard b = pawns & ~seventh; b; ) {
+            SquareId from = PopLsb(b);
+            for (Bitboard att = PawnAttacks(us, from) & enemies; att; ) {
+                list.Add(PackedMove(from, PopLsb(att), PackedMove::CAPTURE));
+            }
+        }
+        // En passant
+        if (m_st.epSquare != NO_SQUARE) {
+            for (Bitboard b = PawnAttacks(them, m_st.epSquare) & pawns; b; ) {
+                list.Add(PackedMove(PopLsb(b), m_st.epSquare, PackedMove::EN_PASSANT));
+            }
+        }
+    }
+
+    if (quiets) {
+        Bitboard single = ShiftForward(pawns & ~seventh, us) & empty;
+        Bitboard dbl = ShiftForward(single & third, us) & empty;
+        while (single) {
+            SquareId to = PopLsb(single);
+            list.Add(PackedMove(static_cast<SquareId>(to - up), to));
+        }
+        while (dbl) {
+            SquareId to = PopLsb(dbl);
+            list.Add(PackedMove(static_cast<SquareId>(to - 2 * up), to, PackedMove::DOUBLE_PUSH));
+        }
+    }
+
+    //------------------ Pieces ------------------
+    Bitboard targets = (captures ? enemies : 0) | (quiets ? empty : 0);
+    for (uint8_t t{ static_cast<uint8_t>(PieceType::KNIGHT) };
+         t <= static_cast<uint8_t>(PieceType::KING); t++) {
+        PieceType pieceType = static_cast<PieceType>(t);
+        for (Bitboard b = GetPieces(us, pieceType); b; ) {
+            SquareId from = PopLsb(b);
+            Bitboard attacks{ 0 };
+            switch (pieceType) {
+            case PieceType::KNIGHT: attacks = KnightAttacks(from); break;
+            case PieceType::BISHOP: attacks = BishopAttacks(from, occupied); break;
+            case PieceType::ROOK:   attacks = RookAttacks(from, occupied); break;
+            case PieceType::QUEEN:
+                attacks = BishopAttacks(from, occupied) | RookAttacks(from, occupied);
+                break;
+            default:                attacks = KingAttacks(from); break;
+            }
+            for (attacks &= targets; attacks; ) {
+                SquareId to = PopLsb(attacks);
+                list.Add(PackedMove(from, to,
+                    (enemies & SquareBB(to)) ? PackedMove::CAPTURE : PackedMove::QUIET));
+            }
+        }
+    }
+
+    if (quiets) {
+        GenerateCastling(list);
+    }
+}
+
+void Position::GenerateCastling(MoveList &list) const
+{
+    if (InCheck()) {
+        return;
+    }
+    const PieceColor us = m_sideToMove, them = Opposite(us);
+    const bool white = (us == PieceColor::WHITE);
+    const uint8_t oo = white ? WHITE_OO : BLACK_OO;
+    const uint8_t ooo = white ? WHITE_OOO : BLACK_OOO;
+    const SquareId ksq = white ? 4 : 60;
+    const Bitboard occupied = GetOccupied();
+
+    if ((m_st.castling & oo) && !(Between(ksq, ksq + 3) & occupied) &&
+        !IsSquareAttacked(ksq + 1, them) && !IsSquareAttacked(ksq + 2, them)) {
+        list.Add(PackedMove(ksq, ksq + 2, PackedMove::KING_CASTLE));
+    }
+    if ((m_st.castling & ooo) && !(Between(ksq, ksq - 4) & occupied) &&
+        !IsSquareAttacked(ksq - 1, them) && !IsSquareAttacked(ksq - 2, them)) {
+        list.Add(PackedMove(ksq, ksq - 2, PackedMove::QUEEN_CASTLE));
+    }
+}
+
+void Position::GenerateLegalMoves(MoveList &list) const
+{
+    MoveList pseudo;
+    GenerateMoves(pseudo, GenType::ALL);
+    list.Clear();
+    for (const auto &item : pseudo) {
+        if (IsLegal(item.move)) {
+            list.Add(item.move);
+        }
+    }
+}
+
+/**************************************************
+ * @details
+ *      Check a pseudo-legal move does not leave
+ *      our king in check.
+ **************************************************/
+bool Position::IsLegal(PackedMove move) const
+{
+    const PieceColor us = m_sideToMove, them = Opposite(us);
+    const SquareId from = move.From(), to = move.To();
+    const SquareId ksq = GetKingSquare(us);
+
+    // En passant removes two pieces from the king's lines
+    if (move.Flags() == PackedMove::EN_PASSANT) {
+        SquareId capSq = static_cast<SquareId>(to - ForwardStep(us));
+        Bitboard occupied = (GetOccupied() ^ SquareBB(from) ^ SquareBB(capSq)) | SquareBB(to);
+        Bitboard rooksQueens = GetPieces(them, PieceType::ROOK) | GetPieces(them, PieceType::QUEEN);
+        Bitboard bishopsQueens = GetPieces(them, PieceType::BISHOP) | GetPieces(them, PieceType::QUEEN);
+        return !(RookAttacks(ksq, occupied) & rooksQueens) &&
+               !(BishopAttacks(ksq, occupied) & bishopsQueens);
+    }
+
+    // King moves: destination must not be attacked
+    // (castling path is verified by the generator)
+    if (from == ksq) {
+        return move.IsCastle() ||
+            !(AttackersTo(to, GetOccupied() ^ SquareBB(from)) & GetPieces(them));
+    }
+
+    // In check: capture the checker or block it
+    if (m_st.checkers) {
+        if (MoreThanOne(m_st.checkers)) {
+            return false;
+        }
+        SquareId checker = Lsb(m_st.checkers);
+        if (!((Between(ksq, checker) | m_st.checkers) & SquareBB(to))) {
+            return false;
+        }
+    }
+
+    // Pinned pieces can only move along the pin line
+    return !(m_st.pinned & SquareBB(from)) || Aligned(from, to, ksq);
+}
+
+/**************************************************
+ * @details
+ *      Validate a move that was not produced by the
+ *      generator for this position (hash & killer moves).
+ **************************************************/
+bool Position::IsPseudoLegal(PackedMove move) const
+{
+    const PieceColor us = m_sideToMove;
+    const SquareId from = move.From(), to = move.To();
+    const PieceCode pc = m_mailbox[from];
+    const uint8_t flags = move.Flags();
+
+    if (move.IsNull() || pc == NO_PIECE || ColorOf(pc) != us ||
+        (GetPieces(us) & SquareBB(to)) || flags == 6 || flags == 7) {
+        return false;
+    }
+
+    if (move.IsCastle()) {
+        MoveList castles;
+        GenerateCastling(castles);
+        return castles.Contains(move);
+    }
+
+    const PieceType type = TypeOf(pc);
+    const PieceCode target = m_mailbox[to];
+    if (flags == PackedMove::EN_PASSANT) {
+        return type == PieceType::PAWN && to == m_st.epSquare &&
+            (PawnAttacks(us, from) & SquareBB(to));
+    }
+    if (move.IsCapture() != (target != NO_PIECE) ||
+        (target != NO_PIECE && TypeOf(target) == PieceType::KING)) {
+        return false;
+    }
+
+    if (type == PieceType::PAWN) {
+        const uint8_t lastRank = (us == PieceColor::WHITE) ? 7 : 0;
+        if ((RankOf(to) == lastRank) != move.IsPromotion()) {
+            return false;
+        }
+        const int up = ForwardStep(us);
+        if (move.IsCapture()) {
+            return (PawnAttacks(us, from) & SquareBB(to)) != 0;
+        }
+        if (flags == PackedMove::DOUBLE_PUSH) {
+            const uint8_t secondRank = (us == PieceColor::WHITE) ? 1 : 6;
+            return RankOf(from) == secondRank && to == from + 2 * up &&
+                m_mailbox[from + up] == NO_PIECE;
+        }
+        return to == from + up;
+    }
+
+    if (move.IsPromotion() || flags == PackedMove::DOUBLE_PUSH) {
+        return false;
+    }
+    Bitboard occupied = GetOccupied();
+    Bitboard attacks{ 0 };
+    switch (type) {
+    case PieceType::KNIGHT: attacks = KnightAttacks(from); break;
+    case PieceType::BISHOP: attacks = BishopAttacks(from, occupied); break;
+    case PieceType::ROOK:   attacks = RookAttacks(from, occupied); break;
+    case PieceType::QUEEN:
+        attacks = BishopAttacks(from, occupied) | RookAttacks(from, occupied);
+        break;
+    default:                attacks = KingAttacks(from); break;
+    }
+    return (attacks & SquareBB(to)) != 0;
+}
+
+PackedMove Position::ParseUciMove(const std::string &uci) const
+{
+    MoveList list;
+    GenerateLegalMoves(list);
+    for (const auto &item : list) {
+        if (item.move.ToUci() == uci) {
+            return item.move;
+        }
+    }
+    return NULL_PACKED_MOVE;
+}
+
+/**************************************************
+ * @details
+ *      Check/annotation suffixes are ignored, castling
+ *      accepts both "O-O" and "0-0". A null move is
+ *      returned for illegal or ambiguous input.
+ **************************************************/
+PackedMove Position::ParseSanMove(const std::string &san) const
+{
+    std::string text = san;
+    while (!text.empty() && std::string("+#!?").find(text.back()) != std::string::npos) {
+        text.pop_back();
+    }
+    MoveList list;
+    GenerateLegalMoves(list);
+
+    if (text == "O-O" || text == "0-0" || text == "O-O-O" || text == "0-0-0") {
+        const uint8_t flag = text.size() == 3 ? PackedMove::KING_CASTLE : PackedMove::QUEEN_CASTLE;
+        for (const auto &item : list) {
+            if (item.move.Flags() == flag) {
+                return item.move;
+            }
+        }
+        return NULL_PACKED_MOVE;
+    }
+
+    // Promotion suffix ("=Q" or "Q")
+    PieceType promotion{ PieceType::UNKNOWN };
+    static const std::string PROMOTION_CHARS{ "NBRQ" };
+    if (text.size() > 2 && PROMOTION_CHARS.find(text.back()) != std::string::npos &&
+        (text[text.size() - 2] == '=' || isdigit(text[text.size() - 2]))) {
+        promotion = static_cast<PieceType>(PROMOTION_CHARS.find(text.back()) + 1);
+        text.pop_back();
+        if (text.back() == '=') {
+            text.pop_back();
+        }
+    }
+
+    // Moving piece, then optional disambiguation and the target square
+    static const std::string PIECE_LETTERS{ "PNBRQK" };
+    PieceType type{ PieceType::PAWN };
+    size_t pos{ 0 };
+    if (!text.empty() && isupper(text[0])) {
+        size_t index = PIECE_LETTERS.find(text[0]);
+        if (index == std::string::npos) {
+            return NULL_PACKED_MOVE;
+        }
+        type = static_cast<PieceType>(index);
+        pos = 1;
+    }
+    if (text.size() < pos + 2) {
+        return NULL_PACKED_MOVE;
+    }
+    const char toFile = text[text.size() - 2], toRank = text[text.size() - 1];
+    if (toFile < 'a' || toFile > 'h' || toRank < '1' || toRank > '8') {
+        return NULL_PACKED_MOVE;
+    }
+    const SquareId to = static_cast<SquareId>((toRank - '1') * BOARD_SIZE + (toFile - 'a'));
+    int fromFile{ -1 }, fromRank{ -1 };
+    for (size_t i{ pos }; i + 2 < text.size(); i++) {
+        if (text[i] >= 'a' && text[i] <= 'h') {
+            fromFile = text[i] - 'a';
+        } else if (text[i] >= '1' && text[i] <= '8') {
+            fromRank = text[i] - '1';
+        } else if (text[i] != 'x' && text[i] != '-') {
+            return NULL_PACKED_MOVE;
+        }
+    }
+
+    PackedMove found{ NULL_PACKED_MOVE };
+    for (const auto &item : list) {
+        const PackedMove move = item.move;
+        if (move.To() != to || TypeOf(m_mailbox[move.From()]) != type ||
+            (fromFile >= 0 && FileOf(move.From()) != fromFile) ||
+            (fromRank >= 0 && RankOf(move.From()) != fromRank) ||
+            (move.IsPromotion() ? move.PromotionType() != promotion
+                                : promotion != PieceType::UNKNOWN)) {
+            continue;
+        }
+        if (!found.IsNull()) {
+            return NULL_PACKED_MOVE;    // ambiguous
+        }
+        found = move;
+    }
+    return found;
+}
+
+/**************************************************
+ * @details
+ *      Pieces are disambiguated by file, else by
+ *      rank, else by both. The check suffix needs
+ *      the position after the move (made on a copy).
+ **************************************************/
+std::string Position::ToSan(PackedMove move) const
+{
+    const SquareId from = move.From(), to = move.To();
+    const PieceType type = TypeOf(m_mailbox[from]);
+    std::string san;
+    if (move.IsCastle()) {
+        san = (move.Flags() == PackedMove::KING_CASTLE) ? "O-O" : "O-O-O";
+    } else if (type == PieceType::PAWN) {
+        if (move.IsCapture()) {
+            san += static_cast<char>('a' + FileOf(from));
+            san += 'x';
+        }
+        san += ToSquare(to).GetSquareName();
+        if (move.IsPromotion()) {
+            san += '=';
+            san += "NBRQ"[static_cast<uint8_t>(move.PromotionType()) - 1];
+        }
+    } else {
+        san += "PNBRQK"[static_cast<uint8_t>(type)];
+        MoveList list;
+        GenerateLegalMoves(list);
+        bool ambiguous{ false }, sameFile{ false }, sameRank{ false };
+        for (const auto &item : list) {
+            const SquareId other = item.move.From();
+            if (item.move.To() == to && other != from && TypeOf(m_mailbox[other]) == type) {
+                ambiguous = true;
+                sameFile |= (FileOf(other) == FileOf(from));
+                sameRank |= (RankOf(other) == RankOf(from));
+            }
+        }
+        if (ambiguous && (!sameFile || sameRank)) {
+            san += static_cast<char>('a' + FileOf(from));
+        }
+        if (ambiguous && sameFile) {
+            san += static_cast<char>('1' + RankOf(from));
+        }
+        if (move.IsCapture()) {
+            san += 'x';
+        }
+        san += ToSquare(to).GetSquareName();
+    }
+
+    Position next(*this);
+    next.MakeMove(move);
+    if (next.InCheck()) {
+        MoveList replies;
+        next.GenerateLegalMoves(replies);
+        san += (replies.Size() == 0) ? '#' : '+';
+    }
+    return san;
+}
+
+uint64_t Position::Perft(int depth)
+{
+    MoveList list;
+    GenerateLegalMoves(list);
+    if (depth <= 1) {
+        return (depth == 1) ? list.Size() : 1;
+    }
+    uint64_t nodes{ 0 };
+    for (const auto &item : list) {
+        MakeMove(item.move);
+        nodes += Perft(depth - 1);
+        UnmakeMove(item.move);
+    }
+    return nodes;
+}
+
+//--------------------------------------------------
+// Game state
+//--------------------------------------------------
+bool Position::IsRepetition() const
+{
+    int end = std::min(m_st.halfmoveClock, m_st.pliesFromNull);
+    int size = static_cast<int>(m_history.size());
+    for (int i{ 4 }; i <= end && i <= size; i += 2) {
+        if (m_history[size - i].key == m_st.key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Position::IsInsufficientMaterial() const
+{
+    if (GetPieces(PieceType::PAWN) | GetPieces(PieceType::ROOK) | GetPieces(PieceType::QUEEN)) {
+        return false;
+    }
+    return PopCount(GetPieces(PieceType::KNIGHT) | GetPieces(PieceType::BISHOP)) <= 1;
+}
+
+bool Position::IsDraw() const
+{
+    return m_st.halfmoveClock >= 100 || IsRepetition() || IsInsufficientMaterial();
+}
+
+bool Position::HasNonPawnMaterial(PieceColor color) const
+{
+    return (GetPieces(color) &
+        ~GetPieces(color, PieceType::PAWN) & ~GetPieces(color, PieceType::KING)) != 0;
+}
+
+} // namespace Shohih
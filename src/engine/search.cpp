@@ -0,0 +1,668 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Alpha-beta search Implementation
+ **************************************************/
+
+#include <cmath>
+#include <algorithm>
+#include "search.h"
+#include "evaluate.h"
+
+namespace Shohih {
+
+namespace {
+
+// Safety margin for delta pruning in quiescence (centipawns)
+constexpr int DELTA_MARGIN{ 200 };
+
+// Aspiration window around the previous score
+constexpr int ASPIRATION_MIN_DEPTH{ 4 };
+constexpr int ASPIRATION_DELTA{ 25 };
+
+// Null move: R = base + depth / divisor. Shallower nodes would answer
+// the null move from quiescence, which misses quiet mate threats.
+constexpr int NULL_MOVE_MIN_DEPTH{ 4 };
+constexpr int NULL_MOVE_BASE_REDUCTION{ 3 };
+constexpr int NULL_MOVE_DEPTH_DIVISOR{ 4 };
+constexpr int NULL_MOVE_VERIFY_DEPTH{ 10 };     // cutoffs verified from here on
+
+// (Reverse) futility pruning near the leaves
+constexpr int FUTILITY_MAX_DEPTH{ 6 };
+constexpr int RFP_MARGIN{ 80 };             // per ply
+constexpr int FUTILITY_BASE_MARGIN{ 100 };
+constexpr int FUTILITY_MARGIN{ 120 };       // per ply
+
+// Late move reductions: history worth one ply
+constexpr int LMR_MIN_DEPTH{ 3 };
+constexpr int LMR_HISTORY_DIVISOR{ 8192 };
+
+//--------------------------------------------------
+// Base late move reduction by depth & move number
+//--------------------------------------------------
+struct ReductionTable {
+    std::array<std::array<int8_t, 64>, MAX_DEPTH + 1> table{};
+
+    ReductionTable()
+    {
+        for (int depth{ 1 }; depth <= MAX_DEPTH; depth++) {
+            for (int moveCount{ 1 }; moveCount < 64; moveCount++) {
+                table[depth][moveCount] = static_cast<int8_t>(
+                    0.75 + std::log(depth) * std::log(moveCount) / 2.25);
+            }
+        }
+    }
+    int Get(int depth, int moveCount) const
+        { return table[std::min(depth, MAX_DEPTH)][std::min(moveCount, 63)]; }
+};
+const ReductionTable g_reductions{};
+
+} // namespace
+
+void Search::Clear()
+{
+    m_history.Clear();
+    for (auto &killers : m_killers) {
+        killers.fill(NULL_PACKED_MOVE);
+    }
+}
+
+int Search::ScoreToTT(int score, int ply)
+{
+    return score >= VALUE_TB_WIN_IN_MAX_PLY ? score + ply
+         : score <= -VALUE_TB_WIN_IN_MAX_PLY ? score - ply : score;
+}
+
+int Search::ScoreFromTT(int score, int ply)
+{
+    return score >= VALUE_TB_WIN_IN_MAX_PLY ? score - ply
+         : score <= -VALUE_TB_WIN_IN_MAX_PLY ? score + ply : score;
+}
+
+int64_t Search::ElapsedMs() const
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - m_startTime).count();
+}
+
+/**************************************************
+ * @details
+ *      Split the clock evenly over the remaining moves
+ *      (30 if unknown) plus most of the increment. The
+ *      hard limit allows overrunning the target on
+ *      unstable iterations but never the clock itself.
+ **************************************************/
+void ComputeTimeLimits(const SearchLimits &limits, PieceColor us, int64_t &optimumMs, int64_t &maximumMs)
+{
+    optimumMs = maximumMs = 0;
+    if (limits.infinite) {
+        return;
+    }
+    if (limits.moveTime != 0) {
+        maximumMs = limits.moveTime;
+        return;
+    }
+    const uint8_t side = static_cast<uint8_t>(us);
+    const int64_t time = limits.time[side];
+    if (time <= 0) {
+        return;
+    }
+    const int64_t movesToGo = limits.movesToGo > 0 ? std::min(limits.movesToGo, 40) : 30;
+    const int64_t available = std::max<int64_t>(time - MOVE_OVERHEAD_MS, 1);
+    optimumMs = std::min(time / movesToGo + limits.inc[side] * 3 / 4, available);
+    maximumMs = std::min(optimumMs * 3, available);
+    optimumMs = std::max<int64_t>(optimumMs, 1);
+}
+
+void Search::InitTimeManagement()
+{
+    ComputeTimeLimits(m_limits, m_pos.GetSideToMove(), m_optimumMs, m_maximumMs);
+}
+
+/**************************************************
+ * @details
+ *      Node and time limits are polled every 1024
+ *      nodes to keep the clock off the hot path.
+ *      Pondering ignores the clock until PonderHit().
+ **************************************************/
+bool Search::ShouldStop()
+{
+    if (m_signals->stop.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    const uint64_t nodes = GetNodes();
+    if ((m_limits.nodes != 0 && nodes >= m_limits.nodes) ||
+        ((nodes & 1023) == 0 && m_maximumMs != 0 &&
+         !m_signals->ponder.load(std::memory_order_relaxed) && ElapsedMs() >= m_maximumMs)) {
+        Stop();
+        return true;
+    }
+    return false;
+}
+
+int Search::Evaluate()
+{
+    return Shohih::Evaluate(m_pos, &m_pawns);
+}
+
+void Search::UpdatePv(int ply, PackedMove move)
+{
+    m_pv[ply][ply] = move;
+    for (int i{ ply + 1 }; i < m_pvLength[ply + 1]; i++) {
+        m_pv[ply][i] = m_pv[ply + 1][i];
+    }
+    m_pvLength[ply] = std::max(m_pvLength[ply + 1], ply + 1);
+}
+
+/**************************************************
+ * @details
+ *      A quiet move caused a beta cutoff: make it a
+ *      killer, reward it in the history table and
+ *      penalize the quiets that were tried before it.
+ **************************************************/
+void Search::UpdateQuietStats(PackedMove bestMove, const PackedMove *quiets,
+    size_t quietCount, int depth, int ply)
+{
+    KillerMoves &killers = m_killers[ply];
+    if (killers[0] != bestMove) {
+        killers[1] = killers[0];
+        killers[0] = bestMove;
+    }
+    const PieceColor us = m_pos.GetSideToMove();
+    const int bonus = std::min(depth * depth, 400);
+    m_history.Update(us, bestMove, bonus);
+    for (size_t i{ 0 }; i < quietCount; i++) {
+        m_history.Update(us, quiets[i], -bonus);
+    }
+}
+
+/**************************************************
+ * @details
+ *      WDL probe right after a zeroing move (the
+ *      tables ignore the 50-move counter otherwise).
+ *      Positions with the largest covered piece count
+ *      are only probed at SyzygyProbeDepth or more.
+ *      Cursed wins and blessed losses score as near
+ *      draws.
+ *      - @return true if @param score is a cutoff
+ **************************************************/
+bool Search::ProbeTablebase(int alpha, int beta, int depth, int ply, int &score)
+{
+    const int pieces = PopCount(m_pos.GetOccupied());
+    if (pieces > m_tbPieces || (pieces == m_tbPieces && depth < Tablebases::GetProbeDepth()) ||
+        m_pos.GetHalfmoveClock() != 0 || m_pos.GetCastlingRights() != 0) {
+        return false;
+    }
+    Tablebases::ProbeState state;
+    const Tablebases::WdlScore wdl = Tablebases::ProbeWdl(m_pos, state);
+    if (state == Tablebases::ProbeState::FAIL) {
+        return false;
+    }
+    TranspositionTable::Bound bound;
+    if (wdl < Tablebases::WDL_BLESSED_LOSS) {
+        score = -VALUE_TB_WIN + ply;
+        bound = TranspositionTable::BOUND_UPPER;
+    } else if (wdl > Tablebases::WDL_CURSED_WIN) {
+        score = VALUE_TB_WIN - ply;
+        bound = TranspositionTable::BOUND_LOWER;
+    } else {
+        score = VALUE_DRAW + 2 * wdl;
+        bound = TranspositionTable::BOUND_EXACT;
+    }
+    if (bound == TranspositionTable::BOUND_EXACT ||
+        (bound == TranspositionTable::BOUND_LOWER ? score >= beta : score <= alpha)) {
+        m_tt.Store(m_pos.GetKey(), NULL_PACKED_MOVE, ScoreToTT(score, ply), 0,
+                   std::min(depth + 6, MAX_DEPTH - 1), bound);
+        return true;
+    }
+    return false;
+}
+
+/**************************************************
+ * @details
+ *      Fail-soft negamax alpha-beta with transposition
+ *      table cutoffs and staged move ordering. Pruning
+ *      and reductions (see SearchConfig) only apply
+ *      outside of check and away from mate scores.
+ **************************************************/
+int Search::AlphaBeta(int alpha, int beta, int depth, int ply)
+{
+    const bool rootNode = (ply == 0);
+    const bool pvNode = (beta - alpha > 1);
+    m_pvLength[ply] = ply;
+
+    if (depth <= 0) {
+        return Quiescence(alpha, beta, ply);
+    }
+
+    CountNode();
+    m_selDepth = std::max(m_selDepth, ply);
+    if (ShouldStop()) {
+        return 0;
+    }
+
+    if (!rootNode) {
+        if (m_pos.IsDraw()) {
+            return VALUE_DRAW;
+        }
+        if (ply >= MAX_PLY) {
+            return Evaluate();
+        }
+        // Mate distance pruning
+        alpha = std::max(alpha, -VALUE_MATE + ply);
+        beta = std::min(beta, VALUE_MATE - ply - 1);
+        if (alpha >= beta) {
+            return alpha;
+        }
+    }
+
+    // Transposition table lookup
+    TranspositionTable::Entry ttEntry;
+    const bool ttHit = m_tt.Probe(m_pos.GetKey(), ttEntry);
+    const PackedMove ttMove = ttHit ? ttEntry.move : NULL_PACKED_MOVE;
+    if (ttHit && !pvNode && ttEntry.depth >= depth) {
+        int ttScore = ScoreFromTT(ttEntry.score, ply);
+        if ((ttEntry.bound == TranspositionTable::BOUND_EXACT) ||
+            (ttEntry.bound == TranspositionTable::BOUND_LOWER && ttScore >= beta) ||
+            (ttEntry.bound == TranspositionTable::BOUND_UPPER && ttScore <= alpha)) {
+            return ttScore;
+        }
+    }
+
+    if (!rootNode && m_tbPieces != 0) {
+        int tbScore;
+        if (ProbeTablebase(alpha, beta, depth, ply, tbScore)) {
+            return tbScore;
+        }
+    }
+
+    const bool inCheck = m_pos.InCheck();
+    const int staticEval = inCheck ? -VALUE_INFINITE : Evaluate();
+    const bool nonMateBeta = std::abs(beta) < VALUE_TB_WIN_IN_MAX_PLY;
+
+    // Reverse futility pruning: far above beta near the leaves
+    if (m_config.futility && !pvNode && !inCheck && nonMateBeta &&
+        depth <= FUTILITY_MAX_DEPTH && staticEval - RFP_MARGIN * depth >= beta) {
+        return staticEval;
+    }
+
+    //--------------------------------------------------
+    // Null move pruning. Zugzwang guards: the side to
+    // move needs a piece besides pawns, two null moves
+    // are never made in a row, and deep cutoffs are
+    // verified by a reduced search without null moves.
+    //--------------------------------------------------
+    if (m_config.nullMove && !pvNode && !inCheck && nonMateBeta && !m_afterNull[ply] &&
+        ply >= m_nullMoveMinPly && depth >= NULL_MOVE_MIN_DEPTH && staticEval >= beta &&
+        m_pos.HasNonPawnMaterial(m_pos.GetSideToMove())) {
+        const int reduction = NULL_MOVE_BASE_REDUCTION + depth / NULL_MOVE_DEPTH_DIVISOR;
+        m_pos.MakeNullMove();
+        m_afterNull[ply + 1] = true;
+        int nullScore = -AlphaBeta(-beta, -beta + 1, depth - 1 - reduction, ply + 1);
+        m_afterNull[ply + 1] = false;
+        m_pos.UnmakeNullMove();
+        if (m_signals->stop.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+        if (nullScore >= beta) {
+            // Unproven mate scores are not returned
+            nullScore = std::min(nullScore, VALUE_TB_WIN_IN_MAX_PLY - 1);
+            if (depth < NULL_MOVE_VERIFY_DEPTH) {
+                return nullScore;
+            }
+            m_nullMoveMinPly = ply + 3 * (depth - reduction) / 4;
+            const int verified = AlphaBeta(beta - 1, beta, depth - reduction, ply);
+            m_nullMoveMinPly = 0;
+            if (m_signals->stop.load(std::memory_order_relaxed)) {
+                return 0;
+            }
+            if (verified >= beta) {
+                return nullScore;
+            }
+        }
+    }
+
+    const bool canFutilityPrune = m_config.futility && !pvNode && !inCheck &&
+        depth <= FUTILITY_MAX_DEPTH && std::abs(alpha) < VALUE_TB_WIN_IN_MAX_PLY;
+    const int futilityValue = staticEval + FUTILITY_BASE_MARGIN + FUTILITY_MARGIN * depth;
+
+    const int oldAlpha = alpha;
+    int bestScore{ -VALUE_INFINITE };
+    PackedMove bestMove{};
+    int moveCount{ 0 };
+    std::array<PackedMove, 64> quietsTried;
+    size_t quietCount{ 0 };
+
+    MovePicker picker(m_pos, ttMove, m_killers[ply], m_history);
+    for (PackedMove move = picker.NextMove(); !move.IsNull(); move = picker.NextMove()) {
+        if (!m_pos.IsLegal(move)) {
+            continue;
+        }
+        if (rootNode && !m_rootMoves.empty() &&
+            std::find(m_rootMoves.begin(), m_rootMoves.end(), move) == m_rootMoves.end()) {
+            continue;
+        }
+        moveCount++;
+        const bool isKiller = (move == m_killers[ply][0] || move == m_killers[ply][1]);
+        const int history = m_history.Get(m_pos.GetSideToMove(), move);
+
+        m_pos.MakeMove(move);
+        const bool givesCheck = m_pos.InCheck();
+
+        // Futility pruning: quiet moves that cannot reach alpha
+        if (canFutilityPrune && moveCount > 1 && move.IsQuiet() && !givesCheck &&
+            futilityValue <= alpha) {
+            m_pos.UnmakeMove(move);
+            bestScore = std::max(bestScore, futilityValue);
+            continue;
+        }
+
+        // Check extension (bounded to avoid endless checking lines)
+        const int extension = (givesCheck && ply < 2 * m_rootDepth) ? 1 : 0;
+        const int newDepth = depth - 1 + extension;
+
+        //--------------------------------------------------
+        // Late move reductions: late quiet moves are
+        // searched shallower first (less for PV nodes,
+        // killers and moves with a good history) and
+        // re-searched at full depth if they beat alpha
+        //--------------------------------------------------
+        int score{ 0 };
+        bool fullDepth{ true };
+        if (m_config.lmr && depth >= LMR_MIN_DEPTH && moveCount > 1 + (pvNode ? 1 : 0) &&
+            move.IsQuiet() && !inCheck && !givesCheck) {
+            int reduction = g_reductions.Get(depth, moveCount) - (pvNode ? 1 : 0) - (isKiller ? 1 : 0) -
+                history / LMR_HISTORY_DIVISOR;
+            reduction = std::max(0, std::min(reduction, newDepth - 1));
+            if (reduction > 0) {
+                const int lmrBeta = m_config.pvs ? alpha + 1 : beta;
+                score = -AlphaBeta(-lmrBeta, -alpha, newDepth - reduction, ply + 1);
+                fullDepth = (score > alpha && !m_signals->stop.load(std::memory_order_relaxed));
+            }
+        }
+
+        // Principal variation search: null window after the first move
+        if (fullDepth) {
+            if (m_config.pvs && moveCount > 1) {
+                score = -AlphaBeta(-alpha - 1, -alpha, newDepth, ply + 1);
+                if (pvNode && score > alpha && score < beta &&
+                    !m_signals->stop.load(std::memory_order_relaxed)) {
+                    score = -AlphaBeta(-beta, -alpha, newDepth, ply + 1);
+                }
+            } else {
+                score = -AlphaBeta(-beta, -alpha, newDepth, ply + 1);
+            }
+        }
+        m_pos.UnmakeMove(move);
+
+        if (m_signals->stop.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+
+        if (score > bestScore) {
+            bestScore = score;
+            if (score > alpha) {
+                bestMove = move;
+                UpdatePv(ply, move);
+                if (score >= beta) {
+                    break;
+                }
+                alpha = score;
+            }
+        }
+        if (move.IsQuiet() && quietCount < quietsTried.size()) {
+            quietsTried[quietCount++] = move;
+        }
+    }
+
+    // Checkmate or stalemate
+    if (moveCount == 0) {
+        return inCheck ? -VALUE_MATE + ply : VALUE_DRAW;
+    }
+
+    if (bestScore >= beta && bestMove.IsQuiet()) {
+        UpdateQuietStats(bestMove, quietsTried.data(), quietCount, depth, ply);
+    }
+
+    TranspositionTable::Bound bound =
+        bestScore >= beta ? TranspositionTable::BOUND_LOWER
+        : bestScore > oldAlpha ? TranspositionTable::BOUND_EXACT
+        : TranspositionTable::BOUND_UPPER;
+    m_tt.Store(m_pos.GetKey(), bestMove, ScoreToTT(bestScore, ply), 0, depth, bound);
+
+    return bestScore;
+}
+
+/**************************************************
+ * @details
+ *      Quiescence search: only captures and queen
+ *      promotions are searched until the position is
+ *      quiet. The side to move may "stand pat" on the
+ *      static evaluation unless it is in check, in which
+ *      case all evasions are searched.
+ *      Captures that lose material (SEE < 0) and captures
+ *      that cannot raise alpha even when winning the
+ *      victim outright (delta pruning) are skipped.
+ **************************************************/
+int Search::Quiescence(int alpha, int beta, int ply)
+{
+    const bool pvNode = (beta - alpha > 1);
+    m_pvLength[ply] = ply;
+
+    CountNode();
+    m_selDepth = std::max(m_selDepth, ply);
+    if (ShouldStop()) {
+        return 0;
+    }
+    if (m_pos.IsDraw()) {
+        return VALUE_DRAW;
+    }
+    const bool inCheck = m_pos.InCheck();
+    if (ply >= MAX_PLY) {
+        return inCheck ? VALUE_DRAW : Evaluate();
+    }
+
+    // Transposition table lookup (any depth is enough)
+    TranspositionTable::Entry ttEntry;
+    const bool ttHit = m_tt.Probe(m_pos.GetKey(), ttEntry);
+    const PackedMove ttMove = ttHit ? ttEntry.move : NULL_PACKED_MOVE;
+    if (ttHit && !pvNode) {
+        int ttScore = ScoreFromTT(ttEntry.score, ply);
+        if ((ttEntry.bound == TranspositionTable::BOUND_EXACT) ||
+            (ttEntry.bound == TranspositionTable::BOUND_LOWER && ttScore >= beta) ||
+            (ttEntry.bound == TranspositionTable::BOUND_UPPER && ttScore <= alpha)) {
+            return ttScore;
+        }
+    }
+
+    // Stand pat
+    int bestScore{ -VALUE_INFINITE };
+    int standPat{ 0 };
+    if (!inCheck) {
+        standPat = Evaluate();
+        if (standPat >= beta) {
+            return standPat;
+        }
+        alpha = std::max(alpha, standPat);
+        bestScore = standPat;
+    }
+
+    const int oldAlpha = alpha;
+    PackedMove bestMove{};
+    int moveCount{ 0 };
+    static const KillerMoves noKillers{};
+    MovePicker picker = inCheck
+        ? MovePicker(m_pos, ttMove, noKillers, m_history)
+        : MovePicker(m_pos, ttMove, m_history);
+
+    for (PackedMove move = picker.NextMove(); !move.IsNull(); move = picker.NextMove()) {
+        if (!m_pos.IsLegal(move)) {
+            continue;
+        }
+        moveCount++;
+
+        if (!inCheck) {
+            // Under-promotions never matter in quiescence
+            if (move.IsPromotion() && move.PromotionType() != PieceType::QUEEN) {
+                continue;
+            }
+            // Delta pruning
+            int victim = (move.Flags() == PackedMove::EN_PASSANT) ? PieceValue(PieceType::PAWN)
+                : move.IsCapture() ? PieceValue(TypeOf(m_pos.GetPieceOn(move.To()))) : 0;
+            if (!move.IsPromotion() && standPat + victim + DELTA_MARGIN <= alpha) {
+                bestScore = std::max(bestScore, standPat + victim + DELTA_MARGIN);
+                continue;
+            }
+            // SEE pruning
+            if (!m_pos.SeeGe(move, 0)) {
+                continue;
+            }
+        }
+
+        m_pos.MakeMove(move);
+        int score = -Quiescence(-beta, -alpha, ply + 1);
+        m_pos.UnmakeMove(move);
+
+        if (m_signals->stop.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+
+        if (score > bestScore) {
+            bestScore = score;
+            if (score > alpha) {
+                bestMove = move;
+                UpdatePv(ply, move);
+                if (score >= beta) {
+                    break;
+                }
+                alpha = score;
+            }
+        }
+    }
+
+    // Checkmate (only detectable when all evasions were generated)
+    if (inCheck && moveCount == 0) {
+        return -VALUE_MATE + ply;
+    }
+
+    TranspositionTable::Bound bound =
+        bestScore >= beta ? TranspositionTable::BOUND_LOWER
+        : bestScore > oldAlpha ? TranspositionTable::BOUND_EXACT
+        : TranspositionTable::BOUND_UPPER;
+    m_tt.Store(m_pos.GetKey(), bestMove, ScoreToTT(bestScore, ply), standPat, 0, bound);
+
+    return bestScore;
+}
+
+/**************************************************
+ * @details
+ *      Iterative deepening. The result of the last
+ *      completed iteration is returned; a search that
+ *      is stopped during the first iteration falls
+ *      back to its partial result or the first legal move.
+ **************************************************/
+SearchResult Search::Run(const Position &pos, const SearchLimits &limits)
+{
+    m_startTime = std::chrono::steady_clock::now();
+    m_pos = pos;
+    m_pos.RefreshAccumulator();     // the caller's copy may predate the network
+    m_limits = limits;
+    if (m_signals == &m_ownSignals) {
+        m_ownSignals.stop.store(false, std::memory_order_relaxed);
+        m_ownSignals.ponder.store(limits.ponder, std::memory_order_relaxed);
+    }
+    ResetNodes();
+    InitTimeManagement();
+    for (auto &killers : m_killers) {
+        killers.fill(NULL_PACKED_MOVE);
+    }
+
+    SearchResult result{};
+    MoveList legalMoves;
+    m_pos.GenerateLegalMoves(legalMoves);
+    if (legalMoves.Empty()) {
+        result.score = m_pos.InCheck() ? -VALUE_MATE : VALUE_DRAW;
+        return result;
+    }
+    result.bestMove = legalMoves[0].move;
+
+    // Tablebase root: search only the moves that keep the best result. With
+    // DTZ they already make progress, so the tree is not probed any further.
+    m_rootMoves.clear();
+    m_tbPieces = Tablebases::MaxPieces();
+    if (m_tbPieces >= PopCount(m_pos.GetOccupied()) && m_pos.GetCastlingRights() == 0) {
+        Tablebases::RootProbe probe;
+        if (Tablebases::ProbeRoot(m_pos, probe)) {
+            m_rootMoves = probe.moves;
+            result.bestMove = m_rootMoves.front();
+            if (probe.dtz || probe.rank <= 0) {
+                m_tbPieces = 0;
+            }
+        }
+    }
+
+    for (int depth{ 1 + m_threadId % 2 }; depth <= std::min(limits.depth, MAX_DEPTH); depth++) {
+        m_rootDepth = depth;
+        m_selDepth = 0;
+
+        //--------------------------------------------------
+        // Aspiration window around the previous score,
+        // widened on the failing side until it holds
+        //--------------------------------------------------
+        int delta{ ASPIRATION_DELTA };
+        int alpha{ -VALUE_INFINITE }, beta{ VALUE_INFINITE };
+        if (m_config.aspiration && depth >= ASPIRATION_MIN_DEPTH &&
+            std::abs(result.score) < VALUE_TB_WIN_IN_MAX_PLY) {
+            alpha = std::max(result.score - delta, -VALUE_INFINITE);
+            beta = std::min(result.score + delta, VALUE_INFINITE);
+        }
+        int score{ 0 };
+        while (true) {
+            score = AlphaBeta(alpha, beta, depth, 0);
+            if (m_signals->stop.load(std::memory_order_relaxed)) {
+                break;
+            }
+            if (score <= alpha) {
+                beta = (alpha + beta) / 2;
+                alpha = std::max(score - delta, -VALUE_INFINITE);
+            } else if (score >= beta) {
+                beta = std::min(score + delta, VALUE_INFINITE);
+            } else {
+                break;
+            }
+            delta += delta / 2;
+        }
+
+        if (m_signals->stop.load(std::memory_order_relaxed)) {
+            if (depth == 1 && m_pvLength[0] > 0) {
+                result.bestMove = m_pv[0][0];
+            }
+            break;
+        }
+
+        result.bestMove = m_pv[0][0];
+        result.ponderMove = (m_pvLength[0] > 1) ? m_pv[0][1] : NULL_PACKED_MOVE;
+        result.score = score;
+        result.depth = depth;
+
+        if (m_infoCallback) {
+            SearchInfo info;
+            info.depth = depth;
+            info.selDepth = m_selDepth;
+            info.score = score;
+            info.nodes = GetNodes();
+            info.elapsedMs = ElapsedMs();
+            info.pv.assign(m_pv[0].begin(), m_pv[0].begin() + m_pvLength[0]);
+            m_infoCallback(info);
+        }
+
+        // The next iteration would most likely not finish in time
+        if (m_optimumMs != 0 && !m_signals->ponder.load(std::memory_order_relaxed) &&
+            ElapsedMs() > m_optimumMs / 2) {
+            break;
+        }
+    }
+    result.nodes = GetNodes();
+    return result;
+}
+
+} // namespace Shohih
@@ -0,0 +1,169 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Lazy SMP thread pool Implementation
+ **************************************************/
+
+#include "search_pool.h"
+
+namespace Shohih {
+
+SearchPool::SearchPool(TranspositionTable &tt, size_t numThreads) : m_tt(tt)
+{
+    m_mcts.SetSignals(&m_signals);
+    SetThreads(numThreads);
+}
+
+SearchPool::~SearchPool()
+{
+    Stop();
+    Wait();
+}
+
+void SearchPool::SetThreads(size_t numThreads)
+{
+    Wait();
+    numThreads = std::max<size_t>(numThreads, 1);
+    m_workers.resize(numThreads);
+    for (size_t i{ 0 }; i < numThreads; i++) {
+        if (m_workers[i] == nullptr) {
+            m_workers[i] = std::make_unique<Search>(m_tt);
+            m_workers[i]->SetThreadId(static_cast<int>(i));
+            m_workers[i]->SetSignals(&m_signals);
+            m_workers[i]->SetConfig(m_workers.front()->GetConfig());
+        }
+    }
+    m_workers.front()->SetInfoCallback(m_infoCallback);
+    m_mcts.SetThreads(numThreads);
+}
+
+void SearchPool::SetInfoCallback(SearchInfoCallback callback)
+{
+    Wait();
+    m_infoCallback = callback;
+    m_workers.front()->SetInfoCallback(m_infoCallback);
+    m_mcts.SetInfoCallback(m_infoCallback);
+}
+
+void SearchPool::SetConfig(const SearchConfig &config)
+{
+    Wait();
+    for (auto &worker : m_workers) {
+        worker->SetConfig(config);
+    }
+}
+
+void SearchPool::SetMctsMode(bool enabled)
+{
+    Wait();
+    m_mctsMode = enabled;
+}
+
+/**************************************************
+ * @details
+ *      Signals are reset here, before any thread
+ *      starts, so a Stop() that follows Start() is
+ *      never overwritten by a worker.
+ **************************************************/
+void SearchPool::Start(const Position &pos, const SearchLimits &limits, FinishCallback onFinish)
+{
+    Wait();
+    m_tt.NewSearch();
+    m_signals.stop.store(false, std::memory_order_relaxed);
+    m_signals.ponder.store(limits.ponder, std::memory_order_relaxed);
+    for (auto &worker : m_workers) {
+        worker->ResetNodes();
+    }
+    m_searching.store(true, std::memory_order_release);
+    m_thread = std::thread(&SearchPool::Worker, this, pos, limits, onFinish);
+}
+
+void SearchPool::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_signals.stop.store(true, std::memory_order_relaxed);
+    }
+    m_cv.notify_all();
+}
+
+void SearchPool::PonderHit()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_signals.ponder.store(false, std::memory_order_relaxed);
+    }
+    m_cv.notify_all();
+}
+
+uint64_t SearchPool::GetNodes() const
+{
+    if (m_mctsMode) {
+        return m_mcts.GetNodes();
+    }
+    uint64_t nodes{ 0 };
+    for (const auto &worker : m_workers) {
+        nodes += worker->GetNodes();
+    }
+    return nodes;
+}
+
+SearchResult SearchPool::Wait()
+{
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    return m_result;
+}
+
+void SearchPool::Clear()
+{
+    Wait();
+    for (auto &worker : m_workers) {
+        worker->Clear();
+    }
+    m_mcts.Clear();
+}
+
+/**************************************************
+ * @details
+ *      Runs on the search thread: helpers search the
+ *      same position without limits until the main
+ *      worker is done, then they are stopped. The
+ *      result always comes from the main worker.
+ *      In MCTS mode there are no helpers.
+ **************************************************/
+void SearchPool::Worker(const Position &pos, const SearchLimits &limits, FinishCallback onFinish)
+{
+    SearchLimits helperLimits;
+    helperLimits.infinite = true;
+    std::vector<std::thread> helpers;
+    for (size_t i{ 1 }; i < m_workers.size() && !m_mctsMode; i++) {
+        helpers.emplace_back([this, i, &pos, &helperLimits]() {
+            m_workers[i]->Run(pos, helperLimits);
+        });
+    }
+
+    // MCTS runs its own threads on one shared tree
+    SearchResult result = m_mctsMode ? m_mcts.Run(pos, limits) : m_workers.front()->Run(pos, limits);
+
+    // Infinite and ponder searches must not report before stop/ponderhit
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this, &limits]() {
+            return m_signals.stop.load(std::memory_order_relaxed) ||
+                (!limits.infinite && !m_signals.ponder.load(std::memory_order_relaxed));
+        });
+        m_signals.stop.store(true, std::memory_order_relaxed);
+    }
+    for (auto &helper : helpers) {
+        helper.join();
+    }
+    result.nodes = GetNodes();
+    m_result = result;
+    m_searching.store(false, std::memory_order_release);
+    if (onFinish) {
+        onFinish(result);
+    }
+}
+
+} // namespace Shohih
@@ -0,0 +1,504 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Self-play match harness Implementation
+ **************************************************/
+
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <algorithm>
+#include "selfplay.h"
+
+namespace Shohih {
+
+namespace {
+
+// 95% two-sided normal quantile
+constexpr double CONFIDENCE_Z{ 1.959964 };
+
+// PGN move text line width
+constexpr size_t PGN_LINE_WIDTH{ 80 };
+
+const char *ResultString(GameResult result)
+{
+    switch (result) {
+    case GameResult::WHITE_WIN: return "1-0";
+    case GameResult::BLACK_WIN: return "0-1";
+    case GameResult::DRAW:      return "1/2-1/2";
+    default:                    return "*";
+    }
+}
+
+GameResult LossFor(PieceColor color)
+{
+    return color == PieceColor::WHITE ? GameResult::BLACK_WIN : GameResult::WHITE_WIN;
+}
+
+//--------------------------------------------------
+// Occurrences of the current position since the
+// last irreversible move (@param keys holds one key
+// per position of the game, the current one last)
+//--------------------------------------------------
+int RepetitionCount(const std::vector<uint64_t> &keys, int halfmoveClock)
+{
+    const size_t last = keys.size() - 1;
+    int count{ 1 };
+    for (size_t back{ 4 }; back <= static_cast<size_t>(halfmoveClock) && back <= last; back += 2) {
+        count += (keys[last - back] == keys[last]) ? 1 : 0;
+    }
+    return count;
+}
+
+std::string FormatSeconds(int64_t ms)
+{
+    std::ostringstream text;
+    text << ms / 1000;
+    if (ms % 1000 != 0) {
+        std::string fraction = std::to_string(1000 + ms % 1000).substr(1);
+        fraction.erase(fraction.find_last_not_of('0') + 1);
+        text << '.' << fraction;
+    }
+    return text.str();
+}
+
+} // namespace
+
+const char *TerminationName(Termination termination)
+{
+    switch (termination) {
+    case Termination::CHECKMATE:             return "checkmate";
+    case Termination::STALEMATE:             return "stalemate";
+    case Termination::REPETITION:            return "threefold repetition";
+    case Termination::FIFTY_MOVES:           return "fifty-move rule";
+    case Termination::INSUFFICIENT_MATERIAL: return "insufficient material";
+    case Termination::TIME_FORFEIT:          return "time forfeit";
+    case Termination::RESIGN_ADJUDICATION:   return "adjudicated loss";
+    case Termination::DRAW_ADJUDICATION:     return "adjudicated draw";
+    default:                                 return "maximum game length";
+    }
+}
+
+double GameRecord::FirstEngineScore() const
+{
+    if (result == GameResult::DRAW || result == GameResult::UNKNOWN) {
+        return 0.5;
+    }
+    return ((result == GameResult::WHITE_WIN) == firstEngineWhite) ? 1.0 : 0.0;
+}
+
+//--------------------------------------------------
+// Match statistics
+//--------------------------------------------------
+void MatchStats::Add(const GameRecord &game)
+{
+    const double score = game.FirstEngineScore();
+    if (score == 1.0) {
+        wins++;
+    } else if (score == 0.0) {
+        losses++;
+    } else {
+        draws++;
+    }
+}
+
+double MatchStats::Score() const
+{
+    return Games() ? (static_cast<double>(wins) + 0.5 * static_cast<double>(draws)) /
+        static_cast<double>(Games()) : 0.5;
+}
+
+double MatchStats::EloToScore(double elo)
+{
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+double MatchStats::ScoreToElo(double score)
+{
+    score = std::min(std::max(score, 1e-6), 1.0 - 1e-6);
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+double MatchStats::Elo() const
+{
+    return ScoreToElo(Score());
+}
+
+/**************************************************
+ * @details
+ *      Trinomial variance of the per-game score;
+ *      the interval of the mean score is mapped to
+ *      Elo and halved.
+ **************************************************/
+double MatchStats::EloError() const
+{
+    const double n = static_cast<double>(Games());
+    if (n < 2) {
+        return 0.0;
+    }
+    const double s = Score();
+    const double variance = (static_cast<double>(wins) * (1.0 - s) * (1.0 - s) +
+        static_cast<double>(draws) * (0.5 - s) * (0.5 - s) +
+        static_cast<double>(losses) * s * s) / n;
+    const double margin = CONFIDENCE_Z * std::sqrt(variance / n);
+    return (ScoreToElo(s + margin) - ScoreToElo(s - margin)) / 2.0;
+}
+
+/**************************************************
+ * @details
+ *      Generalised SPRT log-likelihood ratio under
+ *      a normal approximation of the mean score:
+ *      LLR = n (s1 - s0) (2s - s0 - s1) / (2 var)
+ **************************************************/
+double MatchStats::Llr(const SprtOptions &sprt) const
+{
+    const double n = static_cast<double>(Games());
+    if (wins == 0 || losses == 0 || n < 2) {
+        return 0.0;     // variance not estimable yet
+    }
+    const double s = Score();
+    const double variance = (static_cast<double>(wins) * (1.0 - s) * (1.0 - s) +
+        static_cast<double>(draws) * (0.5 - s) * (0.5 - s) +
+        static_cast<double>(losses) * s * s) / n;
+    const double s0 = EloToScore(sprt.elo0), s1 = EloToScore(sprt.elo1);
+    return n * (s1 - s0) * (2.0 * s - s0 - s1) / (2.0 * variance);
+}
+
+double MatchStats::LowerBound(const SprtOptions &sprt)
+{
+    return std::log(sprt.beta / (1.0 - sprt.alpha));
+}
+
+double MatchStats::UpperBound(const SprtOptions &sprt)
+{
+    return std::log((1.0 - sprt.beta) / sprt.alpha);
+}
+
+SprtVerdict MatchStats::Verdict(const SprtOptions &sprt) const
+{
+    const double llr = Llr(sprt);
+    if (llr >= UpperBound(sprt)) {
+        return SprtVerdict::ACCEPT_H1;
+    }
+    if (llr <= LowerBound(sprt)) {
+        return SprtVerdict::ACCEPT_H0;
+    }
+    return SprtVerdict::CONTINUE;
+}
+
+/**************************************************
+ * @details
+ *      The rules are checked before every move
+ *      (mate and stalemate first). The engines'
+ *      scores (side to move's view) drive the
+ *      resign and draw adjudication.
+ **************************************************/
+GameRecord PlayGame(const std::string &fen, Search &white, Search &black,
+    const TimeControl &timeControl, const Adjudication &adjudication)
+{
+    GameRecord game;
+    game.startFen = fen;
+    Position pos;
+    if (UNLIKELY(pos.SetFEN(fen) != SUCCESS)) {
+        return game;
+    }
+
+    const bool useClock = (timeControl.nodes == 0 && timeControl.depth == 0);
+    std::array<int64_t, NUM_PIECE_COLORS> clocks{ { timeControl.baseMs, timeControl.baseMs } };
+    std::array<int, NUM_PIECE_COLORS> resignStreak{};
+    std::array<int, NUM_PIECE_COLORS> lastScore{};
+    int drawStreak{ 0 };
+    std::vector<uint64_t> keys{ pos.GetKey() };
+
+    auto finish = [&game](GameResult result, Termination termination) {
+        game.result = result;
+        game.termination = termination;
+    };
+
+    while (true) {
+        MoveList legal;
+        pos.GenerateLegalMoves(legal);
+        const PieceColor us = pos.GetSideToMove();
+        const int c = static_cast<int>(us);
+        if (legal.Empty()) {
+            if (pos.InCheck()) {
+                finish(LossFor(us), Termination::CHECKMATE);
+            } else {
+                finish(GameResult::DRAW, Termination::STALEMATE);
+            }
+            break;
+        }
+        if (pos.GetHalfmoveClock() >= 100) {
+            finish(GameResult::DRAW, Termination::FIFTY_MOVES);
+            break;
+        }
+        if (pos.IsInsufficientMaterial()) {
+            finish(GameResult::DRAW, Termination::INSUFFICIENT_MATERIAL);
+            break;
+        }
+        if (RepetitionCount(keys, pos.GetHalfmoveClock()) >= 3) {
+            finish(GameResult::DRAW, Termination::REPETITION);
+            break;
+        }
+        if (adjudication.maxPlies > 0 && game.moves.size() >= static_cast<size_t>(adjudication.maxPlies)) {
+            finish(GameResult::DRAW, Termination::MAX_PLIES);
+            break;
+        }
+
+        SearchLimits limits;
+        if (useClock) {
+            limits.time = clocks;
+            limits.inc = { { timeControl.incMs, timeControl.incMs } };
+        } else {
+            limits.nodes = timeControl.nodes;
+            limits.depth = timeControl.depth > 0 ? timeControl.depth : MAX_DEPTH;
+        }
+        Search &engine = (us == PieceColor::WHITE) ? white : black;
+        const auto start = std::chrono::steady_clock::now();
+        const SearchResult result = engine.Run(pos, limits);
+        const int64_t elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        game.nodes += result.nodes;
+
+        if (useClock) {
+            // An empty clock would read as "no limit" to the search
+            clocks[c] -= elapsed;
+            if (clocks[c] <= 0) {
+                finish(LossFor(us), Termination::TIME_FORFEIT);
+                break;
+            }
+            clocks[c] += timeControl.incMs;
+        }
+
+        PackedMove move = result.bestMove;
+        if (UNLIKELY(!legal.Contains(move))) {
+            ERROR_LOG("Engine returned an illegal move " << move.ToUci() << " in " << pos.GetFEN());
+            move = legal[0].move;
+        }
+
+        // Resign: the mover is lost and the opponent agreed on its last move
+        const int score = result.score;
+        lastScore[c] = score;
+        const int them = 1 - c;
+        if (adjudication.resignMoves > 0 && score <= -adjudication.resignScore &&
+            lastScore[them] >= adjudication.resignScore) {
+            if (++resignStreak[c] >= adjudication.resignMoves) {
+                finish(LossFor(us), Termination::RESIGN_ADJUDICATION);
+                break;
+            }
+        } else {
+            resignStreak[c] = 0;
+        }
+
+        // Draw: both sides see a dead equal position for a while
+        if (adjudication.drawMoves > 0 && static_cast<int>(game.moves.size()) >= adjudication.drawMinPly &&
+            std::abs(score) <= adjudication.drawScore) {
+            if (++drawStreak >= 2 * adjudication.drawMoves) {
+                finish(GameResult::DRAW, Termination::DRAW_ADJUDICATION);
+                break;
+            }
+        } else {
+            drawStreak = 0;
+        }
+
+        pos.MakeMove(move);
+        game.moves.push_back(move);
+        keys.push_back(pos.GetKey());
+    }
+    return game;
+}
+
+/**************************************************
+ * @details
+ *      Lines whose position does not parse, games
+ *      that do not replay and finished positions
+ *      are skipped with a warning.
+ **************************************************/
+ErrorCode LoadOpenings(const std::string &path, int plies, std::vector<std::string> &fens)
+{
+    std::ifstream file(path);
+    if (UNLIKELY(!file.is_open())) {
+        ERROR_LOG("Could not open " << path);
+        return FILE_OPEN_ERROR;
+    }
+    fens.clear();
+
+    auto accept = [&fens](const Position &pos) {
+        MoveList legal;
+        pos.GenerateLegalMoves(legal);
+        if (!legal.Empty()) {
+            fens.push_back(pos.GetFEN());
+        }
+    };
+
+    const bool isPgn = path.size() >= 4 && path.compare(path.size() - 4, 4, ".pgn") == 0;
+    size_t skipped{ 0 };
+    if (isPgn) {
+        PgnReader reader(file);
+        PgnGame game;
+        while (reader.NextGame(game)) {
+            Position pos;
+            std::vector<PackedMove> moves;
+            if (game.ParseMoves(pos, moves) != SUCCESS) {
+                skipped++;
+                continue;
+            }
+            for (size_t i{ moves.size() }; i > static_cast<size_t>(std::max(plies, 0)); i--) {
+                pos.UnmakeMove(moves[i - 1]);
+            }
+            accept(pos);
+        }
+    } else {
+        std::string line;
+        while (std::getline(file, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            Position pos;
+            if (pos.SetFEN(line) != SUCCESS) {
+                skipped++;
+                continue;
+            }
+            accept(pos);
+        }
+    }
+    if (skipped > 0) {
+        WARNING_LOG("Skipped " << skipped << " invalid openings in " << path);
+    }
+    return SUCCESS;
+}
+
+std::string FormatPgn(const GameRecord &game, const MatchOptions &options)
+{
+    const std::string &first = options.engines[0].name, &second = options.engines[1].name;
+    const TimeControl &tc = options.timeControl;
+    char date[16]{ "????.??.??" };
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y.%m.%d", std::localtime(&now));
+
+    std::ostringstream pgn;
+    pgn << "[Event \"" << options.event << "\"]\n"
+        << "[Site \"?\"]\n"
+        << "[Date \"" << date << "\"]\n"
+        << "[Round \"" << game.round + 1 << "\"]\n"
+        << "[White \"" << (game.firstEngineWhite ? first : second) << "\"]\n"
+        << "[Black \"" << (game.firstEngineWhite ? second : first) << "\"]\n"
+        << "[Result \"" << ResultString(game.result) << "\"]\n";
+    if (game.startFen != STANDARD_POSITION_FEN) {
+        pgn << "[SetUp \"1\"]\n" << "[FEN \"" << game.startFen << "\"]\n";
+    }
+    if (tc.nodes == 0 && tc.depth == 0) {
+        pgn << "[TimeControl \"" << FormatSeconds(tc.baseMs) << '+' << FormatSeconds(tc.incMs) << "\"]\n";
+    }
+    const bool normal = game.termination != Termination::TIME_FORFEIT &&
+        game.termination != Termination::RESIGN_ADJUDICATION &&
+        game.termination != Termination::DRAW_ADJUDICATION &&
+        game.termination != Termination::MAX_PLIES;
+    pgn << "[Termination \"" << (game.termination == Termination::TIME_FORFEIT ? "time forfeit"
+        : normal ? "normal" : "adjudication") << "\"]\n"
+        << "[PlyCount \"" << game.moves.size() << "\"]\n\n";
+
+    // Move text, wrapped
+    Position pos;
+    pos.SetFEN(game.startFen);
+    std::string line;
+    auto emit = [&pgn, &line](const std::string &token) {
+        if (!line.empty() && line.size() + 1 + token.size() > PGN_LINE_WIDTH) {
+            pgn << line << '\n';
+            line.clear();
+        }
+        line += (line.empty() ? "" : " ") + token;
+    };
+    for (size_t i{ 0 }; i < game.moves.size(); i++) {
+        if (pos.GetSideToMove() == PieceColor::WHITE) {
+            emit(std::to_string(pos.GetFullmoveNumber()) + ".");
+        } else if (i == 0) {
+            emit(std::to_string(pos.GetFullmoveNumber()) + "...");
+        }
+        emit(pos.ToSan(game.moves[i]));
+        pos.MakeMove(game.moves[i]);
+    }
+    emit(std::string("{") + TerminationName(game.termination) + "}");
+    emit(ResultString(game.result));
+    pgn << line << "\n\n";
+    return pgn.str();
+}
+
+/**************************************************
+ * @details
+ *      Workers take the next game number until the
+ *      match is complete; game 2k and 2k+1 share an
+ *      opening with colours reversed. Each worker
+ *      owns both engines' hashes and clears them
+ *      before every game.
+ **************************************************/
+MatchStats RunMatch(const MatchOptions &options, const std::vector<std::string> &openings,
+    GameCallback onGame)
+{
+    const std::vector<std::string> starts = openings.empty()
+        ? std::vector<std::string>{ STANDARD_POSITION_FEN } : openings;
+
+    std::ofstream pgnFile;
+    if (!options.pgnPath.empty()) {
+        pgnFile.open(options.pgnPath, std::ios::app);
+        if (UNLIKELY(!pgnFile.is_open())) {
+            ERROR_LOG("Could not open " << options.pgnPath << ", games are not saved");
+        }
+    }
+
+    MatchStats stats;
+    std::mutex statsMutex;
+    std::atomic<size_t> next{ 0 };
+    std::atomic<bool> decided{ false };
+
+    auto worker = [&]() {
+        std::array<std::unique_ptr<TranspositionTable>, 2> tts;
+        std::array<std::unique_ptr<Search>, 2> engines;
+        for (size_t e{ 0 }; e < 2; e++) {
+            tts[e] = std::make_unique<TranspositionTable>(options.engines[e].hashMb);
+            engines[e] = std::make_unique<Search>(*tts[e]);
+            engines[e]->SetConfig(options.engines[e].config);
+        }
+        for (size_t i = next++; i < options.games && !decided.load(); i = next++) {
+            const bool firstWhite = (i % 2 == 0);
+            for (size_t e{ 0 }; e < 2; e++) {
+                tts[e]->Clear();
+                engines[e]->Clear();
+            }
+            GameRecord game = PlayGame(starts[(i / 2) % starts.size()],
+                firstWhite ? *engines[0] : *engines[1], firstWhite ? *engines[1] : *engines[0],
+                options.timeControl, options.adjudication);
+            game.round = i;
+            game.firstEngineWhite = firstWhite;
+
+            std::lock_guard<std::mutex> lock(statsMutex);
+            stats.Add(game);
+            if (pgnFile.is_open()) {
+                pgnFile << FormatPgn(game, options) << std::flush;
+            }
+            if (onGame) {
+                onGame(game, stats);
+            }
+            if (options.sprt.enabled && stats.Verdict(options.sprt) != SprtVerdict::CONTINUE) {
+                decided = true;
+            }
+        }
+    };
+
+    const size_t threads = std::max<size_t>(1, std::min(options.concurrency, options.games));
+    std::vector<std::thread> helpers;
+    for (size_t i{ 1 }; i < threads; i++) {
+        helpers.emplace_back(worker);
+    }
+    worker();
+    for (auto &helper : helpers) {
+        helper.join();
+    }
+    return stats;
+}
+
+} // namespace Shohih
@@ -0,0 +1,1130 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Syzygy tablebase probing Implementation
+ *
+ * File format (see the generator at
+ * https://github.com/syzygy1/tb for the reference):
+ *  - Positions are mapped to an index: the leading
+ *    group (kings + unique pieces, or the leading
+ *    pawns) is normalized by board symmetry, the
+ *    remaining groups are combinations of squares
+ *  - Values are compressed in blocks with Re-Pair
+ *    symbols coded by a canonical Huffman code, with
+ *    a sparse index to find the block of an index
+ **************************************************/
+
+#include <mutex>
+#include <atomic>
+#include <deque>
+#include <cstring>
+#include <sstream>
+#include <algorithm>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "tbprobe.h"
+
+namespace Shohih {
+namespace Tablebases {
+
+namespace {
+
+enum TableType : uint8_t {
+    WDL,
+    DTZ
+};
+
+constexpr std::array<std::array<uint8_t, 4>, 2> MAGIC{ {
+    { { 0x71, 0xE8, 0x23, 0x5D } },     // WDL
+    { { 0xD7, 0x66, 0x0C, 0xA5 } },     // DTZ
+} };
+const std::array<std::string, 2> SUFFIX{ { ".rtbw", ".rtbz" } };
+
+// Per-table flags
+constexpr uint8_t FLAG_STM{ 1 };
+constexpr uint8_t FLAG_MAPPED{ 2 };
+constexpr uint8_t FLAG_WIN_PLIES{ 4 };
+constexpr uint8_t FLAG_LOSS_PLIES{ 8 };
+constexpr uint8_t FLAG_WIDE{ 16 };
+constexpr uint8_t FLAG_SINGLE_VALUE{ 128 };
+
+// File header flags
+constexpr uint8_t HEADER_SPLIT{ 1 };
+
+// Piece letters in file names, indexed by PieceType
+const std::string PIECE_CHARS{ "PNBRQK" };
+
+using Sym = uint16_t;
+constexpr Sym NO_SYM{ 0xFFF };
+
+//--------------------------------------------------
+// Reads from the mapped file (any alignment)
+//--------------------------------------------------
+template <typename T>
+T ReadLittleEndian(const uint8_t *data)
+{
+    T value{ 0 };
+    for (size_t i{ 0 }; i < sizeof(T); i++) {
+        value = static_cast<T>(value | (static_cast<T>(data[i]) << (8 * i)));
+    }
+    return value;
+}
+
+template <typename T>
+T ReadBigEndian(const uint8_t *data)
+{
+    T value{ 0 };
+    for (size_t i{ 0 }; i < sizeof(T); i++) {
+        value = static_cast<T>((value << 8) | data[i]);
+    }
+    return value;
+}
+
+//--------------------------------------------------
+// Decoding tables of one (side, file) sub-table
+//--------------------------------------------------
+struct PairsData {
+    uint8_t flags{ 0 };
+    uint8_t maxSymLen{ 0 };
+    uint8_t minSymLen{ 0 };             // or the value of a single-value table
+    uint32_t numIndices{ 0 };
+    size_t sizeofBlock{ 0 };
+    size_t span{ 0 };                   // values between sparse index entries
+    const uint8_t *lowestSym{ nullptr };    // [length] lowest symbol (LE16)
+    const uint8_t *btree{ nullptr };        // [sym] left & right child (2 x 12 bits)
+    const uint8_t *blockLength{ nullptr };  // [block] values - 1 (LE16)
+    uint32_t blockLengthSize{ 0 };
+    const uint8_t *sparseIndex{ nullptr };  // [k] block (LE32) + offset (LE16)
+    size_t sparseIndexSize{ 0 };
+    const uint8_t *data{ nullptr };         // compressed blocks
+    std::vector<uint64_t> base64{};         // [length] lowest code, left aligned
+    std::vector<uint8_t> symLen{};          // [sym] values - 1 it expands to
+    std::array<uint8_t, MAX_TB_PIECES> pieces{};            // encoding order
+    std::array<uint64_t, MAX_TB_PIECES + 1> groupIdx{};     // index multiplier per group
+    std::array<int, MAX_TB_PIECES + 1> groupLen{};          // zero terminated
+    std::array<uint16_t, 4> mapIdx{};                       // DTZ value map per WDL
+
+    Sym Left(Sym sym) const
+        { return static_cast<Sym>(((btree[3 * sym + 1] & 0xF) << 8) | btree[3 * sym]); }
+    Sym Right(Sym sym) const
+        { return static_cast<Sym>((btree[3 * sym + 2] << 4) | (btree[3 * sym + 1] >> 4)); }
+    int BlockLength(uint32_t block) const
+        { return ReadLittleEndian<uint16_t>(blockLength + 2 * block); }
+};
+
+//--------------------------------------------------
+// One WDL or DTZ file. The material is stored with
+// the first side of the name as white; key2 is the
+// colour-swapped material.
+//--------------------------------------------------
+struct Table {
+    Table(TableType t, const std::string &n) : type(t), name(n) {}
+    ~Table()
+    {
+        if (mapping != nullptr) {
+            munmap(mapping, mapSize);
+        }
+    }
+
+    PairsData *Get(int stm, int file)
+        { return &items[type == WDL ? stm : 0][hasPawns ? file : 0]; }
+
+    TableType type;
+    std::string name;
+    uint64_t key{ 0 };
+    uint64_t key2{ 0 };
+    int pieceCount{ 0 };
+    bool hasPawns{ false };
+    bool hasUniquePieces{ false };
+    std::array<uint8_t, 2> pawnCount{};     // [leading colour, other colour]
+
+    std::atomic<bool> ready{ false };
+    void *mapping{ nullptr };
+    size_t mapSize{ 0 };
+    const uint8_t *dtzMap{ nullptr };
+    PairsData items[2][4];                  // [side to move][leading pawn file]
+};
+
+//--------------------------------------------------
+// Registered tables (read-only while searching)
+//--------------------------------------------------
+std::vector<std::string> g_paths{};
+std::deque<Table> g_tables{};
+std::unordered_map<uint64_t, std::pair<Table *, Table *>> g_byKey{};    // key -> WDL, DTZ
+int g_maxPieces{ 0 };
+int g_probeDepth{ 1 };
+std::mutex g_mapMutex{};
+
+//--------------------------------------------------
+// Index encoding tables
+//--------------------------------------------------
+struct EncodingTables {
+    EncodingTables();
+
+    std::array<int, NUM_SQUARES> mapPawns{};        // a2-h7 -> 0..47, edge & low rank first
+    std::array<int, NUM_SQUARES> mapB1H1H7{};       // below the a1-h8 diagonal -> 0..27
+    std::array<int, NUM_SQUARES> mapA1D1D4{};       // a1-d1-d4 triangle -> 0..9
+    std::array<std::array<int, NUM_SQUARES>, 10> mapKK{};   // 462 king pairs
+    std::array<std::array<uint64_t, NUM_SQUARES>, 6> binomial{};    // [k][n]
+    std::array<std::array<int, NUM_SQUARES>, 6> leadPawnIdx{};      // [lead pawns][square]
+    std::array<std::array<int, 4>, 6> leadPawnsSize{};              // [lead pawns][file]
+};
+
+// 0 on the a1-h8 diagonal, > 0 above it
+int OffDiagonal(int sq)
+{
+    return static_cast<int>(RankOf(static_cast<SquareId>(sq))) -
+        static_cast<int>(FileOf(static_cast<SquareId>(sq)));
+}
+
+EncodingTables::EncodingTables()
+{
+    int code{ 0 };
+    for (int sq{ 0 }; sq < NUM_SQUARES; sq++) {
+        if (OffDiagonal(sq) < 0) {
+            mapB1H1H7[sq] = code++;
+        }
+    }
+
+    // Triangle squares below the diagonal first, then the diagonal
+    std::vector<int> diagonal;
+    code = 0;
+    for (int sq{ 0 }; sq <= 27; sq++) {     // a1..d4
+        if (FileOf(static_cast<SquareId>(sq)) > 3) {
+            continue;
+        }
+        if (OffDiagonal(sq) < 0) {
+            mapA1D1D4[sq] = code++;
+        } else if (OffDiagonal(sq) == 0) {
+            diagonal.push_back(sq);
+        }
+    }
+    for (int sq : diagonal) {
+        mapA1D1D4[sq] = code++;
+    }
+
+    // Legal king pairs with the first king in the triangle; when it is on
+    // the diagonal the second one is not above it. Pairs with both kings
+    // on the diagonal come last.
+    std::vector<std::pair<int, int>> bothOnDiagonal;
+    code = 0;
+    for (int idx{ 0 }; idx < 10; idx++) {
+        for (int s1{ 0 }; s1 <= 27; s1++) {
+            if (FileOf(static_cast<SquareId>(s1)) > 3 || OffDiagonal(s1) > 0 ||
+                mapA1D1D4[s1] != idx || (idx == 0 && s1 != 1)) {    // b1 is mapped to 0
+                continue;
+            }
+            for (int s2{ 0 }; s2 < NUM_SQUARES; s2++) {
+                if ((KingAttacks(static_cast<SquareId>(s1)) | SquareBB(static_cast<SquareId>(s1))) &
+                    SquareBB(static_cast<SquareId>(s2))) {
+                    continue;
+                }
+                if (OffDiagonal(s1) == 0 && OffDiagonal(s2) > 0) {
+                    continue;
+                }
+                if (OffDiagonal(s1) == 0 && OffDiagonal(s2) == 0) {
+                    bothOnDiagonal.emplace_back(idx, s2);
+                } else {
+                    mapKK[idx][s2] = code++;
+                }
+            }
+        }
+    }
+    for (const auto &pair : bothOnDiagonal) {
+        mapKK[pair.first][pair.second] = code++;
+    }
+
+    binomial[0][0] = 1;
+    for (int n{ 1 }; n < NUM_SQUARES; n++) {
+        for (int k{ 0 }; k < 6 && k <= n; k++) {
+            binomial[k][n] = (k > 0 ? binomial[k - 1][n - 1] : 0) +
+                (k < n ? binomial[k][n - 1] : 0);
+        }
+    }
+
+    // The leading pawn is the one with the highest mapPawns[] value: pawns
+    // further from the centre and on lower ranks lead
+    int available{ 47 };
+    for (int leadPawns{ 1 }; leadPawns <= 5; leadPawns++) {
+        for (int file{ 0 }; file < 4; file++) {
+            int idx{ 0 };
+            for (int rank{ 1 }; rank <= 6; rank++) {
+                const int sq = rank * BOARD_SIZE + file;
+                if (leadPawns == 1) {
+                    mapPawns[sq] = available--;
+                    mapPawns[sq ^ 7] = available--;
+                }
+                leadPawnIdx[leadPawns][sq] = idx;
+                idx += static_cast<int>(binomial[leadPawns - 1][mapPawns[sq]]);
+            }
+            leadPawnsSize[leadPawns][file] = idx;
+        }
+    }
+}
+
+const EncodingTables &Encoding()
+{
+    static const EncodingTables tables;
+    return tables;
+}
+
+//--------------------------------------------------
+// Piece codes used in the files: colour * 8 + type + 1
+//--------------------------------------------------
+uint8_t TbPiece(PieceCode pc)
+{
+    return static_cast<uint8_t>((static_cast<uint8_t>(ColorOf(pc)) << 3) |
+        (static_cast<uint8_t>(TypeOf(pc)) + 1));
+}
+
+//--------------------------------------------------
+// Material signature: 4 bits per (colour, type)
+//--------------------------------------------------
+using MaterialCounts = std::array<std::array<int, NUM_PIECE_TYPES>, NUM_PIECE_COLORS>;
+
+uint64_t MaterialKey(const MaterialCounts &counts)
+{
+    uint64_t key{ 0 };
+    for (size_t c{ 0 }; c < NUM_PIECE_COLORS; c++) {
+        for (size_t t{ 0 }; t < NUM_PIECE_TYPES; t++) {
+            key |= static_cast<uint64_t>(counts[c][t] & 0xF) << (4 * (c * NUM_PIECE_TYPES + t));
+        }
+    }
+    return key;
+}
+
+uint64_t MaterialKey(const Position &pos)
+{
+    MaterialCounts counts{};
+    for (uint8_t c{ 0 }; c < NUM_PIECE_COLORS; c++) {
+        for (uint8_t t{ 0 }; t < NUM_PIECE_TYPES; t++) {
+            counts[c][t] = PopCount(pos.GetPieces(static_cast<PieceColor>(c), static_cast<PieceType>(t)));
+        }
+    }
+    return MaterialKey(counts);
+}
+
+//--------------------------------------------------
+// "KRPvKR" -> piece counts, @return false if invalid
+//--------------------------------------------------
+bool ParseName(const std::string &name, MaterialCounts &counts)
+{
+    counts = MaterialCounts{};
+    size_t side{ 0 };
+    for (char c : name) {
+        if (c == 'v' && side == 0) {
+            side = 1;
+            continue;
+        }
+        size_t type = PIECE_CHARS.find(c);
+        if (type == std::string::npos) {
+            return false;
+        }
+        counts[side][type]++;
+    }
+    int total{ 0 };
+    for (const auto &sideCounts : counts) {
+        for (int count : sideCounts) {
+            total += count;
+        }
+    }
+    const size_t king = static_cast<size_t>(PieceType::KING);
+    return side == 1 && counts[0][king] == 1 && counts[1][king] == 1 && total <= MAX_TB_PIECES;
+}
+
+void SetupTable(Table &table, const MaterialCounts &counts)
+{
+    const size_t pawn = static_cast<size_t>(PieceType::PAWN);
+    const size_t king = static_cast<size_t>(PieceType::KING);
+    MaterialCounts swapped{ { counts[1], counts[0] } };
+    table.key = MaterialKey(counts);
+    table.key2 = MaterialKey(swapped);
+    table.pieceCount = 0;
+    for (size_t c{ 0 }; c < NUM_PIECE_COLORS; c++) {
+        for (size_t t{ 0 }; t < NUM_PIECE_TYPES; t++) {
+            table.pieceCount += counts[c][t];
+            if (t != king && counts[c][t] == 1) {
+                table.hasUniquePieces = true;
+            }
+        }
+    }
+    table.hasPawns = counts[0][pawn] + counts[1][pawn] > 0;
+    // Pawns of the side with fewer pawns lead (better compression)
+    const bool whiteLeads = counts[1][pawn] == 0 ||
+        (counts[0][pawn] != 0 && counts[1][pawn] >= counts[0][pawn]);
+    table.pawnCount[0] = static_cast<uint8_t>(counts[whiteLeads ? 0 : 1][pawn]);
+    table.pawnCount[1] = static_cast<uint8_t>(counts[whiteLeads ? 1 : 0][pawn]);
+}
+
+//--------------------------------------------------
+// Decoding setup
+//--------------------------------------------------
+uint8_t SetSymLen(PairsData &d, Sym sym, std::vector<bool> &visited)
+{
+    visited[sym] = true;    // the tree is acyclic
+    const Sym right = d.Right(sym);
+    if (right == NO_SYM) {
+        return 0;
+    }
+    const Sym left = d.Left(sym);
+    if (!visited[left]) {
+        d.symLen[left] = SetSymLen(d, left, visited);
+    }
+    if (!visited[right]) {
+        d.symLen[right] = SetSymLen(d, right, visited);
+    }
+    return static_cast<uint8_t>(d.symLen[left] + d.symLen[right] + 1);
+}
+
+/**************************************************
+ * @details
+ *      Groups of identical pieces are encoded as
+ *      combinations. The order of the groups in the
+ *      index is a per-table parameter: the leading
+ *      group sits at order[0], the remaining pawns
+ *      (pawns on both sides) at order[1].
+ **************************************************/
+void SetGroups(const Table &table, PairsData &d, const int order[2], int file)
+{
+    const EncodingTables &enc = Encoding();
+    int n{ 0 };
+    int firstLen = table.hasPawns ? 0 : table.hasUniquePieces ? 3 : 2;
+    d.groupLen[n] = 1;
+    for (int i{ 1 }; i < table.pieceCount; i++) {
+        if (--firstLen > 0 || d.pieces[i] == d.pieces[i - 1]) {
+            d.groupLen[n]++;
+        } else {
+            d.groupLen[++n] = 1;
+        }
+    }
+    d.groupLen[++n] = 0;
+
+    const bool bothPawns = table.hasPawns && table.pawnCount[1] != 0;
+    int next = bothPawns ? 2 : 1;
+    int freeSquares = NUM_SQUARES - d.groupLen[0] - (bothPawns ? d.groupLen[1] : 0);
+    uint64_t idx{ 1 };
+    for (int k{ 0 }; next < n || k == order[0] || k == order[1]; k++) {
+        if (k == order[0]) {
+            d.groupIdx[0] = idx;
+            idx *= table.hasPawns ? static_cast<uint64_t>(enc.leadPawnsSize[d.groupLen[0]][file])
+                : table.hasUniquePieces ? 31332 : 462;
+        } else if (k == order[1]) {
+            d.groupIdx[1] = idx;
+            idx *= enc.binomial[d.groupLen[1]][48 - d.groupLen[0]];
+        } else {
+            d.groupIdx[next] = idx;
+            idx *= enc.binomial[d.groupLen[next]][freeSquares];
+            freeSquares -= d.groupLen[next++];
+        }
+    }
+    d.groupIdx[n] = idx;
+}
+
+const uint8_t *SetSizes(PairsData &d, const uint8_t *data)
+{
+    d.flags = *data++;
+    if (d.flags & FLAG_SINGLE_VALUE) {
+        d.numIndices = d.blockLengthSize = 0;
+        d.span = d.sparseIndexSize = 0;
+        d.minSymLen = *data++;
+        return data;
+    }
+
+    // The last group index is the size of the table
+    size_t groups{ 0 };
+    while (d.groupLen[groups] != 0) {
+        groups++;
+    }
+    const uint64_t tbSize = d.groupIdx[groups];
+
+    d.sizeofBlock = size_t{ 1 } << *data++;
+    d.span = size_t{ 1 } << *data++;
+    d.sparseIndexSize = static_cast<size_t>((tbSize + d.span - 1) / d.span);
+    const uint8_t padding = *data++;
+    d.numIndices = ReadLittleEndian<uint32_t>(data);
+    data += sizeof(uint32_t);
+    d.blockLengthSize = d.numIndices + padding;
+    d.maxSymLen = *data++;
+    d.minSymLen = *data++;
+    d.lowestSym = data;
+
+    // Canonical Huffman code: longer codes have lower values. base64[i] is the
+    // lowest code of length minSymLen + i, left aligned in 64 bits.
+    d.base64.assign(static_cast<size_t>(d.maxSymLen - d.minSymLen + 1), 0);
+    for (int i{ static_cast<int>(d.base64.size()) - 2 }; i >= 0; i--) {
+        d.base64[i] = (d.base64[i + 1] + ReadLittleEndian<Sym>(d.lowestSym + 2 * i) -
+            ReadLittleEndian<Sym>(d.lowestSym + 2 * (i + 1))) / 2;
+    }
+    for (size_t i{ 0 }; i < d.base64.size(); i++) {
+        d.base64[i] <<= 64 - i - d.minSymLen;
+    }
+    data += d.base64.size() * sizeof(Sym);
+
+    d.symLen.assign(ReadLittleEndian<uint16_t>(data), 0);
+    data += sizeof(uint16_t);
+    d.btree = data;
+    std::vector<bool> visited(d.symLen.size());
+    for (size_t sym{ 0 }; sym < d.symLen.size(); sym++) {
+        if (!visited[sym]) {
+            d.symLen[sym] = SetSymLen(d, static_cast<Sym>(sym), visited);
+        }
+    }
+    return data + d.symLen.size() * 3 + (d.symLen.size() & 1);
+}
+
+const uint8_t *Align(const uint8_t *data, uintptr_t alignment)
+{
+    const uintptr_t addr = reinterpret_cast<uintptr_t>(data);
+    return data + ((alignment - (addr % alignment)) % alignment);
+}
+
+//--------------------------------------------------
+// DTZ values may be stored through a per-WDL map
+//--------------------------------------------------
+const uint8_t *SetDtzMap(Table &table, const uint8_t *data, int maxFile)
+{
+    table.dtzMap = data;
+    for (int file{ 0 }; file <= maxFile; file++) {
+        PairsData &d = *table.Get(0, file);
+        if (!(d.flags & FLAG_MAPPED)) {
+            continue;
+        }
+        if (d.flags & FLAG_WIDE) {
+            data = Align(data, 2);
+            for (auto &idx : d.mapIdx) {
+                idx = static_cast<uint16_t>((data - table.dtzMap) / 2 + 1);
+                data += 2 * ReadLittleEndian<uint16_t>(data) + 2;
+            }
+        } else {
+            for (auto &idx : d.mapIdx) {
+                idx = static_cast<uint16_t>(data - table.dtzMap + 1);
+                data += *data + 1;
+            }
+        }
+    }
+    return Align(data, 2);
+}
+
+void ReadTable(Table &table, const uint8_t *data)
+{
+    const bool split = (*data & HEADER_SPLIT) != 0;
+    data++;
+    const int sides = (table.type == WDL && split) ? 2 : 1;
+    const int maxFile = table.hasPawns ? 3 : 0;
+    const bool bothPawns = table.hasPawns && table.pawnCount[1] != 0;
+
+    for (int file{ 0 }; file <= maxFile; file++) {
+        for (int i{ 0 }; i < sides; i++) {
+            *table.Get(i, file) = PairsData{};
+        }
+        const int order[2][2] = {
+            { *data & 0xF, bothPawns ? *(data + 1) & 0xF : 0xF },
+            { *data >> 4, bothPawns ? *(data + 1) >> 4 : 0xF },
+        };
+        data += 1 + bothPawns;
+        for (int k{ 0 }; k < table.pieceCount; k++, data++) {
+            for (int i{ 0 }; i < sides; i++) {
+                table.Get(i, file)->pieces[k] = static_cast<uint8_t>(i ? *data >> 4 : *data & 0xF);
+            }
+        }
+        for (int i{ 0 }; i < sides; i++) {
+            SetGroups(table, *table.Get(i, file), order[i], file);
+        }
+    }
+    data = Align(data, 2);
+
+    for (int file{ 0 }; file <= maxFile; file++) {
+        for (int i{ 0 }; i < sides; i++) {
+            data = SetSizes(*table.Get(i, file), data);
+        }
+    }
+    if (table.type == DTZ) {
+        data = SetDtzMap(table, data, maxFile);
+    }
+    for (int file{ 0 }; file <= maxFile; file++) {
+        for (int i{ 0 }; i < sides; i++) {
+            PairsData &d = *table.Get(i, file);
+            d.sparseIndex = data;
+            data += d.sparseIndexSize * 6;
+        }
+    }
+    for (int file{ 0 }; file <= maxFile; file++) {
+        for (int i{ 0 }; i < sides; i++) {
+            PairsData &d = *table.Get(i, file);
+            d.blockLength = data;
+            data += d.blockLengthSize * sizeof(uint16_t);
+        }
+    }
+    for (int file{ 0 }; file <= maxFile; file++) {
+        for (int i{ 0 }; i < sides; i++) {
+            PairsData &d = *table.Get(i, file);
+            data = Align(data, 64);
+            d.data = data;
+            data += static_cast<size_t>(d.numIndices) * d.sizeofBlock;
+        }
+    }
+}
+
+//--------------------------------------------------
+// Map the file on first use (once per process)
+//  - @return false if the file is missing or invalid
+//--------------------------------------------------
+bool MapTable(Table &table)
+{
+    if (table.ready.load(std::memory_order_acquire)) {
+        return table.mapping != nullptr;
+    }
+    std::lock_guard<std::mutex> lock(g_mapMutex);
+    if (table.ready.load(std::memory_order_relaxed)) {
+        return table.mapping != nullptr;
+    }
+
+    for (const auto &dir : g_paths) {
+        const std::string path = dir + "/" + table.name + SUFFIX[table.type];
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            continue;
+        }
+        struct stat info{};
+        if (UNLIKELY(fstat(fd, &info) != 0 || info.st_size % 64 != 16)) {
+            ::close(fd);
+            ERROR_LOG("Corrupt tablebase file: " << path);
+            break;
+        }
+        const size_t size = static_cast<size_t>(info.st_size);
+        void *data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);    // the mapping stays valid
+        if (UNLIKELY(data == MAP_FAILED)) {
+            ERROR_LOG("Cannot map tablebase: " << path);
+            break;
+        }
+        madvise(data, size, MADV_RANDOM);
+        if (UNLIKELY(memcmp(data, MAGIC[table.type].data(), 4) != 0)) {
+            munmap(data, size);
+            ERROR_LOG("Invalid tablebase header: " << path);
+            break;
+        }
+        table.mapping = data;
+        table.mapSize = size;
+        ReadTable(table, static_cast<const uint8_t *>(data) + 4);
+        break;
+    }
+    table.ready.store(true, std::memory_order_release);
+    return table.mapping != nullptr;
+}
+
+/**************************************************
+ * @details
+ *      Value stored at @param idx: find the block
+ *      through the sparse index, decode Huffman
+ *      symbols up to the one covering idx, then walk
+ *      down its pair tree to the leaf.
+ **************************************************/
+int DecompressPairs(const PairsData &d, uint64_t idx)
+{
+    if (d.flags & FLAG_SINGLE_VALUE) {
+        return d.minSymLen;
+    }
+
+    const size_t k = static_cast<size_t>(idx / d.span);
+    uint32_t block = ReadLittleEndian<uint32_t>(d.sparseIndex + 6 * k);
+    int offset = ReadLittleEndian<uint16_t>(d.sparseIndex + 6 * k + 4);
+    offset += static_cast<int>(idx % d.span) - static_cast<int>(d.span / 2);
+    while (offset < 0) {
+        offset += d.BlockLength(--block) + 1;
+    }
+    while (offset > d.BlockLength(block)) {
+        offset -= d.BlockLength(block++) + 1;
+    }
+
+    const uint8_t *ptr = d.data + static_cast<uint64_t>(block) * d.sizeofBlock;
+    uint64_t buf64 = ReadBigEndian<uint64_t>(ptr);
+    ptr += 8;
+    int buf64Size{ 64 };
+    Sym sym;
+    while (true) {
+        size_t len{ 0 };    // symbol length - minSymLen
+        while (buf64 < d.base64[len]) {
+            len++;
+        }
+        sym = static_cast<Sym>((buf64 - d.base64[len]) >> (64 - len - d.minSymLen));
+        sym = static_cast<Sym>(sym + ReadLittleEndian<Sym>(d.lowestSym + 2 * len));
+        if (offset < d.symLen[sym] + 1) {
+            break;
+        }
+        offset -= d.symLen[sym] + 1;
+        len += d.minSymLen;
+        buf64 <<= len;
+        buf64Size -= static_cast<int>(len);
+        if (buf64Size <= 32) {
+            buf64Size += 32;
+            buf64 |= static_cast<uint64_t>(ReadBigEndian<uint32_t>(ptr)) << (64 - buf64Size);
+            ptr += 4;
+        }
+    }
+
+    // Pair children are adjacent in the value sequence
+    while (d.symLen[sym] != 0) {
+        const Sym left = d.Left(sym);
+        if (offset < d.symLen[left] + 1) {
+            sym = left;
+        } else {
+            offset -= d.symLen[left] + 1;
+            sym = d.Right(sym);
+        }
+    }
+    return d.Left(sym);
+}
+
+int MapDtzScore(Table &table, int file, int value, WdlScore wdl)
+{
+    static constexpr std::array<int, 5> WDL_MAP{ { 1, 3, 0, 2, 0 } };
+    const PairsData &d = *table.Get(0, file);
+    if (d.flags & FLAG_MAPPED) {
+        const size_t index = d.mapIdx[WDL_MAP[wdl + 2]] + static_cast<size_t>(value);
+        value = (d.flags & FLAG_WIDE) ? ReadLittleEndian<uint16_t>(table.dtzMap + 2 * index)
+                                      : table.dtzMap[index];
+    }
+    // Convert moves to plies where needed
+    if ((wdl == WDL_WIN && !(d.flags & FLAG_WIN_PLIES)) ||
+        (wdl == WDL_LOSS && !(d.flags & FLAG_LOSS_PLIES)) ||
+        wdl == WDL_CURSED_WIN || wdl == WDL_BLESSED_LOSS) {
+        value *= 2;
+    }
+    return value + 1;
+}
+
+/**************************************************
+ * @details
+ *      Tables are stored with the stronger side as
+ *      white (and white to move if both sides have
+ *      the same material); other positions are probed
+ *      colour-flipped. The squares are then
+ *      normalized by symmetry and turned into an
+ *      index.
+ **************************************************/
+int ProbeTable(const Position &pos, Table &table, WdlScore wdl, ProbeState &state)
+{
+    const EncodingTables &enc = Encoding();
+    std::array<int, MAX_TB_PIECES> squares{};
+    std::array<uint8_t, MAX_TB_PIECES> pieces{};
+    int size{ 0 }, leadPawnsCnt{ 0 }, tbFile{ 0 };
+    Bitboard leadPawns{ 0 };
+    uint64_t idx{ 0 };
+
+    const bool blackToMove = pos.GetSideToMove() == PieceColor::BLACK;
+    const bool flip = (table.key == table.key2 && blackToMove) || MaterialKey(pos) != table.key;
+    const uint8_t flipColor = flip ? 8 : 0;
+    const int flipSquares = flip ? 56 : 0;
+    const int stm = flip != blackToMove;
+
+    auto pawnsComp = [&enc](int a, int b) { return enc.mapPawns[a] < enc.mapPawns[b]; };
+
+    // Pawn tables are split by the file of the leading pawn
+    if (table.hasPawns) {
+        const uint8_t pc = table.Get(0, 0)->pieces[0] ^ flipColor;
+        Bitboard b = leadPawns = pos.GetPieces(static_cast<PieceColor>(pc >> 3), PieceType::PAWN);
+        while (b) {
+            squares[size++] = PopLsb(b) ^ flipSquares;
+        }
+        leadPawnsCnt = size;
+        std::swap(squares[0],
+            *std::max_element(squares.begin(), squares.begin() + leadPawnsCnt, pawnsComp));
+        tbFile = FileOf(static_cast<SquareId>(squares[0]));
+        if (tbFile > 3) {
+            tbFile = FileOf(static_cast<SquareId>(squares[0] ^ 7));
+        }
+    }
+
+    // DTZ tables store one side to move only
+    if (table.type == DTZ) {
+        const uint8_t flags = table.Get(stm, tbFile)->flags;
+        if ((flags & FLAG_STM) != stm && !(table.key == table.key2 && !table.hasPawns)) {
+            state = ProbeState::CHANGE_STM;
+            return 0;
+        }
+    }
+
+    Bitboard b = pos.GetOccupied() ^ leadPawns;
+    while (b) {
+        const SquareId sq = PopLsb(b);
+        squares[size] = sq ^ flipSquares;
+        pieces[size++] = TbPiece(pos.GetPieceOn(sq)) ^ flipColor;
+    }
+
+    // Order the pieces as the table encodes them
+    PairsData &d = *table.Get(stm, tbFile);
+    for (int i{ leadPawnsCnt }; i < size - 1; i++) {
+        for (int j{ i + 1 }; j < size; j++) {
+            if (d.pieces[i] == pieces[j]) {
+                std::swap(pieces[i], pieces[j]);
+                std::swap(squares[i], squares[j]);
+                break;
+            }
+        }
+    }
+
+    // Leading piece on files a-d
+    if (FileOf(static_cast<SquareId>(squares[0])) > 3) {
+        for (int i{ 0 }; i < size; i++) {
+            squares[i] ^= 7;
+        }
+    }
+
+    if (table.hasPawns) {
+        idx = static_cast<uint64_t>(enc.leadPawnIdx[leadPawnsCnt][squares[0]]);
+        std::stable_sort(squares.begin() + 1, squares.begin() + leadPawnsCnt, pawnsComp);
+        for (int i{ 1 }; i < leadPawnsCnt; i++) {
+            idx += enc.binomial[i][enc.mapPawns[squares[i]]];
+        }
+    } else {
+        // Leading piece on ranks 1-4, then below the a1-h8 diagonal
+        if (RankOf(static_cast<SquareId>(squares[0])) > 3) {
+            for (int i{ 0 }; i < size; i++) {
+                squares[i] ^= 56;
+            }
+        }
+        for (int i{ 0 }; i < d.groupLen[0]; i++) {
+            if (OffDiagonal(squares[i]) == 0) {
+                continue;
+            }
+            if (OffDiagonal(squares[i]) > 0) {
+                for (int j{ i }; j < size; j++) {
+                    squares[j] = ((squares[j] >> 3) | (squares[j] << 3)) & 63;
+                }
+            }
+            break;
+        }
+
+        if (table.hasUniquePieces) {
+            // Three unique pieces (kings included) are encoded together
+            const int adjust1 = squares[1] > squares[0];
+            const int adjust2 = (squares[2] > squares[0]) + (squares[2] > squares[1]);
+            const auto rank = [](int sq) { return static_cast<int>(RankOf(static_cast<SquareId>(sq))); };
+            if (OffDiagonal(squares[0])) {
+                idx = static_cast<uint64_t>((enc.mapA1D1D4[squares[0]] * 63 +
+                    (squares[1] - adjust1)) * 62 + squares[2] - adjust2);
+            } else if (OffDiagonal(squares[1])) {
+                idx = static_cast<uint64_t>((6 * 63 + rank(squares[0]) * 28 +
+                    enc.mapB1H1H7[squares[1]]) * 62 + squares[2] - adjust2);
+            } else if (OffDiagonal(squares[2])) {
+                idx = static_cast<uint64_t>(6 * 63 * 62 + 4 * 28 * 62 +
+                    rank(squares[0]) * 7 * 28 + (rank(squares[1]) - adjust1) * 28 +
+                    enc.mapB1H1H7[squares[2]]);
+            } else {
+                idx = static_cast<uint64_t>(6 * 63 * 62 + 4 * 28 * 62 + 4 * 7 * 28 +
+                    rank(squares[0]) * 7 * 6 + (rank(squares[1]) - adjust1) * 6 +
+                    (rank(squares[2]) - adjust2));
+            }
+        } else {
+            idx = static_cast<uint64_t>(enc.mapKK[enc.mapA1D1D4[squares[0]]][squares[1]]);
+        }
+    }
+
+    // Remaining groups: combinations of the squares not taken by earlier groups
+    idx *= d.groupIdx[0];
+    int groupStart = d.groupLen[0];
+    bool remainingPawns = table.hasPawns && table.pawnCount[1] != 0;
+    for (int next{ 1 }; d.groupLen[next] != 0; next++) {
+        const int len = d.groupLen[next];
+        std::stable_sort(squares.begin() + groupStart, squares.begin() + groupStart + len);
+        uint64_t n{ 0 };
+        for (int i{ 0 }; i < len; i++) {
+            const int sq = squares[groupStart + i];
+            const int adjust = static_cast<int>(std::count_if(squares.begin(),
+                squares.begin() + groupStart, [sq](int other) { return sq > other; }));
+            n += enc.binomial[i + 1][sq - adjust - 8 * remainingPawns];
+        }
+        remainingPawns = false;
+        idx += n * d.groupIdx[next];
+        groupStart += len;
+    }
+
+    const int value = DecompressPairs(d, idx);
+    return table.type == WDL ? value - 2 : MapDtzScore(table, tbFile, value, wdl);
+}
+
+int ProbeTable(const Position &pos, TableType type, WdlScore wdl, ProbeState &state)
+{
+    if (PopCount(pos.GetOccupied()) == 2) {
+        return 0;   // KvK
+    }
+    auto it = g_byKey.find(MaterialKey(pos));
+    Table *table = (it == g_byKey.end()) ? nullptr
+        : (type == WDL ? it->second.first : it->second.second);
+    if (table == nullptr || !MapTable(*table)) {
+        state = ProbeState::FAIL;
+        return 0;
+    }
+    return ProbeTable(pos, *table, wdl, state);
+}
+
+bool IsZeroing(const Position &pos, PackedMove move)
+{
+    return move.IsCapture() || TypeOf(pos.GetPieceOn(move.From())) == PieceType::PAWN;
+}
+
+int Sign(int value)
+{
+    return (value > 0) - (value < 0);
+}
+
+int DtzBeforeZeroing(WdlScore wdl)
+{
+    return wdl == WDL_WIN ? 1 : wdl == WDL_CURSED_WIN ? 101
+         : wdl == WDL_BLESSED_LOSS ? -101 : wdl == WDL_LOSS ? -1 : 0;
+}
+
+/**************************************************
+ * @details
+ *      Tables assume no en passant rights and store
+ *      "don't care" values where a capture (or, for
+ *      DTZ, a pawn move) is best, so those moves are
+ *      searched first and the table is only trusted
+ *      when it beats them.
+ **************************************************/
+WdlScore SearchWdl(Position &pos, ProbeState &state, bool checkZeroing)
+{
+    MoveList list;
+    pos.GenerateLegalMoves(list);
+    int bestValue{ WDL_LOSS };
+    size_t moveCount{ 0 };
+    for (const auto &item : list) {
+        const PackedMove move = item.move;
+        if (!move.IsCapture() && (!checkZeroing || !IsZeroing(pos, move))) {
+            continue;
+        }
+        moveCount++;
+        pos.MakeMove(move);
+        const int value = -SearchWdl(pos, state, false);
+        pos.UnmakeMove(move);
+        if (state == ProbeState::FAIL) {
+            return WDL_DRAW;
+        }
+        if (value > bestValue) {
+            bestValue = value;
+            if (value >= WDL_WIN) {
+                state = ProbeState::ZEROING_BEST_MOVE;
+                return static_cast<WdlScore>(value);
+            }
+        }
+    }
+
+    const bool noMoreMoves = moveCount != 0 && moveCount == list.Size();
+    int value = bestValue;
+    if (!noMoreMoves) {
+        value = ProbeTable(pos, WDL, WDL_DRAW, state);
+        if (state == ProbeState::FAIL) {
+            return WDL_DRAW;
+        }
+    }
+    if (bestValue >= value) {
+        state = (bestValue > WDL_DRAW || noMoreMoves) ? ProbeState::ZEROING_BEST_MOVE : ProbeState::OK;
+        return static_cast<WdlScore>(bestValue);
+    }
+    state = ProbeState::OK;
+    return static_cast<WdlScore>(value);
+}
+
+bool IsMate(const Position &pos)
+{
+    if (!pos.InCheck()) {
+        return false;
+    }
+    MoveList list;
+    pos.GenerateLegalMoves(list);
+    return list.Empty();
+}
+
+} // namespace
+
+size_t Init(const std::string &paths)
+{
+    std::lock_guard<std::mutex> lock(g_mapMutex);
+    g_byKey.clear();
+    g_tables.clear();
+    g_paths.clear();
+    g_maxPieces = 0;
+
+    std::istringstream stream(paths);
+    std::string dir;
+    while (std::getline(stream, dir, ':')) {
+        if (!dir.empty() && dir != "<empty>") {
+            g_paths.push_back(dir);
+        }
+    }
+
+    for (const auto &path : g_paths) {
+        DIR *handle = opendir(path.c_str());
+        if (handle == nullptr) {
+            WARNING_LOG("Cannot open tablebase directory: " << path);
+            continue;
+        }
+        const std::string &suffix = SUFFIX[WDL];
+        while (const dirent *entry = readdir(handle)) {
+            const std::string file(entry->d_name);
+            if (file.size() <= suffix.size() ||
+                file.compare(file.size() - suffix.size(), suffix.size(), suffix) != 0) {
+                continue;
+            }
+            const std::string name = file.substr(0, file.size() - suffix.size());
+            MaterialCounts counts;
+            if (!ParseName(name, counts) || g_byKey.count(MaterialKey(counts)) != 0) {
+                continue;
+            }
+            g_tables.emplace_back(WDL, name);
+            Table &wdl = g_tables.back();
+            SetupTable(wdl, counts);
+            g_tables.emplace_back(DTZ, name);
+            Table &dtz = g_tables.back();
+            SetupTable(dtz, counts);
+            g_byKey[wdl.key] = std::make_pair(&wdl, &dtz);
+            g_byKey[wdl.key2] = std::make_pair(&wdl, &dtz);
+            g_maxPieces = std::max(g_maxPieces, wdl.pieceCount);
+        }
+        closedir(handle);
+    }
+    return g_tables.size() / 2;
+}
+
+int MaxPieces()
+{
+    return g_maxPieces;
+}
+
+void SetProbeDepth(int depth)
+{
+    g_probeDepth = std::max(depth, 1);
+}
+
+int GetProbeDepth()
+{
+    return g_probeDepth;
+}
+
+WdlScore ProbeWdl(Position &pos, ProbeState &state)
+{
+    state = ProbeState::OK;
+    return SearchWdl(pos, state, false);
+}
+
+/**************************************************
+ * @details
+ *      When the DTZ table stores the other side to
+ *      move, do a 1-ply search for the best DTZ.
+ **************************************************/
+int ProbeDtz(Position &pos, ProbeState &state)
+{
+    state = ProbeState::OK;
+    const WdlScore wdl = SearchWdl(pos, state, true);
+    if (state == ProbeState::FAIL || wdl == WDL_DRAW) {
+        return 0;   // draws are not stored
+    }
+    if (state == ProbeState::ZEROING_BEST_MOVE) {
+        return DtzBeforeZeroing(wdl);
+    }
+
+    int dtz = ProbeTable(pos, DTZ, wdl, state);
+    if (state == ProbeState::FAIL) {
+        return 0;
+    }
+    if (state != ProbeState::CHANGE_STM) {
+        return (dtz + 100 * (wdl == WDL_BLESSED_LOSS || wdl == WDL_CURSED_WIN)) * Sign(wdl);
+    }
+
+    int minDtz{ 0xFFFF };
+    MoveList list;
+    pos.GenerateLegalMoves(list);
+    for (const auto &item : list) {
+        const PackedMove move = item.move;
+        const bool zeroing = IsZeroing(pos, move);
+        pos.MakeMove(move);
+        // The DTZ of a zeroing move is known from the sign of the result
+        dtz = zeroing ? -DtzBeforeZeroing(SearchWdl(pos, state, false)) : -ProbeDtz(pos, state);
+        if (dtz == 1 && IsMate(pos)) {
+            minDtz = 1;
+        }
+        if (!zeroing) {
+            dtz += Sign(dtz);
+        }
+        if (dtz < minDtz && Sign(dtz) == Sign(wdl)) {
+            minDtz = dtz;
+        }
+        pos.UnmakeMove(move);
+        if (state == ProbeState::FAIL) {
+            return 0;
+        }
+    }
+    return minDtz == 0xFFFF ? -1 : minDtz;    // no legal moves: mated
+}
+
+/**************************************************
+ * @details
+ *      Rank 1000 is a win whose zeroing move comes
+ *      within the 50-move counter; smaller positive
+ *      ranks are wins the rule may spoil (mirrored
+ *      for losses). WDL-only ranking cannot see the
+ *      counter.
+ **************************************************/
+bool ProbeRoot(Position &pos, RootProbe &result)
+{
+    MoveList list;
+    pos.GenerateLegalMoves(list);
+    if (list.Empty()) {
+        return false;
+    }
+    std::vector<int> ranks(list.Size());
+    const int cnt50 = pos.GetHalfmoveClock();
+    const bool repeated = pos.IsRepetition();
+    ProbeState state{ ProbeState::OK };
+
+    result.dtz = true;
+    for (size_t i{ 0 }; i < list.Size() && state != ProbeState::FAIL; i++) {
+        const PackedMove move = list[i].move;
+        pos.MakeMove(move);
+        int dtz;
+        if (pos.GetHalfmoveClock() == 0) {
+            dtz = DtzBeforeZeroing(static_cast<WdlScore>(-ProbeWdl(pos, state)));
+        } else {
+            dtz = -ProbeDtz(pos, state);
+            dtz = dtz > 0 ? dtz + 1 : dtz < 0 ? dtz - 1 : dtz;
+        }
+        if (dtz == 2 && IsMate(pos)) {
+            dtz = 1;
+        }
+        pos.UnmakeMove(move);
+        ranks[i] = dtz > 0 ? (dtz + cnt50 <= 99 && !repeated ? 1000 : 1000 - (dtz + cnt50))
+                 : dtz < 0 ? (-dtz * 2 + cnt50 < 100 ? -1000 : -1000 + (-dtz + cnt50))
+                 : 0;
+    }
+
+    if (state == ProbeState::FAIL) {
+        static constexpr std::array<int, 5> WDL_TO_RANK{ { -1000, -899, 0, 899, 1000 } };
+        result.dtz = false;
+        for (size_t i{ 0 }; i < list.Size(); i++) {
+            const PackedMove move = list[i].move;
+            pos.MakeMove(move);
+            const int wdl = -ProbeWdl(pos, state);
+            pos.UnmakeMove(move);
+            if (state == ProbeState::FAIL) {
+                return false;
+            }
+            ranks[i] = WDL_TO_RANK[wdl + 2];
+        }
+    }
+
+    result.rank = *std::max_element(ranks.begin(), ranks.end());
+    result.moves.clear();
+    for (size_t i{ 0 }; i < list.Size(); i++) {
+        if (ranks[i] == result.rank) {
+            result.moves.push_back(list[i].move);
+        }
+    }
+    return true;
+}
+
+} // namespace Tablebases
+} // namespace Shohih
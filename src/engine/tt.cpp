@@ -0,0 +1,129 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Transposition table Implementation
+ **************************************************/
+
+#include "tt.h"
+
+namespace Shohih {
+
+/**************************************************
+ * @details
+ *      Allocate the largest power-of-two number of
+ *      clusters that fits into @param megabytes.
+ **************************************************/
+void TranspositionTable::Resize(size_t megabytes)
+{
+    size_t bytes = std::max<size_t>(megabytes, 1) * 1024 * 1024;
+    size_t clusters{ 1 };
+    while (clusters * 2 * CLUSTER_SIZE * sizeof(Slot) <= bytes) {
+        clusters *= 2;
+    }
+    m_slots.reset(new Slot[clusters * CLUSTER_SIZE]);
+    m_numClusters = clusters;
+    Clear();
+}
+
+void TranspositionTable::Clear()
+{
+    for (size_t i{ 0 }; i < m_numClusters * CLUSTER_SIZE; i++) {
+        m_slots[i].keyXorData.store(0, std::memory_order_relaxed);
+        m_slots[i].data.store(0, std::memory_order_relaxed);
+    }
+    m_generation = 0;
+}
+
+uint64_t TranspositionTable::Pack(PackedMove move, int score, int eval,
+    int depth, Bound bound, uint8_t generation)
+{
+    return static_cast<uint64_t>(move.Raw()) |
+           static_cast<uint64_t>(static_cast<uint16_t>(static_cast<int16_t>(score))) << 16 |
+           static_cast<uint64_t>(static_cast<uint16_t>(static_cast<int16_t>(eval))) << 32 |
+           static_cast<uint64_t>(static_cast<uint8_t>(depth)) << 48 |
+           static_cast<uint64_t>(bound) << 56 |
+           static_cast<uint64_t>(generation & GENERATION_MASK) << 58;
+}
+
+TranspositionTable::Entry TranspositionTable::Unpack(uint64_t data)
+{
+    Entry entry;
+    entry.move = PackedMove::FromRaw(static_cast<uint16_t>(data));
+    entry.score = static_cast<int16_t>(static_cast<uint16_t>(data >> 16));
+    entry.eval = static_cast<int16_t>(static_cast<uint16_t>(data >> 32));
+    entry.depth = static_cast<int8_t>(static_cast<uint8_t>(data >> 48));
+    entry.bound = static_cast<Bound>((data >> 56) & 3);
+    return entry;
+}
+
+bool TranspositionTable::Probe(uint64_t key, Entry &entry) const
+{
+    const Slot *cluster = GetCluster(key);
+    for (size_t i{ 0 }; i < CLUSTER_SIZE; i++) {
+        uint64_t data = cluster[i].data.load(std::memory_order_relaxed);
+        uint64_t check = cluster[i].keyXorData.load(std::memory_order_relaxed);
+        if ((check ^ data) == key && data != 0) {
+            entry = Unpack(data);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**************************************************
+ * @details
+ *      Replace the entry with the same key, otherwise
+ *      the shallowest/oldest entry of the cluster.
+ *      A hit without a move keeps the stored move.
+ **************************************************/
+void TranspositionTable::Store(uint64_t key, PackedMove move, int score,
+    int eval, int depth, Bound bound)
+{
+    Slot *cluster = GetCluster(key);
+    Slot *replace = &cluster[0];
+    int replaceWorth = INT32_MAX;
+
+    for (size_t i{ 0 }; i < CLUSTER_SIZE; i++) {
+        uint64_t data = cluster[i].data.load(std::memory_order_relaxed);
+        uint64_t check = cluster[i].keyXorData.load(std::memory_order_relaxed);
+        if (data == 0 || (check ^ data) == key) {
+            if (data != 0 && move.IsNull()) {
+                move = Unpack(data).move;
+            }
+            // A bound never overwrites a much deeper entry of
+            // this search for the same position (whatever its bound)
+            if (data != 0 && bound != BOUND_EXACT &&
+                depth + 2 < Unpack(data).depth &&
+                ((data >> 58) & GENERATION_MASK) == m_generation) {
+                return;
+            }
+            replace = &cluster[i];
+            break;
+        }
+        // Older generations are cheaper to replace
+        uint8_t age = (m_generation - static_cast<uint8_t>(data >> 58)) & GENERATION_MASK;
+        int worth = Unpack(data).depth - 8 * age;
+        if (worth < replaceWorth) {
+            replaceWorth = worth;
+            replace = &cluster[i];
+        }
+    }
+
+    uint64_t data = Pack(move, score, eval, depth, bound, m_generation);
+    replace->data.store(data, std::memory_order_relaxed);
+    replace->keyXorData.store(key ^ data, std::memory_order_relaxed);
+}
+
+int TranspositionTable::Hashfull() const
+{
+    const size_t sample = std::min<size_t>(1000, m_numClusters * CLUSTER_SIZE);
+    int used{ 0 };
+    for (size_t i{ 0 }; i < sample; i++) {
+        uint64_t data = m_slots[i].data.load(std::memory_order_relaxed);
+        if (data != 0 && ((data >> 58) & GENERATION_MASK) == m_generation) {
+            used++;
+        }
+    }
+    return static_cast<int>(used * 1000 / std::max<size_t>(sample, 1));
+}
+
+} // namespace Shohih
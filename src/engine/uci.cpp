@@ -0,0 +1,443 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   UCI protocol front end Implementation
+ **************************************************/
+
+#include <cctype>
+#include <algorithm>
+#include "uci.h"
+#include "bench.h"
+
+namespace Shohih {
+
+namespace {
+
+// Queued by the input thread when stdin is closed
+const std::string END_OF_INPUT{ "<eof>" };
+
+constexpr size_t MAX_HASH_MB{ 65536 };
+constexpr size_t MAX_THREADS{ 256 };
+
+std::string ToLower(std::string str)
+{
+    std::transform(str.begin(), str.end(), str.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return str;
+}
+
+} // namespace
+
+Uci::Uci(std::istream &in, std::ostream &out) : m_in(in), m_out(out), m_pool(m_tt)
+{
+    m_pool.SetInfoCallback([this](const SearchInfo &info) { SendInfo(info); });
+}
+
+Uci::~Uci()
+{
+    m_pool.Stop();
+    m_pool.Wait();
+}
+
+/**************************************************
+ * @details
+ *      The main thread executes queued commands; the
+ *      search itself runs on the pool's threads, so
+ *      "isready" is answered while searching.
+ **************************************************/
+void Uci::Loop()
+{
+    std::thread input(&Uci::ReadInput, this);
+    std::string line;
+    while (NextCommand(line)) {
+        Execute(line);
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_executing = false;
+    }
+    input.join();
+}
+
+/**************************************************
+ * @details
+ *      "stop" and "ponderhit" bypass the queue when
+ *      nothing is pending, so they reach the search
+ *      within one node-poll interval. Otherwise they
+ *      keep their place behind the pending "go".
+ **************************************************/
+void Uci::ReadInput()
+{
+    std::string line;
+    while (std::getline(m_in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        std::istringstream args(line);
+        std::string cmd;
+        args >> cmd;
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            if ((cmd == "stop" || cmd == "ponderhit") && m_queue.empty() && !m_executing) {
+                if (cmd == "stop") {
+                    m_pool.Stop();
+                } else {
+                    m_pool.PonderHit();
+                }
+                continue;
+            }
+            m_queue.push_back(line);
+        }
+        m_queueCv.notify_one();
+        if (cmd == "quit") {
+            return;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_queue.push_back(END_OF_INPUT);
+    }
+    m_queueCv.notify_one();
+}
+
+/**************************************************
+ * @details
+ *      - @return false on "quit" or end of input
+ **************************************************/
+bool Uci::NextCommand(std::string &line)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_queueMutex);
+        m_queueCv.wait(lock, [this]() { return !m_queue.empty(); });
+        line = m_queue.front();
+        m_queue.pop_front();
+        m_executing = true;
+    }
+    if (line == END_OF_INPUT) {
+        FinishPendingSearch();
+        return false;
+    }
+    if (line.compare(0, 4, "quit") == 0) {
+        m_pool.Stop();
+        m_pool.Wait();
+        return false;
+    }
+    return true;
+}
+
+void Uci::Execute(const std::string &line)
+{
+    std::istringstream args(line);
+    std::string cmd;
+    args >> cmd;
+
+    if (cmd == "uci") {
+        CmdUci();
+    } else if (cmd == "isready") {
+        Send("readyok");
+    } else if (cmd == "ucinewgame") {
+        m_pool.Wait();
+        m_tt.Clear();
+        m_pool.Clear();
+    } else if (cmd == "setoption") {
+        CmdSetOption(args);
+    } else if (cmd == "position") {
+        if (ParsePosition(args, m_pos) != SUCCESS) {
+            Send("info string Invalid position: " + line);
+        }
+    } else if (cmd == "go") {
+        CmdGo(args);
+    } else if (cmd == "stop") {
+        m_pool.Stop();
+    } else if (cmd == "ponderhit") {
+        m_pool.PonderHit();
+    } else if (cmd == "bench") {
+        CmdBench(args);
+    } else if (!cmd.empty()) {
+        Send("info string Unknown command: " + cmd);
+    }
+}
+
+void Uci::CmdUci()
+{
+    Send("id name Shohih");
+    Send("id author vaezim");
+    Send("option name Hash type spin default 16 min 1 max " + std::to_string(MAX_HASH_MB));
+    Send("option name Threads type spin default 1 min 1 max " + std::to_string(MAX_THREADS));
+    Send("option name Ponder type check default false");
+    Send("option name EvalFile type string default <empty>");
+    Send("option name OwnBook type check default false");
+    Send("option name BookFile type string default <empty>");
+    Send("option name SyzygyPath type string default <empty>");
+    Send("option name SyzygyProbeDepth type spin default 1 min 1 max " + std::to_string(MAX_DEPTH));
+    Send("option name PVS type check default true");
+    Send("option name NullMove type check default true");
+    Send("option name LMR type check default true");
+    Send("option name AspirationWindows type check default true");
+    Send("option name Futility type check default true");
+    Send("option name UseMCTS type check default false");
+    Send("option name MCTSHash type spin default 64 min 1 max " + std::to_string(MAX_HASH_MB));
+    Send("option name MCTSTemperature type spin default 0 min 0 max 200");
+    Send("option name Clear Hash type button");
+    Send("uciok");
+}
+
+/**************************************************
+ * @details
+ *      setoption name <id> [value <x>]
+ *      Option names may contain spaces and are
+ *      matched case-insensitively.
+ **************************************************/
+void Uci::CmdSetOption(std::istringstream &args)
+{
+    std::string token, name, value;
+    args >> token;  // "name"
+    while (args >> token && token != "value") {
+        name += (name.empty() ? "" : " ") + token;
+    }
+    while (args >> token) {
+        value += (value.empty() ? "" : " ") + token;
+    }
+    name = ToLower(name);
+
+    if (name == "hash") {
+        m_pool.Wait();
+        m_tt.Resize(std::min<size_t>(std::max(std::atoi(value.c_str()), 1), MAX_HASH_MB));
+    } else if (name == "threads") {
+        m_pool.SetThreads(std::min<size_t>(std::max(std::atoi(value.c_str()), 1), MAX_THREADS));
+    } else if (name == "ponder") {
+        // Pondering is driven by "go ponder"; nothing to configure
+    } else if (name == "evalfile") {
+        m_pool.Wait();
+        if (value.empty() || value == "<empty>") {
+            Nnue::SetEnabled(false);
+        } else if (Nnue::LoadNetwork(value) == SUCCESS) {
+            Send("info string Loaded NNUE " + value + " (" +
+                 Nnue::SimdLevelName(Nnue::GetSimdLevel()) + ")");
+        } else {
+            Send("info string Cannot load NNUE " + value);
+        }
+    } else if (name == "ownbook") {
+        m_ownBook = (ToLower(value) == "true");
+    } else if (name == "bookfile") {
+        if (value.empty() || value == "<empty>") {
+            m_book.Close();
+        } else if (m_book.Open(value) == SUCCESS) {
+            Send("info string Opened book " + value + " (" +
+                 std::to_string(m_book.Size()) + " entries)");
+        } else {
+            Send("info string Cannot open book " + value);
+        }
+    } else if (name == "syzygypath") {
+        m_pool.Wait();
+        size_t tables = Tablebases::Init(value);
+        Send("info string Found " + std::to_string(tables) + " tablebases (up to " +
+             std::to_string(Tablebases::MaxPieces()) + " pieces)");
+    } else if (name == "syzygyprobedepth") {
+        Tablebases::SetProbeDepth(std::atoi(value.c_str()));
+    } else if (name == "pvs" || name == "nullmove" || name == "lmr" ||
+               name == "aspirationwindows" || name == "futility") {
+        SearchConfig config = m_pool.GetConfig();
+        const bool enabled = (ToLower(value) == "true");
+        if (name == "pvs") {
+            config.pvs = enabled;
+        } else if (name == "nullmove") {
+            config.nullMove = enabled;
+        } else if (name == "lmr") {
+            config.lmr = enabled;
+        } else if (name == "aspirationwindows") {
+            config.aspiration = enabled;
+        } else {
+            config.futility = enabled;
+        }
+        m_pool.SetConfig(config);
+    } else if (name == "usemcts") {
+        m_pool.SetMctsMode(ToLower(value) == "true");
+    } else if (name == "mctshash" || name == "mctstemperature") {
+        m_pool.Wait();
+        MctsOptions options = m_pool.GetMcts().GetOptions();
+        if (name == "mctshash") {
+            options.megabytes = std::min<size_t>(std::max(std::atoi(value.c_str()), 1), MAX_HASH_MB);
+        } else {
+            // Hundredths: 100 = visit-proportional move choice
+            options.temperature = std::max(std::atoi(value.c_str()), 0) / 100.0;
+        }
+        m_pool.GetMcts().SetOptions(options);
+    } else if (name == "clear hash") {
+        m_pool.Wait();
+        m_tt.Clear();
+    } else {
+        Send("info string Unknown option: " + name);
+    }
+}
+
+/**************************************************
+ * @details
+ *      position [startpos | fen <fen>] [moves <m1> ...]
+ *      @param pos is left unchanged on error.
+ *      - @return INVALID_FEN / INVALID_MOVE
+ **************************************************/
+ErrorCode Uci::ParsePosition(std::istringstream &args, Position &pos)
+{
+    std::string token, fen;
+    args >> token;
+    if (token == "startpos") {
+        fen = STANDARD_POSITION_FEN;
+        args >> token;
+    } else if (token == "fen") {
+        while (args >> token && token != "moves") {
+            fen += token + " ";
+        }
+    } else {
+        return INVALID_FEN;
+    }
+
+    Position next;
+    if (next.SetFEN(fen) != SUCCESS) {
+        return INVALID_FEN;
+    }
+    if (token == "moves") {
+        while (args >> token) {
+            PackedMove move = next.ParseUciMove(token);
+            if (move.IsNull()) {
+                return INVALID_MOVE;
+            }
+            next.MakeMove(move);
+        }
+    }
+    pos = next;
+    return SUCCESS;
+}
+
+SearchLimits Uci::ParseGo(std::istringstream &args)
+{
+    SearchLimits limits;
+    const uint8_t white = static_cast<uint8_t>(PieceColor::WHITE);
+    const uint8_t black = static_cast<uint8_t>(PieceColor::BLACK);
+    std::string token;
+    while (args >> token) {
+        if (token == "depth") {
+            args >> limits.depth;
+        } else if (token == "nodes") {
+            args >> limits.nodes;
+        } else if (token == "movetime") {
+            args >> limits.moveTime;
+        } else if (token == "wtime") {
+            args >> limits.time[white];
+        } else if (token == "btime") {
+            args >> limits.time[black];
+        } else if (token == "winc") {
+            args >> limits.inc[white];
+        } else if (token == "binc") {
+            args >> limits.inc[black];
+        } else if (token == "movestogo") {
+            args >> limits.movesToGo;
+        } else if (token == "infinite") {
+            limits.infinite = true;
+        } else if (token == "ponder") {
+            limits.ponder = true;
+        }
+    }
+    limits.depth = std::max(1, std::min(limits.depth, MAX_DEPTH));
+    return limits;
+}
+
+/**************************************************
+ * @details
+ *      Book moves are played without searching,
+ *      except for analysis (infinite) and pondering.
+ **************************************************/
+void Uci::CmdGo(std::istringstream &args)
+{
+    m_lastLimits = ParseGo(args);
+    if (m_ownBook && !m_lastLimits.infinite && !m_lastLimits.ponder) {
+        SearchResult result;
+        result.bestMove = m_book.Probe(m_pos);
+        if (!result.bestMove.IsNull()) {
+            m_pool.Wait();
+            Send("info string Book move");
+            SendBestMove(result);
+            return;
+        }
+    }
+    m_pool.Start(m_pos, m_lastLimits, [this](const SearchResult &result) {
+        SendBestMove(result);
+    });
+}
+
+/**************************************************
+ * @details
+ *      bench [depth]
+ *      Single-threaded alpha-beta with the current
+ *      search switches, independent of the game's
+ *      hash and position.
+ **************************************************/
+void Uci::CmdBench(std::istringstream &args)
+{
+    int depth{ BENCH_DEFAULT_DEPTH };
+    args >> depth;
+    FinishPendingSearch();
+
+    const BenchResult bench = RunBench(depth, m_pool.GetConfig());
+    const auto &fens = GetBenchFens();
+    for (size_t i{ 0 }; i < fens.size(); i++) {
+        Send("info string position " + std::to_string(i + 1) + "/" + std::to_string(fens.size()) +
+             " nodes " + std::to_string(bench.nodes[i]) + " fen " + fens[i]);
+    }
+    Send("Total time (ms) : " + std::to_string(bench.elapsedMs));
+    Send("Nodes searched  : " + std::to_string(bench.totalNodes));
+    Send("Nodes/second    : " + std::to_string(bench.Nps()));
+}
+
+/**************************************************
+ * @details
+ *      Infinite and ponder searches never finish on
+ *      their own; stop them before waiting.
+ **************************************************/
+void Uci::FinishPendingSearch()
+{
+    if (m_lastLimits.infinite || m_lastLimits.ponder) {
+        m_pool.Stop();
+    }
+    m_pool.Wait();
+}
+
+std::string Uci::FormatScore(int score)
+{
+    if (score >= VALUE_MATE_IN_MAX_PLY) {
+        return "mate " + std::to_string((VALUE_MATE - score + 1) / 2);
+    }
+    if (score <= -VALUE_MATE_IN_MAX_PLY) {
+        return "mate " + std::to_string(-(VALUE_MATE + score) / 2);
+    }
+    return "cp " + std::to_string(score);
+}
+
+void Uci::Send(const std::string &line)
+{
+    std::lock_guard<std::mutex> lock(m_outMutex);
+    m_out << line << std::endl;
+}
+
+void Uci::SendInfo(const SearchInfo &info)
+{
+    const uint64_t nodes = m_pool.GetNodes();
+    const int64_t elapsed = std::max<int64_t>(info.elapsedMs, 1);
+    std::ostringstream line;
+    line << "info depth " << info.depth << " seldepth " << info.selDepth
+         << " score " << FormatScore(info.score) << " nodes " << nodes
+         << " nps " << nodes * 1000 / static_cast<uint64_t>(elapsed)
+         << " hashfull " << m_tt.Hashfull() << " time " << info.elapsedMs << " pv";
+    for (const auto &move : info.pv) {
+        line << " " << move.ToUci();
+    }
+    Send(line.str());
+}
+
+void Uci::SendBestMove(const SearchResult &result)
+{
+    std::string line = "bestmove " + (result.bestMove.IsNull() ? "0000" : result.bestMove.ToUci());
+    if (!result.ponderMove.IsNull()) {
+        line += " ponder " + result.ponderMove.ToUci();
+    }
+    Send(line);
+}
+
+} // namespace Shohih
@@ -13,11 +13,12 @@ namespace Shohih {
  *      Game constructor. If game @param mode is online,
  *          a client object is made to get opponent's
  *          moves from the server in address @param addr
+ *          (game room @param room, empty = a new one)
  **************************************************/
-Game::Game(GameMode mode, std::string addr) : m_gameMode(mode)
+Game::Game(GameMode mode, std::string addr, std::string room) : m_gameMode(mode)
 {
     if (m_gameMode == GameMode::ONLINE) {
-        m_client = std::make_shared<Client>(addr);
+        m_client = std::make_shared<Client>(addr, room);
     }
 }
 
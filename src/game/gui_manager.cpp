@@ -82,11 +82,15 @@ void GuiManager::Run()
             // Board texture
             DrawTexture(m_boardTexture, 0, 0, WHITE);
 
-            // Piece textures
-            DrawPieceTextures();
+            {
+                std::lock_guard<std::mutex> lock(m_boardMutex);
 
-            // Handle mouse clicks
-            HandleMouseClicks();
+                // Piece textures
+                DrawPieceTextures();
+
+                // Handle mouse clicks
+                HandleMouseClicks();
+            }
 
             // Draw circles on marked squares
             DrawMarkedSquareCircles();
@@ -97,6 +101,13 @@ void GuiManager::Run()
 
     CloseWindow();
     if (serverHandler != nullptr) {
+        {
+            std::lock_guard<std::mutex> lock(m_syncMutex);
+            m_closing = true;
+        }
+        m_syncCv.notify_one();
+        // Leaving the game also ends a pending long poll
+        m_board->GetClient()->Exit();
         serverHandler->join();
     }
 }
@@ -125,6 +136,13 @@ void GuiManager::HandleMouseClicks()
         m_board->MovePiece(m_lastClickedSquare, sq);
         m_markedSquares.clear();
         m_lastClickedSquare = sq;
+        if (m_board->GetGameMode() == GameMode::ONLINE) {
+            {
+                std::lock_guard<std::mutex> lock(m_syncMutex);
+                m_localMovePending = true;
+            }
+            m_syncCv.notify_one();
+        }
         return;
     }
 
@@ -150,33 +168,102 @@ void GuiManager::HandleMouseClicks()
 
 /**************************************************
  * @details
- *      Constantly checks the server for new moves
- *          and sends clients moves to the server.
+ *      Exchanges moves with the server.
+ *      - First catches up on a game in progress
+ *          (e.g. after rejoining its room).
+ *      - On our turn, sleeps until the player moves.
+ *      - Otherwise, sends our move and long-polls the
+ *          server, which answers as soon as the
+ *          opponent moves (no fixed polling interval)
+ *          with every move we have not seen yet.
+ *      - A move the server did not get (or could not
+ *          record) is sent again after a back-off.
+ *      - If the server rejects our move (our board does
+ *          not know about pins & checks), the board is
+ *          rebuilt from the server's game and it is our
+ *          turn again.
  **************************************************/
-void GuiManager::SyncWithServer() const
+void GuiManager::SyncWithServer()
 {
     auto client = m_board->GetClient();
     if (UNLIKELY(client == nullptr)) {
         ERROR_LOG("Failed to sync with server. Client is nullptr.");
         return;
     }
-    while (!WindowShouldClose()) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(threadSleepTime));
-        // Send player's move to server
-        // (we have made our move and its now opponent's turn)
-        if (m_board->GetClientPieceColor() != m_board->GetPlayerTurn()) {
-            client->SendMove(m_board->GetLastMove());
+    Move sentMove = NULL_MOVE;
+    std::vector<Move> moves;
+    bool catchUp{ true };
+    while (!m_closing) {
+        if (!catchUp) {
+            PieceColor turn{ PieceColor::UNKNOWN };
+            Move ourMove = NULL_MOVE;
+            {
+                std::lock_guard<std::mutex> lock(m_boardMutex);
+                turn = m_board->GetPlayerTurn();
+                ourMove = m_board->GetLastMove();
+            }
+            // Our turn: nothing to exchange until we move
+            if (client->GetPlayerColor() == turn) {
+                std::unique_lock<std::mutex> lock(m_syncMutex);
+                m_syncCv.wait(lock, [this]() { return m_localMovePending || m_closing; });
+                m_localMovePending = false;
+                continue;
+            }
+            // Send player's move to server
+            // (we have made our move and its now opponent's turn)
+            if (ourMove != NULL_MOVE && ourMove != sentMove) {
+                const ErrorCode sendErr = client->SendMove(ourMove);
+                if (UNLIKELY(sendErr == INVALID_MOVE)) {
+                    ERROR_LOG("Server rejected move " << ourMove.first.GetSquareName() << "-"
+                        << ourMove.second.GetSquareName() << " (illegal in the server's game)");
+                    if (UNLIKELY(client->GetAllMoves(moves) != SUCCESS)) {
+                        BackOff();  // sent again (and rejected again)
+                        continue;
+                    }
+                    std::lock_guard<std::mutex> lock(m_boardMutex);
+                    if (UNLIKELY(m_board->ReplayGame(moves) != SUCCESS)) {
+                        ERROR_LOG("Failed to replay the server's game.");
+                    }
+                    sentMove = m_board->GetLastMove();
+                    continue;
+                }
+                if (UNLIKELY(sendErr != SUCCESS)) {
+                    BackOff();  // the server does not have it: sent again
+                    continue;
+                }
+                sentMove = ourMove;
+            }
+        }
+        // Wait for opponent's moves on the server
+        const ErrorCode err = client->GetMoves(moves, catchUp ? 0 : MOVE_POLL_TIMEOUT_MS);
+        catchUp = false;
+        if (UNLIKELY(err != SUCCESS)) {
+            BackOff();
+            continue;
+        }
+        // Update board (replayed moves of ours are not sent again)
+        std::lock_guard<std::mutex> lock(m_boardMutex);
+        for (const Move &move : moves) {
+            m_board->MovePiece(move);
         }
-        // Get opponent's move from server
-        Move opponentMove = client->GetMove();
-        // Update board
-        if (LIKELY(opponentMove != NULL_MOVE) &&
-            opponentMove != m_board->GetLastMove()) {
-            m_board->MovePiece(opponentMove);
+        if (!moves.empty()) {
+            sentMove = m_board->GetLastMove();
         }
     }
 }
 
+/**************************************************
+ * @details
+ *      After a failed request: wait a little before
+ *      the next one (unless the window is closed)
+ **************************************************/
+void GuiManager::BackOff()
+{
+    std::unique_lock<std::mutex> lock(m_syncMutex);
+    m_syncCv.wait_for(lock, std::chrono::milliseconds(threadSleepTime),
+        [this]() { return m_closing.load(); });
+}
+
 /**************************************************
  * @details
  *      Iterate marked squares and draw
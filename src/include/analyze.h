@@ -0,0 +1,121 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Batch position analysis: a streaming
+ *          pipeline of search workers with results
+ *          in input order
+ **************************************************/
+
+#pragma once
+#ifndef ANALYZE_H
+#define ANALYZE_H
+
+#include <thread>
+#include "search.h"
+
+namespace Shohih {
+
+//--------------------------------------------------
+// 32-byte binary position record:
+// bytes 0-7: occupied squares (little endian)
+// bytes 8-23: piece codes, 4 bits each, in square
+//             order (low nibble first, max 32 pieces)
+// byte 24: side to move (bit 0) | castling << 1
+// byte 25: en passant square (64 = none)
+// byte 26: halfmove clock (capped at 255)
+// bytes 27-28: fullmove number (little endian)
+// bytes 29-31: zero
+//--------------------------------------------------
+constexpr size_t PACKED_POSITION_SIZE{ 32 };
+using PackedPosition = std::array<uint8_t, PACKED_POSITION_SIZE>;
+
+// @return INVALID_FEN for more than 32 pieces
+ErrorCode PackPosition(const Position &pos, PackedPosition &packed);
+ErrorCode UnpackPosition(const PackedPosition &packed, Position &pos);
+
+enum class InputFormat : uint8_t {
+    TEXT,       // one FEN or EPD per line ('#' comments)
+    PACKED      // PackedPosition records
+};
+
+//--------------------------------------------------
+// Reads one position at a time, so input files of any
+// size are streamed
+//--------------------------------------------------
+class PositionReader {
+public:
+    PositionReader(std::istream &in, InputFormat format) : m_in(in), m_format(format) {}
+
+    //--------------------------------------------------
+    // Next input record as text (a packed record that
+    // does not unpack gives an empty string). @return
+    // false at the end of the input.
+    //--------------------------------------------------
+    bool Next(std::string &input);
+
+private:
+    std::istream &m_in;
+    const InputFormat m_format;
+};
+
+struct AnalyzeOptions {
+    // Budget per position (0 = off); depth only if no
+    // other limit is set
+    uint64_t nodes{ 1000000 };
+    int64_t timeMs{ 0 };
+    int depth{ 0 };
+
+    size_t threads{ std::max(1u, std::thread::hardware_concurrency()) };
+    size_t hashMb{ 16 };            // per worker
+    size_t window{ 0 };             // reorder buffer (0 = 4 per worker)
+    SearchConfig config{};
+};
+
+struct AnalysisResult {
+    size_t index{ 0 };              // 0-based input record
+    std::string input{};
+    std::string fen{};              // empty = invalid input
+    PackedMove bestMove{};
+    int score{ 0 };                 // side to move's view
+    int depth{ 0 };
+    int selDepth{ 0 };
+    uint64_t nodes{ 0 };
+    int64_t elapsedMs{ 0 };
+    std::vector<PackedMove> pv{};
+
+    bool IsValid() const { return !fen.empty(); }
+};
+
+//--------------------------------------------------
+// One JSON object (no newline), e.g.
+// {"index":0,"fen":"...","bestmove":"e2e4","score":
+// {"cp":31},"depth":12,"seldepth":19,"nodes":1000000,
+// "time":850,"pv":["e2e4","e7e5"]}
+// Mate scores are {"mate":N}; invalid input gives
+// {"index":3,"input":"...","error":"invalid position"}
+//--------------------------------------------------
+std::string FormatJson(const AnalysisResult &result);
+
+struct AnalyzeStats {
+    size_t positions{ 0 };
+    size_t invalid{ 0 };
+    uint64_t nodes{ 0 };
+    int64_t elapsedMs{ 0 };
+
+    double PositionsPerHour() const;
+};
+
+using ResultCallback = std::function<void(const AnalysisResult &)>;
+
+//--------------------------------------------------
+// Analyze every position of @param reader. The input
+// queue and the reorder buffer are bounded, so memory
+// stays flat and reading stalls while the workers or
+// @param onResult fall behind. @param onResult gets
+// the results one at a time, in input order.
+//--------------------------------------------------
+AnalyzeStats AnalyzePositions(PositionReader &reader, const AnalyzeOptions &options,
+    ResultCallback onResult);
+
+} // namespace Shohih
+
+#endif // ANALYZE_H
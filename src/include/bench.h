@@ -0,0 +1,42 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Deterministic search benchmark
+ **************************************************/
+
+#pragma once
+#ifndef BENCH_H
+#define BENCH_H
+
+#include "search.h"
+
+namespace Shohih {
+
+constexpr int BENCH_DEFAULT_DEPTH{ 10 };
+constexpr size_t BENCH_HASH_MB{ 16 };
+
+struct BenchResult {
+    std::vector<uint64_t> nodes{};  // per position
+    uint64_t totalNodes{ 0 };
+    int64_t elapsedMs{ 0 };
+
+    uint64_t Nps() const
+        { return totalNodes * 1000 / static_cast<uint64_t>(std::max<int64_t>(elapsedMs, 1)); }
+};
+
+// Built-in positions (openings, middlegames, endgames)
+const std::vector<std::string> &GetBenchFens();
+
+//--------------------------------------------------
+// Search every bench position to @param depth on one
+// thread, with a cleared hash and history for each
+// position. The total node count is a signature of
+// the search: it only changes when move generation,
+// evaluation or search behave differently (or with
+// @param config, the eval file or tablebases).
+//--------------------------------------------------
+BenchResult RunBench(int depth=BENCH_DEFAULT_DEPTH, const SearchConfig &config=SearchConfig{},
+    size_t megabytes=BENCH_HASH_MB);
+
+} // namespace Shohih
+
+#endif // BENCH_H
@@ -0,0 +1,49 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   King + pawn vs king win/draw bitbase,
+ *          generated at startup by retrograde
+ *          analysis
+ **************************************************/
+
+#pragma once
+#ifndef BITBASE_H
+#define BITBASE_H
+
+#include <thread>
+#include "position.h"
+
+namespace Shohih {
+namespace Kpk {
+
+//--------------------------------------------------
+// Index: [side to move][pawn file a-d][pawn rank 2-7]
+// [weak king][strong king], one bit per position
+// (24 KB)
+//--------------------------------------------------
+constexpr size_t MAX_INDEX{ 2 * 24 * 64 * 64 };
+
+//--------------------------------------------------
+// Build the bitbase, iterating over slices of the
+// positions on @param threads threads. Call before
+// searching; Probe() is valid afterwards.
+//  - @return elapsed milliseconds
+//--------------------------------------------------
+int64_t Init(size_t threads=std::max(1u, std::thread::hardware_concurrency()));
+bool IsReady();
+
+//--------------------------------------------------
+// White has the pawn (on files a-d), @param stm is
+// the side to move. @return true if white wins.
+//--------------------------------------------------
+bool Probe(SquareId whiteKing, SquareId pawn, SquareId blackKing, PieceColor stm);
+
+//--------------------------------------------------
+// Any KPK position, from the side with the pawn's
+// point of view. @return true if that side wins.
+//--------------------------------------------------
+bool Probe(const Position &pos);
+
+} // namespace Kpk
+} // namespace Shohih
+
+#endif // BITBASE_H
@@ -0,0 +1,121 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Bitboard types and attack tables
+ **************************************************/
+
+#pragma once
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <array>
+#include "shohih_defs.h"
+
+namespace Shohih {
+
+//--------------------------------------------------
+// Bitboard: one bit per square
+// Square index = y * 8 + x (a1 = 0, b1 = 1, ..., h8 = 63)
+//--------------------------------------------------
+using Bitboard = uint64_t;
+
+constexpr uint8_t NUM_SQUARES{ 64 };
+constexpr SquareId NO_SQUARE{ 64 };
+
+constexpr Bitboard FILE_A_BB{ 0x0101010101010101ULL };
+constexpr Bitboard FILE_H_BB{ FILE_A_BB << 7 };
+constexpr Bitboard RANK_1_BB{ 0xFFULL };
+constexpr Bitboard RANK_2_BB{ RANK_1_BB << 8 };
+constexpr Bitboard RANK_4_BB{ RANK_1_BB << 24 };
+constexpr Bitboard RANK_5_BB{ RANK_1_BB << 32 };
+constexpr Bitboard RANK_7_BB{ RANK_1_BB << 48 };
+constexpr Bitboard RANK_8_BB{ RANK_1_BB << 56 };
+
+//--------------------------------------------------
+// Square <-> SquareId conversion
+//--------------------------------------------------
+constexpr SquareId ToSquareId(Square sq)
+    { return static_cast<SquareId>(sq.y * BOARD_SIZE + sq.x); }
+constexpr Square ToSquare(SquareId id)
+    { return Square{ static_cast<uint8_t>(id % BOARD_SIZE),
+                     static_cast<uint8_t>(id / BOARD_SIZE) }; }
+constexpr uint8_t FileOf(SquareId id) { return id & 7; }
+constexpr uint8_t RankOf(SquareId id) { return id >> 3; }
+constexpr Bitboard SquareBB(SquareId id) { return 1ULL << id; }
+
+//--------------------------------------------------
+// Bit manipulation
+//--------------------------------------------------
+inline int PopCount(Bitboard b) { return __builtin_popcountll(b); }
+inline SquareId Lsb(Bitboard b) { return static_cast<SquareId>(__builtin_ctzll(b)); }
+inline SquareId Msb(Bitboard b) { return static_cast<SquareId>(63 ^ __builtin_clzll(b)); }
+inline bool MoreThanOne(Bitboard b) { return (b & (b - 1)) != 0; }
+inline SquareId PopLsb(Bitboard &b)
+{
+    SquareId sq = Lsb(b);
+    b &= b - 1;
+    return sq;
+}
+
+//--------------------------------------------------
+// Precomputed attack tables (built once at startup)
+//--------------------------------------------------
+struct AttackTables {
+    AttackTables();
+
+    // Ray directions: N, NE, E, SE, S, SW, W, NW
+    std::array<std::array<Bitboard, NUM_SQUARES>, 8> rays{};
+    std::array<std::array<Bitboard, NUM_SQUARES>, NUM_PIECE_COLORS> pawn{};
+    std::array<Bitboard, NUM_SQUARES> knight{};
+    std::array<Bitboard, NUM_SQUARES> king{};
+    std::array<Bitboard, NUM_SQUARES> bishopEmpty{};
+    std::array<Bitboard, NUM_SQUARES> rookEmpty{};
+
+    // Squares strictly between two aligned squares (0 if not aligned)
+    std::array<std::array<Bitboard, NUM_SQUARES>, NUM_SQUARES> between{};
+    // Full line through two aligned squares (0 if not aligned)
+    std::array<std::array<Bitboard, NUM_SQUARES>, NUM_SQUARES> line{};
+};
+
+extern const AttackTables g_attacks;
+
+//--------------------------------------------------
+// Attack getters
+//--------------------------------------------------
+inline Bitboard PawnAttacks(PieceColor color, SquareId sq)
+    { return g_attacks.pawn[static_cast<uint8_t>(color)][sq]; }
+inline Bitboard KnightAttacks(SquareId sq) { return g_attacks.knight[sq]; }
+inline Bitboard KingAttacks(SquareId sq) { return g_attacks.king[sq]; }
+
+// Sliding attacks on a single ray, stopping at the first blocker
+inline Bitboard RayAttacks(uint8_t dir, SquareId sq, Bitboard occupied)
+{
+    Bitboard attacks = g_attacks.rays[dir][sq];
+    Bitboard blockers = attacks & occupied;
+    if (blockers) {
+        // N, NE, E and NW rays grow towards higher square indices
+        bool positive = (dir < 3) || (dir == 7);
+        attacks ^= g_attacks.rays[dir][positive ? Lsb(blockers) : Msb(blockers)];
+    }
+    return attacks;
+}
+
+inline Bitboard BishopAttacks(SquareId sq, Bitboard occupied)
+{
+    return RayAttacks(1, sq, occupied) | RayAttacks(3, sq, occupied) |
+           RayAttacks(5, sq, occupied) | RayAttacks(7, sq, occupied);
+}
+
+inline Bitboard RookAttacks(SquareId sq, Bitboard occupied)
+{
+    return RayAttacks(0, sq, occupied) | RayAttacks(2, sq, occupied) |
+           RayAttacks(4, sq, occupied) | RayAttacks(6, sq, occupied);
+}
+
+inline Bitboard Between(SquareId a, SquareId b) { return g_attacks.between[a][b]; }
+inline Bitboard Line(SquareId a, SquareId b) { return g_attacks.line[a][b]; }
+inline bool Aligned(SquareId a, SquareId b, SquareId c)
+    { return (Line(a, b) & SquareBB(c)) != 0; }
+
+} // namespace Shohih
+
+#endif // BITBOARD_H
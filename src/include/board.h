@@ -8,6 +8,7 @@
 #define BOARD_H
 
 #include <array>
+#include <vector>
 #include "piece.h"
 #include "client.h"
 
@@ -35,6 +36,13 @@ public:
     ErrorCode MovePiece(Move move);
     ErrorCode MovePiece(Square src, Square dst);
 
+    // Clear the board and set the pieces of @param fen
+    ErrorCode SetPosition(std::string fen);
+
+    // Play @param moves from the standard position (e.g.
+    // the server's game, after it rejected a move of ours)
+    ErrorCode ReplayGame(const std::vector<Move> &moves);
+
     //--------------------------------------------------
     // Getters
     //--------------------------------------------------
@@ -0,0 +1,85 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Polyglot opening book (memory-mapped)
+ *          http://hgm.nubati.net/book_format.html
+ **************************************************/
+
+#pragma once
+#ifndef BOOK_H
+#define BOOK_H
+
+#include "position.h"
+
+namespace Shohih {
+
+//--------------------------------------------------
+// One book record in host byte order (16 bytes
+// big-endian on disk, sorted by key)
+//--------------------------------------------------
+struct BookEntry {
+    uint64_t key{ 0 };
+    uint16_t move{ 0 };     // Polyglot move encoding
+    uint16_t weight{ 0 };
+    uint32_t learn{ 0 };
+};
+
+struct BookMove {
+    PackedMove move{};
+    uint16_t weight{ 0 };
+};
+
+class OpeningBook {
+public:
+    enum class Selection : uint8_t {
+        BEST,       // highest weight
+        WEIGHTED    // random, proportional to weight
+    };
+
+    OpeningBook() = default;
+    ~OpeningBook() { Close(); }
+    OpeningBook(const OpeningBook &) = delete;
+    OpeningBook &operator=(const OpeningBook &) = delete;
+
+    //--------------------------------------------------
+    // Map a .bin file read-only; pages are loaded by
+    // the OS on first access and shared between
+    // processes using the same book.
+    //--------------------------------------------------
+    ErrorCode Open(const std::string &path);
+    void Close();
+    bool IsOpen() const { return m_data != nullptr; }
+    size_t Size() const { return m_numEntries; }
+
+    //--------------------------------------------------
+    // Legal book moves for @param pos, best first
+    //--------------------------------------------------
+    std::vector<BookMove> GetMoves(const Position &pos) const;
+
+    //--------------------------------------------------
+    // Pick a book move, or a null move when the
+    // position is not in the book. Thread-safe.
+    //--------------------------------------------------
+    PackedMove Probe(const Position &pos, Selection selection=Selection::WEIGHTED) const;
+
+    //--------------------------------------------------
+    // Polyglot key, move encoding & file writing
+    // (shared with the book builder)
+    //--------------------------------------------------
+    static uint64_t PolyglotKey(const Position &pos);
+    static uint16_t EncodeMove(PackedMove move);
+    static PackedMove DecodeMove(const Position &pos, uint16_t raw);
+    static ErrorCode Write(const std::string &path, std::vector<BookEntry> entries);
+    static void WriteEntry(std::ostream &file, const BookEntry &entry);
+
+private:
+    BookEntry EntryAt(size_t index) const;
+    size_t LowerBound(uint64_t key) const;
+
+    const uint8_t *m_data{ nullptr };
+    size_t m_mapSize{ 0 };
+    size_t m_numEntries{ 0 };
+};
+
+} // namespace Shohih
+
+#endif // BOOK_H
@@ -0,0 +1,116 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Opening book builder: aggregates move
+ *          statistics from PGN games into a
+ *          Polyglot .bin file
+ **************************************************/
+
+#pragma once
+#ifndef BOOK_BUILDER_H
+#define BOOK_BUILDER_H
+
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <thread>
+#include "pgn.h"
+#include "book.h"
+
+namespace Shohih {
+
+class BookBuilder {
+public:
+    struct Options {
+        size_t threads{ std::max(1u, std::thread::hardware_concurrency()) };
+        int maxPly{ 30 };                       // positions per game
+        uint32_t minGames{ 1 };                 // per (position, move)
+        size_t maxEntries{ 4 * 1024 * 1024 };   // in memory before spilling a run
+        std::string tempDir{ "." };
+    };
+
+    explicit BookBuilder(const Options &options);
+    ~BookBuilder();     // removes spilled runs
+    BookBuilder(const BookBuilder &) = delete;
+    BookBuilder &operator=(const BookBuilder &) = delete;
+
+    //--------------------------------------------------
+    // Stream games through the worker threads. Games
+    // with unknown results or illegal moves are skipped.
+    //--------------------------------------------------
+    ErrorCode AddPgn(std::istream &in);
+    ErrorCode AddPgnFile(const std::string &path);
+
+    //--------------------------------------------------
+    // Merge the spilled runs with what is in memory and
+    // write the book. Weight = 2 * wins + draws for the
+    // side to move, scaled per position to 16 bits.
+    //--------------------------------------------------
+    ErrorCode Write(const std::string &path);
+
+    uint64_t GetGames() const { return m_games.load(); }
+    uint64_t GetSkippedGames() const { return m_skipped.load(); }
+    uint64_t GetPositions() const { return m_positions.load(); }
+    uint64_t GetBookEntries() const { return m_bookEntries; }
+    size_t GetRuns() const { return m_runFiles.size(); }
+
+private:
+    //--------------------------------------------------
+    // Statistics of one move in one position
+    //--------------------------------------------------
+    struct MoveKey {
+        uint64_t key;
+        uint16_t move;
+        bool operator==(const MoveKey &other) const
+            { return key == other.key && move == other.move; }
+        bool operator<(const MoveKey &other) const
+            { return key != other.key ? key < other.key : move < other.move; }
+    };
+    struct MoveKeyHash {
+        size_t operator()(const MoveKey &k) const
+            { return static_cast<size_t>(k.key ^ (static_cast<uint64_t>(k.move) * 0x9E3779B97F4A7C15ULL)); }
+    };
+    struct MoveStats {
+        uint32_t wins{ 0 };
+        uint32_t draws{ 0 };
+        uint32_t losses{ 0 };
+    };
+    struct Record {
+        MoveKey key;
+        MoveStats stats;
+    };
+
+    //--------------------------------------------------
+    // Sharded map: a (position, move) always lands in the
+    // same shard, so shards can be locked independently
+    //--------------------------------------------------
+    static constexpr size_t NUM_SHARDS{ 64 };
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<MoveKey, MoveStats, MoveKeyHash> map;
+    };
+
+    void ProcessGame(const PgnGame &game, Position &pos);
+    void Insert(const MoveKey &key, int score);
+    std::vector<Record> DrainShards();
+    ErrorCode SpillRun();
+
+    Options m_options;
+    std::array<Shard, NUM_SHARDS> m_shards{};
+    std::atomic<size_t> m_entries{ 0 };
+
+    // Sorted runs on disk
+    std::mutex m_spillMutex{};
+    std::vector<std::string> m_runFiles{};
+    std::atomic<bool> m_spillFailed{ false };
+
+    std::atomic<uint64_t> m_games{ 0 };
+    std::atomic<uint64_t> m_skipped{ 0 };
+    std::atomic<uint64_t> m_positions{ 0 };
+    uint64_t m_bookEntries{ 0 };
+};
+
+} // namespace Shohih
+
+#endif // BOOK_BUILDER_H
@@ -0,0 +1,80 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Blocking multi-producer/multi-consumer
+ *          queue with a fixed capacity (backpressure)
+ **************************************************/
+
+#pragma once
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+namespace Shohih {
+
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : m_capacity(capacity > 0 ? capacity : 1) {}
+
+    //--------------------------------------------------
+    // Block while full. @return false once closed.
+    //--------------------------------------------------
+    bool Push(T item)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [this]() { return m_closed || m_items.size() < m_capacity; });
+        if (m_closed) {
+            return false;
+        }
+        m_items.push_back(std::move(item));
+        lock.unlock();
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    //--------------------------------------------------
+    // Block while empty. @return false once closed and
+    // drained.
+    //--------------------------------------------------
+    bool Pop(T &item)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notEmpty.wait(lock, [this]() { return m_closed || !m_items.empty(); });
+        if (m_items.empty()) {
+            return false;
+        }
+        item = std::move(m_items.front());
+        m_items.pop_front();
+        lock.unlock();
+        m_notFull.notify_one();
+        return true;
+    }
+
+    //--------------------------------------------------
+    // No more pushes; consumers drain what is left
+    //--------------------------------------------------
+    void Close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+        m_notFull.notify_all();
+        m_notEmpty.notify_all();
+    }
+
+private:
+    const size_t m_capacity;
+    std::deque<T> m_items{};
+    bool m_closed{ false };
+    std::mutex m_mutex{};
+    std::condition_variable m_notFull{};
+    std::condition_variable m_notEmpty{};
+};
+
+} // namespace Shohih
+
+#endif // BOUNDED_QUEUE_H
@@ -7,28 +7,74 @@
 #ifndef CLIENT_H
 #define CLIENT_H
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include "httplib.h"
 #include "shohih_defs.h"
+#include "websocket.h"
 
 namespace Shohih {
 
+// Longest time the server holds a /getmove request
+constexpr int64_t MOVE_POLL_TIMEOUT_MS{ 25000 };
+
+// Longest wait for the server to acknowledge a pushed move
+constexpr int64_t WS_ACK_TIMEOUT_MS{ 5000 };
+
+// HTTP status of a move the server found illegal
+constexpr int STATUS_REJECTED_MOVE{ 422 };
+
+// HTTP status of a move the server could not record
+// for now (its journal failed): send it again later
+constexpr int STATUS_RETRY_MOVE{ 503 };
+
 class Client : public httplib::Client {
 public:
-    Client(const std::string &addr);
-    ~Client() = default;
+    //--------------------------------------------------
+    // Join @param room on the server (empty = open a
+    // new room; share GetRoom() with the opponent).
+    // Moves are pushed over a WebSocket when the server
+    // offers one, HTTP is used otherwise.
+    //--------------------------------------------------
+    Client(const std::string &addr, const std::string &room="");
+    ~Client();
+
+    //--------------------------------------------------
+    // Get the last move from the server. With @param
+    // waitMs, the server holds the request until a move
+    // newer than the last one seen arrives (long poll).
+    //--------------------------------------------------
+    Move GetMove(int64_t waitMs=0);
+
+    //--------------------------------------------------
+    // Every move of the game newer than the last one
+    // seen, in order (all of them after joining a game
+    // in progress). Waits like GetMove() if none.
+    // @return CONNECTION_FAILED | INVALID_SESSION
+    //--------------------------------------------------
+    ErrorCode GetMoves(std::vector<Move> &moves, int64_t waitMs=0);
 
     //--------------------------------------------------
-    // Get the last move from the server
+    // Every move of the game from the first one (e.g.
+    // to rebuild the board). Does not wait.
+    // @return CONNECTION_FAILED | INVALID_SESSION
     //--------------------------------------------------
-    Move GetMove();
+    ErrorCode GetAllMoves(std::vector<Move> &moves);
 
     //--------------------------------------------------
     // Send the last move to the server
+    // @return INVALID_MOVE if the server rejected it |
+    // FILE_OPEN_ERROR if it could not record it (send
+    // it again later) | CONNECTION_FAILED if it did
+    // not get it
     //--------------------------------------------------
-    void SendMove(const Move &move);
+    ErrorCode SendMove(const Move &move);
 
     //--------------------------------------------------
-    // Leave the server
+    // Leave the server (once; safe while another thread
+    // waits in GetMove(), which then returns)
     //--------------------------------------------------
     void Exit();
 
@@ -37,10 +83,45 @@ public:
     //--------------------------------------------------
     PieceColor GetPlayerColor() const { return m_playerColor; }
 
+    //--------------------------------------------------
+    // Room joined on the server
+    //--------------------------------------------------
+    const std::string &GetRoom() const { return m_room; }
+
+    //--------------------------------------------------
+    // Whether moves travel over the push connection
+    //--------------------------------------------------
+    bool UsesWebSocket() const { return m_ws != nullptr; }
+
 private:
+    void ConnectWebSocket();
+    void ReadPushes();
+    ErrorCode FetchMoves(uint64_t since, int64_t waitMs, std::vector<Move> &moves);
+
     std::string m_addr;
+    std::string m_room;
+    std::string m_token;    // session token sent with every request
     PieceColor m_playerColor;
     Move m_lastMove = NULL_MOVE;
+
+    // Sequence number of the last move seen on the server
+    uint64_t m_lastSeq{ 0 };
+    std::atomic<bool> m_exited{ false };
+
+    //--------------------------------------------------
+    // WebSocket push connection (nullptr: HTTP only)
+    // and the state its reader thread keeps up to date
+    //--------------------------------------------------
+    std::shared_ptr<WsConnection> m_ws{ nullptr };
+    std::thread m_wsReader{};
+    std::mutex m_wsMutex{};
+    std::condition_variable m_wsCv{};
+    Move m_gameMove = NULL_MOVE;    // newest move of the game
+    uint64_t m_gameSeq{ 0 };
+    uint64_t m_wsAcks{ 0 };         // acks (or failures) received
+    uint64_t m_wsAckSeq{ 0 };       // sequence number of the last ack
+    ErrorCode m_wsAckError{ SUCCESS };  // or why the move failed
+    bool m_wsClosed{ false };
 };
 
 } // namespace Shohih
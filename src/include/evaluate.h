@@ -0,0 +1,46 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Static evaluation
+ **************************************************/
+
+#pragma once
+#ifndef EVALUATE_H
+#define EVALUATE_H
+
+#include "pawn_hash.h"
+
+namespace Shohih {
+
+//--------------------------------------------------
+// Static evaluation from the side to move's view:
+// NNUE when a network is enabled, classical else.
+// KPK endings use the bitbase once it is generated.
+// @param pawns caches the classical pawn terms.
+//--------------------------------------------------
+int Evaluate(const Position &pos, PawnHashTable *pawns=nullptr);
+
+//--------------------------------------------------
+// Tapered material + piece-square + pawn structure
+// evaluation. The piece-square terms are maintained
+// by Position during make/unmake; the pawn terms are
+// recomputed, or looked up in @param pawns.
+//--------------------------------------------------
+int EvaluateClassical(const Position &pos);
+int EvaluateClassical(const Position &pos, PawnHashTable &pawns);
+
+//--------------------------------------------------
+// Forward pass of the loaded network over the
+// position's accumulator
+//--------------------------------------------------
+int EvaluateNnue(const Position &pos);
+
+//--------------------------------------------------
+// Recompute the piece-square terms by scanning the
+// board (debugging & tests)
+//--------------------------------------------------
+EvalScore ComputePsqScore(const Position &pos);
+int ComputePhase(const Position &pos);
+
+} // namespace Shohih
+
+#endif // EVALUATE_H
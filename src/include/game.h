@@ -14,7 +14,7 @@ namespace Shohih {
 
 class Game {
 public:
-    Game(GameMode mode=GameMode::OFFLINE, std::string addr="");
+    Game(GameMode mode=GameMode::OFFLINE, std::string addr="", std::string room="");
     ~Game();
 
     //--------------------------------------------------
@@ -0,0 +1,184 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Write-ahead journal of the server's games:
+ *          per-shard append-only segments with group
+ *          commit, compact snapshots & mmap replay
+ **************************************************/
+
+#pragma once
+#ifndef GAME_JOURNAL_H
+#define GAME_JOURNAL_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "shohih_defs.h"
+
+namespace Shohih {
+
+class GameRegistry;
+
+// Journal files per directory (a game always lives in one)
+constexpr size_t JOURNAL_SHARDS{ 16 };
+
+constexpr std::chrono::milliseconds JOURNAL_SYNC_INTERVAL{ 10 };
+constexpr std::chrono::seconds JOURNAL_SNAPSHOT_INTERVAL{ 300 };
+
+struct JournalOptions {
+    std::string dir{};
+
+    // Records are written & fsynced together every
+    // interval (a crash may lose the last interval;
+    // failed writes are retried). 0 = callers wait
+    // until their record is on disk, and a change is
+    // only published once it is (a failed write drops
+    // the batch & its changes are refused); concurrent
+    // records still share one fsync.
+    std::chrono::milliseconds syncInterval{ JOURNAL_SYNC_INTERVAL };
+
+    // Compact the journal into snapshots this often
+    // (0 = only when Snapshot() is called)
+    std::chrono::seconds snapshotInterval{ JOURNAL_SNAPSHOT_INTERVAL };
+};
+
+//--------------------------------------------------
+// Position of a record; pass it to WaitDurable()
+//--------------------------------------------------
+struct JournalTicket {
+    size_t shard{ 0 };
+    uint64_t lsn{ 0 };
+};
+
+struct RecoveryStats {
+    size_t games{ 0 };
+    size_t moves{ 0 };
+    size_t records{ 0 };    // journal records replayed after the snapshots
+    double seconds{ 0.0 };
+};
+
+class GameJournal {
+public:
+    explicit GameJournal(const JournalOptions &options);
+    ~GameJournal();
+    GameJournal(const GameJournal&) = delete;
+    GameJournal &operator=(const GameJournal&) = delete;
+
+    //--------------------------------------------------
+    // Rebuild the games of the journal directory in
+    // @param registry (one thread per shard), then
+    // journal its changes until Close(). Call before
+    // serving requests.
+    // @return FILE_OPEN_ERROR | INVALID_FILE_FORMAT
+    //--------------------------------------------------
+    ErrorCode Open(GameRegistry &registry, RecoveryStats &stats);
+
+    //--------------------------------------------------
+    // Sync every record and stop the background threads
+    //--------------------------------------------------
+    void Close();
+
+    //--------------------------------------------------
+    // Append a record (called with the game's lock
+    // held, so records of a game keep their order).
+    // Never waits for I/O.
+    //--------------------------------------------------
+    JournalTicket LogJoin(const std::string &room, PieceColor color, const std::string &token);
+    JournalTicket LogLeave(const std::string &room, PieceColor color);
+    JournalTicket LogMove(const std::string &room, const Move &move);
+
+    //--------------------------------------------------
+    // With a 0 sync interval, block until the record
+    // of @param ticket is on disk (no-op otherwise).
+    // Call once per ticket. @return FILE_OPEN_ERROR if
+    // the record could not be written (the caller
+    // undoes its change)
+    //--------------------------------------------------
+    ErrorCode WaitDurable(const JournalTicket &ticket);
+
+    //--------------------------------------------------
+    // Write & fsync all pending records now
+    //--------------------------------------------------
+    void Sync();
+
+    //--------------------------------------------------
+    // Records appended but not yet on disk
+    //--------------------------------------------------
+    uint64_t NumPendingRecords();
+
+    //--------------------------------------------------
+    // Fold every shard's segments into its snapshot
+    // and delete them
+    //--------------------------------------------------
+    ErrorCode Snapshot();
+
+private:
+    // Records of a failed write in synchronous mode,
+    // kept until each of their writers has seen it
+    struct FailedBatch {
+        uint64_t first{ 0 };
+        uint64_t last{ 0 };
+        uint64_t waiters{ 0 };
+    };
+
+    struct Shard {
+        std::mutex mutex{};             // guards <pending>, <appended> & <failed>
+        std::string pending{};          // records not written yet
+        uint64_t appended{ 0 };         // LSN of the last appended record
+        std::vector<FailedBatch> failed{};
+
+        // Last LSN written, or dropped by a failed write
+        // in synchronous mode (then also in <failed>)
+        std::atomic<uint64_t> durable{ 0 };
+
+        std::mutex ioMutex{};           // guards the fields below
+        std::string writing{};          // batch being written (keeps its capacity)
+        bool failing{ false };          // the last write failed
+        int fd{ -1 };                   // -1 = open a new segment on the next write
+        uint64_t segment{ 0 };          // number of the open segment
+        size_t segmentBytes{ 0 };       // bytes written to it
+        uint64_t snapshotSegment{ 0 };  // segments <= this are in the snapshot
+    };
+
+    JournalTicket Append(const std::string &room, const std::string &payload);
+
+    //--------------------------------------------------
+    // Write & fsync the shard's pending records
+    // (FlushLocked: with <ioMutex> held)
+    //--------------------------------------------------
+    void FlushShard(Shard &shard);
+    void FlushLocked(Shard &shard);
+
+    ErrorCode OpenSegment(size_t index, bool logErrors=true);
+    ErrorCode RecoverShard(size_t index, GameRegistry &registry, RecoveryStats &stats);
+    ErrorCode CompactShard(size_t index);
+    void FlushLoop();
+    void SnapshotLoop();
+
+    std::string SegmentPath(size_t index, uint64_t segment) const;
+    std::string SnapshotPath(size_t index) const;
+
+    const JournalOptions m_options;
+    std::array<Shard, JOURNAL_SHARDS> m_shards{};
+    GameRegistry *m_registry{ nullptr };
+
+    // Guards <m_dirty>; wakes the background threads
+    // and the writers waiting for durability
+    std::mutex m_mutex{};
+    std::condition_variable m_flushCv{};
+    std::condition_variable m_stopCv{};
+    std::condition_variable m_durableCv{};
+    bool m_dirty{ false };
+    std::atomic<bool> m_running{ false };
+    std::thread m_flushThread{};
+    std::thread m_snapshotThread{};
+    std::mutex m_snapshotMutex{};       // one compaction at a time
+};
+
+} // namespace Shohih
+
+#endif // GAME_JOURNAL_H
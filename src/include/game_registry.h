@@ -0,0 +1,279 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Online games hosted by the server: rooms,
+ *          seats & session tokens in a sharded map
+ **************************************************/
+
+#pragma once
+#ifndef GAME_REGISTRY_H
+#define GAME_REGISTRY_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "shohih_defs.h"
+#include "position.h"
+#include "game_journal.h"
+
+namespace Shohih {
+
+// Longest room ID a client may choose
+constexpr size_t MAX_ROOM_ID_LENGTH{ 64 };
+
+// Longest time a /getmove request is held open
+constexpr std::chrono::milliseconds MAX_MOVE_WAIT{ 30000 };
+
+// Plies of history reserved per game (longer games
+// grow it once in a while)
+constexpr size_t GAME_HISTORY_PLIES{ 160 };
+
+// Seat without a session slot (see GameRegistry)
+constexpr uint32_t NO_SESSION_SLOT{ UINT32_MAX };
+
+//--------------------------------------------------
+// One game. Writers are serialized by its mutex;
+// the last move is published in one atomic word so
+// readers never lock.
+//--------------------------------------------------
+struct OnlineGame {
+    explicit OnlineGame(const std::string &id) : room(id) { moves.reserve(GAME_HISTORY_PLIES); }
+
+    const std::string room;
+    std::mutex mutex{};
+
+    //--------------------------------------------------
+    // Published state: sequence number (bumped on every
+    // change of the last move) << 16 | packed last move
+    // (0 = none, else 1 << 12 | from << 6 | to).
+    // Stored with <mutex> held; waiting requests are
+    // woken through <moved>.
+    //--------------------------------------------------
+    std::atomic<uint64_t> state{ 0 };
+    std::condition_variable moved{};
+
+    static uint64_t PackState(uint64_t seq, const Move &move)
+    {
+        const uint64_t packed = (move == NULL_MOVE) ? 0 :
+            (1u << 12) | (ToSquareId(move.first) << 6) | ToSquareId(move.second);
+        return (seq << 16) | packed;
+    }
+    static uint64_t SeqOf(uint64_t packedState) { return packedState >> 16; }
+    static Move MoveOf(uint64_t packedState)
+    {
+        if ((packedState & 0xFFFF) == 0) {
+            return NULL_MOVE;
+        }
+        return Move{ ToSquare(static_cast<SquareId>((packedState >> 6) & 0x3F)),
+                     ToSquare(static_cast<SquareId>(packedState & 0x3F)) };
+    }
+
+    // Authoritative board: every move is validated
+    // against it before it is stored (under <mutex>)
+    Position position{ GAME_HISTORY_PLIES };
+
+    // Every move of the game; move <seq> is moves[seq - 1]
+    // (under <mutex>)
+    std::vector<Move> moves{};
+
+    // Session token per seat (empty = seat free)
+    std::array<std::string, NUM_PIECE_COLORS> tokens{};
+
+    // Session slot per seat, given a copy of <state>
+    // whenever it is stored (under <mutex>)
+    std::array<uint32_t, NUM_PIECE_COLORS> slots{ { NO_SESSION_SLOT, NO_SESSION_SLOT } };
+};
+
+//--------------------------------------------------
+// Legal move of @param pos played by a network move
+// (pawns promote to a queen), or a null move
+//--------------------------------------------------
+PackedMove FindLegalMove(const Position &pos, const Move &move);
+
+//--------------------------------------------------
+// A player: the game and the seat of a token
+//--------------------------------------------------
+struct Session {
+    std::shared_ptr<OnlineGame> game{ nullptr };
+    PieceColor color{ PieceColor::WHITE };
+};
+
+class GameRegistry {
+public:
+    // Receives every stored move with the opponent's token
+    using MoveListener = std::function<void(const std::string &token, const Move &move, uint64_t seq)>;
+
+    // Independent locks: requests for games in other
+    // shards never wait for each other
+    static constexpr size_t NUM_SHARDS{ 64 };
+
+    GameRegistry() = default;
+    ~GameRegistry() = default;
+
+    //--------------------------------------------------
+    // Take a seat in @param room (created on first use;
+    // empty = a new room with a generated ID, returned
+    // in @param room). White is seated first.
+    // @return ROOM_FULL | INVALID_ROOM | FILE_OPEN_ERROR
+    // when the journal cannot record it (not seated)
+    //--------------------------------------------------
+    ErrorCode Join(std::string &room, std::string &token, PieceColor &color);
+
+    //--------------------------------------------------
+    // Free the seat of @param token. The game goes on
+    // (a player may take the seat again and catch up);
+    // it is dropped once both seats are free.
+    // @return INVALID_SESSION for an unknown token |
+    // FILE_OPEN_ERROR when the journal cannot record it
+    // (still seated)
+    //--------------------------------------------------
+    ErrorCode Leave(const std::string &token);
+
+    //--------------------------------------------------
+    // @return false for an unknown token
+    //--------------------------------------------------
+    bool FindSession(const std::string &token, Session &session) const;
+
+    //--------------------------------------------------
+    // Last move of the token's game and its sequence
+    // number. Wait-free for tokens with a session slot
+    // (no lock, no reference count).
+    // @return INVALID_SESSION for an unknown token
+    //--------------------------------------------------
+    ErrorCode GetLastMove(const std::string &token, Move &move, uint64_t &seq) const;
+
+    //--------------------------------------------------
+    // Play @param move in the token's game (pawns
+    // promote to a queen). @return INVALID_SESSION |
+    // INVALID_MOVE when it is not the player's turn or
+    // the move is illegal | FILE_OPEN_ERROR when the
+    // journal cannot record it (nothing is stored)
+    //--------------------------------------------------
+    ErrorCode SetLastMove(const std::string &token, const Move &move, uint64_t &seq);
+
+    //--------------------------------------------------
+    // Block until the game's sequence number passes
+    // @param since (or @param timeout expires, then
+    // @param seq == @param since). Leaving the game
+    // ends the player's own waiting requests.
+    //--------------------------------------------------
+    ErrorCode WaitForMove(const std::string &token, uint64_t since, std::chrono::milliseconds timeout,
+        Move &move, uint64_t &seq) const;
+
+    //--------------------------------------------------
+    // All moves after sequence number @param since,
+    // waiting like WaitForMove() while there are none.
+    // @param seq = number of moves in the game
+    //--------------------------------------------------
+    ErrorCode WaitForMoves(const std::string &token, uint64_t since, std::chrono::milliseconds timeout,
+        std::vector<Move> &moves, uint64_t &seq) const;
+
+    //--------------------------------------------------
+    // Called after each move without any lock held
+    // (set before serving requests)
+    //--------------------------------------------------
+    void SetMoveListener(MoveListener listener) { m_moveListener = std::move(listener); }
+
+    //--------------------------------------------------
+    // Record seats & moves in @param journal (nullptr =
+    // stop); set by GameJournal::Open() & Close()
+    //--------------------------------------------------
+    void SetJournal(GameJournal *journal) { m_journal = journal; }
+
+    //--------------------------------------------------
+    // Put back a game read from the journal: its seats
+    // and moves (replayed on its board, not journaled).
+    // @return INVALID_ROOM | INVALID_MOVE (the moves
+    // before the illegal one are kept)
+    //--------------------------------------------------
+    ErrorCode RestoreGame(const std::string &room, const std::array<std::string, NUM_PIECE_COLORS> &tokens,
+        const std::vector<Move> &moves);
+
+    size_t NumGames() const;
+    size_t NumSessions() const;
+
+    static bool IsValidRoomId(const std::string &room);
+
+private:
+    struct Shard {
+        mutable std::mutex mutex{};
+        std::unordered_map<std::string, std::shared_ptr<OnlineGame>> games{};     // by room
+        std::unordered_map<std::string, Session> sessions{};                     // by token
+    };
+
+    //--------------------------------------------------
+    // Session slots let GetLastMove() find a session
+    // without locking. A token starts with the index of
+    // its slot; the slot holds the rest of the token
+    // and a copy of the game's state. Slots are never
+    // freed, so a reader may always look at one; the
+    // version (odd while the slot is rewritten) tells
+    // it the slot changed hands meanwhile.
+    //--------------------------------------------------
+    struct SessionSlot {
+        std::atomic<uint32_t> version{ 0 };
+        std::atomic<bool> used{ false };
+        std::atomic<uint32_t> keyHigh{ 0 };
+        std::atomic<uint64_t> keyLow{ 0 };
+        std::atomic<uint64_t> state{ 0 };
+    };
+    static constexpr uint32_t SLOT_BLOCK_SIZE{ 4096 };
+    static constexpr uint32_t MAX_SLOT_BLOCKS{ 1024 };
+
+    //--------------------------------------------------
+    // Clear the seat of @param session, dropping the
+    // game once both seats are free
+    //--------------------------------------------------
+    void FreeSeat(const Session &session);
+
+    //--------------------------------------------------
+    // Wait on the game's lock until it moves past
+    // @param since or @param token's seat is freed
+    //--------------------------------------------------
+    static void WaitLocked(const Session &session, const std::string &token, uint64_t since,
+        std::chrono::milliseconds timeout, std::unique_lock<std::mutex> &lock);
+
+    Shard &ShardOf(const std::string &key);
+    const Shard &ShardOf(const std::string &key) const;
+
+    //--------------------------------------------------
+    // Session slots: take a free one (NO_SESSION_SLOT
+    // when all are taken), take @param index (restored
+    // tokens; @return false if taken), give one back
+    //--------------------------------------------------
+    uint32_t AllocateSlot();
+    bool ClaimSlot(uint32_t index);
+    void ReleaseSlot(uint32_t index);
+    void AddSlotsUpTo(uint32_t index);
+    SessionSlot *SlotAt(uint32_t index) const;
+
+    //--------------------------------------------------
+    // Point the slot of @param token at @param state
+    // (empty token = clear it). Under the game's lock.
+    //--------------------------------------------------
+    void WriteSlot(uint32_t index, const std::string &token, uint64_t state);
+
+    std::array<Shard, NUM_SHARDS> m_shards{};
+    MoveListener m_moveListener{};
+    GameJournal *m_journal{ nullptr };
+
+    // Blocks of slots, published once and never freed
+    // while the registry lives (readers load them)
+    std::array<std::atomic<SessionSlot*>, MAX_SLOT_BLOCKS> m_slotBlocks{};
+
+    // Slot bookkeeping; guarded by m_slotMutex
+    std::mutex m_slotMutex{};
+    std::vector<std::unique_ptr<SessionSlot[]>> m_slotStorage{};
+    std::vector<bool> m_slotUsed{};
+    std::vector<uint32_t> m_freeSlots{};        // may hold used slots (skipped)
+    uint32_t m_nextSlot{ 0 };
+};
+
+} // namespace Shohih
+
+#endif // GAME_REGISTRY_H
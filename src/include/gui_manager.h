@@ -8,6 +8,9 @@
 #define GUI_MGR_H
 
 #include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include "board.h"
 #include "raylib.h"
 
@@ -41,12 +44,26 @@ private:
     //--------------------------------------------------
     // Online mode
     //--------------------------------------------------
-    void SyncWithServer() const;
+    void SyncWithServer();
+    void BackOff();
 
     //--------------------------------------------------
-    // Pointer to Shohih board handler
+    // Wakes the sync thread after a local move or when
+    // the window is closed
+    //--------------------------------------------------
+    std::mutex m_syncMutex{};
+    std::condition_variable m_syncCv{};
+    bool m_localMovePending{ false };
+    std::atomic<bool> m_closing{ false };
+
+    //--------------------------------------------------
+    // Pointer to Shohih board handler. In online mode
+    // the sync thread updates it too: both threads use
+    // it with <m_boardMutex> held (taken before
+    // <m_syncMutex>, never while waiting for the server)
     //--------------------------------------------------
     std::shared_ptr<Board> m_board{ nullptr };
+    std::mutex m_boardMutex{};
 
     //--------------------------------------------------
     // Board texture
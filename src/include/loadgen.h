@@ -0,0 +1,109 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Load generator: simulated players (headless
+ *          bots) against a Shohih server, with request
+ *          throughput & move latency histograms
+ **************************************************/
+
+#pragma once
+#ifndef LOADGEN_H
+#define LOADGEN_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include "shohih_defs.h"
+#include "websocket.h"
+
+namespace Shohih {
+
+//--------------------------------------------------
+// Log-linear histogram of latencies in microseconds:
+// 16 buckets per power of two (values within 6.25%),
+// up to 2^LATENCY_MAX_BITS us. One writer; merge the
+// histograms of several threads for the totals.
+//--------------------------------------------------
+class LatencyHistogram {
+public:
+    static constexpr size_t SUB_BUCKET_BITS{ 4 };
+    static constexpr size_t LATENCY_MAX_BITS{ 40 };
+    static constexpr size_t NUM_BUCKETS{ (LATENCY_MAX_BITS - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS };
+
+    void Record(uint64_t micros);
+    void Record(std::chrono::steady_clock::duration latency);
+    void Merge(const LatencyHistogram &other);
+
+    uint64_t Count() const { return m_count; }
+    uint64_t Max() const { return m_max; }
+    double Mean() const;
+
+    //--------------------------------------------------
+    // Smallest bucket bound with at least @param q of
+    // the values at or below it (0 < q <= 1)
+    //--------------------------------------------------
+    uint64_t Percentile(double q) const;
+
+private:
+    static size_t BucketOf(uint64_t micros);
+    static uint64_t UpperBoundOf(size_t bucket);
+
+    std::array<uint64_t, NUM_BUCKETS> m_counts{};
+    uint64_t m_count{ 0 };
+    uint64_t m_sum{ 0 };
+    uint64_t m_max{ 0 };
+};
+
+struct LoadgenOptions {
+    std::string host{ "localhost" };
+    int port{ 8080 };
+    int wsPort{ WEBSOCKET_PORT };
+    bool webSocket{ true };         // false = HTTP long polling only
+
+    size_t players{ 1000 };         // rounded up to pairs
+    double rate{ 1.0 };             // moves per second per player (0 = no pause)
+    std::chrono::seconds duration{ 30 };
+    int maxPlies{ 120 };            // then the pair starts a new game
+
+    // Engine moves with this many nodes each (0 =
+    // random legal moves), searched by a shared pool
+    uint64_t engineNodes{ 0 };
+    size_t engineThreads{ std::max(1u, std::thread::hardware_concurrency()) };
+};
+
+//--------------------------------------------------
+// Running totals of all players
+//--------------------------------------------------
+struct LoadCounters {
+    uint64_t requests{ 0 };     // HTTP requests & WebSocket messages sent
+    uint64_t moves{ 0 };        // moves delivered to the opponent
+    uint64_t rejected{ 0 };     // moves the server refused
+    uint64_t errors{ 0 };       // failed requests & lost connections
+    uint64_t games{ 0 };        // games played to the end
+    size_t players{ 0 };        // players seated in a game
+};
+
+struct LoadReport {
+    LoadCounters totals{};
+    double seconds{ 0.0 };
+
+    // Mover sends a move => the opponent has it
+    LatencyHistogram delivery{};
+
+    // Mover sends a move => the server acknowledges it
+    LatencyHistogram roundTrip{};
+};
+
+using LoadProgress = std::function<void(double seconds, const LoadCounters &totals)>;
+
+//--------------------------------------------------
+// Play pairs of bots against the server at host:port
+// for the duration (one thread per player). @param
+// onProgress is called about once a second.
+//--------------------------------------------------
+LoadReport RunLoad(const LoadgenOptions &options, LoadProgress onProgress=LoadProgress{});
+
+} // namespace Shohih
+
+#endif // LOADGEN_H
@@ -0,0 +1,116 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Depth-first proof-number (DFPN) search
+ *          for forced mates
+ **************************************************/
+
+#pragma once
+#ifndef MATE_SOLVER_H
+#define MATE_SOLVER_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include "position.h"
+
+namespace Shohih {
+
+//--------------------------------------------------
+// Solver limits (0 = unlimited). The side to move is
+// the attacker; mates longer than maxMoves are not
+// searched for.
+//--------------------------------------------------
+struct MateLimits {
+    int maxMoves{ 8 };
+    uint64_t nodes{ 0 };
+    int64_t timeMs{ 0 };
+};
+
+enum class MateStatus : uint8_t {
+    MATE,       // forced mate found (shortest)
+    NO_MATE,    // proven: no mate within maxMoves
+    UNKNOWN     // limits hit or invalid position
+};
+
+struct MateResult {
+    MateStatus status{ MateStatus::UNKNOWN };
+    int mateIn{ 0 };                    // moves, MATE only
+    std::vector<PackedMove> line{};     // mating line, MATE only (cut short
+                                        // if the limits hit while extracting it)
+    uint64_t nodes{ 0 };
+    int64_t elapsedMs{ 0 };
+};
+
+class MateSolver {
+public:
+    explicit MateSolver(size_t megabytes=16) { Resize(megabytes); }
+    ~MateSolver() = default;
+
+    //--------------------------------------------------
+    // Proof table management
+    //--------------------------------------------------
+    void Resize(size_t megabytes);
+    void Clear();
+
+    //--------------------------------------------------
+    // Solve mate in 1, 2, ... maxMoves (blocking)
+    //--------------------------------------------------
+    MateResult Solve(const Position &pos, const MateLimits &limits);
+
+    // Abort a running Solve() (safe from other threads)
+    void Stop() { m_stop.store(true, std::memory_order_relaxed); }
+
+private:
+    //--------------------------------------------------
+    // Proof & disproof numbers of an OR (attacker to
+    // move) or AND (defender to move) node. Entries are
+    // keyed by position and remaining plies, so the
+    // searched graph has no cycles.
+    //--------------------------------------------------
+    struct Entry {
+        uint64_t key;
+        uint32_t pn;
+        uint32_t dn;
+        uint32_t work;  // nodes spent below (replacement)
+    };
+    static constexpr size_t CLUSTER_SIZE{ 4 };
+
+    void Mid(uint64_t key, int depth, uint32_t thPn, uint32_t thDn);
+    void Lookup(uint64_t key, uint32_t &pn, uint32_t &dn) const;
+    void Store(uint64_t key, uint32_t pn, uint32_t dn, uint64_t work);
+    int ProvenDepth(int first, int last);
+    bool ExtractLine(int depth, std::vector<PackedMove> &line);
+    bool ShouldStop();
+
+    static uint64_t NodeKey(uint64_t positionKey, int depth);
+
+    std::unique_ptr<Entry[]> m_entries{ nullptr };
+    size_t m_numClusters{ 0 };
+
+    Position m_pos{};
+    MateLimits m_limits{};
+    uint64_t m_nodes{ 0 };
+    std::chrono::steady_clock::time_point m_startTime{};
+    std::atomic<bool> m_stop{ false };
+};
+
+//--------------------------------------------------
+// Solve @param fens (FEN or EPD lines) on @param
+// threads workers, each with its own proof table.
+// Limits apply per position. @return results in the
+// input order (UNKNOWN for invalid lines).
+//--------------------------------------------------
+std::vector<MateResult> SolveMateBatch(const std::vector<std::string> &fens, const MateLimits &limits,
+    size_t threads=std::max(1u, std::thread::hardware_concurrency()), size_t megabytes=16);
+
+//--------------------------------------------------
+// Same for a file with one position per line (empty
+// lines and lines starting with '#' are skipped)
+//--------------------------------------------------
+ErrorCode SolveMateFile(const std::string &path, const MateLimits &limits, size_t threads,
+    size_t megabytes, std::vector<std::string> &fens, std::vector<MateResult> &results);
+
+} // namespace Shohih
+
+#endif // MATE_SOLVER_H
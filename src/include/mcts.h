@@ -0,0 +1,124 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Monte Carlo tree search (UCT / PUCT) with
+ *          tree parallelism
+ **************************************************/
+
+#pragma once
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <memory>
+#include "search.h"
+
+namespace Shohih {
+
+//--------------------------------------------------
+// Tuning & strength settings
+//--------------------------------------------------
+struct MctsOptions {
+    size_t megabytes{ 64 };     // node arena (the search stops when it is full)
+    bool puct{ true };          // PUCT with move priors, else UCT
+    double exploration{ 1.5 };  // c_puct / UCT constant
+    int virtualLoss{ 3 };       // losses added to nodes in flight
+    int rolloutPlies{ 4 };      // light playout before the static evaluation
+    double temperature{ 0.0 };  // pick moves with p ~ visits^(1/T); 0 = most visited
+    uint64_t seed{ 1 };
+};
+
+class Mcts {
+public:
+    explicit Mcts(const MctsOptions &options=MctsOptions{});
+    ~Mcts() = default;
+
+    //--------------------------------------------------
+    // Settings (not during a search). A new arena size
+    // drops the tree.
+    //--------------------------------------------------
+    void SetOptions(const MctsOptions &options);
+    const MctsOptions &GetOptions() const { return m_options; }
+    void SetThreads(size_t numThreads) { m_numThreads = std::max<size_t>(numThreads, 1); }
+
+    //--------------------------------------------------
+    // Search @param pos on all threads (blocking).
+    // limits.nodes caps the playouts; depth is ignored.
+    // The subtree of @param pos is reused when it was
+    // reached from the previous root.
+    //--------------------------------------------------
+    SearchResult Run(const Position &pos, const SearchLimits &limits);
+
+    void Stop() { m_signals->stop.store(true, std::memory_order_relaxed); }
+    void SetSignals(SearchSignals *signals) { m_signals = signals; }
+    void SetInfoCallback(SearchInfoCallback callback) { m_infoCallback = callback; }
+
+    // Forget the tree (new game)
+    void Clear();
+
+    uint64_t GetNodes() const { return m_playouts.load(std::memory_order_relaxed); }
+    size_t GetTreeSize() const { return std::min(m_size.load(std::memory_order_relaxed), m_capacity); }
+
+private:
+    //--------------------------------------------------
+    // Arena node. Statistics are from the view of the
+    // side that played @p move; children are allocated
+    // contiguously on expansion.
+    //--------------------------------------------------
+    struct Node {
+        std::atomic<uint32_t> visits;
+        std::atomic<int64_t> valueSum;      // fixed point, VALUE_ONE = 1.0
+        uint32_t firstChild;                // valid once EXPANDED
+        std::atomic<uint8_t> state;
+        uint16_t numChildren;
+        int8_t result;                      // TERMINAL: -1 mated, 0 stalemate
+        PackedMove move;
+        float prior;
+    };
+    static constexpr uint8_t UNEXPANDED{ 0 };
+    static constexpr uint8_t EXPANDING{ 1 };
+    static constexpr uint8_t EXPANDED{ 2 };
+    static constexpr uint8_t TERMINAL{ 3 };     // no legal moves
+    static constexpr int64_t VALUE_ONE{ 1 << 16 };
+
+    void Worker(size_t threadId);
+    void Playout(Position &pos, uint64_t &rng);
+    void AddVirtualLoss(Node &node) const;
+    uint32_t SelectChild(const Node &node) const;
+    bool Expand(Node &node, Position &pos);
+    double Rollout(Position &pos, uint64_t &rng);
+    bool Allocate(size_t count, uint32_t &first);
+    void ResetNode(Node &node, PackedMove move, float prior);
+    bool ReuseTree(const Position &pos);
+    bool ShouldStop(uint64_t localPlayouts);
+
+    uint32_t ChooseChild(uint64_t &rng) const;
+    uint32_t MostVisitedChild(uint32_t index) const;
+    int Score(uint32_t index) const;
+    std::vector<PackedMove> GetPv() const;
+    void SendInfo();
+    int64_t ElapsedMs() const;
+
+    MctsOptions m_options{};
+    size_t m_numThreads{ 1 };
+
+    // Node arena (never freed during a search)
+    std::unique_ptr<Node[]> m_nodes{ nullptr };
+    size_t m_capacity{ 0 };
+    std::atomic<size_t> m_size{ 0 };
+    uint32_t m_root{ 0 };
+    Position m_rootPos{};
+    bool m_hasTree{ false };
+
+    SearchLimits m_limits{};
+    SearchSignals m_ownSignals{};
+    SearchSignals *m_signals{ &m_ownSignals };
+    SearchInfoCallback m_infoCallback{};
+    std::atomic<uint64_t> m_playouts{ 0 };
+    std::atomic<int> m_selDepth{ 0 };
+    std::chrono::steady_clock::time_point m_startTime{};
+    int64_t m_optimumMs{ 0 };
+    uint64_t m_rng{ 1 };
+};
+
+} // namespace Shohih
+
+#endif // MCTS_H
@@ -0,0 +1,163 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Server metrics: sharded counters & request
+ *          latency histograms, rendered for /metrics in
+ *          the Prometheus text format
+ **************************************************/
+
+#pragma once
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include "shohih_defs.h"
+
+namespace Shohih {
+
+// Counter cells per metric; threads are spread over them
+constexpr size_t METRIC_SHARDS{ 16 };
+
+// Cells of different shards never share a cache line
+constexpr size_t METRIC_CELL_BYTES{ 64 };
+
+//--------------------------------------------------
+// Shard of the calling thread (handed out round robin
+// on first use)
+//--------------------------------------------------
+inline size_t MetricShard()
+{
+    static std::atomic<size_t> nextShard{ 0 };
+    thread_local const size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS;
+    return shard;
+}
+
+//--------------------------------------------------
+// Monotonic counter. Add() is one uncontended relaxed
+// atomic add on the thread's own cache line; Value()
+// sums the shards (for scrapes).
+//--------------------------------------------------
+class ShardedCounter {
+public:
+    void Add(uint64_t n=1) { m_cells[MetricShard()].value.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t Value() const;
+
+private:
+    struct Cell {
+        std::atomic<uint64_t> value{ 0 };
+        char padding[METRIC_CELL_BYTES - sizeof(std::atomic<uint64_t>)];
+    };
+    std::array<Cell, METRIC_SHARDS> m_cells{};
+};
+
+//--------------------------------------------------
+// Request latency histogram with fixed bounds from
+// 100 us to 30 s (the longest long poll). Each shard
+// holds a count per bucket & the sum.
+//--------------------------------------------------
+class LatencyBuckets {
+public:
+    static constexpr size_t NUM_BOUNDS{ 16 };
+    static const std::array<uint64_t, NUM_BOUNDS> BOUNDS;   // upper bounds (ns)
+
+    struct Totals {
+        std::array<uint64_t, NUM_BOUNDS + 1> counts{};      // per bucket, +Inf last
+        uint64_t count{ 0 };
+        double sum{ 0.0 };                                  // seconds
+    };
+
+    void Observe(std::chrono::steady_clock::duration latency);
+    Totals Collect() const;
+
+private:
+    static constexpr size_t CELL_WORDS{ NUM_BOUNDS + 2 };   // buckets, +Inf, sum (ns)
+
+    struct Cell {
+        std::array<std::atomic<uint64_t>, CELL_WORDS> words{};
+        char padding[METRIC_CELL_BYTES - CELL_WORDS * sizeof(std::atomic<uint64_t>) % METRIC_CELL_BYTES];
+    };
+    std::array<Cell, METRIC_SHARDS> m_cells{};
+};
+
+//--------------------------------------------------
+// Instrumented endpoints: the HTTP routes and the
+// move frames of the WebSocket
+//--------------------------------------------------
+enum class Endpoint : uint8_t {
+    REGISTER,
+    EXIT,
+    GET_MOVE,
+    GET_MOVES,
+    SEND_MOVE,
+    METRICS,
+    WS_MOVE,
+    NUM_ENDPOINTS
+};
+
+constexpr size_t NUM_ENDPOINTS{ static_cast<size_t>(Endpoint::NUM_ENDPOINTS) };
+
+const char *EndpointName(Endpoint endpoint);
+
+//--------------------------------------------------
+// Values read at scrape time from the server's parts
+//--------------------------------------------------
+struct ServerGauges {
+    size_t games{ 0 };              // games in progress
+    size_t sessions{ 0 };           // seated players
+    size_t wsConnections{ 0 };      // open WebSockets
+    size_t httpThreads{ 0 };        // request handler threads
+    uint64_t journalPending{ 0 };   // journal records not on disk yet
+};
+
+class ServerMetrics {
+public:
+    //--------------------------------------------------
+    // Times one request from construction to
+    // destruction (a null @param metrics records
+    // nothing). Call Fail() for error responses.
+    //--------------------------------------------------
+    class RequestTimer {
+    public:
+        RequestTimer(ServerMetrics *metrics, Endpoint endpoint);
+        ~RequestTimer();
+        RequestTimer(const RequestTimer&) = delete;
+        RequestTimer &operator=(const RequestTimer&) = delete;
+
+        void Fail() { m_failed = true; }
+
+    private:
+        ServerMetrics *const m_metrics;
+        const Endpoint m_endpoint;
+        const std::chrono::steady_clock::time_point m_start;
+        bool m_failed{ false };
+    };
+
+    //--------------------------------------------------
+    // Outcome of a move sent over any transport:
+    // SUCCESS = played, INVALID_MOVE = rejected
+    //--------------------------------------------------
+    void CountMove(ErrorCode err);
+
+    //--------------------------------------------------
+    // Every metric in the Prometheus text format 0.0.4
+    //--------------------------------------------------
+    std::string Render(const ServerGauges &gauges) const;
+
+private:
+    struct EndpointMetrics {
+        ShardedCounter started{};
+        ShardedCounter finished{};      // started - finished = in flight
+        ShardedCounter failed{};
+        LatencyBuckets latency{};
+    };
+
+    std::array<EndpointMetrics, NUM_ENDPOINTS> m_endpoints{};
+    ShardedCounter m_moves{};
+    ShardedCounter m_rejectedMoves{};
+};
+
+} // namespace Shohih
+
+#endif // METRICS_H
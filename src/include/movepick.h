@@ -0,0 +1,100 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Staged move picker & move ordering tables
+ **************************************************/
+
+#pragma once
+#ifndef MOVEPICK_H
+#define MOVEPICK_H
+
+#include "position.h"
+
+namespace Shohih {
+
+//--------------------------------------------------
+// Butterfly history: [side][from][to] score of quiet
+// moves, raised when they cause beta cutoffs.
+//--------------------------------------------------
+class HistoryTable {
+public:
+    static constexpr int MAX_SCORE{ 16384 };
+
+    void Clear() { for (auto &side : m_table) { side.fill(0); } }
+    int Get(PieceColor color, PackedMove move) const
+        { return m_table[static_cast<uint8_t>(color)][Index(move)]; }
+
+    // History gravity: scores saturate towards +-MAX_SCORE
+    void Update(PieceColor color, PackedMove move, int bonus);
+
+private:
+    static size_t Index(PackedMove move) { return move.From() * NUM_SQUARES + move.To(); }
+    std::array<std::array<int16_t, NUM_SQUARES * NUM_SQUARES>, NUM_PIECE_COLORS> m_table{};
+};
+
+//--------------------------------------------------
+// Two killer moves per ply (quiet moves that caused
+// a cutoff in a sibling node)
+//--------------------------------------------------
+using KillerMoves = std::array<PackedMove, 2>;
+
+class MovePicker {
+public:
+    //--------------------------------------------------
+    // Main search: TT move, winning captures (MVV-LVA),
+    // killers, quiets (history), losing captures (SEE < 0)
+    //--------------------------------------------------
+    MovePicker(const Position &pos, PackedMove ttMove,
+        const KillerMoves &killers, const HistoryTable &history);
+
+    //--------------------------------------------------
+    // Quiescence search: TT move (if capture), captures
+    //--------------------------------------------------
+    MovePicker(const Position &pos, PackedMove ttMove, const HistoryTable &history);
+
+    //--------------------------------------------------
+    // Return the next pseudo-legal move or a null move
+    // when exhausted. Later stages are only generated
+    // once the earlier stages have been consumed.
+    //--------------------------------------------------
+    PackedMove NextMove();
+
+private:
+    enum class Stage : uint8_t {
+        // Main search
+        TT_MOVE,
+        INIT_CAPTURES,
+        CAPTURES,
+        KILLER_1,
+        KILLER_2,
+        INIT_QUIETS,
+        QUIETS,
+        BAD_CAPTURES,
+        // Quiescence search
+        QS_TT_MOVE,
+        QS_INIT_CAPTURES,
+        QS_CAPTURES,
+        END
+    };
+
+    void ScoreCaptures();
+    void ScoreQuiets();
+    PackedMove PickBest();
+    bool IsSpecial(PackedMove move) const;
+
+    const Position &m_pos;
+    const HistoryTable &m_history;
+    PackedMove m_ttMove{};
+    KillerMoves m_killers{};
+    Stage m_stage{ Stage::END };
+
+    MoveList m_moves;
+    size_t m_current{ 0 };
+
+    // Captures deferred until after the quiets
+    MoveList m_badCaptures;
+    size_t m_badCurrent{ 0 };
+};
+
+} // namespace Shohih
+
+#endif // MOVEPICK_H
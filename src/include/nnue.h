@@ -0,0 +1,116 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Efficiently updatable neural network
+ *          evaluation (NNUE), CPU only
+ *
+ * Architecture: (768 -> 256) x 2 -> 32 -> 32 -> 1
+ *  - Feature transformer: one-hot [piece][square]
+ *    from each side's perspective, int16 weights,
+ *    accumulated incrementally by Position
+ *  - Dense layers: int8 weights, int32 biases,
+ *    clipped ReLU activations in [0, 127]
+ **************************************************/
+
+#pragma once
+#ifndef NNUE_H
+#define NNUE_H
+
+#include <array>
+#include "shohih_defs.h"
+
+namespace Shohih {
+namespace Nnue {
+
+//--------------------------------------------------
+// Network dimensions & quantization
+//--------------------------------------------------
+constexpr size_t NUM_FEATURES{ 768 };   // [own/their][type][square]
+constexpr size_t L1_SIZE{ 256 };        // accumulator width per perspective
+constexpr size_t L2_SIZE{ 32 };
+constexpr size_t L3_SIZE{ 32 };
+constexpr int ACTIVATION_MAX{ 127 };
+constexpr int WEIGHT_SHIFT{ 6 };        // dense weights are scaled by 64
+constexpr int OUTPUT_SCALE{ 16 };       // raw output / OUTPUT_SCALE = centipawns
+
+//--------------------------------------------------
+// Kernel implementations, picked at runtime from
+// what the CPU supports
+//--------------------------------------------------
+enum class SimdLevel : uint8_t {
+    SCALAR,
+    SSE41,
+    AVX2
+};
+SimdLevel GetSupportedSimdLevel();
+SimdLevel GetSimdLevel();
+void SetSimdLevel(SimdLevel level);    // clamped to the supported level
+const char *SimdLevelName(SimdLevel level);
+
+//--------------------------------------------------
+// Feature transformer output for both perspectives
+// ([color] = that side's view of the board)
+//--------------------------------------------------
+struct Accumulator {
+    std::array<std::array<int16_t, L1_SIZE>, NUM_PIECE_COLORS> values;
+};
+
+class Network {
+public:
+    //--------------------------------------------------
+    // Binary weights file (little-endian):
+    //  header: magic "SHNN", version, 4 dimensions
+    //  body:   FT weights/biases, L1, L2, output layer
+    //--------------------------------------------------
+    ErrorCode Load(const std::string &path);
+    ErrorCode Save(const std::string &path) const;
+
+    // Small random weights (tests & benchmarks)
+    void Randomize(uint64_t seed);
+    bool IsLoaded() const { return m_loaded; }
+
+    //--------------------------------------------------
+    // Accumulator updates (@param pieceCode is the
+    // engine's color * 6 + type code)
+    //--------------------------------------------------
+    void ResetAccumulator(Accumulator &acc) const;
+    void AddFeature(Accumulator &acc, uint8_t pieceCode, SquareId sq) const;
+    void RemoveFeature(Accumulator &acc, uint8_t pieceCode, SquareId sq) const;
+    void MoveFeature(Accumulator &acc, uint8_t pieceCode, SquareId from, SquareId to) const;
+
+    //--------------------------------------------------
+    // Forward pass, centipawns from @param sideToMove
+    //--------------------------------------------------
+    int Evaluate(const Accumulator &acc, PieceColor sideToMove) const;
+
+private:
+    static size_t FeatureIndex(PieceColor perspective, uint8_t pieceCode, SquareId sq);
+    const int16_t *FeatureWeights(size_t index) const
+        { return &m_ftWeights[index * L1_SIZE]; }
+
+    bool m_loaded{ false };
+    std::vector<int16_t> m_ftWeights{};     // [feature][L1_SIZE]
+    std::vector<int16_t> m_ftBiases{};      // [L1_SIZE]
+    std::vector<int8_t> m_l1Weights{};      // [L2_SIZE][2 * L1_SIZE]
+    std::vector<int32_t> m_l1Biases{};
+    std::vector<int8_t> m_l2Weights{};      // [L3_SIZE][L2_SIZE]
+    std::vector<int32_t> m_l2Biases{};
+    std::vector<int8_t> m_outWeights{};     // [L3_SIZE]
+    int32_t m_outBias{ 0 };
+};
+
+//--------------------------------------------------
+// Process-wide network. Load/enable before starting
+// searches; positions refresh their accumulators
+// with Position::RefreshAccumulator().
+//--------------------------------------------------
+extern Network g_network;
+extern bool g_enabled;
+
+ErrorCode LoadNetwork(const std::string &path);
+void SetEnabled(bool enabled);         // no effect until a network is loaded
+inline bool IsEnabled() { return g_enabled; }
+
+} // namespace Nnue
+} // namespace Shohih
+
+#endif // NNUE_H
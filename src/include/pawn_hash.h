@@ -0,0 +1,65 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Pawn structure evaluation & per-thread
+ *          pawn hash table
+ **************************************************/
+
+#pragma once
+#ifndef PAWN_HASH_H
+#define PAWN_HASH_H
+
+#include <memory>
+#include "position.h"
+
+namespace Shohih {
+
+//--------------------------------------------------
+// Passed, isolated, doubled and backward pawns plus
+// the pawn shield in front of both kings (white's
+// view). Computed from scratch: use a PawnHashTable
+// on hot paths.
+//--------------------------------------------------
+EvalScore EvaluatePawns(const Position &pos);
+
+//--------------------------------------------------
+// Cache of EvaluatePawns() keyed by the position's
+// pawn key. Not thread-safe: each search thread owns
+// one. Shields are cached for the king squares they
+// were last computed for.
+//--------------------------------------------------
+class PawnHashTable {
+public:
+    static constexpr size_t DEFAULT_ENTRIES{ 1 << 14 };
+
+    explicit PawnHashTable(size_t entries=DEFAULT_ENTRIES) { Resize(entries); }
+    ~PawnHashTable() = default;
+
+    void Resize(size_t entries);    // rounded down to a power of two
+    void Clear();
+
+    // Same as EvaluatePawns(pos)
+    EvalScore Evaluate(const Position &pos);
+
+    //--------------------------------------------------
+    // Statistics (since the last Clear)
+    //--------------------------------------------------
+    uint64_t GetProbes() const { return m_probes; }
+    uint64_t GetHits() const { return m_hits; }
+
+private:
+    struct Entry {
+        uint64_t key;
+        EvalScore structure;
+        std::array<SquareId, NUM_PIECE_COLORS> kingSquares;
+        std::array<int, NUM_PIECE_COLORS> shields;     // middlegame only
+    };
+
+    std::unique_ptr<Entry[]> m_entries{ nullptr };
+    size_t m_mask{ 0 };
+    uint64_t m_probes{ 0 };
+    uint64_t m_hits{ 0 };
+};
+
+} // namespace Shohih
+
+#endif // PAWN_HASH_H
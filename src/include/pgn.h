@@ -0,0 +1,66 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Streaming PGN reader
+ **************************************************/
+
+#pragma once
+#ifndef PGN_H
+#define PGN_H
+
+#include <map>
+#include <istream>
+#include "position.h"
+
+namespace Shohih {
+
+enum class GameResult : uint8_t {
+    WHITE_WIN,
+    BLACK_WIN,
+    DRAW,
+    UNKNOWN
+};
+
+//--------------------------------------------------
+// One game as read from the file; the move text is
+// parsed separately so that it can happen on worker
+// threads
+//--------------------------------------------------
+struct PgnGame {
+    std::map<std::string, std::string> tags{};
+    std::string moveText{};
+
+    std::string GetTag(const std::string &name) const;
+    GameResult GetResult() const;
+
+    //--------------------------------------------------
+    // Play the main line from the start position (or
+    // the FEN tag) and collect its moves
+    //  - @return INVALID_FEN / INVALID_MOVE
+    //--------------------------------------------------
+    ErrorCode ParseMoves(Position &pos, std::vector<PackedMove> &moves) const;
+};
+
+class PgnReader {
+public:
+    explicit PgnReader(std::istream &in) : m_in(in) {}
+
+    //--------------------------------------------------
+    // Read the next game, @return false at end of input
+    //--------------------------------------------------
+    bool NextGame(PgnGame &game);
+
+    //--------------------------------------------------
+    // SAN tokens of the main line: comments, variations,
+    // NAGs, move numbers and the result are dropped
+    //--------------------------------------------------
+    static std::vector<std::string> Tokenize(const std::string &moveText);
+
+private:
+    std::istream &m_in;
+    std::string m_pendingLine{};
+    bool m_hasPendingLine{ false };
+};
+
+} // namespace Shohih
+
+#endif // PGN_H
@@ -0,0 +1,299 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Compact position used by the engine
+ *          (bitboards + mailbox with make/unmake)
+ **************************************************/
+
+#pragma once
+#ifndef POSITION_H
+#define POSITION_H
+
+#include "bitboard.h"
+#include "psqt.h"
+#include "nnue.h"
+
+namespace Shohih {
+
+//--------------------------------------------------
+// Engine constants
+//--------------------------------------------------
+constexpr int MAX_MOVES{ 256 };
+constexpr int MAX_PLY{ 128 };
+
+//--------------------------------------------------
+// Piece code = color * NUM_PIECE_TYPES + type
+// (same layout as the GUI piece texture index)
+//--------------------------------------------------
+using PieceCode = uint8_t;
+constexpr PieceCode NO_PIECE{ NUM_PIECE_TYPES * NUM_PIECE_COLORS };
+
+constexpr PieceCode MakePieceCode(PieceColor color, PieceType type)
+    { return static_cast<PieceCode>(
+        static_cast<uint8_t>(color) * NUM_PIECE_TYPES + static_cast<uint8_t>(type)); }
+constexpr PieceType TypeOf(PieceCode pc)
+    { return static_cast<PieceType>(pc % NUM_PIECE_TYPES); }
+constexpr PieceColor ColorOf(PieceCode pc)
+    { return static_cast<PieceColor>(pc / NUM_PIECE_TYPES); }
+constexpr PieceColor Opposite(PieceColor color)
+    { return color == PieceColor::WHITE ? PieceColor::BLACK : PieceColor::WHITE; }
+
+//--------------------------------------------------
+// Simple piece values (move ordering & exchanges)
+//--------------------------------------------------
+constexpr std::array<int, NUM_PIECE_TYPES> PIECE_VALUES{ { 100, 320, 330, 500, 900, 0 } };
+inline int PieceValue(PieceType type) { return PIECE_VALUES[static_cast<uint8_t>(type)]; }
+
+//--------------------------------------------------
+// Castling rights (bit flags)
+//--------------------------------------------------
+constexpr uint8_t WHITE_OO{ 1 };
+constexpr uint8_t WHITE_OOO{ 2 };
+constexpr uint8_t BLACK_OO{ 4 };
+constexpr uint8_t BLACK_OOO{ 8 };
+constexpr uint8_t ALL_CASTLING{ 15 };
+
+//--------------------------------------------------
+// 16-bit move encoding
+// bits 0-5: from | bits 6-11: to | bits 12-15: flags
+//--------------------------------------------------
+class PackedMove {
+public:
+    // Move flags
+    static constexpr uint8_t QUIET{ 0 };
+    static constexpr uint8_t DOUBLE_PUSH{ 1 };
+    static constexpr uint8_t KING_CASTLE{ 2 };
+    static constexpr uint8_t QUEEN_CASTLE{ 3 };
+    static constexpr uint8_t CAPTURE{ 4 };
+    static constexpr uint8_t EN_PASSANT{ 5 };
+    static constexpr uint8_t PROMOTION{ 8 };    // + (promoted type - KNIGHT)
+
+    // Trivial so move lists need no initialization; use {} for a null move
+    PackedMove() = default;
+    constexpr PackedMove(SquareId from, SquareId to, uint8_t flags=QUIET)
+        : m_data(static_cast<uint16_t>(from | (to << 6) | (flags << 12))) {}
+
+    static constexpr PackedMove FromRaw(uint16_t raw)
+        { return PackedMove(raw & 0x3F, (raw >> 6) & 0x3F, static_cast<uint8_t>(raw >> 12)); }
+
+    constexpr SquareId From() const { return m_data & 0x3F; }
+    constexpr SquareId To() const { return (m_data >> 6) & 0x3F; }
+    constexpr uint8_t Flags() const { return static_cast<uint8_t>(m_data >> 12); }
+    constexpr uint16_t Raw() const { return m_data; }
+
+    constexpr bool IsNull() const { return m_data == 0; }
+    constexpr bool IsCapture() const { return (Flags() & CAPTURE) != 0; }
+    constexpr bool IsPromotion() const { return (Flags() & PROMOTION) != 0; }
+    constexpr bool IsCastle() const
+        { return Flags() == KING_CASTLE || Flags() == QUEEN_CASTLE; }
+    constexpr bool IsQuiet() const { return !IsCapture() && !IsPromotion(); }
+    constexpr PieceType PromotionType() const
+        { return static_cast<PieceType>((Flags() & 3) + static_cast<uint8_t>(PieceType::KNIGHT)); }
+
+    constexpr bool operator==(const PackedMove &other) const { return m_data == other.m_data; }
+    constexpr bool operator!=(const PackedMove &other) const { return m_data != other.m_data; }
+
+    // Long algebraic notation (e.g. "e2e4", "e7e8q", "0000")
+    std::string ToUci() const;
+
+    // Convert to the GUI/network move type
+    Move ToMove() const
+        { return IsNull() ? NULL_MOVE : Move{ ToSquare(From()), ToSquare(To()) }; }
+
+private:
+    uint16_t m_data;
+};
+
+constexpr PackedMove NULL_PACKED_MOVE{ 0, 0 };
+
+//--------------------------------------------------
+// Fixed-capacity move list (no heap allocation)
+//--------------------------------------------------
+struct ScoredMove {
+    PackedMove move;
+    int score;
+};
+
+class MoveList {
+public:
+    void Add(PackedMove move) { m_moves[m_size++].move = move; }
+    void Clear() { m_size = 0; }
+    size_t Size() const { return m_size; }
+    bool Empty() const { return m_size == 0; }
+    bool Contains(PackedMove move) const;
+
+    ScoredMove &operator[](size_t i) { return m_moves[i]; }
+    const ScoredMove &operator[](size_t i) const { return m_moves[i]; }
+    ScoredMove *begin() { return m_moves.data(); }
+    ScoredMove *end() { return m_moves.data() + m_size; }
+    const ScoredMove *begin() const { return m_moves.data(); }
+    const ScoredMove *end() const { return m_moves.data() + m_size; }
+
+private:
+    std::array<ScoredMove, MAX_MOVES> m_moves;
+    size_t m_size{ 0 };
+};
+
+//--------------------------------------------------
+// Move generation type
+// CAPTURES: captures & promotions | QUIETS: everything else
+//--------------------------------------------------
+enum class GenType : uint8_t {
+    CAPTURES,
+    QUIETS,
+    ALL
+};
+
+class Position {
+public:
+    // Room for @param historyPlies moves before the
+    // state stack has to grow
+    explicit Position(size_t historyPlies=MAX_PLY * 4);
+
+    //--------------------------------------------------
+    // Setup
+    //--------------------------------------------------
+    ErrorCode SetFEN(const std::string &fen);
+    std::string GetFEN() const;
+
+    //--------------------------------------------------
+    // Make/unmake (moves must be legal)
+    //--------------------------------------------------
+    void MakeMove(PackedMove move);
+    void UnmakeMove(PackedMove move);
+    void MakeNullMove();
+    void UnmakeNullMove();
+
+    //--------------------------------------------------
+    // Move generation (pseudo-legal unless stated)
+    //--------------------------------------------------
+    void GenerateMoves(MoveList &list, GenType type) const;
+    void GenerateLegalMoves(MoveList &list) const;
+    bool IsLegal(PackedMove move) const;        // move must be pseudo-legal
+    bool IsPseudoLegal(PackedMove move) const;  // any move (e.g. from hash tables)
+
+    // Parse long algebraic notation against the legal moves
+    PackedMove ParseUciMove(const std::string &uci) const;
+
+    // Parse standard algebraic notation (PGN), e.g. "Nbd7", "exd8=Q+", "O-O"
+    PackedMove ParseSanMove(const std::string &san) const;
+
+    // Standard algebraic notation of a legal move, with check/mate suffix
+    std::string ToSan(PackedMove move) const;
+
+    // Count leaf nodes of the legal move tree
+    uint64_t Perft(int depth);
+
+    //--------------------------------------------------
+    // Attacks
+    //--------------------------------------------------
+    Bitboard AttackersTo(SquareId sq, Bitboard occupied) const;
+    bool IsSquareAttacked(SquareId sq, PieceColor byColor) const;
+    bool InCheck() const { return m_st.checkers != 0; }
+    Bitboard GetCheckers() const { return m_st.checkers; }
+
+    //--------------------------------------------------
+    // Static exchange evaluation: material balance of
+    // the capture sequence on the move's target square
+    // (least valuable attacker first, x-rays included)
+    //--------------------------------------------------
+    int See(PackedMove move) const;
+    bool SeeGe(PackedMove move, int threshold) const { return See(move) >= threshold; }
+
+    //--------------------------------------------------
+    // Game state
+    //--------------------------------------------------
+    bool IsRepetition() const;
+    bool IsInsufficientMaterial() const;
+    bool IsDraw() const;
+    bool HasNonPawnMaterial(PieceColor color) const;
+
+    //--------------------------------------------------
+    // Getters
+    //--------------------------------------------------
+    PieceColor GetSideToMove() const { return m_sideToMove; }
+    PieceCode GetPieceOn(SquareId sq) const { return m_mailbox[sq]; }
+    Bitboard GetPieces(PieceColor color, PieceType type) const
+        { return m_pieceBB[MakePieceCode(color, type)]; }
+    Bitboard GetPieces(PieceType type) const
+        { return GetPieces(PieceColor::WHITE, type) | GetPieces(PieceColor::BLACK, type); }
+    Bitboard GetPieces(PieceColor color) const
+        { return m_colorBB[static_cast<uint8_t>(color)]; }
+    Bitboard GetOccupied() const { return m_colorBB[0] | m_colorBB[1]; }
+    SquareId GetKingSquare(PieceColor color) const
+        { return Lsb(GetPieces(color, PieceType::KING)); }
+    SquareId GetEnPassantSquare() const { return m_st.epSquare; }
+    uint8_t GetCastlingRights() const { return m_st.castling; }
+    uint16_t GetHalfmoveClock() const { return m_st.halfmoveClock; }
+    uint16_t GetFullmoveNumber() const { return m_fullmoveNumber; }
+    uint64_t GetKey() const { return m_st.key; }
+    uint64_t GetPawnKey() const { return m_st.pawnKey; }  // pawns only
+    PieceCode GetCapturedPiece() const { return m_st.captured; }
+    Bitboard GetPinned() const { return m_st.pinned; }
+
+    //--------------------------------------------------
+    // Incrementally maintained evaluation terms: sum of
+    // tapered material + piece-square scores (white's
+    // view) and game phase (may exceed MAX_PHASE after
+    // promotions)
+    //--------------------------------------------------
+    const EvalScore &GetPsqScore() const { return m_psq; }
+    int GetPhase() const { return m_phase; }
+
+    //--------------------------------------------------
+    // NNUE accumulator, maintained only while the
+    // network is enabled. Refresh after enabling or
+    // loading a network.
+    //--------------------------------------------------
+    const Nnue::Accumulator &GetAccumulator() const { return m_acc; }
+    void RefreshAccumulator();
+
+private:
+    //--------------------------------------------------
+    // State that cannot be recovered by unmake
+    //--------------------------------------------------
+    struct StateInfo {
+        uint64_t key{ 0 };
+        uint64_t pawnKey{ 0 };
+        Bitboard checkers{ 0 };
+        Bitboard pinned{ 0 };
+        PieceCode captured{ NO_PIECE };
+        uint8_t castling{ 0 };
+        SquareId epSquare{ NO_SQUARE };
+        uint16_t halfmoveClock{ 0 };
+        uint16_t pliesFromNull{ 0 };
+    };
+
+    //--------------------------------------------------
+    // Board updates (bitboards, mailbox & eval terms)
+    //--------------------------------------------------
+    void PutPiece(PieceCode pc, SquareId sq);
+    void RemovePiece(SquareId sq);
+    void MovePieceTo(SquareId from, SquareId to);
+
+    void UpdateCheckInfo();
+    void Clear();
+    uint64_t ComputeKey() const;
+    uint64_t ComputePawnKey() const;
+    void GenerateCastling(MoveList &list) const;
+
+    // Piece placement
+    std::array<PieceCode, NUM_SQUARES> m_mailbox{};
+    std::array<Bitboard, NO_PIECE> m_pieceBB{};
+    std::array<Bitboard, NUM_PIECE_COLORS> m_colorBB{};
+
+    // Evaluation accumulators (updated with the placement)
+    EvalScore m_psq{};
+    int m_phase{ 0 };
+    Nnue::Accumulator m_acc{};
+
+    PieceColor m_sideToMove{ PieceColor::WHITE };
+    uint16_t m_fullmoveNumber{ 1 };
+
+    // Current state and the stack of previous states
+    StateInfo m_st{};
+    std::vector<StateInfo> m_history{};
+};
+
+} // namespace Shohih
+
+#endif // POSITION_H
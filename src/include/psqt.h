@@ -0,0 +1,51 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tapered material & piece-square tables
+ **************************************************/
+
+#pragma once
+#ifndef PSQT_H
+#define PSQT_H
+
+#include "bitboard.h"
+
+namespace Shohih {
+
+//--------------------------------------------------
+// Middlegame/endgame score pair (centipawns)
+//--------------------------------------------------
+struct EvalScore {
+    int mg{ 0 };
+    int eg{ 0 };
+
+    EvalScore &operator+=(const EvalScore &other) { mg += other.mg; eg += other.eg; return *this; }
+    EvalScore &operator-=(const EvalScore &other) { mg -= other.mg; eg -= other.eg; return *this; }
+    bool operator==(const EvalScore &other) const { return mg == other.mg && eg == other.eg; }
+};
+
+//--------------------------------------------------
+// Game phase: sum of non-pawn material weights,
+// MAX_PHASE = full middlegame, 0 = pawn endgame
+//--------------------------------------------------
+constexpr std::array<int, NUM_PIECE_TYPES> PHASE_WEIGHTS{ { 0, 1, 1, 2, 4, 0 } };
+constexpr int MAX_PHASE{ 24 };
+
+//--------------------------------------------------
+// Material + square bonus per [piece code][square],
+// from white's view (black entries are negated and
+// mirrored). Indexed by the engine's PieceCode.
+//--------------------------------------------------
+struct PsqTable {
+    PsqTable();
+    std::array<std::array<EvalScore, NUM_SQUARES>, NUM_PIECE_TYPES * NUM_PIECE_COLORS> scores{};
+};
+extern const PsqTable g_psqt;
+
+inline const EvalScore &PsqScore(uint8_t pieceCode, SquareId sq)
+    { return g_psqt.scores[pieceCode][sq]; }
+inline int PhaseWeight(uint8_t pieceCode)
+    { return PHASE_WEIGHTS[pieceCode % NUM_PIECE_TYPES]; }
+
+} // namespace Shohih
+
+#endif // PSQT_H
@@ -0,0 +1,100 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Bounded buffer that puts results of
+ *          numbered jobs back into job order
+ **************************************************/
+
+#pragma once
+#ifndef REORDER_BUFFER_H
+#define REORDER_BUFFER_H
+
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+
+namespace Shohih {
+
+//--------------------------------------------------
+// Producers finish jobs 0, 1, 2, ... in any order; the
+// consumer gets them back in order. At most @param
+// window results wait at a time: a producer that runs
+// too far ahead blocks (backpressure). Jobs must be
+// handed out in order, then the producer holding the
+// next job is never blocked.
+//--------------------------------------------------
+template <typename T>
+class ReorderBuffer {
+public:
+    explicit ReorderBuffer(size_t window) :
+        m_slots(window > 0 ? window : 1), m_filled(m_slots.size(), false) {}
+
+    //--------------------------------------------------
+    // Block while @param index is outside the window.
+    // @return false once closed.
+    //--------------------------------------------------
+    bool Put(size_t index, T item)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_notFull.wait(lock, [this, index]() { return m_closed || index < m_next + m_slots.size(); });
+        if (m_closed) {
+            return false;
+        }
+        const size_t slot = index % m_slots.size();
+        m_slots[slot] = std::move(item);
+        m_filled[slot] = true;
+        const bool isNext = (index == m_next);
+        lock.unlock();
+        if (isNext) {
+            m_ready.notify_one();
+        }
+        return true;
+    }
+
+    //--------------------------------------------------
+    // Block until the next result in order is there.
+    // @return false once closed and that result never
+    // arrived.
+    //--------------------------------------------------
+    bool Pop(T &item)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        const size_t slot = m_next % m_slots.size();
+        m_ready.wait(lock, [this, slot]() { return m_closed || m_filled[slot]; });
+        if (!m_filled[slot]) {
+            return false;
+        }
+        item = std::move(m_slots[slot]);
+        m_filled[slot] = false;
+        m_next++;
+        lock.unlock();
+        m_notFull.notify_all();
+        return true;
+    }
+
+    //--------------------------------------------------
+    // No more results; the consumer drains the ones in
+    // order that are left
+    //--------------------------------------------------
+    void Close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+        m_notFull.notify_all();
+        m_ready.notify_all();
+    }
+
+private:
+    std::vector<T> m_slots;
+    std::vector<bool> m_filled;
+    size_t m_next{ 0 };
+    bool m_closed{ false };
+    std::mutex m_mutex{};
+    std::condition_variable m_notFull{};
+    std::condition_variable m_ready{};
+};
+
+} // namespace Shohih
+
+#endif // REORDER_BUFFER_H
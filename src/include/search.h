@@ -0,0 +1,204 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Alpha-beta search
+ **************************************************/
+
+#pragma once
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include "tt.h"
+#include "movepick.h"
+#include "tbprobe.h"
+#include "pawn_hash.h"
+
+namespace Shohih {
+
+//--------------------------------------------------
+// Score constants (centipawns, side to move)
+//--------------------------------------------------
+constexpr int VALUE_DRAW{ 0 };
+constexpr int VALUE_MATE{ 32000 };
+constexpr int VALUE_INFINITE{ 32001 };
+constexpr int VALUE_MATE_IN_MAX_PLY{ VALUE_MATE - MAX_PLY };
+constexpr int VALUE_TB_WIN{ VALUE_MATE_IN_MAX_PLY - 1 };   // - ply
+constexpr int VALUE_TB_WIN_IN_MAX_PLY{ VALUE_TB_WIN - MAX_PLY };
+constexpr int MAX_DEPTH{ 64 };
+
+//--------------------------------------------------
+// Search limits (0 = unlimited)
+//--------------------------------------------------
+struct SearchLimits {
+    int depth{ MAX_DEPTH };
+    uint64_t nodes{ 0 };
+    int64_t moveTime{ 0 };  // milliseconds
+
+    // Clock: remaining time & increment per color (ms)
+    std::array<int64_t, NUM_PIECE_COLORS> time{};
+    std::array<int64_t, NUM_PIECE_COLORS> inc{};
+    int movesToGo{ 0 };
+
+    bool infinite{ false };  // ignore the clock until stopped
+    bool ponder{ false };    // ignore the clock until PonderHit()
+};
+
+//--------------------------------------------------
+// Pruning & reduction features. Each can be switched
+// off (UCI options) to measure its effect with bench.
+//--------------------------------------------------
+struct SearchConfig {
+    bool pvs{ true };           // principal variation search
+    bool nullMove{ true };      // null move pruning (with zugzwang guards)
+    bool lmr{ true };           // late move reductions
+    bool aspiration{ true };    // aspiration windows at the root
+    bool futility{ true };      // futility & reverse futility pruning
+};
+
+// Safety margin kept on the clock for I/O latency
+constexpr int64_t MOVE_OVERHEAD_MS{ 30 };
+
+//--------------------------------------------------
+// Time for one move of @param us (ms, 0 = no limit):
+// @param optimumMs is the target, @param maximumMs
+// the hard stop (the only one for a fixed move time)
+//--------------------------------------------------
+void ComputeTimeLimits(const SearchLimits &limits, PieceColor us, int64_t &optimumMs, int64_t &maximumMs);
+
+//--------------------------------------------------
+// Progress reported after each completed iteration
+//--------------------------------------------------
+struct SearchInfo {
+    int depth{ 0 };
+    int selDepth{ 0 };
+    int score{ 0 };
+    uint64_t nodes{ 0 };
+    int64_t elapsedMs{ 0 };
+    std::vector<PackedMove> pv{};
+};
+using SearchInfoCallback = std::function<void(const SearchInfo &)>;
+
+//--------------------------------------------------
+// Flags set from outside the search thread. A thread
+// pool shares one set between all of its workers.
+//--------------------------------------------------
+struct SearchSignals {
+    std::atomic<bool> stop{ false };
+    std::atomic<bool> ponder{ false };
+};
+
+struct SearchResult {
+    PackedMove bestMove{};
+    PackedMove ponderMove{};
+    int score{ 0 };
+    int depth{ 0 };
+    uint64_t nodes{ 0 };
+};
+
+class Search {
+public:
+    explicit Search(TranspositionTable &tt) : m_tt(tt) { Clear(); }
+    ~Search() = default;
+
+    //--------------------------------------------------
+    // Iterative deepening from @param pos (blocking).
+    // Call TranspositionTable::NewSearch() before each
+    // search that reuses the table.
+    //--------------------------------------------------
+    SearchResult Run(const Position &pos, const SearchLimits &limits);
+
+    //--------------------------------------------------
+    // Abort a running search / switch from pondering to
+    // the normal clock (safe from other threads)
+    //--------------------------------------------------
+    void Stop() { m_signals->stop.store(true, std::memory_order_relaxed); }
+    void PonderHit() { m_signals->ponder.store(false, std::memory_order_relaxed); }
+
+    //--------------------------------------------------
+    // Forget move ordering statistics (new game)
+    //--------------------------------------------------
+    void Clear();
+
+    void SetInfoCallback(SearchInfoCallback callback) { m_infoCallback = callback; }
+    void SetConfig(const SearchConfig &config) { m_config = config; }
+    const SearchConfig &GetConfig() const { return m_config; }
+    uint64_t GetNodes() const { return m_nodes.load(std::memory_order_relaxed); }
+    void ResetNodes() { m_nodes.store(0, std::memory_order_relaxed); }
+
+    //--------------------------------------------------
+    // Lazy SMP helper index (0 = main thread). Helpers
+    // start at staggered depths to diversify the tree.
+    //--------------------------------------------------
+    void SetThreadId(int threadId) { m_threadId = threadId; }
+
+    //--------------------------------------------------
+    // Use externally owned signals. Run() then leaves
+    // them untouched: the owner resets them before the
+    // search, so a stop sent right after it is not lost.
+    //--------------------------------------------------
+    void SetSignals(SearchSignals *signals) { m_signals = signals; }
+
+private:
+    int AlphaBeta(int alpha, int beta, int depth, int ply);
+    int Quiescence(int alpha, int beta, int ply);
+    bool ProbeTablebase(int alpha, int beta, int depth, int ply, int &score);
+    int Evaluate();
+    bool ShouldStop();
+    int64_t ElapsedMs() const;
+    void InitTimeManagement();
+    void CountNode()
+        { m_nodes.store(m_nodes.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed); }
+
+    void UpdatePv(int ply, PackedMove move);
+    void UpdateQuietStats(PackedMove bestMove, const PackedMove *quiets,
+                          size_t quietCount, int depth, int ply);
+
+    // Mate & tablebase scores are stored relative to the node, not the root
+    static int ScoreToTT(int score, int ply);
+    static int ScoreFromTT(int score, int ply);
+
+    TranspositionTable &m_tt;
+    Position m_pos{};
+    SearchLimits m_limits{};
+    SearchConfig m_config{};
+    SearchInfoCallback m_infoCallback{};
+
+    SearchSignals m_ownSignals{};
+    SearchSignals *m_signals{ &m_ownSignals };
+    std::atomic<uint64_t> m_nodes{ 0 };     // written by this thread only
+    int m_threadId{ 0 };
+    int m_rootDepth{ 0 };
+    int m_selDepth{ 0 };
+
+    // Tablebases: root moves kept by the root probe (empty =
+    // all) and the piece count probed in search (0 = off)
+    std::vector<PackedMove> m_rootMoves{};
+    int m_tbPieces{ 0 };
+
+    // Time management (0 = no limit)
+    std::chrono::steady_clock::time_point m_startTime{};
+    int64_t m_optimumMs{ 0 };   // do not start another iteration after this
+    int64_t m_maximumMs{ 0 };   // hard stop
+
+    // Null move state: the node was reached by a null move /
+    // null moves are off below this ply (verification search)
+    std::array<bool, MAX_PLY + 2> m_afterNull{};
+    int m_nullMoveMinPly{ 0 };
+
+    // Move ordering statistics
+    HistoryTable m_history{};
+    std::array<KillerMoves, MAX_PLY + 1> m_killers{};
+
+    // Per-thread cache of the classical pawn terms
+    PawnHashTable m_pawns{};
+
+    // Triangular principal variation table
+    std::array<std::array<PackedMove, MAX_PLY + 1>, MAX_PLY + 1> m_pv{};
+    std::array<int, MAX_PLY + 1> m_pvLength{};
+};
+
+} // namespace Shohih
+
+#endif // SEARCH_H
@@ -0,0 +1,93 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Lazy SMP: several searches of the same
+ *          position sharing one transposition table
+ **************************************************/
+
+#pragma once
+#ifndef SEARCH_POOL_H
+#define SEARCH_POOL_H
+
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <condition_variable>
+#include "mcts.h"
+
+namespace Shohih {
+
+class SearchPool {
+public:
+    using FinishCallback = std::function<void(const SearchResult &)>;
+
+    explicit SearchPool(TranspositionTable &tt, size_t numThreads=1);
+    ~SearchPool();
+
+    //--------------------------------------------------
+    // Number of search threads (waits for a running
+    // search to finish)
+    //--------------------------------------------------
+    void SetThreads(size_t numThreads);
+    size_t GetThreads() const { return m_workers.size(); }
+
+    //--------------------------------------------------
+    // Start searching in the background. The main
+    // thread reports progress through @param callback;
+    // @param onFinish runs on the search thread once the
+    // result is final. Infinite and ponder searches are
+    // only final after Stop() / PonderHit().
+    //--------------------------------------------------
+    void SetInfoCallback(SearchInfoCallback callback);
+    void SetConfig(const SearchConfig &config);
+    const SearchConfig &GetConfig() const { return m_workers.front()->GetConfig(); }
+    void Start(const Position &pos, const SearchLimits &limits, FinishCallback onFinish=nullptr);
+
+    //--------------------------------------------------
+    // Safe to call from any thread
+    //--------------------------------------------------
+    void Stop();
+    void PonderHit();
+    bool IsSearching() const { return m_searching.load(std::memory_order_acquire); }
+    uint64_t GetNodes() const;
+
+    //--------------------------------------------------
+    // Block until the current search has finished
+    //--------------------------------------------------
+    SearchResult Wait();
+
+    // Forget move ordering statistics & the MCTS tree (new game)
+    void Clear();
+
+    //--------------------------------------------------
+    // Search with MCTS instead of alpha-beta, on the
+    // same number of threads (waits for a running
+    // search). Change its options only while idle.
+    //--------------------------------------------------
+    void SetMctsMode(bool enabled);
+    bool IsMctsMode() const { return m_mctsMode; }
+    Mcts &GetMcts() { return m_mcts; }
+
+private:
+    void Worker(const Position &pos, const SearchLimits &limits, FinishCallback onFinish);
+
+    TranspositionTable &m_tt;
+    std::vector<std::unique_ptr<Search>> m_workers{};
+    SearchInfoCallback m_infoCallback{};
+    Mcts m_mcts{};
+    bool m_mctsMode{ false };
+
+    // Shared by all workers
+    SearchSignals m_signals{};
+
+    // Wakes the search thread on stop/ponderhit
+    std::mutex m_mutex{};
+    std::condition_variable m_cv{};
+
+    std::thread m_thread{};
+    std::atomic<bool> m_searching{ false };
+    SearchResult m_result{};
+};
+
+} // namespace Shohih
+
+#endif // SEARCH_POOL_H
@@ -0,0 +1,162 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Engine-vs-engine match harness: concurrent
+ *          games, clocks, adjudication, Elo & SPRT
+ **************************************************/
+
+#pragma once
+#ifndef SELFPLAY_H
+#define SELFPLAY_H
+
+#include <thread>
+#include "pgn.h"
+#include "search.h"
+
+namespace Shohih {
+
+//--------------------------------------------------
+// One side of the match: the in-process engine with
+// its own search switches and hash
+//--------------------------------------------------
+struct EngineSpec {
+    std::string name{ "Shohih" };
+    SearchConfig config{};
+    size_t hashMb{ 16 };
+};
+
+//--------------------------------------------------
+// Per-game clock: base + increment (ms). A fixed
+// node or depth budget per move replaces the clock.
+//--------------------------------------------------
+struct TimeControl {
+    int64_t baseMs{ 10000 };
+    int64_t incMs{ 100 };
+    uint64_t nodes{ 0 };
+    int depth{ 0 };
+};
+
+//--------------------------------------------------
+// Adjudication on top of the rules (0 = off): both
+// engines agree on a lost or dead drawn position for
+// a number of consecutive moves
+//--------------------------------------------------
+struct Adjudication {
+    int maxPlies{ 400 };        // then drawn
+    int resignScore{ 1000 };    // centipawns
+    int resignMoves{ 4 };
+    int drawScore{ 10 };
+    int drawMoves{ 8 };
+    int drawMinPly{ 80 };
+};
+
+enum class Termination : uint8_t {
+    CHECKMATE,
+    STALEMATE,
+    REPETITION,
+    FIFTY_MOVES,
+    INSUFFICIENT_MATERIAL,
+    TIME_FORFEIT,
+    RESIGN_ADJUDICATION,
+    DRAW_ADJUDICATION,
+    MAX_PLIES
+};
+const char *TerminationName(Termination termination);
+
+struct GameRecord {
+    size_t round{ 0 };              // 0-based game number
+    std::string startFen{};
+    std::vector<PackedMove> moves{};
+    bool firstEngineWhite{ true };
+    GameResult result{ GameResult::UNKNOWN };
+    Termination termination{ Termination::MAX_PLIES };
+    uint64_t nodes{ 0 };
+
+    // Result from the first engine's view: 1, 0.5 or 0
+    double FirstEngineScore() const;
+};
+
+//--------------------------------------------------
+// Sequential probability ratio test of H0: elo0 vs
+// H1: elo1 (logistic Elo, normal approximation)
+//--------------------------------------------------
+struct SprtOptions {
+    bool enabled{ false };
+    double elo0{ 0.0 };
+    double elo1{ 5.0 };
+    double alpha{ 0.05 };
+    double beta{ 0.05 };
+};
+
+enum class SprtVerdict : uint8_t {
+    CONTINUE,
+    ACCEPT_H0,
+    ACCEPT_H1
+};
+
+//--------------------------------------------------
+// Wins/draws/losses of the first engine
+//--------------------------------------------------
+struct MatchStats {
+    uint64_t wins{ 0 };
+    uint64_t draws{ 0 };
+    uint64_t losses{ 0 };
+
+    void Add(const GameRecord &game);
+    uint64_t Games() const { return wins + draws + losses; }
+    double Score() const;
+    double Elo() const;
+    double EloError() const;    // 95% confidence half-width
+    double Llr(const SprtOptions &sprt) const;
+    SprtVerdict Verdict(const SprtOptions &sprt) const;
+
+    static double EloToScore(double elo);
+    static double ScoreToElo(double score);
+    static double LowerBound(const SprtOptions &sprt);
+    static double UpperBound(const SprtOptions &sprt);
+};
+
+struct MatchOptions {
+    std::array<EngineSpec, 2> engines{};
+    TimeControl timeControl{};
+    Adjudication adjudication{};
+    SprtOptions sprt{};
+    size_t games{ 100 };
+    size_t concurrency{ std::max(1u, std::thread::hardware_concurrency()) };
+    std::string pgnPath{};      // empty = no PGN output
+    std::string event{ "Shohih self-play" };
+};
+
+//--------------------------------------------------
+// Play one game from @param fen (a worker thread's
+// searches are passed in so their hashes are reused)
+//--------------------------------------------------
+GameRecord PlayGame(const std::string &fen, Search &white, Search &black,
+    const TimeControl &timeControl, const Adjudication &adjudication);
+
+//--------------------------------------------------
+// Opening positions: FEN/EPD lines, or the first
+// @param plies moves of each game of a .pgn file
+//--------------------------------------------------
+ErrorCode LoadOpenings(const std::string &path, int plies, std::vector<std::string> &fens);
+
+//--------------------------------------------------
+// PGN text of a finished game
+//--------------------------------------------------
+std::string FormatPgn(const GameRecord &game, const MatchOptions &options);
+
+using GameCallback = std::function<void(const GameRecord &, const MatchStats &)>;
+
+//--------------------------------------------------
+// Run the match: one game per worker thread at a
+// time (every search single-threaded), each opening
+// played twice with colours reversed. Stops early on
+// an SPRT verdict (games in progress are finished).
+// @param onGame is called in completion order, one
+// game at a time.
+//--------------------------------------------------
+MatchStats RunMatch(const MatchOptions &options, const std::vector<std::string> &openings,
+    GameCallback onGame=GameCallback{});
+
+} // namespace Shohih
+
+#endif // SELFPLAY_H
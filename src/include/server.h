@@ -7,50 +7,98 @@
 #ifndef SERVER_H
 #define SERVER_H
 
+#include <memory>
 #include "httplib.h"
 #include "shohih_defs.h"
+#include "game_registry.h"
+#include "metrics.h"
+#include "websocket.h"
 
 namespace Shohih {
 
+// Default number of request handler threads
+constexpr size_t SERVER_THREADS{ 64 };
+
 class Server : public httplib::Server {
 public:
-    Server();
+    explicit Server(size_t threads=SERVER_THREADS);
     ~Server() = default;
 
     //--------------------------------------------------
-    // Main server API
+    // Main server API: HTTP on @param port, pushed
+    // moves over WebSocket on @param wsPort
     //--------------------------------------------------
-    void Listen();
+    void Listen(int port=8080, int wsPort=WEBSOCKET_PORT);
+
+    //--------------------------------------------------
+    // Restore the games journaled in @param options.dir
+    // and journal every change from now on (call
+    // before Listen). @return FILE_OPEN_ERROR |
+    // INVALID_FILE_FORMAT
+    //--------------------------------------------------
+    ErrorCode EnableJournal(const JournalOptions &options);
 
 private:
+    using MemberHandler = void (Server::*)(const httplib::Request&, httplib::Response&);
+
+    //--------------------------------------------------
+    // @param handler, timed & counted under @param
+    // endpoint (responses >= 400 count as errors)
+    //--------------------------------------------------
+    httplib::Server::Handler Instrumented(Endpoint endpoint, MemberHandler handler);
+
     //--------------------------------------------------
     // Manage clients
+    // /register?room=<id> => "<color> <room> <token>"
+    // (no room: a new room is created)
     //--------------------------------------------------
-    void RemoveClient(const httplib::Request &req);
-    void RegisterClient(const httplib::Request &req, httplib::Response &);
+    void RemoveClient(const httplib::Request &req, httplib::Response &resp);
+    void RegisterClient(const httplib::Request &req, httplib::Response &resp);
 
     //--------------------------------------------------
-    // Send the last move to clients
+    // Send the last move of the client's game
     //--------------------------------------------------
-    void SendMove(httplib::Response &);
+    void SendMove(const httplib::Request &req, httplib::Response &resp);
+
+    //--------------------------------------------------
+    // Send every move of the client's game after
+    // ?since=<seq> (to catch up after a reconnect)
+    //--------------------------------------------------
+    void SendMoves(const httplib::Request &req, httplib::Response &resp);
 
     //--------------------------------------------------
     // Receive a move from clients
     //--------------------------------------------------
-    void ReceiveMove(const httplib::Request &);
+    void ReceiveMove(const httplib::Request &req, httplib::Response &resp);
+
+    //--------------------------------------------------
+    // Counters, histograms & gauges in the Prometheus
+    // text format
+    //--------------------------------------------------
+    void SendMetrics(const httplib::Request &req, httplib::Response &resp);
+
+    // Request handler threads
+    const size_t m_threads;
 
     //--------------------------------------------------
-    // Last received move by the server
+    // Every game hosted by this server. Requests carry
+    // the session token from /register (?token=...).
     //--------------------------------------------------
-    Move m_lastMove = NULL_MOVE;
+    GameRegistry m_games{};
+
+    // Updated by the handlers of both transports
+    ServerMetrics m_metrics{};
 
     //--------------------------------------------------
-    // Number of connected clients (max = 2)
-    // First client gets white, Second client get black
+    // Push connections; moves sent over either
+    // transport reach both kinds of clients
     //--------------------------------------------------
-    uint8_t m_numConnectedClients{ 0 };
+    WsServer m_ws{ m_games };
+
+    // Write-ahead journal of m_games (none by default)
+    std::unique_ptr<GameJournal> m_journal{ nullptr };
 };
 
 } // namespace Shohih
 
-#endif // SERVER_H
\ No newline at end of file
+#endif // SERVER_H
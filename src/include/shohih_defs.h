@@ -82,7 +82,7 @@ constexpr int WINDOW_WIDTH = BOARD_SIZE * SQUARE_SIZE;
 constexpr int WINDOW_HEIGHT = WINDOW_WIDTH;
 constexpr int CIRCLE_RADIUS = 8;
 
-// Thread sleep time
+// Online mode: delay before retrying a failed server request
 constexpr int threadSleepTime = 200; // milliseconds
 
 
@@ -118,6 +118,13 @@ enum ErrorCode : uint8_t {
     INVALID_PIECE_TYPE,
     GAME_ALREADY_STARTED,
     NULL_CLIENT_PTR,
+    FILE_OPEN_ERROR,
+    INVALID_FILE_FORMAT,
+    INVALID_MOVE,
+    ROOM_FULL,
+    INVALID_ROOM,
+    INVALID_SESSION,
+    CONNECTION_FAILED,
 };
 
 // Game modes: Offline/Online
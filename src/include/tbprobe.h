@@ -0,0 +1,88 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Syzygy endgame tablebase probing (WDL &
+ *          DTZ). Tables are found by file name and
+ *          memory-mapped on first access.
+ *          https://github.com/syzygy1/tb
+ **************************************************/
+
+#pragma once
+#ifndef TBPROBE_H
+#define TBPROBE_H
+
+#include "position.h"
+
+namespace Shohih {
+namespace Tablebases {
+
+constexpr int MAX_TB_PIECES{ 7 };
+
+//--------------------------------------------------
+// Result for the side to move. Cursed wins and
+// blessed losses are draws under the 50-move rule.
+//--------------------------------------------------
+enum WdlScore : int {
+    WDL_LOSS = -2,
+    WDL_BLESSED_LOSS = -1,
+    WDL_DRAW = 0,
+    WDL_CURSED_WIN = 1,
+    WDL_WIN = 2
+};
+
+enum class ProbeState : uint8_t {
+    FAIL,               // table missing or unreadable
+    OK,
+    CHANGE_STM,         // DTZ table stores the other side to move
+    ZEROING_BEST_MOVE   // best move is a capture or a pawn move
+};
+
+//--------------------------------------------------
+// Register the .rtbw/.rtbz files in @param paths
+// (directories separated by ':'). Replaces previously
+// registered tables: do not call during a search.
+//  - @return number of tables found
+//--------------------------------------------------
+size_t Init(const std::string &paths);
+
+// Largest piece count covered (0 = no tables)
+int MaxPieces();
+
+//--------------------------------------------------
+// In-search probes stop at this remaining depth when
+// the position has MaxPieces() pieces (UCI option
+// SyzygyProbeDepth)
+//--------------------------------------------------
+void SetProbeDepth(int depth);
+int GetProbeDepth();
+
+//--------------------------------------------------
+// Probes temporarily make moves on @param pos (en
+// passant and zeroing captures are resolved by a
+// small search); it is restored before returning.
+//--------------------------------------------------
+WdlScore ProbeWdl(Position &pos, ProbeState &state);
+
+//--------------------------------------------------
+// Plies to the next zeroing move on the optimal path:
+// > 0 winning, < 0 losing, 0 drawn. Cursed wins and
+// blessed losses are offset by 100.
+//--------------------------------------------------
+int ProbeDtz(Position &pos, ProbeState &state);
+
+//--------------------------------------------------
+// Root move filter. Moves are ranked by DTZ (WDL if
+// the DTZ table is missing) taking the 50-move
+// counter into account; only the best-ranked ones
+// are kept.
+//--------------------------------------------------
+struct RootProbe {
+    std::vector<PackedMove> moves{};
+    int rank{ 0 };      // > 0 win, 0 draw, < 0 loss; +-1000 = not spoiled by the 50-move rule
+    bool dtz{ false };  // ranked by DTZ
+};
+bool ProbeRoot(Position &pos, RootProbe &result);
+
+} // namespace Tablebases
+} // namespace Shohih
+
+#endif // TBPROBE_H
@@ -0,0 +1,85 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Transposition table (shared by search threads)
+ **************************************************/
+
+#pragma once
+#ifndef TT_H
+#define TT_H
+
+#include <atomic>
+#include <memory>
+#include "position.h"
+
+namespace Shohih {
+
+class TranspositionTable {
+public:
+    //--------------------------------------------------
+    // Score bound stored with an entry
+    //--------------------------------------------------
+    enum Bound : uint8_t {
+        BOUND_NONE,
+        BOUND_UPPER,
+        BOUND_LOWER,
+        BOUND_EXACT = BOUND_UPPER | BOUND_LOWER
+    };
+
+    //--------------------------------------------------
+    // Decoded entry returned by Probe()
+    //--------------------------------------------------
+    struct Entry {
+        PackedMove move{};
+        int score{ 0 };
+        int eval{ 0 };
+        int depth{ 0 };
+        Bound bound{ BOUND_NONE };
+    };
+
+    TranspositionTable(size_t megabytes=16) { Resize(megabytes); }
+    ~TranspositionTable() = default;
+
+    //--------------------------------------------------
+    // Table management
+    //--------------------------------------------------
+    void Resize(size_t megabytes);
+    void Clear();
+    void NewSearch() { m_generation = (m_generation + 1) & GENERATION_MASK; }
+
+    //--------------------------------------------------
+    // Probe & store (lock-free, safe across threads)
+    //--------------------------------------------------
+    bool Probe(uint64_t key, Entry &entry) const;
+    void Store(uint64_t key, PackedMove move, int score, int eval, int depth, Bound bound);
+
+    // Permille of used entries (UCI "hashfull")
+    int Hashfull() const;
+
+private:
+    //--------------------------------------------------
+    // Slot layout: key is stored XOR-ed with the data so
+    // a torn write from another thread fails the key check.
+    // data: move 16 | score 16 | eval 16 | depth 8 | bound 2 | generation 6
+    //--------------------------------------------------
+    struct Slot {
+        std::atomic<uint64_t> keyXorData;
+        std::atomic<uint64_t> data;
+    };
+    static constexpr size_t CLUSTER_SIZE{ 4 };
+    static constexpr uint8_t GENERATION_MASK{ 0x3F };
+
+    static uint64_t Pack(PackedMove move, int score, int eval, int depth,
+                         Bound bound, uint8_t generation);
+    static Entry Unpack(uint64_t data);
+
+    Slot *GetCluster(uint64_t key) const
+        { return &m_slots[(key & (m_numClusters - 1)) * CLUSTER_SIZE]; }
+
+    std::unique_ptr<Slot[]> m_slots{ nullptr };
+    size_t m_numClusters{ 0 };
+    uint8_t m_generation{ 0 };
+};
+
+} // namespace Shohih
+
+#endif // TT_H
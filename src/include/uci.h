@@ -0,0 +1,78 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   UCI protocol front end
+ *          https://www.shredderchess.com/chess-features/uci-universal-chess-interface.html
+ **************************************************/
+
+#pragma once
+#ifndef UCI_H
+#define UCI_H
+
+#include <deque>
+#include <sstream>
+#include "book.h"
+#include "search_pool.h"
+
+namespace Shohih {
+
+class Uci {
+public:
+    Uci(std::istream &in, std::ostream &out);
+    ~Uci();
+
+    //--------------------------------------------------
+    // Process commands until "quit" or end of input.
+    // End of input lets a running search finish first,
+    // so scripted sessions can be piped in.
+    //--------------------------------------------------
+    void Loop();
+
+    //--------------------------------------------------
+    // Helpers shared with the tests
+    //--------------------------------------------------
+    static std::string FormatScore(int score);
+    static ErrorCode ParsePosition(std::istringstream &args, Position &pos);
+    static SearchLimits ParseGo(std::istringstream &args);
+
+private:
+    //--------------------------------------------------
+    // Input thread: "stop" and "ponderhit" act at once,
+    // everything else is queued for the main thread
+    //--------------------------------------------------
+    void ReadInput();
+    bool NextCommand(std::string &line);
+
+    void Execute(const std::string &line);
+    void CmdUci();
+    void CmdSetOption(std::istringstream &args);
+    void CmdGo(std::istringstream &args);
+    void CmdBench(std::istringstream &args);
+    void FinishPendingSearch();
+
+    void Send(const std::string &line);
+    void SendInfo(const SearchInfo &info);
+    void SendBestMove(const SearchResult &result);
+
+    std::istream &m_in;
+    std::ostream &m_out;
+    std::mutex m_outMutex{};
+
+    TranspositionTable m_tt{};
+    SearchPool m_pool;
+    Position m_pos{};
+    SearchLimits m_lastLimits{};
+
+    // Opening book (used when OwnBook is set)
+    OpeningBook m_book{};
+    bool m_ownBook{ false };
+
+    // Commands waiting for the main thread
+    std::mutex m_queueMutex{};
+    std::condition_variable m_queueCv{};
+    std::deque<std::string> m_queue{};
+    bool m_executing{ false };
+};
+
+} // namespace Shohih
+
+#endif // UCI_H
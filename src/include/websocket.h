@@ -0,0 +1,194 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   WebSocket (RFC 6455) push transport for
+ *          online games: frames, connections and the
+ *          server side endpoint
+ **************************************************/
+
+#pragma once
+#ifndef WEBSOCKET_H
+#define WEBSOCKET_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "shohih_defs.h"
+#include "game_registry.h"
+#include "metrics.h"
+
+namespace Shohih {
+
+// Port of the WebSocket endpoint (the HTTP API stays on 8080)
+constexpr int WEBSOCKET_PORT{ 8081 };
+
+// Pings keep idle connections alive; a peer silent for
+// WEBSOCKET_PING_TIMEOUTS intervals is disconnected
+constexpr std::chrono::milliseconds WEBSOCKET_PING_INTERVAL{ 15000 };
+constexpr int WEBSOCKET_PING_TIMEOUTS{ 3 };
+
+// Largest accepted frame payload (messages are a few bytes)
+constexpr size_t WEBSOCKET_MAX_PAYLOAD{ 4096 };
+
+// Connections served at once (one thread each); more
+// are refused and those clients fall back to HTTP
+constexpr size_t WEBSOCKET_MAX_CONNECTIONS{ 10000 };
+
+enum class WsOpcode : uint8_t {
+    CONTINUATION = 0x0,
+    TEXT = 0x1,
+    BINARY = 0x2,
+    CLOSE = 0x8,
+    PING = 0x9,
+    PONG = 0xA
+};
+
+struct WsFrame {
+    WsOpcode opcode{ WsOpcode::TEXT };
+    std::string payload{};
+};
+
+//--------------------------------------------------
+// Move messages shared by HTTP & WebSocket:
+// "<square>-<square> <seq>" ("null-null" = no move)
+//--------------------------------------------------
+std::string FormatMoveMessage(const Move &move, uint64_t seq);
+bool ParseMoveMessage(const std::string &message, Move &move, uint64_t &seq);
+
+//--------------------------------------------------
+// Move lists of /getmoves: "<seq> <move> <move> ..."
+// (@param seq = sequence number of the last move)
+//--------------------------------------------------
+std::string FormatMoveList(const std::vector<Move> &moves, uint64_t seq);
+bool ParseMoveList(const std::string &message, std::vector<Move> &moves, uint64_t &seq);
+
+//--------------------------------------------------
+// Sec-WebSocket-Accept value for a handshake key
+//--------------------------------------------------
+std::string WsAcceptKey(const std::string &key);
+
+//--------------------------------------------------
+// Single unfragmented frame. Clients mask their frames.
+//--------------------------------------------------
+std::string EncodeWsFrame(WsOpcode opcode, const std::string &payload, bool mask);
+
+//--------------------------------------------------
+// Decode the frame at the front of @param buffer.
+// @param fromClient: client frames must be masked,
+// server frames must not be (RFC 6455, section 5.1).
+// @return bytes consumed, 0 if the frame is incomplete,
+// std::string::npos on a protocol error
+//--------------------------------------------------
+size_t DecodeWsFrame(const std::string &buffer, WsFrame &frame, bool fromClient);
+
+//--------------------------------------------------
+// An open WebSocket. One thread receives; any thread
+// may send.
+//--------------------------------------------------
+class WsConnection {
+public:
+    WsConnection(int fd, bool client, std::string buffered="");
+    ~WsConnection();
+    WsConnection(const WsConnection&) = delete;
+    WsConnection &operator=(const WsConnection&) = delete;
+
+    //--------------------------------------------------
+    // Open ws://@param host:@param port@param path
+    // @return nullptr on failure (e.g. rejected token)
+    //--------------------------------------------------
+    static std::shared_ptr<WsConnection> Connect(const std::string &host, int port,
+        const std::string &path, std::chrono::milliseconds timeout=WEBSOCKET_PING_INTERVAL * WEBSOCKET_PING_TIMEOUTS);
+
+    bool Send(WsOpcode opcode, const std::string &payload);
+
+    //--------------------------------------------------
+    // Block until the next frame (control frames too)
+    // @return false once the connection is closed
+    //--------------------------------------------------
+    bool Receive(WsFrame &frame);
+
+    //--------------------------------------------------
+    // Unblock Receive() & fail further sends
+    //--------------------------------------------------
+    void Shutdown();
+
+    //--------------------------------------------------
+    // Time of the last received frame (steady clock)
+    //--------------------------------------------------
+    std::chrono::steady_clock::time_point LastSeen() const;
+
+private:
+    const int m_fd;
+    const bool m_client;
+    std::string m_buffer;
+    std::mutex m_sendMutex{};
+    std::atomic<int64_t> m_lastSeen;
+};
+
+//--------------------------------------------------
+// Server side endpoint: GET /ws?token=<session token>
+// Pushes "<move> <seq>" frames of the player's game
+// (the current state right after connecting), takes
+// "<square>-<square>" frames and answers them with
+// "ack <seq>" | "fail" | "retry" (the journal could
+// not record the move; send it again later).
+//--------------------------------------------------
+class WsServer {
+public:
+    explicit WsServer(GameRegistry &games, std::chrono::milliseconds pingInterval=WEBSOCKET_PING_INTERVAL,
+        size_t maxConnections=WEBSOCKET_MAX_CONNECTIONS);
+    ~WsServer();
+
+    //--------------------------------------------------
+    // Listen on @param port (0 = any free port) in
+    // background threads. @return false on failure
+    //--------------------------------------------------
+    bool Start(int port=WEBSOCKET_PORT);
+    void Stop();
+    int GetPort() const { return m_port; }
+
+    //--------------------------------------------------
+    // Push a move to the connection of @param token
+    // (no-op for players without one)
+    //--------------------------------------------------
+    void Push(const std::string &token, const Move &move, uint64_t seq);
+
+    size_t NumConnections() const;
+
+    //--------------------------------------------------
+    // Time move frames & count moves in @param metrics
+    // (nullptr = none; set before Start())
+    //--------------------------------------------------
+    void SetMetrics(ServerMetrics *metrics) { m_metrics = metrics; }
+
+private:
+    void AcceptLoop();
+    void Serve(int fd);
+    void PingLoop();
+    void HandleMove(const std::string &token, WsConnection &conn, const std::string &message);
+
+    GameRegistry &m_games;
+    const std::chrono::milliseconds m_pingInterval;
+    const size_t m_maxConnections;
+    ServerMetrics *m_metrics{ nullptr };
+
+    int m_listenFd{ -1 };
+    int m_port{ 0 };
+    std::atomic<bool> m_running{ false };
+    std::thread m_acceptThread{};
+    std::thread m_pingThread{};
+
+    // Open connections by session token; guarded by m_mutex
+    mutable std::mutex m_mutex{};
+    std::condition_variable m_cv{};
+    std::unordered_map<std::string, std::shared_ptr<WsConnection>> m_connections{};
+    size_t m_numServing{ 0 };   // connection threads still running
+};
+
+} // namespace Shohih
+
+#endif // WEBSOCKET_H
@@ -11,7 +11,7 @@ int main(int argc, char **argv)
 {
     // Game mode (offline|online)
     Shohih::GameMode gameMode;
-    std::string addr;
+    std::string addr, room;
 
     // Parse arguments
     std::string progName(argv[0]);
@@ -38,11 +38,19 @@ int main(int argc, char **argv)
         }
         addr = argv[4];
         addr += std::string(":8080");
+        if (argc >= 7) {
+            std::string roomFlag(argv[5]);
+            if (roomFlag != "-r" && roomFlag != "--room") {
+                PrintUsage(progName);
+                return 0;
+            }
+            room = argv[6];
+        }
     }
     gameMode = (mode == "online") ? Shohih::GameMode::ONLINE : Shohih::GameMode::OFFLINE;
 
     // Create a game object
-    Shohih::Game game(gameMode, addr);
+    Shohih::Game game(gameMode, addr, room);
 
     // This function will not return unless ESC key is pressed,
     // window is closed, or program is killed with Ctrl+C.
@@ -56,8 +64,10 @@ void PrintUsage(const std::string &progName)
         << "Options:\n"
         << "-m, --mode\tSelect game mode (online|offline)\n"
         << "-u, --host\tSet server address in online mode\n"
+        << "-r, --room\tJoin a game room in online mode (default: open a new room)\n"
         << "Example: ./shohih_main --mode offline\n"
         << "Example: ./shohih_main -m online --host 10.12.24.36\n"
+        << "Example: ./shohih_main -m online --host 10.12.24.36 --room 3f9a61c2\n"
         << "NOTE: Server address can be ip address or url\n"
         << "NOTE: Server is listening on port 8080\n"
         << COLOR_DEFAULT << std::endl;
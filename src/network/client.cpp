@@ -3,6 +3,8 @@
  * @brief   Shohih Client Implementation
  **************************************************/
 
+#include <algorithm>
+#include <cstdlib>
 #include <sstream>
 #include "client.h"
 
@@ -11,12 +13,17 @@ namespace Shohih {
 /**************************************************
  * @details
  *      Client constructor. Registers to the server
- *      gets the player's color
+ *      in room @param room, gets the player's color
+ *      and the session token
  **************************************************/
-Client::Client(const std::string &addr) : httplib::Client(addr), m_addr(addr)
+Client::Client(const std::string &addr, const std::string &room) :
+    httplib::Client(addr), m_addr(addr), m_room(room)
 {
+    // Long polls stay open for up to MOVE_POLL_TIMEOUT_MS
+    set_read_timeout(MOVE_POLL_TIMEOUT_MS / 1000 + 5, 0);
+
     // Register to the server
-    auto resp = Get("/register");
+    auto resp = Get(room.empty() ? "/register" : "/register?room=" + room);
     // Check connection status
     if (resp.error() == httplib::Error::Connection) {
         ERROR_LOG("Failed to connect to Shohih server (" << addr << ")");
@@ -29,62 +36,233 @@ Client::Client(const std::string &addr) : httplib::Client(addr), m_addr(addr)
         ERROR_LOG("Failed to register to Shohih server (" << addr << ")");
         ERROR_LOG("Server returned status code " << resp->status);
     }
-    // Set player's color
-    std::string playerColor = resp->body;
+    // Body: <color> <room> <token>
+    std::istringstream body(resp->body);
+    std::string playerColor;
+    body >> playerColor >> m_room >> m_token;
     if (UNLIKELY(playerColor == "fail")) {
-        ERROR_LOG("Failed to register to the server. Server is already serving 2 clients");
+        ERROR_LOG("Failed to register to the server. Room " << room << " is already serving 2 clients");
     } else if (playerColor == "white") {
         m_playerColor = PieceColor::WHITE;
+        INFO_LOG("Joined room " << m_room << " (share it with your opponent)");
     } else if (playerColor == "black") {
         m_playerColor = PieceColor::BLACK;
+        INFO_LOG("Joined room " << m_room);
+    }
+    if (!m_token.empty()) {
+        ConnectWebSocket();
+    }
+}
+
+/**************************************************
+ * @details
+ *      Client destructor: closes the push connection
+ **************************************************/
+Client::~Client()
+{
+    if (m_ws != nullptr) {
+        m_ws->Shutdown();
+    }
+    if (m_wsReader.joinable()) {
+        m_wsReader.join();
+    }
+}
+
+/**************************************************
+ * @details
+ *      Opens the WebSocket push connection on the
+ *      server's host. Older servers have none: the
+ *      client then keeps using HTTP long polling.
+ **************************************************/
+void Client::ConnectWebSocket()
+{
+    // <scheme>://<host>:<port>/... => <host>
+    std::string host = m_addr;
+    const size_t scheme = host.find("://");
+    if (scheme != std::string::npos) {
+        host = host.substr(scheme + 3);
+    }
+    host = host.substr(0, host.find('/'));
+    const size_t port = host.rfind(':');
+    if (port != std::string::npos && host.find(']') == std::string::npos) {
+        host = host.substr(0, port);
+    }
+    m_ws = WsConnection::Connect(host, WEBSOCKET_PORT, "/ws?token=" + m_token);
+    if (m_ws == nullptr) {
+        INFO_LOG("No WebSocket endpoint on the server (or it is full), using HTTP long polling");
+        return;
+    }
+    m_wsReader = std::thread(&Client::ReadPushes, this);
+}
+
+/**************************************************
+ * @details
+ *      Push connection reader: keeps the newest move
+ *      of the game, collects acks of our own moves
+ *      and answers pings.
+ **************************************************/
+void Client::ReadPushes()
+{
+    WsFrame frame;
+    while (m_ws->Receive(frame)) {
+        if (frame.opcode == WsOpcode::PING) {
+            m_ws->Send(WsOpcode::PONG, frame.payload);
+            continue;
+        }
+        if (frame.opcode != WsOpcode::TEXT) {
+            continue;
+        }
+        Move move = NULL_MOVE;
+        uint64_t seq{ 0 };
+        std::lock_guard<std::mutex> lock(m_wsMutex);
+        if (frame.payload == "fail" || frame.payload == "retry") {
+            m_wsAcks++;
+            m_wsAckSeq = 0;
+            m_wsAckError = (frame.payload == "fail") ? INVALID_MOVE : FILE_OPEN_ERROR;
+        } else if (frame.payload.compare(0, 4, "ack ") == 0) {
+            m_wsAcks++;
+            m_wsAckSeq = std::strtoull(frame.payload.c_str() + 4, nullptr, 10);
+            m_wsAckError = SUCCESS;
+        } else if (ParseMoveMessage(frame.payload, move, seq) && seq >= m_gameSeq) {
+            m_gameMove = move;
+            m_gameSeq = seq;
+        }
+        m_wsCv.notify_all();
     }
+    std::lock_guard<std::mutex> lock(m_wsMutex);
+    m_wsClosed = true;
+    m_wsCv.notify_all();
 }
 
 /**************************************************
  * @details
- *      Sends /exit request to server.
+ *      Sends /exit request to server. A separate
+ *      connection is used, since this one may be held
+ *      by a long poll; leaving wakes that poll up.
  **************************************************/
 void Client::Exit()
 {
-    Get("/exit");
+    if (m_exited.exchange(true)) {
+        return;
+    }
+    httplib::Client(m_addr).Get("/exit?token=" + m_token);
+    if (m_ws != nullptr) {
+        m_ws->Shutdown();
+    }
 }
 
 /**************************************************
  * @details
- *      Client sends an http request to /getmove directory
- *      of server. If an invalid or previous move is returned,
- *      client waits for 0.1 seconds and send another request.
+ *      With a push connection, waits up to @param
+ *      waitMs for a move newer than the last one seen.
+ *      Otherwise the client sends an http request to
+ *      /getmove directory of server with the last
+ *      sequence number it has seen. The server answers
+ *      at once if the game has moved on, otherwise
+ *      after a new move or @param waitMs.
+ *      Body: <square str>-<square str> <seq>
  **************************************************/
-Move Client::GetMove()
+Move Client::GetMove(int64_t waitMs)
 {
-    auto resp = Get("/getmove");
-    std::string move_str = resp->body;
-    auto separator = move_str.find('-');
-    // move_str does not contain separator '-'
-    if (UNLIKELY(separator == std::string::npos)) {
+    waitMs = std::min(std::max<int64_t>(waitMs, 0), MOVE_POLL_TIMEOUT_MS);
+    if (m_ws != nullptr) {
+        std::unique_lock<std::mutex> lock(m_wsMutex);
+        m_wsCv.wait_for(lock, std::chrono::milliseconds(waitMs),
+            [this]() { return m_gameSeq > m_lastSeq || m_wsClosed; });
+        // A closed connection falls back to HTTP
+        if (m_gameSeq > m_lastSeq || !m_wsClosed) {
+            m_lastSeq = std::max(m_lastSeq, m_gameSeq);
+            return m_gameMove;
+        }
+    }
+    auto resp = Get("/getmove?token=" + m_token + "&since=" + std::to_string(m_lastSeq) +
+        "&wait=" + std::to_string(waitMs));
+    if (UNLIKELY(!resp || resp->status != 200)) {
         return NULL_MOVE;
     }
-    // server returned "null-null"
-    std::string sq1_str = move_str.substr(0, separator);
-    std::string sq2_str = move_str.substr(separator + 1);
-    if (UNLIKELY(sq1_str == "null" || sq2_str == "null")) {
+    Move move = NULL_MOVE;
+    uint64_t seq{ 0 };
+    if (UNLIKELY(!ParseMoveMessage(resp->body, move, seq))) {
         return NULL_MOVE;
     }
-    return Move {
-        Square::GetSquareByName(sq1_str),
-        Square::GetSquareByName(sq2_str)
-    };
+    m_lastSeq = seq;
+    return move;
+}
+
+/**************************************************
+ * @details
+ *      A push connection delivers moves one by one;
+ *      /getmoves is asked for the missing ones when
+ *      there is a gap (e.g. after joining a game in
+ *      progress) or the connection is gone.
+ *      Body: <seq> <square str>-<square str> ...
+ **************************************************/
+ErrorCode Client::GetMoves(std::vector<Move> &moves, int64_t waitMs)
+{
+    moves.clear();
+    waitMs = std::min(std::max<int64_t>(waitMs, 0), MOVE_POLL_TIMEOUT_MS);
+    if (m_ws != nullptr) {
+        std::unique_lock<std::mutex> lock(m_wsMutex);
+        m_wsCv.wait_for(lock, std::chrono::milliseconds(waitMs),
+            [this]() { return m_gameSeq > m_lastSeq || m_wsClosed; });
+        if (m_gameSeq == m_lastSeq + 1) {
+            moves.push_back(m_gameMove);
+            m_lastSeq = m_gameSeq;
+            return SUCCESS;
+        }
+        if (m_gameSeq <= m_lastSeq && !m_wsClosed) {
+            return SUCCESS;
+        }
+        waitMs = 0;
+    }
+    return FetchMoves(m_lastSeq, waitMs, moves);
+}
+
+ErrorCode Client::GetAllMoves(std::vector<Move> &moves)
+{
+    return FetchMoves(0, 0, moves);
 }
 
 /**************************************************
  * @details
- *      Client posts the move to /sendmove dir of
+ *      Ask /getmoves for the moves after @param since
+ *      (they count as seen from then on).
+ **************************************************/
+ErrorCode Client::FetchMoves(uint64_t since, int64_t waitMs, std::vector<Move> &moves)
+{
+    moves.clear();
+    auto resp = Get("/getmoves?token=" + m_token + "&since=" + std::to_string(since) +
+        "&wait=" + std::to_string(waitMs));
+    if (UNLIKELY(!resp)) {
+        return CONNECTION_FAILED;
+    }
+    uint64_t seq{ 0 };
+    if (UNLIKELY(resp->status != 200 || !ParseMoveList(resp->body, moves, seq))) {
+        return INVALID_SESSION;
+    }
+    m_lastSeq = std::max(m_lastSeq, seq);
+    if (m_ws != nullptr && !moves.empty()) {
+        std::lock_guard<std::mutex> lock(m_wsMutex);
+        if (seq > m_gameSeq) {
+            m_gameMove = moves.back();
+            m_gameSeq = seq;
+        }
+    }
+    return SUCCESS;
+}
+
+/**************************************************
+ * @details
+ *      Client sends the move as a frame over the push
+ *      connection, or posts it to /sendmove dir of
  *      server inside request body with plain text format.
+ *      The reply is the move's sequence number, so the
+ *      next GetMove() waits for the opponent's move.
  **************************************************/
-void Client::SendMove(const Move &move)
+ErrorCode Client::SendMove(const Move &move)
 {
     if (move == m_lastMove) {
-        return;
+        return SUCCESS;
     }
     std::stringstream move_ss;
     if (UNLIKELY(!move.first.IsValid() || !move.second.IsValid())) {
@@ -93,8 +271,43 @@ void Client::SendMove(const Move &move)
         move_ss << move.first.GetSquareName() << "-"
                 << move.second.GetSquareName();
     }
-    Post("/sendmove", move_ss.str(), "text/plain");
+    if (m_ws != nullptr) {
+        std::unique_lock<std::mutex> lock(m_wsMutex);
+        const uint64_t acks = m_wsAcks;
+        lock.unlock();
+        if (m_ws->Send(WsOpcode::TEXT, move_ss.str())) {
+            lock.lock();
+            m_wsCv.wait_for(lock, std::chrono::milliseconds(WS_ACK_TIMEOUT_MS),
+                [this, acks]() { return m_wsAcks != acks || m_wsClosed; });
+            if (m_wsAcks != acks) {
+                if (UNLIKELY(m_wsAckError != SUCCESS)) {
+                    return m_wsAckError;
+                }
+                if (m_wsAckSeq >= m_gameSeq) {
+                    m_gameMove = move;
+                    m_gameSeq = m_wsAckSeq;
+                }
+                m_lastSeq = std::max(m_lastSeq, m_wsAckSeq);
+                m_lastMove = move;
+                return SUCCESS;
+            }
+        }
+    }
+    auto resp = Post("/sendmove?token=" + m_token, move_ss.str(), "text/plain");
+    if (UNLIKELY(!resp)) {
+        return CONNECTION_FAILED;
+    }
+    if (UNLIKELY(resp->status != 200)) {
+        if (resp->status == STATUS_REJECTED_MOVE) {
+            return INVALID_MOVE;
+        }
+        return (resp->status == STATUS_RETRY_MOVE) ? FILE_OPEN_ERROR : CONNECTION_FAILED;
+    }
+    if (!resp->body.empty()) {
+        m_lastSeq = std::strtoull(resp->body.c_str(), nullptr, 10);
+    }
     m_lastMove = move;
+    return SUCCESS;
 }
 
-} // namespace Shohih
\ No newline at end of file
+} // namespace Shohih
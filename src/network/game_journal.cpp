@@ -0,0 +1,851 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Game journal Implementation
+ **************************************************/
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+#include "game_journal.h"
+#include "game_registry.h"
+
+namespace Shohih {
+
+namespace {
+
+//--------------------------------------------------
+// Segment record: [u32 length][u32 checksum][payload]
+// JOIN:  type, color, room, token
+// LEAVE: type, color, room
+// MOVE:  type, room, u16 from << 6 | to
+// (strings: u8 length + bytes, integers in host order)
+//--------------------------------------------------
+enum class RecordType : uint8_t {
+    JOIN = 1,
+    LEAVE = 2,
+    MOVE = 3
+};
+
+constexpr size_t RECORD_HEADER_SIZE{ 8 };
+
+// Snapshot: magic, version, last covered segment,
+// number of games, games, u64 checksum
+constexpr uint32_t SNAPSHOT_MAGIC{ 0x4E534853 };   // "SHSN"
+constexpr uint32_t SNAPSHOT_VERSION{ 1 };
+
+constexpr const char *SEGMENT_PREFIX{ "journal-" };
+constexpr const char *SEGMENT_SUFFIX{ ".log" };
+
+uint32_t Checksum32(const char *data, size_t size)
+{
+    uint32_t hash{ 2166136261u };
+    for (size_t i{ 0 }; i < size; i++) {
+        hash = (hash ^ static_cast<uint8_t>(data[i])) * 16777619u;
+    }
+    return hash;
+}
+
+uint64_t Checksum64(const char *data, size_t size)
+{
+    uint64_t hash{ 14695981039346656037ull };
+    for (size_t i{ 0 }; i < size; i++) {
+        hash = (hash ^ static_cast<uint8_t>(data[i])) * 1099511628211ull;
+    }
+    return hash;
+}
+
+template <typename T>
+void Put(std::string &out, T value)
+{
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void PutString(std::string &out, const std::string &str)
+{
+    Put<uint8_t>(out, static_cast<uint8_t>(str.size()));
+    out += str;
+}
+
+uint16_t PackMove(const Move &move)
+{
+    return static_cast<uint16_t>((ToSquareId(move.first) << 6) | ToSquareId(move.second));
+}
+
+Move UnpackMove(uint16_t packed)
+{
+    return Move{ ToSquare(static_cast<SquareId>((packed >> 6) & 0x3F)),
+                 ToSquare(static_cast<SquareId>(packed & 0x3F)) };
+}
+
+//--------------------------------------------------
+// Bounds-checked reads from a mapped file
+//--------------------------------------------------
+class Reader {
+public:
+    Reader(const char *data, size_t size) : m_pos(data), m_end(data + size) {}
+
+    bool Read(void *dst, size_t size)
+    {
+        if (static_cast<size_t>(m_end - m_pos) < size) {
+            return false;
+        }
+        std::memcpy(dst, m_pos, size);
+        m_pos += size;
+        return true;
+    }
+
+    template <typename T>
+    bool Get(T &value) { return Read(&value, sizeof(T)); }
+
+    bool GetString(std::string &str)
+    {
+        uint8_t length{ 0 };
+        if (!Get(length) || static_cast<size_t>(m_end - m_pos) < length) {
+            return false;
+        }
+        str.assign(m_pos, length);
+        m_pos += length;
+        return true;
+    }
+
+    size_t Remaining() const { return static_cast<size_t>(m_end - m_pos); }
+
+private:
+    const char *m_pos;
+    const char *m_end;
+};
+
+//--------------------------------------------------
+// Read-only mapping of a whole file
+//--------------------------------------------------
+class MappedFile {
+public:
+    explicit MappedFile(const std::string &path)
+    {
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) == 0) {
+            m_exists = true;
+            if (st.st_size > 0) {
+                void *addr = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (addr != MAP_FAILED) {
+                    m_data = static_cast<const char*>(addr);
+                    m_size = static_cast<size_t>(st.st_size);
+                    ::madvise(addr, m_size, MADV_SEQUENTIAL);
+                } else {
+                    m_exists = false;
+                }
+            }
+        }
+        ::close(fd);
+    }
+    ~MappedFile()
+    {
+        if (m_data != nullptr) {
+            ::munmap(const_cast<char*>(m_data), m_size);
+        }
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile &operator=(const MappedFile&) = delete;
+
+    bool Exists() const { return m_exists; }
+    const char *Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+
+private:
+    bool m_exists{ false };
+    const char *m_data{ nullptr };
+    size_t m_size{ 0 };
+};
+
+//--------------------------------------------------
+// A game as the journal knows it
+//--------------------------------------------------
+struct JournaledGame {
+    std::array<std::string, NUM_PIECE_COLORS> tokens{};
+    std::vector<uint16_t> moves{};
+};
+using JournaledGames = std::unordered_map<std::string, JournaledGame>;
+
+//--------------------------------------------------
+// Apply one record payload. A game is dropped when
+// both seats are free, like GameRegistry::Leave().
+// @return false (and change nothing) if malformed
+//--------------------------------------------------
+bool ApplyRecord(const char *data, size_t size, JournaledGames &games)
+{
+    Reader reader(data, size);
+    uint8_t type{ 0 };
+    uint8_t color{ 0 };
+    std::string room;
+    if (!reader.Get(type)) {
+        return false;
+    }
+    switch (static_cast<RecordType>(type)) {
+    case RecordType::JOIN: {
+        std::string token;
+        if (!reader.Get(color) || color >= NUM_PIECE_COLORS ||
+            !reader.GetString(room) || !reader.GetString(token)) {
+            return false;
+        }
+        games[room].tokens[color] = std::move(token);
+        return true;
+    }
+    case RecordType::LEAVE: {
+        if (!reader.Get(color) || color >= NUM_PIECE_COLORS || !reader.GetString(room)) {
+            return false;
+        }
+        auto it = games.find(room);
+        if (it != games.end()) {
+            it->second.tokens[color].clear();
+            if (it->second.tokens[0].empty() && it->second.tokens[1].empty()) {
+                games.erase(it);
+            }
+        }
+        return true;
+    }
+    case RecordType::MOVE: {
+        uint16_t move{ 0 };
+        if (!reader.GetString(room) || !reader.Get(move)) {
+            return false;
+        }
+        auto it = games.find(room);
+        if (it != games.end()) {
+            it->second.moves.push_back(move);
+        }
+        return true;
+    }
+    }
+    return false;
+}
+
+//--------------------------------------------------
+// Apply the records of a segment up to the first
+// torn or corrupt one (an interrupted write).
+// @return number of records applied
+//--------------------------------------------------
+size_t ReplaySegment(const std::string &path, JournaledGames &games)
+{
+    MappedFile file(path);
+    if (!file.Exists()) {
+        WARNING_LOG("Cannot read journal segment " << path);
+        return 0;
+    }
+    const char *data = file.Data();
+    const size_t size = file.Size();
+    size_t offset{ 0 };
+    size_t records{ 0 };
+    while (size - offset >= RECORD_HEADER_SIZE) {
+        uint32_t length{ 0 };
+        uint32_t checksum{ 0 };
+        std::memcpy(&length, data + offset, sizeof(length));
+        std::memcpy(&checksum, data + offset + sizeof(length), sizeof(checksum));
+        const char *payload = data + offset + RECORD_HEADER_SIZE;
+        if (length == 0 || length > size - offset - RECORD_HEADER_SIZE ||
+            Checksum32(payload, length) != checksum || !ApplyRecord(payload, length, games)) {
+            break;
+        }
+        offset += RECORD_HEADER_SIZE + length;
+        records++;
+    }
+    if (offset != size) {
+        WARNING_LOG("Ignoring " << size - offset << " bytes of torn records at the end of " << path);
+    }
+    return records;
+}
+
+//--------------------------------------------------
+// @param covered = last segment folded into the
+// snapshot (0 if there is none)
+//--------------------------------------------------
+ErrorCode LoadSnapshot(const std::string &path, JournaledGames &games, uint64_t &covered)
+{
+    covered = 0;
+    MappedFile file(path);
+    if (!file.Exists()) {
+        return SUCCESS;
+    }
+    uint64_t checksum{ 0 };
+    if (file.Size() < sizeof(checksum)) {
+        return INVALID_FILE_FORMAT;
+    }
+    const size_t size = file.Size() - sizeof(checksum);
+    std::memcpy(&checksum, file.Data() + size, sizeof(checksum));
+    if (checksum != Checksum64(file.Data(), size)) {
+        return INVALID_FILE_FORMAT;
+    }
+
+    Reader reader(file.Data(), size);
+    uint32_t magic{ 0 };
+    uint32_t version{ 0 };
+    uint64_t numGames{ 0 };
+    if (!reader.Get(magic) || magic != SNAPSHOT_MAGIC || !reader.Get(version) ||
+        version != SNAPSHOT_VERSION || !reader.Get(covered) || !reader.Get(numGames)) {
+        return INVALID_FILE_FORMAT;
+    }
+    games.reserve(games.size() + numGames);
+    for (uint64_t i{ 0 }; i < numGames; i++) {
+        std::string room;
+        JournaledGame game;
+        uint32_t numMoves{ 0 };
+        if (!reader.GetString(room) || !reader.GetString(game.tokens[0]) ||
+            !reader.GetString(game.tokens[1]) || !reader.Get(numMoves) ||
+            reader.Remaining() < numMoves * sizeof(uint16_t)) {
+            return INVALID_FILE_FORMAT;
+        }
+        game.moves.resize(numMoves);
+        reader.Read(game.moves.data(), numMoves * sizeof(uint16_t));
+        games[room] = std::move(game);
+    }
+    return (reader.Remaining() == 0) ? SUCCESS : INVALID_FILE_FORMAT;
+}
+
+bool WriteAll(int fd, const std::string &data)
+{
+    size_t written{ 0 };
+    while (written < data.size()) {
+        const ssize_t n = ::write(fd, data.data() + written, data.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+//--------------------------------------------------
+// Make created, renamed & deleted files durable
+//--------------------------------------------------
+void SyncDirectory(const std::string &dir)
+{
+    const int fd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd >= 0) {
+        ::fsync(fd);
+        ::close(fd);
+    }
+}
+
+//--------------------------------------------------
+// Written to a temporary file first, so a crash
+// leaves either the old or the new snapshot
+//--------------------------------------------------
+ErrorCode SaveSnapshot(const std::string &dir, const std::string &path,
+    const JournaledGames &games, uint64_t covered)
+{
+    std::string data;
+    Put(data, SNAPSHOT_MAGIC);
+    Put(data, SNAPSHOT_VERSION);
+    Put<uint64_t>(data, covered);
+    Put<uint64_t>(data, games.size());
+    for (const auto &entry : games) {
+        PutString(data, entry.first);
+        PutString(data, entry.second.tokens[0]);
+        PutString(data, entry.second.tokens[1]);
+        Put<uint32_t>(data, static_cast<uint32_t>(entry.second.moves.size()));
+        data.append(reinterpret_cast<const char*>(entry.second.moves.data()),
+            entry.second.moves.size() * sizeof(uint16_t));
+    }
+    Put<uint64_t>(data, Checksum64(data.data(), data.size()));
+
+    const std::string tmpPath = path + ".tmp";
+    const int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        ERROR_LOG("Cannot create " << tmpPath << ": " << std::strerror(errno));
+        return FILE_OPEN_ERROR;
+    }
+    const bool written = WriteAll(fd, data) && ::fsync(fd) == 0;
+    ::close(fd);
+    if (!written || ::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        ERROR_LOG("Cannot write " << path << ": " << std::strerror(errno));
+        ::unlink(tmpPath.c_str());
+        return FILE_OPEN_ERROR;
+    }
+    SyncDirectory(dir);
+    return SUCCESS;
+}
+
+//--------------------------------------------------
+// Segment numbers of journal shard @param index,
+// in ascending order
+//--------------------------------------------------
+std::vector<uint64_t> ListSegments(const std::string &dir, size_t index)
+{
+    std::vector<uint64_t> segments;
+    DIR *handle = ::opendir(dir.c_str());
+    if (handle == nullptr) {
+        return segments;
+    }
+    const std::string prefix = SEGMENT_PREFIX + std::to_string(index) + "-";
+    const std::string suffix{ SEGMENT_SUFFIX };
+    while (const dirent *entry = ::readdir(handle)) {
+        const std::string name(entry->d_name);
+        if (name.size() <= prefix.size() + suffix.size() ||
+            name.compare(0, prefix.size(), prefix) != 0 ||
+            name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+            continue;
+        }
+        const std::string number = name.substr(prefix.size(), name.size() - prefix.size() - suffix.size());
+        if (number.find_first_not_of("0123456789") == std::string::npos) {
+            segments.push_back(std::strtoull(number.c_str(), nullptr, 10));
+        }
+    }
+    ::closedir(handle);
+    std::sort(segments.begin(), segments.end());
+    return segments;
+}
+
+//--------------------------------------------------
+// Per-thread buffer for building a record payload
+//--------------------------------------------------
+std::string &RecordBuffer()
+{
+    thread_local std::string buffer;
+    buffer.clear();
+    return buffer;
+}
+
+} // namespace
+
+GameJournal::GameJournal(const JournalOptions &options) : m_options(options) {}
+
+GameJournal::~GameJournal()
+{
+    Close();
+}
+
+std::string GameJournal::SegmentPath(size_t index, uint64_t segment) const
+{
+    return m_options.dir + "/" + SEGMENT_PREFIX + std::to_string(index) + "-" +
+        std::to_string(segment) + SEGMENT_SUFFIX;
+}
+
+std::string GameJournal::SnapshotPath(size_t index) const
+{
+    return m_options.dir + "/snapshot-" + std::to_string(index) + ".bin";
+}
+
+/**************************************************
+ * @details
+ *      Shards are independent files, so they are
+ *      recovered in parallel: each one maps its
+ *      snapshot & segments, folds them into the final
+ *      state of its games and only then replays their
+ *      moves on the boards. New records go to fresh
+ *      segments; the recovered ones are folded away by
+ *      the next compaction.
+ **************************************************/
+ErrorCode GameJournal::Open(GameRegistry &registry, RecoveryStats &stats)
+{
+    const auto start = std::chrono::steady_clock::now();
+    if (::mkdir(m_options.dir.c_str(), 0700) != 0 && errno != EEXIST) {
+        ERROR_LOG("Cannot create journal directory " << m_options.dir << ": " << std::strerror(errno));
+        return FILE_OPEN_ERROR;
+    }
+
+    std::array<RecoveryStats, JOURNAL_SHARDS> shardStats{};
+    std::array<ErrorCode, JOURNAL_SHARDS> errors{};
+    std::vector<std::thread> threads;
+    threads.reserve(JOURNAL_SHARDS);
+    for (size_t i{ 0 }; i < JOURNAL_SHARDS; i++) {
+        threads.emplace_back([this, i, &registry, &shardStats, &errors]() {
+            errors[i] = RecoverShard(i, registry, shardStats[i]);
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    stats = RecoveryStats{};
+    for (size_t i{ 0 }; i < JOURNAL_SHARDS; i++) {
+        if (errors[i] != SUCCESS) {
+            return errors[i];
+        }
+        stats.games += shardStats[i].games;
+        stats.moves += shardStats[i].moves;
+        stats.records += shardStats[i].records;
+        const ErrorCode err = OpenSegment(i);
+        if (err != SUCCESS) {
+            return err;
+        }
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    m_registry = &registry;
+    m_registry->SetJournal(this);
+    m_running = true;
+    m_flushThread = std::thread(&GameJournal::FlushLoop, this);
+    if (m_options.snapshotInterval.count() > 0) {
+        m_snapshotThread = std::thread(&GameJournal::SnapshotLoop, this);
+    }
+    return SUCCESS;
+}
+
+void GameJournal::Close()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+        m_flushCv.notify_all();
+        m_stopCv.notify_all();
+    }
+    if (m_flushThread.joinable()) {
+        m_flushThread.join();
+    }
+    if (m_snapshotThread.joinable()) {
+        m_snapshotThread.join();
+    }
+    if (m_registry != nullptr) {
+        m_registry->SetJournal(nullptr);
+        m_registry = nullptr;
+    }
+    for (auto &shard : m_shards) {
+        std::lock_guard<std::mutex> ioLock(shard.ioMutex);
+        FlushLocked(shard);
+        if (shard.fd >= 0) {
+            ::close(shard.fd);
+            shard.fd = -1;
+        }
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_durableCv.notify_all();
+}
+
+ErrorCode GameJournal::RecoverShard(size_t index, GameRegistry &registry, RecoveryStats &stats)
+{
+    Shard &shard = m_shards[index];
+    JournaledGames games;
+    if (LoadSnapshot(SnapshotPath(index), games, shard.snapshotSegment) != SUCCESS) {
+        ERROR_LOG("Corrupt journal snapshot " << SnapshotPath(index));
+        return INVALID_FILE_FORMAT;
+    }
+    shard.segment = shard.snapshotSegment;
+    for (const uint64_t segment : ListSegments(m_options.dir, index)) {
+        if (segment <= shard.snapshotSegment) {
+            continue;   // left behind by an interrupted compaction
+        }
+        stats.records += ReplaySegment(SegmentPath(index, segment), games);
+        shard.segment = segment;
+    }
+
+    std::vector<Move> moves;
+    for (const auto &entry : games) {
+        moves.clear();
+        for (const uint16_t packed : entry.second.moves) {
+            moves.push_back(UnpackMove(packed));
+        }
+        if (UNLIKELY(registry.RestoreGame(entry.first, entry.second.tokens, moves) != SUCCESS)) {
+            WARNING_LOG("Game " << entry.first << " could not be fully restored from the journal");
+        }
+        stats.games++;
+        stats.moves += moves.size();
+    }
+    return SUCCESS;
+}
+
+ErrorCode GameJournal::OpenSegment(size_t index, bool logErrors)
+{
+    Shard &shard = m_shards[index];
+    shard.segment++;
+    const std::string path = SegmentPath(index, shard.segment);
+    shard.fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+    if (shard.fd < 0) {
+        if (logErrors) {
+            ERROR_LOG("Cannot open journal segment " << path << ": " << std::strerror(errno));
+        }
+        return FILE_OPEN_ERROR;
+    }
+    shard.segmentBytes = 0;
+    SyncDirectory(m_options.dir);
+    return SUCCESS;
+}
+
+/**************************************************
+ * @details
+ *      A game's records always go to the same shard
+ *      (FNV-1a of the room, stable across restarts)
+ *      and are appended under the game's lock, so
+ *      they are replayed in order.
+ **************************************************/
+JournalTicket GameJournal::Append(const std::string &room, const std::string &payload)
+{
+    const size_t index = Checksum32(room.data(), room.size()) % JOURNAL_SHARDS;
+    Shard &shard = m_shards[index];
+    JournalTicket ticket{ index, 0 };
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        Put<uint32_t>(shard.pending, static_cast<uint32_t>(payload.size()));
+        Put<uint32_t>(shard.pending, Checksum32(payload.data(), payload.size()));
+        shard.pending += payload;
+        ticket.lsn = ++shard.appended;
+    }
+    if (m_options.syncInterval.count() == 0) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_dirty = true;
+        m_flushCv.notify_one();
+    }
+    return ticket;
+}
+
+JournalTicket GameJournal::LogJoin(const std::string &room, PieceColor color, const std::string &token)
+{
+    std::string &payload = RecordBuffer();
+    Put(payload, RecordType::JOIN);
+    Put(payload, static_cast<uint8_t>(color));
+    PutString(payload, room);
+    PutString(payload, token);
+    return Append(room, payload);
+}
+
+JournalTicket GameJournal::LogLeave(const std::string &room, PieceColor color)
+{
+    std::string &payload = RecordBuffer();
+    Put(payload, RecordType::LEAVE);
+    Put(payload, static_cast<uint8_t>(color));
+    PutString(payload, room);
+    return Append(room, payload);
+}
+
+JournalTicket GameJournal::LogMove(const std::string &room, const Move &move)
+{
+    std::string &payload = RecordBuffer();
+    Put(payload, RecordType::MOVE);
+    PutString(payload, room);
+    Put(payload, PackMove(move));
+    return Append(room, payload);
+}
+
+ErrorCode GameJournal::WaitDurable(const JournalTicket &ticket)
+{
+    if (m_options.syncInterval.count() != 0) {
+        return SUCCESS;
+    }
+    Shard &shard = m_shards[ticket.shard];
+    if (shard.durable.load(std::memory_order_acquire) < ticket.lsn) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_durableCv.wait(lock, [this, &shard, &ticket]() {
+            return shard.durable.load(std::memory_order_acquire) >= ticket.lsn || !m_running;
+        });
+    }
+
+    // Failed batches are recorded before <durable> passes them
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (auto it = shard.failed.begin(); it != shard.failed.end(); ++it) {
+        if (ticket.lsn >= it->first && ticket.lsn <= it->last) {
+            if (--it->waiters == 0) {
+                shard.failed.erase(it);
+            }
+            return FILE_OPEN_ERROR;
+        }
+    }
+    return (shard.durable.load(std::memory_order_acquire) >= ticket.lsn) ? SUCCESS : FILE_OPEN_ERROR;
+}
+
+void GameJournal::FlushShard(Shard &shard)
+{
+    std::lock_guard<std::mutex> ioLock(shard.ioMutex);
+    FlushLocked(shard);
+}
+
+/**************************************************
+ * @details
+ *      Appends continue into the emptied buffer while
+ *      the batch is written, and all of them share the
+ *      next fsync (group commit).
+ *      A failed write is cut off the segment (or the
+ *      next batch goes to a new segment), so replay
+ *      never stops at a torn record in the middle.
+ *      The batch is then put back for the next flush,
+ *      or, when writers wait for it, dropped & reported
+ *      to them.
+ **************************************************/
+void GameJournal::FlushLocked(Shard &shard)
+{
+    uint64_t lsn{ 0 };
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.writing.swap(shard.pending);
+        lsn = shard.appended;
+    }
+    if (shard.writing.empty()) {
+        return;
+    }
+    const size_t index = static_cast<size_t>(&shard - m_shards.data());
+    bool written = (shard.fd >= 0 || OpenSegment(index, !shard.failing) == SUCCESS) &&
+        WriteAll(shard.fd, shard.writing) && ::fdatasync(shard.fd) == 0;
+    if (LIKELY(written)) {
+        shard.segmentBytes += shard.writing.size();
+        shard.writing.clear();
+        if (UNLIKELY(shard.failing)) {
+            shard.failing = false;
+            INFO_LOG("Journal writes resumed");
+        }
+        shard.durable.store(lsn, std::memory_order_release);
+        return;
+    }
+
+    const bool synchronous = (m_options.syncInterval.count() == 0);
+    if (!shard.failing) {
+        ERROR_LOG("Journal write failed: " << std::strerror(errno)
+            << (synchronous ? "; changes are refused until it recovers" : "; retrying"));
+        shard.failing = true;
+    }
+    if (shard.fd >= 0 && ::ftruncate(shard.fd, static_cast<off_t>(shard.segmentBytes)) != 0) {
+        ::close(shard.fd);
+        shard.fd = -1;
+    }
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (synchronous) {
+        const uint64_t first = shard.durable.load(std::memory_order_relaxed) + 1;
+        shard.failed.push_back(FailedBatch{ first, lsn, lsn - first + 1 });
+        shard.writing.clear();
+        shard.durable.store(lsn, std::memory_order_release);
+    } else {
+        shard.writing += shard.pending;
+        shard.writing.swap(shard.pending);
+        shard.writing.clear();
+    }
+}
+
+void GameJournal::Sync()
+{
+    for (auto &shard : m_shards) {
+        FlushShard(shard);
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_durableCv.notify_all();
+}
+
+uint64_t GameJournal::NumPendingRecords()
+{
+    uint64_t pending{ 0 };
+    for (auto &shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        pending += shard.appended - std::min(shard.appended, shard.durable.load(std::memory_order_acquire));
+    }
+    return pending;
+}
+
+/**************************************************
+ * @details
+ *      With a sync interval, flush on a timer; without
+ *      one, flush as soon as a record is appended.
+ *      Records appended during a flush are batched
+ *      into the next one either way.
+ **************************************************/
+void GameJournal::FlushLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_running) {
+        if (m_options.syncInterval.count() == 0) {
+            m_flushCv.wait(lock, [this]() { return m_dirty || !m_running; });
+        } else {
+            m_flushCv.wait_for(lock, m_options.syncInterval, [this]() { return !m_running; });
+        }
+        m_dirty = false;
+        lock.unlock();
+        for (auto &shard : m_shards) {
+            FlushShard(shard);
+        }
+        lock.lock();
+        m_durableCv.notify_all();
+    }
+}
+
+void GameJournal::SnapshotLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_running) {
+        m_stopCv.wait_for(lock, m_options.snapshotInterval, [this]() { return !m_running; });
+        if (!m_running) {
+            break;
+        }
+        lock.unlock();
+        Snapshot();
+        lock.lock();
+    }
+}
+
+ErrorCode GameJournal::Snapshot()
+{
+    std::lock_guard<std::mutex> lock(m_snapshotMutex);
+    ErrorCode result{ SUCCESS };
+    for (size_t i{ 0 }; i < JOURNAL_SHARDS; i++) {
+        const ErrorCode err = CompactShard(i);
+        if (err != SUCCESS) {
+            result = err;
+        }
+    }
+    return result;
+}
+
+/**************************************************
+ * @details
+ *      Only the segment switch holds the shard's I/O
+ *      lock: the closed segments are folded from the
+ *      files (not from the live games), so writers
+ *      are never blocked by a compaction.
+ **************************************************/
+ErrorCode GameJournal::CompactShard(size_t index)
+{
+    Shard &shard = m_shards[index];
+    uint64_t covered{ 0 };
+    {
+        std::lock_guard<std::mutex> ioLock(shard.ioMutex);
+        FlushLocked(shard);
+        if (shard.fd < 0) {     // not open, or the last write failed
+            return SUCCESS;
+        }
+        if (shard.segmentBytes > 0) {
+            ::close(shard.fd);
+            shard.fd = -1;
+            const ErrorCode err = OpenSegment(index);
+            if (err != SUCCESS) {
+                return err;
+            }
+        }
+        covered = shard.segment - 1;
+    }
+    if (covered == shard.snapshotSegment) {
+        return SUCCESS;
+    }
+
+    JournaledGames games;
+    uint64_t previous{ 0 };
+    if (LoadSnapshot(SnapshotPath(index), games, previous) != SUCCESS) {
+        ERROR_LOG("Corrupt journal snapshot " << SnapshotPath(index));
+        return INVALID_FILE_FORMAT;
+    }
+    const std::vector<uint64_t> segments = ListSegments(m_options.dir, index);
+    for (const uint64_t segment : segments) {
+        if (segment > shard.snapshotSegment && segment <= covered) {
+            ReplaySegment(SegmentPath(index, segment), games);
+        }
+    }
+    const ErrorCode err = SaveSnapshot(m_options.dir, SnapshotPath(index), games, covered);
+    if (err != SUCCESS) {
+        return err;
+    }
+    shard.snapshotSegment = covered;
+    for (const uint64_t segment : segments) {
+        if (segment <= covered) {
+            ::unlink(SegmentPath(index, segment).c_str());
+        }
+    }
+    SyncDirectory(m_options.dir);
+    return SUCCESS;
+}
+
+} // namespace Shohih
@@ -0,0 +1,608 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Online game registry Implementation
+ **************************************************/
+
+#include <cctype>
+#include <random>
+#include "game_registry.h"
+
+namespace Shohih {
+
+namespace {
+
+constexpr size_t TOKEN_LENGTH{ 32 };        // slot index + 96 random bits
+constexpr size_t TOKEN_SLOT_LENGTH{ 8 };
+constexpr size_t GENERATED_ROOM_LENGTH{ 8 };
+
+//--------------------------------------------------
+// Random hex string (one generator per server thread)
+//--------------------------------------------------
+std::string RandomHex(size_t length)
+{
+    static const char HEX_DIGITS[]{ "0123456789abcdef" };
+    thread_local std::mt19937_64 rng{ std::random_device{}() };
+    std::string hex(length, '0');
+    uint64_t bits{ 0 };
+    for (size_t i{ 0 }; i < length; i++) {
+        if (i % 16 == 0) {
+            bits = rng();
+        }
+        hex[i] = HEX_DIGITS[bits & 0xF];
+        bits >>= 4;
+    }
+    return hex;
+}
+
+//--------------------------------------------------
+// Session token: the hex index of its slot, then
+// random digits (NO_SESSION_SLOT = "ffffffff...")
+//--------------------------------------------------
+std::string NewToken(uint32_t slot)
+{
+    static const char HEX_DIGITS[]{ "0123456789abcdef" };
+    std::string token(TOKEN_SLOT_LENGTH, '0');
+    for (size_t i{ 0 }; i < TOKEN_SLOT_LENGTH; i++) {
+        token[TOKEN_SLOT_LENGTH - 1 - i] = HEX_DIGITS[(slot >> (4 * i)) & 0xF];
+    }
+    return token + RandomHex(TOKEN_LENGTH - TOKEN_SLOT_LENGTH);
+}
+
+struct TokenKey {
+    uint32_t slot{ NO_SESSION_SLOT };
+    uint32_t high{ 0 };
+    uint64_t low{ 0 };
+};
+
+//--------------------------------------------------
+// @return false for a token of another format
+//--------------------------------------------------
+bool ParseToken(const std::string &token, TokenKey &key)
+{
+    if (token.size() != TOKEN_LENGTH) {
+        return false;
+    }
+    std::array<uint64_t, 3> words{};
+    constexpr std::array<size_t, 3> WORD_DIGITS{ { TOKEN_SLOT_LENGTH, 8, 16 } };
+    size_t i{ 0 };
+    for (size_t w{ 0 }; w < words.size(); w++) {
+        for (size_t d{ 0 }; d < WORD_DIGITS[w]; d++, i++) {
+            const char c = token[i];
+            uint64_t digit;
+            if (c >= '0' && c <= '9') {
+                digit = static_cast<uint64_t>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                digit = static_cast<uint64_t>(c - 'a' + 10);
+            } else {
+                return false;
+            }
+            words[w] = (words[w] << 4) | digit;
+        }
+    }
+    key.slot = static_cast<uint32_t>(words[0]);
+    key.high = static_cast<uint32_t>(words[1]);
+    key.low = words[2];
+    return true;
+}
+
+} // namespace
+
+/**************************************************
+ * @details
+ *      Only the matching pseudo-legal move is checked
+ *      for legality; nothing is allocated.
+ **************************************************/
+PackedMove FindLegalMove(const Position &pos, const Move &move)
+{
+    if (UNLIKELY(!move.first.IsValid() || !move.second.IsValid())) {
+        return NULL_PACKED_MOVE;
+    }
+    const SquareId from = ToSquareId(move.first);
+    const SquareId to = ToSquareId(move.second);
+    MoveList list;
+    pos.GenerateMoves(list, GenType::ALL);
+    for (const auto &item : list) {
+        const PackedMove candidate = item.move;
+        if (candidate.From() != from || candidate.To() != to ||
+            (candidate.IsPromotion() && candidate.PromotionType() != PieceType::QUEEN)) {
+            continue;
+        }
+        return pos.IsLegal(candidate) ? candidate : NULL_PACKED_MOVE;
+    }
+    return NULL_PACKED_MOVE;
+}
+
+GameRegistry::Shard &GameRegistry::ShardOf(const std::string &key)
+{
+    return m_shards[std::hash<std::string>{}(key) % NUM_SHARDS];
+}
+
+const GameRegistry::Shard &GameRegistry::ShardOf(const std::string &key) const
+{
+    return m_shards[std::hash<std::string>{}(key) % NUM_SHARDS];
+}
+
+bool GameRegistry::IsValidRoomId(const std::string &room)
+{
+    if (room.empty() || room.size() > MAX_ROOM_ID_LENGTH) {
+        return false;
+    }
+    for (const char c : room) {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '_') {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**************************************************
+ * @details
+ *      Lock order: room shard, then game. The seat
+ *      is taken with both held, so a concurrent
+ *      Leave() cannot drop the game in between; the
+ *      session is published afterwards in its slot
+ *      and the token's shard, once the journal has
+ *      the seat.
+ **************************************************/
+ErrorCode GameRegistry::Join(std::string &room, std::string &token, PieceColor &color)
+{
+    if (!room.empty() && UNLIKELY(!IsValidRoomId(room))) {
+        ERROR_LOG("Invalid room ID: " << room);
+        return INVALID_ROOM;
+    }
+
+    std::shared_ptr<OnlineGame> game;
+    uint32_t slot{ NO_SESSION_SLOT };
+    JournalTicket ticket;
+    {
+        // A generated ID is retried until it names a new room
+        Shard *shard{ nullptr };
+        std::unique_lock<std::mutex> shardLock;
+        const bool generated = room.empty();
+        do {
+            if (generated) {
+                room = RandomHex(GENERATED_ROOM_LENGTH);
+            }
+            shard = &ShardOf(room);
+            shardLock = std::unique_lock<std::mutex>(shard->mutex);
+        } while (generated && shard->games.count(room) != 0);
+
+        auto &entry = shard->games[room];
+        if (entry == nullptr) {
+            entry = std::make_shared<OnlineGame>(room);
+        }
+        game = entry;
+
+        std::lock_guard<std::mutex> gameLock(game->mutex);
+        if (game->tokens[0].empty()) {
+            color = PieceColor::WHITE;
+        } else if (game->tokens[1].empty()) {
+            color = PieceColor::BLACK;
+        } else {
+            return ROOM_FULL;
+        }
+        slot = AllocateSlot();
+        token = NewToken(slot);
+        game->tokens[static_cast<uint8_t>(color)] = token;
+        if (m_journal != nullptr) {
+            ticket = m_journal->LogJoin(room, color, token);
+        }
+    }
+
+    if (m_journal != nullptr) {
+        const ErrorCode err = m_journal->WaitDurable(ticket);
+        if (UNLIKELY(err != SUCCESS)) {
+            FreeSeat(Session{ game, color });
+            ReleaseSlot(slot);
+            return err;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> gameLock(game->mutex);
+        game->slots[static_cast<uint8_t>(color)] = slot;
+        WriteSlot(slot, token, game->state.load(std::memory_order_relaxed));
+    }
+    {
+        Shard &tokenShard = ShardOf(token);
+        std::lock_guard<std::mutex> lock(tokenShard.mutex);
+        tokenShard.sessions[token] = Session{ game, color };
+    }
+    return SUCCESS;
+}
+
+/**************************************************
+ * @details
+ *      The session is taken out first, so the token
+ *      leaves once; the seat is only freed once the
+ *      journal has the record, so no Join() can be
+ *      journaled before it. The slot is cleared before
+ *      it is given back, so a reader holding the old
+ *      token cannot match its next owner.
+ **************************************************/
+ErrorCode GameRegistry::Leave(const std::string &token)
+{
+    Session session;
+    {
+        Shard &tokenShard = ShardOf(token);
+        std::lock_guard<std::mutex> lock(tokenShard.mutex);
+        auto it = tokenShard.sessions.find(token);
+        if (it == tokenShard.sessions.end()) {
+            return INVALID_SESSION;
+        }
+        session = std::move(it->second);
+        tokenShard.sessions.erase(it);
+    }
+
+    OnlineGame &game = *session.game;
+    const uint8_t seat = static_cast<uint8_t>(session.color);
+    uint32_t slot{ NO_SESSION_SLOT };
+    ErrorCode err{ SUCCESS };
+    {
+        std::lock_guard<std::mutex> gameLock(game.mutex);
+        slot = game.slots[seat];
+        game.slots[seat] = NO_SESSION_SLOT;
+        WriteSlot(slot, "", 0);
+        if (m_journal != nullptr) {
+            err = m_journal->WaitDurable(m_journal->LogLeave(game.room, session.color));
+            if (UNLIKELY(err != SUCCESS)) {
+                game.slots[seat] = slot;
+                WriteSlot(slot, token, game.state.load(std::memory_order_relaxed));
+            }
+        }
+    }
+    if (UNLIKELY(err != SUCCESS)) {
+        Shard &tokenShard = ShardOf(token);
+        std::lock_guard<std::mutex> lock(tokenShard.mutex);
+        tokenShard.sessions[token] = std::move(session);
+        return err;
+    }
+    FreeSeat(session);
+    ReleaseSlot(slot);
+    game.moved.notify_all();
+    return SUCCESS;
+}
+
+void GameRegistry::FreeSeat(const Session &session)
+{
+    OnlineGame &game = *session.game;
+    Shard &roomShard = ShardOf(game.room);
+    std::lock_guard<std::mutex> shardLock(roomShard.mutex);
+    std::lock_guard<std::mutex> gameLock(game.mutex);
+    game.tokens[static_cast<uint8_t>(session.color)].clear();
+    if (game.tokens[0].empty() && game.tokens[1].empty()) {
+        auto it = roomShard.games.find(game.room);
+        if (it != roomShard.games.end() && it->second == session.game) {
+            roomShard.games.erase(it);
+        }
+    }
+}
+
+bool GameRegistry::FindSession(const std::string &token, Session &session) const
+{
+    const Shard &shard = ShardOf(token);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.sessions.find(token);
+    if (it == shard.sessions.end()) {
+        return false;
+    }
+    session = it->second;
+    return true;
+}
+
+/**************************************************
+ * @details
+ *      Hot path of /getmove: a seqlock read of the
+ *      token's slot, a fixed number of atomic loads.
+ *      Tokens without a slot (all slots were taken,
+ *      or read from an older journal), unknown ones
+ *      and slots changing hands right now take the
+ *      locked lookup instead.
+ **************************************************/
+ErrorCode GameRegistry::GetLastMove(const std::string &token, Move &move, uint64_t &seq) const
+{
+    TokenKey key;
+    const SessionSlot *slot = ParseToken(token, key) ? SlotAt(key.slot) : nullptr;
+    if (LIKELY(slot != nullptr)) {
+        const uint32_t version = slot->version.load(std::memory_order_acquire);
+        const bool match = slot->used.load(std::memory_order_acquire) &&
+            slot->keyHigh.load(std::memory_order_acquire) == key.high &&
+            slot->keyLow.load(std::memory_order_acquire) == key.low;
+        const uint64_t state = slot->state.load(std::memory_order_acquire);
+        if (LIKELY(match && version % 2 == 0 && slot->version.load(std::memory_order_relaxed) == version)) {
+            move = OnlineGame::MoveOf(state);
+            seq = OnlineGame::SeqOf(state);
+            return SUCCESS;
+        }
+    }
+
+    Session session;
+    if (UNLIKELY(!FindSession(token, session))) {
+        return INVALID_SESSION;
+    }
+    const uint64_t state = session.game->state.load(std::memory_order_acquire);
+    move = OnlineGame::MoveOf(state);
+    seq = OnlineGame::SeqOf(state);
+    return SUCCESS;
+}
+
+/**************************************************
+ * @details
+ *      With a synchronous journal the move is only
+ *      played once it is on disk: the game's lock is
+ *      held meanwhile (the opponent cannot move before
+ *      it anyway), and a failed write leaves the game
+ *      as it was.
+ **************************************************/
+ErrorCode GameRegistry::SetLastMove(const std::string &token, const Move &move, uint64_t &seq)
+{
+    Session session;
+    if (UNLIKELY(!FindSession(token, session))) {
+        return INVALID_SESSION;
+    }
+    OnlineGame &game = *session.game;
+    std::string opponent;
+    {
+        std::lock_guard<std::mutex> lock(game.mutex);
+        if (UNLIKELY(game.position.GetSideToMove() != session.color)) {
+            return INVALID_MOVE;
+        }
+        const PackedMove legal = FindLegalMove(game.position, move);
+        if (UNLIKELY(legal.IsNull())) {
+            return INVALID_MOVE;
+        }
+        if (m_journal != nullptr) {
+            const ErrorCode err = m_journal->WaitDurable(m_journal->LogMove(game.room, move));
+            if (UNLIKELY(err != SUCCESS)) {
+                return err;
+            }
+        }
+        game.position.MakeMove(legal);
+        game.moves.push_back(move);
+        seq = game.moves.size();
+        const uint64_t state = OnlineGame::PackState(seq, move);
+        game.state.store(state, std::memory_order_release);
+        for (const uint32_t slot : game.slots) {
+            if (slot != NO_SESSION_SLOT) {
+                SlotAt(slot)->state.store(state, std::memory_order_release);
+            }
+        }
+        opponent = game.tokens[static_cast<size_t>(session.color) ^ 1];
+    }
+    game.moved.notify_all();
+    if (m_moveListener && !opponent.empty()) {
+        m_moveListener(opponent, move, seq);
+    }
+    return SUCCESS;
+}
+
+/**************************************************
+ * @details
+ *      Called while recovering, before requests are
+ *      served (shards are restored in parallel, so
+ *      the registry's locks are still taken).
+ **************************************************/
+ErrorCode GameRegistry::RestoreGame(const std::string &room,
+    const std::array<std::string, NUM_PIECE_COLORS> &tokens, const std::vector<Move> &moves)
+{
+    if (UNLIKELY(!IsValidRoomId(room))) {
+        return INVALID_ROOM;
+    }
+    auto game = std::make_shared<OnlineGame>(room);
+    ErrorCode err{ SUCCESS };
+    for (const Move &move : moves) {
+        const PackedMove legal = FindLegalMove(game->position, move);
+        if (UNLIKELY(legal.IsNull())) {
+            err = INVALID_MOVE;
+            break;
+        }
+        game->position.MakeMove(legal);
+        game->moves.push_back(move);
+    }
+    if (!game->moves.empty()) {
+        game->state.store(OnlineGame::PackState(game->moves.size(), game->moves.back()),
+            std::memory_order_release);
+    }
+    game->tokens = tokens;
+    for (size_t color{ 0 }; color < NUM_PIECE_COLORS; color++) {
+        TokenKey key;
+        if (!tokens[color].empty() && ParseToken(tokens[color], key) && ClaimSlot(key.slot)) {
+            game->slots[color] = key.slot;
+            WriteSlot(key.slot, tokens[color], game->state.load(std::memory_order_relaxed));
+        }
+    }
+
+    {
+        Shard &roomShard = ShardOf(room);
+        std::lock_guard<std::mutex> lock(roomShard.mutex);
+        roomShard.games[room] = game;
+    }
+    for (size_t color{ 0 }; color < NUM_PIECE_COLORS; color++) {
+        if (tokens[color].empty()) {
+            continue;
+        }
+        Shard &tokenShard = ShardOf(tokens[color]);
+        std::lock_guard<std::mutex> lock(tokenShard.mutex);
+        tokenShard.sessions[tokens[color]] = Session{ game, static_cast<PieceColor>(color) };
+    }
+    return err;
+}
+
+void GameRegistry::WaitLocked(const Session &session, const std::string &token, uint64_t since,
+    std::chrono::milliseconds timeout, std::unique_lock<std::mutex> &lock)
+{
+    OnlineGame &game = *session.game;
+    const std::string &seat = game.tokens[static_cast<uint8_t>(session.color)];
+    game.moved.wait_for(lock, std::min(timeout, MAX_MOVE_WAIT), [&game, &seat, &token, since]() {
+        return OnlineGame::SeqOf(game.state.load(std::memory_order_relaxed)) != since || seat != token;
+    });
+}
+
+/**************************************************
+ * @details
+ *      The state is checked without locking first;
+ *      only requests that actually wait take the game
+ *      lock (writers publish under it, so no wakeup
+ *      is lost). The session keeps the game alive
+ *      while the request waits, even if both players
+ *      leave. A sequence number from the future (e.g.
+ *      from before a server restart) does not wait.
+ **************************************************/
+ErrorCode GameRegistry::WaitForMove(const std::string &token, uint64_t since,
+    std::chrono::milliseconds timeout, Move &move, uint64_t &seq) const
+{
+    Session session;
+    if (UNLIKELY(!FindSession(token, session))) {
+        return INVALID_SESSION;
+    }
+    OnlineGame &game = *session.game;
+    uint64_t state = game.state.load(std::memory_order_acquire);
+    if (OnlineGame::SeqOf(state) == since && timeout.count() > 0) {
+        std::unique_lock<std::mutex> lock(game.mutex);
+        WaitLocked(session, token, since, timeout, lock);
+        state = game.state.load(std::memory_order_relaxed);
+    }
+    move = OnlineGame::MoveOf(state);
+    seq = OnlineGame::SeqOf(state);
+    return SUCCESS;
+}
+
+ErrorCode GameRegistry::WaitForMoves(const std::string &token, uint64_t since,
+    std::chrono::milliseconds timeout, std::vector<Move> &moves, uint64_t &seq) const
+{
+    moves.clear();
+    Session session;
+    if (UNLIKELY(!FindSession(token, session))) {
+        return INVALID_SESSION;
+    }
+    OnlineGame &game = *session.game;
+    std::unique_lock<std::mutex> lock(game.mutex);
+    if (game.moves.size() == since && timeout.count() > 0) {
+        WaitLocked(session, token, since, timeout, lock);
+    }
+    seq = game.moves.size();
+    if (since < seq) {
+        moves.assign(game.moves.begin() + static_cast<std::ptrdiff_t>(since), game.moves.end());
+    }
+    return SUCCESS;
+}
+
+uint32_t GameRegistry::AllocateSlot()
+{
+    std::lock_guard<std::mutex> lock(m_slotMutex);
+    while (!m_freeSlots.empty()) {
+        const uint32_t index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        if (!m_slotUsed[index]) {
+            m_slotUsed[index] = true;
+            return index;
+        }
+    }
+    if (UNLIKELY(m_nextSlot == SLOT_BLOCK_SIZE * MAX_SLOT_BLOCKS)) {
+        return NO_SESSION_SLOT;
+    }
+    const uint32_t index = m_nextSlot;
+    AddSlotsUpTo(index);
+    m_slotUsed[index] = true;
+    return index;
+}
+
+bool GameRegistry::ClaimSlot(uint32_t index)
+{
+    if (index >= SLOT_BLOCK_SIZE * MAX_SLOT_BLOCKS) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(m_slotMutex);
+    AddSlotsUpTo(index);
+    if (m_slotUsed[index]) {
+        return false;
+    }
+    m_slotUsed[index] = true;
+    return true;
+}
+
+void GameRegistry::ReleaseSlot(uint32_t index)
+{
+    if (index == NO_SESSION_SLOT) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_slotMutex);
+    m_slotUsed[index] = false;
+    m_freeSlots.push_back(index);
+}
+
+/**************************************************
+ * @details
+ *      Under m_slotMutex. Slots skipped on the way
+ *      (by a restored token) are free.
+ **************************************************/
+void GameRegistry::AddSlotsUpTo(uint32_t index)
+{
+    for (; m_nextSlot <= index; m_nextSlot++) {
+        if (m_nextSlot % SLOT_BLOCK_SIZE == 0) {
+            m_slotStorage.emplace_back(new SessionSlot[SLOT_BLOCK_SIZE]);
+            m_slotBlocks[m_nextSlot / SLOT_BLOCK_SIZE].store(m_slotStorage.back().get(),
+                std::memory_order_release);
+        }
+        m_slotUsed.push_back(false);
+        if (m_nextSlot != index) {
+            m_freeSlots.push_back(m_nextSlot);
+        }
+    }
+}
+
+GameRegistry::SessionSlot *GameRegistry::SlotAt(uint32_t index) const
+{
+    if (index / SLOT_BLOCK_SIZE >= MAX_SLOT_BLOCKS) {
+        return nullptr;
+    }
+    SessionSlot *block = m_slotBlocks[index / SLOT_BLOCK_SIZE].load(std::memory_order_acquire);
+    return (block != nullptr) ? &block[index % SLOT_BLOCK_SIZE] : nullptr;
+}
+
+/**************************************************
+ * @details
+ *      Seqlock write: the version is odd while the
+ *      fields change. Each field is a release store,
+ *      so a reader that sees a new field also sees the
+ *      odd version (no fences: ThreadSanitizer does not
+ *      model them). Writers of a slot are serialized
+ *      by the lock of the game that owns it.
+ **************************************************/
+void GameRegistry::WriteSlot(uint32_t index, const std::string &token, uint64_t state)
+{
+    SessionSlot *slot = SlotAt(index);
+    if (slot == nullptr) {
+        return;
+    }
+    TokenKey key;
+    const bool used = !token.empty() && ParseToken(token, key);
+    const uint32_t version = slot->version.load(std::memory_order_relaxed);
+    slot->version.store(version + 1, std::memory_order_relaxed);
+    slot->used.store(used, std::memory_order_release);
+    slot->keyHigh.store(key.high, std::memory_order_release);
+    slot->keyLow.store(key.low, std::memory_order_release);
+    slot->state.store(state, std::memory_order_release);
+    slot->version.store(version + 2, std::memory_order_release);
+}
+
+size_t GameRegistry::NumGames() const
+{
+    size_t count{ 0 };
+    for (const auto &shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        count += shard.games.size();
+    }
+    return count;
+}
+
+size_t GameRegistry::NumSessions() const
+{
+    size_t count{ 0 };
+    for (const auto &shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        count += shard.sessions.size();
+    }
+    return count;
+}
+
+} // namespace Shohih
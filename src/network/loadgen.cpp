@@ -0,0 +1,572 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Load generator Implementation
+ **************************************************/
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include "httplib.h"
+#include "bounded_queue.h"
+#include "client.h"
+#include "game_registry.h"
+#include "loadgen.h"
+#include "search.h"
+
+namespace Shohih {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Pause after a failed request, so a saturated server
+// is not hammered by immediate retries
+constexpr std::chrono::milliseconds RETRY_DELAY{ 100 };
+
+constexpr size_t ENGINE_HASH_MB{ 16 };
+
+int64_t Nanos(Clock::time_point time)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+std::string MoveText(const Move &move)
+{
+    return move.first.GetSquareName() + "-" + move.second.GetSquareName();
+}
+
+void Count(std::atomic<uint64_t> &counter)
+{
+    counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+using LegalMoves = std::array<PackedMove, MAX_MOVES>;
+
+//--------------------------------------------------
+// Moves a player may send. Underpromotions are left
+// out: the server promotes every pawn to a queen.
+//--------------------------------------------------
+size_t GenerateLegalMoves(const Position &pos, LegalMoves &legal)
+{
+    MoveList list;
+    pos.GenerateMoves(list, GenType::ALL);
+    size_t numLegal{ 0 };
+    for (const auto &item : list) {
+        if ((!item.move.IsPromotion() || item.move.PromotionType() == PieceType::QUEEN) && pos.IsLegal(item.move)) {
+            legal[numLegal++] = item.move;
+        }
+    }
+    return numLegal;
+}
+
+//--------------------------------------------------
+// Engine moves for all players: a few searches at a
+// time instead of one search (and hash) per player
+//--------------------------------------------------
+class EnginePool {
+public:
+    EnginePool(size_t threads, uint64_t nodes) : m_queue(threads * 4)
+    {
+        for (size_t i{ 0 }; i < threads; i++) {
+            m_workers.emplace_back([this, nodes]() {
+                TranspositionTable tt(ENGINE_HASH_MB);
+                Search search(tt);
+                SearchLimits limits;
+                limits.nodes = nodes;
+                Request request;
+                while (m_queue.Pop(request)) {
+                    Position pos;
+                    pos.SetFEN(request.fen);
+                    tt.NewSearch();
+                    request.result.set_value(search.Run(pos, limits).bestMove);
+                }
+            });
+        }
+    }
+    ~EnginePool()
+    {
+        m_queue.Close();
+        for (auto &worker : m_workers) {
+            worker.join();
+        }
+    }
+
+    PackedMove BestMove(const Position &pos)
+    {
+        Request request;
+        request.fen = pos.GetFEN();
+        std::future<PackedMove> result = request.result.get_future();
+        if (!m_queue.Push(std::move(request))) {
+            return NULL_PACKED_MOVE;
+        }
+        return result.get();
+    }
+
+private:
+    struct Request {
+        std::string fen{};
+        std::promise<PackedMove> result{};
+    };
+
+    BoundedQueue<Request> m_queue;
+    std::vector<std::thread> m_workers{};
+};
+
+//--------------------------------------------------
+// One simulated player. Counters are written by its
+// own thread only and read by the progress reporter.
+//--------------------------------------------------
+struct Bot {
+    std::atomic<uint64_t> requests{ 0 };
+    std::atomic<uint64_t> moves{ 0 };
+    std::atomic<uint64_t> rejected{ 0 };
+    std::atomic<uint64_t> errors{ 0 };
+    std::atomic<uint64_t> games{ 0 };
+    std::atomic<bool> seated{ false };
+
+    LatencyHistogram delivery{};
+    LatencyHistogram roundTrip{};
+
+    // Shut down at the end of the run to wake Receive()
+    std::mutex wsMutex{};
+    std::shared_ptr<WsConnection> ws{ nullptr };
+};
+
+//--------------------------------------------------
+// Two players sharing a game (one move in flight)
+//--------------------------------------------------
+struct Pair {
+    std::atomic<int64_t> sentAt{ 0 };   // steady clock ns
+};
+
+//--------------------------------------------------
+// One player's seat in the current game. The server
+// pushes the opponent's reply as soon as it is made,
+// which can be before our own move is acknowledged:
+// SendMove() keeps it for the next WaitForMove().
+//--------------------------------------------------
+struct Seat {
+    std::string token{};
+    std::shared_ptr<WsConnection> ws{ nullptr };
+    Move pushed{ NULL_MOVE };
+    uint64_t pushedSeq{ 0 };
+};
+
+enum class WaitResult : uint8_t {
+    MOVED,
+    TIMEOUT,
+    FAILED
+};
+
+class LoadRun {
+public:
+    explicit LoadRun(const LoadgenOptions &options) : m_options(options),
+        m_addr(options.host + ":" + std::to_string(options.port))
+    {
+        std::mt19937_64 rng{ std::random_device{}() };
+        std::ostringstream prefix;
+        prefix << "load-" << std::hex << (rng() & 0xFFFFFF);
+        m_roomPrefix = prefix.str();
+
+        const size_t numPairs = std::max<size_t>(1, (options.players + 1) / 2);
+        m_pairs.reset(new Pair[numPairs]);
+        for (size_t i{ 0 }; i < numPairs * 2; i++) {
+            m_bots.emplace_back(new Bot);
+        }
+        if (options.engineNodes > 0) {
+            m_engine.reset(new EnginePool(std::max<size_t>(1, options.engineThreads), options.engineNodes));
+        }
+        if (options.rate > 0.0) {
+            m_moveInterval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / options.rate));
+        }
+    }
+
+    LoadReport Run(const LoadProgress &onProgress);
+
+private:
+    void RunBot(size_t index);
+    void PlayGame(Bot &bot, Pair &pair, httplib::Client &http, const std::string &room, std::mt19937_64 &rng);
+    Move ChooseMove(const Position &pos, const LegalMoves &legal, size_t numLegal, std::mt19937_64 &rng);
+    ErrorCode SendMove(Bot &bot, httplib::Client &http, Seat &seat, const Move &move);
+    WaitResult WaitForMove(Bot &bot, httplib::Client &http, Seat &seat, uint64_t seq, Move &move);
+    LoadCounters Totals() const;
+
+    bool Expired() const { return m_stop.load(std::memory_order_relaxed) || Clock::now() >= m_deadline; }
+    int64_t RemainingMs() const
+    {
+        return std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::milliseconds>(m_deadline - Clock::now()).count());
+    }
+
+    const LoadgenOptions m_options;
+    const std::string m_addr;
+    std::string m_roomPrefix{};
+    std::vector<std::unique_ptr<Bot>> m_bots{};
+    std::unique_ptr<Pair[]> m_pairs{};
+    std::unique_ptr<EnginePool> m_engine{};
+    Clock::duration m_moveInterval{ 0 };
+    Clock::time_point m_deadline{};
+    std::atomic<bool> m_stop{ false };
+};
+
+LoadReport LoadRun::Run(const LoadProgress &onProgress)
+{
+    const auto start = Clock::now();
+    m_deadline = start + m_options.duration;
+    std::vector<std::thread> threads;
+    threads.reserve(m_bots.size());
+    for (size_t i{ 0 }; i < m_bots.size(); i++) {
+        threads.emplace_back(&LoadRun::RunBot, this, i);
+    }
+
+    auto nextReport = start + std::chrono::seconds(1);
+    while (Clock::now() < m_deadline) {
+        std::this_thread::sleep_until(std::min(nextReport, m_deadline));
+        if (onProgress && Clock::now() >= nextReport) {
+            onProgress(std::chrono::duration<double>(Clock::now() - start).count(), Totals());
+            nextReport += std::chrono::seconds(1);
+        }
+    }
+
+    // Wake players blocked on their push connection
+    m_stop = true;
+    for (auto &bot : m_bots) {
+        std::lock_guard<std::mutex> lock(bot->wsMutex);
+        if (bot->ws != nullptr) {
+            bot->ws->Shutdown();
+        }
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    LoadReport report;
+    report.totals = Totals();
+    report.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    for (const auto &bot : m_bots) {
+        report.delivery.Merge(bot->delivery);
+        report.roundTrip.Merge(bot->roundTrip);
+    }
+    return report;
+}
+
+LoadCounters LoadRun::Totals() const
+{
+    LoadCounters totals;
+    for (const auto &bot : m_bots) {
+        totals.requests += bot->requests.load(std::memory_order_relaxed);
+        totals.moves += bot->moves.load(std::memory_order_relaxed);
+        totals.rejected += bot->rejected.load(std::memory_order_relaxed);
+        totals.errors += bot->errors.load(std::memory_order_relaxed);
+        totals.games += bot->games.load(std::memory_order_relaxed);
+        totals.players += bot->seated.load(std::memory_order_relaxed) ? 1 : 0;
+    }
+    return totals;
+}
+
+/**************************************************
+ * @details
+ *      Both players of a pair name their n-th game
+ *      the same way, so they meet again in a new room
+ *      after each game (whoever joins first is white).
+ **************************************************/
+void LoadRun::RunBot(size_t index)
+{
+    Bot &bot = *m_bots[index];
+    Pair &pair = m_pairs[index / 2];
+    std::mt19937_64 rng{ std::random_device{}() ^ index };
+    // A kept-alive connection holds a server thread:
+    // only HTTP players, which poll all the time, keep
+    // theirs open
+    httplib::Client http(m_addr);
+    http.set_keep_alive(!m_options.webSocket);
+    http.set_read_timeout(MOVE_POLL_TIMEOUT_MS / 1000 + 5, 0);
+    for (uint64_t game{ 0 }; !Expired(); game++) {
+        PlayGame(bot, pair, http, m_roomPrefix + "-" + std::to_string(index / 2) + "-" + std::to_string(game), rng);
+    }
+}
+
+void LoadRun::PlayGame(Bot &bot, Pair &pair, httplib::Client &http, const std::string &room, std::mt19937_64 &rng)
+{
+    // Body: <color> <room> <token>
+    Count(bot.requests);
+    auto resp = http.Get("/register?room=" + room);
+    std::string colorName, joinedRoom;
+    Seat seat;
+    if (resp && resp->status == 200) {
+        std::istringstream body(resp->body);
+        body >> colorName >> joinedRoom >> seat.token;
+    }
+    if (UNLIKELY(seat.token.empty())) {
+        Count(bot.errors);
+        std::this_thread::sleep_for(RETRY_DELAY);
+        return;
+    }
+    const PieceColor color = (colorName == "white") ? PieceColor::WHITE : PieceColor::BLACK;
+
+    if (m_options.webSocket) {
+        seat.ws = WsConnection::Connect(m_options.host, m_options.wsPort, "/ws?token=" + seat.token);
+        if (UNLIKELY(seat.ws == nullptr)) {
+            Count(bot.errors);     // this game falls back to HTTP
+        }
+        std::lock_guard<std::mutex> lock(bot.wsMutex);
+        bot.ws = seat.ws;
+    }
+    bot.seated = true;
+
+    Position pos;
+    pos.SetFEN(STANDARD_POSITION_FEN);
+    uint64_t seq{ 0 };
+    auto nextMove = Clock::now();
+    bool finished{ false };
+    while (!Expired()) {
+        LegalMoves legal;
+        const size_t numLegal = GenerateLegalMoves(pos, legal);
+        if (numLegal == 0 || seq >= static_cast<uint64_t>(m_options.maxPlies)) {
+            finished = true;
+            break;
+        }
+
+        Move move = NULL_MOVE;
+        if (pos.GetSideToMove() == color) {
+            if (m_moveInterval.count() > 0) {
+                std::this_thread::sleep_until(std::min(nextMove, m_deadline));
+                nextMove = std::max(nextMove + m_moveInterval, Clock::now() - m_moveInterval);
+                if (Expired()) {
+                    break;
+                }
+            }
+            move = ChooseMove(pos, legal, numLegal, rng);
+            const auto sentAt = Clock::now();
+            pair.sentAt.store(Nanos(sentAt), std::memory_order_relaxed);
+            const ErrorCode err = SendMove(bot, http, seat, move);
+            if (UNLIKELY(err != SUCCESS)) {
+                Count(err == INVALID_MOVE ? bot.rejected : bot.errors);
+                break;
+            }
+            bot.roundTrip.Record(Clock::now() - sentAt);
+        } else {
+            const WaitResult result = WaitForMove(bot, http, seat, seq, move);
+            if (result == WaitResult::TIMEOUT) {
+                continue;
+            }
+            if (UNLIKELY(result == WaitResult::FAILED)) {
+                if (!Expired()) {
+                    Count(bot.errors);
+                }
+                break;
+            }
+            const int64_t sentAt = pair.sentAt.load(std::memory_order_relaxed);
+            bot.delivery.Record(Clock::duration(std::chrono::nanoseconds(Nanos(Clock::now()) - sentAt)));
+            Count(bot.moves);
+        }
+
+        const PackedMove played = FindLegalMove(pos, move);
+        if (UNLIKELY(played.IsNull())) {
+            Count(bot.errors);
+            break;
+        }
+        pos.MakeMove(played);
+        seq++;
+    }
+    if (finished) {
+        Count(bot.games);
+    }
+
+    bot.seated = false;
+    if (seat.ws != nullptr) {
+        seat.ws->Shutdown();
+        std::lock_guard<std::mutex> lock(bot.wsMutex);
+        bot.ws = nullptr;
+    }
+    Count(bot.requests);
+    http.Get("/exit?token=" + seat.token);
+}
+
+//--------------------------------------------------
+// Random legal move, or the engine's choice
+//--------------------------------------------------
+Move LoadRun::ChooseMove(const Position &pos, const LegalMoves &legal, size_t numLegal, std::mt19937_64 &rng)
+{
+    PackedMove choice = legal[rng() % numLegal];
+    if (m_engine != nullptr) {
+        const PackedMove best = m_engine->BestMove(pos);
+        if (!best.IsNull()) {
+            choice = best;
+        }
+    }
+    return Move{ ToSquare(choice.From()), ToSquare(choice.To()) };
+}
+
+ErrorCode LoadRun::SendMove(Bot &bot, httplib::Client &http, Seat &seat, const Move &move)
+{
+    Count(bot.requests);
+    if (seat.ws != nullptr) {
+        WsConnection *ws = seat.ws.get();
+        // Answer: "ack <seq>" | "fail" | "retry"
+        if (!ws->Send(WsOpcode::TEXT, MoveText(move))) {
+            return CONNECTION_FAILED;
+        }
+        WsFrame frame;
+        Move pushed = NULL_MOVE;
+        uint64_t pushedSeq{ 0 };
+        while (ws->Receive(frame)) {
+            if (frame.opcode == WsOpcode::PING) {
+                ws->Send(WsOpcode::PONG, frame.payload);
+            } else if (frame.opcode == WsOpcode::TEXT && ParseMoveMessage(frame.payload, pushed, pushedSeq)) {
+                if (pushedSeq > seat.pushedSeq) {
+                    seat.pushed = pushed;
+                    seat.pushedSeq = pushedSeq;
+                }
+            } else if (frame.opcode == WsOpcode::TEXT && frame.payload == "fail") {
+                return INVALID_MOVE;
+            } else if (frame.opcode == WsOpcode::TEXT && frame.payload == "retry") {
+                return FILE_OPEN_ERROR;
+            } else if (frame.opcode == WsOpcode::TEXT && frame.payload.compare(0, 4, "ack ") == 0) {
+                return SUCCESS;
+            }
+        }
+        return CONNECTION_FAILED;
+    }
+    auto resp = http.Post("/sendmove?token=" + seat.token, MoveText(move), "text/plain");
+    if (UNLIKELY(!resp)) {
+        return CONNECTION_FAILED;
+    }
+    if (resp->status == STATUS_REJECTED_MOVE) {
+        return INVALID_MOVE;
+    }
+    if (resp->status == STATUS_RETRY_MOVE) {
+        return FILE_OPEN_ERROR;
+    }
+    return (resp->status == 200) ? SUCCESS : INVALID_SESSION;
+}
+
+/**************************************************
+ * @details
+ *      Pushed frames older than @param seq (the state
+ *      sent on connecting) are skipped. Over HTTP the
+ *      long poll ends with the run.
+ **************************************************/
+WaitResult LoadRun::WaitForMove(Bot &bot, httplib::Client &http, Seat &seat, uint64_t seq, Move &move)
+{
+    if (seat.pushedSeq > seq) {
+        move = seat.pushed;
+        return (seat.pushedSeq == seq + 1) ? WaitResult::MOVED : WaitResult::FAILED;
+    }
+    if (seat.ws != nullptr) {
+        WsConnection *ws = seat.ws.get();
+        WsFrame frame;
+        uint64_t pushed{ 0 };
+        while (ws->Receive(frame)) {
+            if (frame.opcode == WsOpcode::PING) {
+                ws->Send(WsOpcode::PONG, frame.payload);
+            } else if (frame.opcode == WsOpcode::TEXT && ParseMoveMessage(frame.payload, move, pushed) &&
+                pushed > seq) {
+                return (pushed == seq + 1) ? WaitResult::MOVED : WaitResult::FAILED;
+            }
+        }
+        return WaitResult::FAILED;
+    }
+
+    const int64_t waitMs = std::min(MOVE_POLL_TIMEOUT_MS, RemainingMs());
+    Count(bot.requests);
+    auto resp = http.Get("/getmoves?token=" + seat.token + "&since=" + std::to_string(seq) +
+        "&wait=" + std::to_string(waitMs));
+    std::vector<Move> moves;
+    uint64_t last{ 0 };
+    if (UNLIKELY(!resp || resp->status != 200 || !ParseMoveList(resp->body, moves, last))) {
+        return WaitResult::FAILED;
+    }
+    if (moves.empty()) {
+        return Expired() ? WaitResult::FAILED : WaitResult::TIMEOUT;
+    }
+    move = moves.front();
+    return (moves.size() == 1) ? WaitResult::MOVED : WaitResult::FAILED;
+}
+
+} // namespace
+
+void LatencyHistogram::Record(uint64_t micros)
+{
+    m_counts[BucketOf(micros)]++;
+    m_count++;
+    m_sum += micros;
+    m_max = std::max(m_max, micros);
+}
+
+void LatencyHistogram::Record(std::chrono::steady_clock::duration latency)
+{
+    const auto micros = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    Record(static_cast<uint64_t>(std::max<int64_t>(micros, 0)));
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram &other)
+{
+    for (size_t i{ 0 }; i < NUM_BUCKETS; i++) {
+        m_counts[i] += other.m_counts[i];
+    }
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_max = std::max(m_max, other.m_max);
+}
+
+double LatencyHistogram::Mean() const
+{
+    return (m_count == 0) ? 0.0 : static_cast<double>(m_sum) / static_cast<double>(m_count);
+}
+
+uint64_t LatencyHistogram::Percentile(double q) const
+{
+    if (m_count == 0) {
+        return 0;
+    }
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(q * static_cast<double>(m_count) + 0.5));
+    uint64_t seen{ 0 };
+    for (size_t i{ 0 }; i < NUM_BUCKETS; i++) {
+        seen += m_counts[i];
+        if (seen >= rank) {
+            return std::min(UpperBoundOf(i), m_max);
+        }
+    }
+    return m_max;
+}
+
+/**************************************************
+ * @details
+ *      Values below 16 have a bucket each; above, the
+ *      position of the top bit picks a group of 16
+ *      and the next 4 bits the bucket within it.
+ **************************************************/
+size_t LatencyHistogram::BucketOf(uint64_t micros)
+{
+    constexpr uint64_t SUB_BUCKETS{ 1u << SUB_BUCKET_BITS };
+    if (micros < SUB_BUCKETS) {
+        return static_cast<size_t>(micros);
+    }
+    micros = std::min<uint64_t>(micros, (1ull << LATENCY_MAX_BITS) - 1);
+    const size_t topBit = 63 - static_cast<size_t>(__builtin_clzll(micros));
+    const size_t shift = topBit - SUB_BUCKET_BITS;
+    return ((topBit - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) +
+        static_cast<size_t>((micros >> shift) & (SUB_BUCKETS - 1));
+}
+
+uint64_t LatencyHistogram::UpperBoundOf(size_t bucket)
+{
+    constexpr uint64_t SUB_BUCKETS{ 1u << SUB_BUCKET_BITS };
+    if (bucket < SUB_BUCKETS) {
+        return bucket;
+    }
+    const size_t shift = (bucket >> SUB_BUCKET_BITS) - 1;
+    const uint64_t lower = (SUB_BUCKETS + (bucket & (SUB_BUCKETS - 1))) << shift;
+    return lower + (1ull << shift) - 1;
+}
+
+LoadReport RunLoad(const LoadgenOptions &options, LoadProgress onProgress)
+{
+    LoadRun run(options);
+    return run.Run(onProgress);
+}
+
+} // namespace Shohih
@@ -0,0 +1,188 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Server metrics Implementation
+ **************************************************/
+
+#include <algorithm>
+#include <sstream>
+#include "metrics.h"
+
+namespace Shohih {
+
+namespace {
+
+constexpr uint64_t NANOS_PER_MS{ 1000000 };
+constexpr double NANOS_PER_SECOND{ 1e9 };
+
+// Labels of the endpoints, by Endpoint value
+const std::array<const char*, NUM_ENDPOINTS> ENDPOINT_NAMES{
+    "/register", "/exit", "/getmove", "/getmoves", "/sendmove", "/metrics", "ws"
+};
+
+//--------------------------------------------------
+// "# HELP" & "# TYPE" lines of a metric family
+//--------------------------------------------------
+void WriteHeader(std::ostream &out, const char *name, const char *type, const char *help)
+{
+    out << "# HELP " << name << " " << help << "\n"
+        << "# TYPE " << name << " " << type << "\n";
+}
+
+} // namespace
+
+const std::array<uint64_t, LatencyBuckets::NUM_BOUNDS> LatencyBuckets::BOUNDS{
+    NANOS_PER_MS / 10, NANOS_PER_MS / 4, NANOS_PER_MS / 2, NANOS_PER_MS,
+    NANOS_PER_MS * 5 / 2, NANOS_PER_MS * 5, NANOS_PER_MS * 10, NANOS_PER_MS * 25,
+    NANOS_PER_MS * 50, NANOS_PER_MS * 100, NANOS_PER_MS * 250, NANOS_PER_MS * 500,
+    NANOS_PER_MS * 1000, NANOS_PER_MS * 2500, NANOS_PER_MS * 10000, NANOS_PER_MS * 30000
+};
+
+const char *EndpointName(Endpoint endpoint)
+{
+    return ENDPOINT_NAMES[static_cast<size_t>(endpoint)];
+}
+
+uint64_t ShardedCounter::Value() const
+{
+    uint64_t total{ 0 };
+    for (const auto &cell : m_cells) {
+        total += cell.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+/**************************************************
+ * @details
+ *      Most requests are fast, so the linear scan
+ *      stops within the first few bounds.
+ **************************************************/
+void LatencyBuckets::Observe(std::chrono::steady_clock::duration latency)
+{
+    const uint64_t nanos = static_cast<uint64_t>(std::max<int64_t>(0,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count()));
+    size_t bucket{ 0 };
+    while (bucket < NUM_BOUNDS && nanos > BOUNDS[bucket]) {
+        bucket++;
+    }
+    Cell &cell = m_cells[MetricShard()];
+    cell.words[bucket].fetch_add(1, std::memory_order_relaxed);
+    cell.words[CELL_WORDS - 1].fetch_add(nanos, std::memory_order_relaxed);
+}
+
+LatencyBuckets::Totals LatencyBuckets::Collect() const
+{
+    Totals totals;
+    uint64_t sumNanos{ 0 };
+    for (const auto &cell : m_cells) {
+        for (size_t bucket{ 0 }; bucket <= NUM_BOUNDS; bucket++) {
+            totals.counts[bucket] += cell.words[bucket].load(std::memory_order_relaxed);
+        }
+        sumNanos += cell.words[CELL_WORDS - 1].load(std::memory_order_relaxed);
+    }
+    for (const uint64_t count : totals.counts) {
+        totals.count += count;
+    }
+    totals.sum = static_cast<double>(sumNanos) / NANOS_PER_SECOND;
+    return totals;
+}
+
+ServerMetrics::RequestTimer::RequestTimer(ServerMetrics *metrics, Endpoint endpoint) :
+    m_metrics(metrics), m_endpoint(endpoint), m_start(std::chrono::steady_clock::now())
+{
+    if (m_metrics != nullptr) {
+        m_metrics->m_endpoints[static_cast<size_t>(m_endpoint)].started.Add();
+    }
+}
+
+ServerMetrics::RequestTimer::~RequestTimer()
+{
+    if (m_metrics == nullptr) {
+        return;
+    }
+    EndpointMetrics &endpoint = m_metrics->m_endpoints[static_cast<size_t>(m_endpoint)];
+    endpoint.latency.Observe(std::chrono::steady_clock::now() - m_start);
+    if (m_failed) {
+        endpoint.failed.Add();
+    }
+    endpoint.finished.Add();
+}
+
+void ServerMetrics::CountMove(ErrorCode err)
+{
+    if (err == SUCCESS) {
+        m_moves.Add();
+    } else if (err == INVALID_MOVE) {
+        m_rejectedMoves.Add();
+    }
+}
+
+/**************************************************
+ * @details
+ *      Rates (requests/s, moves/s) are left to the
+ *      scraper: rate(shohih_moves_total[1m]).
+ *      Finished requests are read before started
+ *      ones, so the in-flight gauge does not dip
+ *      below zero.
+ **************************************************/
+std::string ServerMetrics::Render(const ServerGauges &gauges) const
+{
+    std::ostringstream out;
+    out.precision(10);
+
+    WriteHeader(out, "shohih_requests_total", "counter", "Requests answered, by endpoint");
+    for (size_t i{ 0 }; i < NUM_ENDPOINTS; i++) {
+        out << "shohih_requests_total{endpoint=\"" << ENDPOINT_NAMES[i] << "\"} "
+            << m_endpoints[i].finished.Value() << "\n";
+    }
+    WriteHeader(out, "shohih_request_errors_total", "counter", "Requests answered with an error, by endpoint");
+    for (size_t i{ 0 }; i < NUM_ENDPOINTS; i++) {
+        out << "shohih_request_errors_total{endpoint=\"" << ENDPOINT_NAMES[i] << "\"} "
+            << m_endpoints[i].failed.Value() << "\n";
+    }
+    WriteHeader(out, "shohih_requests_in_flight", "gauge",
+        "Requests being handled (held long polls included), by endpoint");
+    for (size_t i{ 0 }; i < NUM_ENDPOINTS; i++) {
+        const uint64_t finished = m_endpoints[i].finished.Value();
+        const uint64_t started = m_endpoints[i].started.Value();
+        out << "shohih_requests_in_flight{endpoint=\"" << ENDPOINT_NAMES[i] << "\"} "
+            << (started > finished ? started - finished : 0) << "\n";
+    }
+    WriteHeader(out, "shohih_request_duration_seconds", "histogram", "Time to answer a request, by endpoint");
+    for (size_t i{ 0 }; i < NUM_ENDPOINTS; i++) {
+        const LatencyBuckets::Totals totals = m_endpoints[i].latency.Collect();
+        uint64_t cumulative{ 0 };
+        for (size_t bucket{ 0 }; bucket <= LatencyBuckets::NUM_BOUNDS; bucket++) {
+            cumulative += totals.counts[bucket];
+            out << "shohih_request_duration_seconds_bucket{endpoint=\"" << ENDPOINT_NAMES[i] << "\",le=\"";
+            if (bucket < LatencyBuckets::NUM_BOUNDS) {
+                out << static_cast<double>(LatencyBuckets::BOUNDS[bucket]) / NANOS_PER_SECOND;
+            } else {
+                out << "+Inf";
+            }
+            out << "\"} " << cumulative << "\n";
+        }
+        out << "shohih_request_duration_seconds_sum{endpoint=\"" << ENDPOINT_NAMES[i] << "\"} "
+            << totals.sum << "\n"
+            << "shohih_request_duration_seconds_count{endpoint=\"" << ENDPOINT_NAMES[i] << "\"} "
+            << totals.count << "\n";
+    }
+
+    WriteHeader(out, "shohih_moves_total", "counter", "Moves played, over HTTP & WebSocket");
+    out << "shohih_moves_total " << m_moves.Value() << "\n";
+    WriteHeader(out, "shohih_rejected_moves_total", "counter", "Illegal or out of turn moves refused");
+    out << "shohih_rejected_moves_total " << m_rejectedMoves.Value() << "\n";
+
+    WriteHeader(out, "shohih_games", "gauge", "Games in progress");
+    out << "shohih_games " << gauges.games << "\n";
+    WriteHeader(out, "shohih_players", "gauge", "Players seated in a game");
+    out << "shohih_players " << gauges.sessions << "\n";
+    WriteHeader(out, "shohih_websocket_connections", "gauge", "Open WebSocket connections");
+    out << "shohih_websocket_connections " << gauges.wsConnections << "\n";
+    WriteHeader(out, "shohih_http_threads", "gauge", "HTTP request handler threads");
+    out << "shohih_http_threads " << gauges.httpThreads << "\n";
+    WriteHeader(out, "shohih_journal_pending_records", "gauge", "Journal records not on disk yet");
+    out << "shohih_journal_pending_records " << gauges.journalPending << "\n";
+    return out.str();
+}
+
+} // namespace Shohih
@@ -3,119 +3,249 @@
  * @brief   Shohih Server Implementation
  **************************************************/
 
-#include <sstream>
+#include <cstdlib>
 #include "server.h"
 
 namespace Shohih {
 
+namespace {
+
+// HTTP status codes
+constexpr int STATUS_BAD_REQUEST{ 400 };
+constexpr int STATUS_FORBIDDEN{ 403 };
+constexpr int STATUS_CONFLICT{ 409 };
+constexpr int STATUS_UNPROCESSABLE{ 422 };
+constexpr int STATUS_UNAVAILABLE{ 503 };
+
+//--------------------------------------------------
+// 503 when the journal could not record the change
+// (nothing changed, the client may retry)
+//--------------------------------------------------
+int ErrorStatus(ErrorCode err, int status)
+{
+    return (err == FILE_OPEN_ERROR) ? STATUS_UNAVAILABLE : status;
+}
+
+} // namespace
+
 /**************************************************
  * @details
  *      Server constructor: Registers handler functions
  *      for different HTTP request types (Get, Post, ...)
+ *      and sizes the handler thread pool.
  **************************************************/
-Server::Server() : httplib::Server()
+Server::Server(size_t threads) : httplib::Server(), m_threads(std::max<size_t>(threads, 1))
 {
-    Get("/register",
-        [this](const httplib::Request &req, httplib::Response &resp) {
-            this->RegisterClient(req, resp);
-        }
-    );
+    new_task_queue = [this]() { return new httplib::ThreadPool(m_threads); };
+    m_ws.SetMetrics(&m_metrics);
 
-    Get("/exit",
-        [this](const httplib::Request &req, httplib::Response &) {
-            this->RemoveClient(req);
+    // Moves stored through any endpoint are pushed to
+    // the opponent's WebSocket (if it has one)
+    m_games.SetMoveListener(
+        [this](const std::string &token, const Move &move, uint64_t seq) {
+            m_ws.Push(token, move, seq);
         }
     );
 
-    Get("/getmove",     // client "gets" the move
-        [this](const httplib::Request &, httplib::Response &resp) {
-            this->SendMove(resp);
-        }
-    );
+    Get("/register", Instrumented(Endpoint::REGISTER, &Server::RegisterClient));
+    Get("/exit", Instrumented(Endpoint::EXIT, &Server::RemoveClient));
+    Get("/getmove", Instrumented(Endpoint::GET_MOVE, &Server::SendMove));       // client "gets" the move
+    Get("/getmoves", Instrumented(Endpoint::GET_MOVES, &Server::SendMoves));    // client catches up on the game
+    Post("/sendmove", Instrumented(Endpoint::SEND_MOVE, &Server::ReceiveMove)); // client "sends" the move
+    Get("/metrics", Instrumented(Endpoint::METRICS, &Server::SendMetrics));
+}
 
-    Post("/sendmove",   // client "sends" the move
-        [this](const httplib::Request &req, httplib::Response &) {
-            this->ReceiveMove(req);
+/**************************************************
+ * @details
+ *      Two clock reads and a few relaxed atomic adds
+ *      on the handler thread's own cache lines: a
+ *      fraction of a microsecond per request.
+ **************************************************/
+httplib::Server::Handler Server::Instrumented(Endpoint endpoint, MemberHandler handler)
+{
+    return [this, endpoint, handler](const httplib::Request &req, httplib::Response &resp) {
+        ServerMetrics::RequestTimer timer(&m_metrics, endpoint);
+        (this->*handler)(req, resp);
+        if (resp.status >= STATUS_BAD_REQUEST) {
+            timer.Fail();
         }
-    );
+    };
 }
 
-void Server::Listen()
+void Server::Listen(int port, int wsPort)
 {
     const std::string addr{ "0.0.0.0" };
-    constexpr int port{ 8080 };
+    if (m_ws.Start(wsPort)) {
+        INFO_LOG("WebSocket endpoint is listening on " << addr << ":" << m_ws.GetPort() << "/ws");
+    } else {
+        WARNING_LOG("WebSocket endpoint disabled; clients fall back to HTTP");
+    }
     INFO_LOG("Server is listening on " << addr << ":" << port);
     listen(addr, port);
+    m_ws.Stop();
+    if (m_journal != nullptr) {
+        m_journal->Close();
+    }
+}
+
+ErrorCode Server::EnableJournal(const JournalOptions &options)
+{
+    m_journal.reset(new GameJournal(options));
+    RecoveryStats stats;
+    const ErrorCode err = m_journal->Open(m_games, stats);
+    if (UNLIKELY(err != SUCCESS)) {
+        m_journal.reset();
+        return err;
+    }
+    INFO_LOG("Journal " << options.dir << ": restored " << stats.games << " games ("
+        << stats.moves << " moves, " << stats.records << " records replayed) in "
+        << stats.seconds << " s");
+    return SUCCESS;
 }
 
 /**************************************************
  * @details
- *      Register the client and choose its piece color
+ *      Seat the client in the requested room (or a
+ *      new one) and hand out its session token.
+ *      Body: <color> <room> <token> | fail
  **************************************************/
 void Server::RegisterClient(const httplib::Request &req, httplib::Response &resp)
 {
-    if (UNLIKELY(m_numConnectedClients >= 2)) {
-        ERROR_LOG("Server cannot serve more than 2 clients");
+    std::string room = req.get_param_value("room");
+    std::string token;
+    PieceColor color{ PieceColor::WHITE };
+    const ErrorCode err = m_games.Join(room, token, color);
+    if (UNLIKELY(err != SUCCESS)) {
+        if (err == ROOM_FULL) {
+            ERROR_LOG("Room " << room << " already has 2 clients");
+        }
+        resp.status = ErrorStatus(err, (err == ROOM_FULL) ? STATUS_CONFLICT : STATUS_BAD_REQUEST);
         resp.body = "fail";
         return;
     }
-    resp.body = (m_numConnectedClients == 0) ? "white" : "black";
-    m_numConnectedClients++;
+    const std::string colorName = (color == PieceColor::WHITE) ? "white" : "black";
+    resp.body = colorName + " " + room + " " + token;
     INFO_LOG("Client with address " << req.remote_addr
-        << " joined Shohih server [" << resp.body << "]");
+        << " joined room " << room << " [" << colorName << "]");
 }
 
 /**************************************************
  * @details
- *      Decrement number of connected clients
+ *      Free the client's seat (the game ends once
+ *      both clients have left)
  **************************************************/
-void Server::RemoveClient(const httplib::Request &req)
+void Server::RemoveClient(const httplib::Request &req, httplib::Response &resp)
 {
-    if (m_numConnectedClients > 0) {
-        m_numConnectedClients--;
+    const ErrorCode err = m_games.Leave(req.get_param_value("token"));
+    if (UNLIKELY(err != SUCCESS)) {
+        resp.status = ErrorStatus(err, STATUS_FORBIDDEN);
+        return;
     }
-    m_lastMove = NULL_MOVE;
     RED_INFO_LOG("Client with address "
         << req.remote_addr << " left Shohih server");
 }
 
 /**************************************************
  * @details
- *      Server sends the last move in response body.
- *      Format: <square str>-<square str> (separated by a dash)
+ *      Server sends the last move of the client's
+ *      game in response body, with its sequence number.
+ *      With ?since=<seq>, the request is held until
+ *      the game moves past <seq> or ?wait=<ms> (at
+ *      most MAX_MOVE_WAIT) expires.
+ *      Format: <square str>-<square str> <seq>
  **************************************************/
-void Server::SendMove(httplib::Response &resp)
+void Server::SendMove(const httplib::Request &req, httplib::Response &resp)
 {
-    if (UNLIKELY(m_lastMove.first == NULL_SQUARE ||
-                 m_lastMove.second == NULL_SQUARE)) {
-        resp.body = "null-null";
+    const std::string token = req.get_param_value("token");
+    Move lastMove = NULL_MOVE;
+    uint64_t seq{ 0 };
+    ErrorCode err{ SUCCESS };
+    if (req.has_param("since")) {
+        const uint64_t since = std::strtoull(req.get_param_value("since").c_str(), nullptr, 10);
+        const auto wait = req.has_param("wait")
+            ? std::chrono::milliseconds(std::atoll(req.get_param_value("wait").c_str()))
+            : MAX_MOVE_WAIT;
+        err = m_games.WaitForMove(token, since, wait, lastMove, seq);
+    } else {
+        err = m_games.GetLastMove(token, lastMove, seq);
+    }
+    if (UNLIKELY(err != SUCCESS)) {
+        resp.status = STATUS_FORBIDDEN;
+        resp.body = "fail";
         return;
     }
-    std::stringstream move;
-    move << m_lastMove.first.GetSquareName() << "-"
-         << m_lastMove.second.GetSquareName();
-    resp.body = move.str();
+    resp.body = FormatMoveMessage(lastMove, seq);
+}
+
+/**************************************************
+ * @details
+ *      All moves of the client's game after ?since=
+ *      (default 0) in one response. With ?wait=<ms>,
+ *      the request is held like /getmove while there
+ *      are none.
+ *      Format: <seq> <square str>-<square str> ...
+ **************************************************/
+void Server::SendMoves(const httplib::Request &req, httplib::Response &resp)
+{
+    const uint64_t since = std::strtoull(req.get_param_value("since").c_str(), nullptr, 10);
+    const auto wait = std::chrono::milliseconds(std::atoll(req.get_param_value("wait").c_str()));
+    std::vector<Move> moves;
+    uint64_t seq{ 0 };
+    if (UNLIKELY(m_games.WaitForMoves(req.get_param_value("token"), since, wait, moves, seq) != SUCCESS)) {
+        resp.status = STATUS_FORBIDDEN;
+        resp.body = "fail";
+        return;
+    }
+    resp.body = FormatMoveList(moves, seq);
 }
 
 /**************************************************
  * @details
  *      Clients put their moves in request body.
  *      Format: <square str>-<square str> (separated by a dash)
+ *      The move is checked against the game's board:
+ *      400 if malformed, 422 if illegal or out of turn,
+ *      503 if the journal cannot record it.
+ *      The response body is the move's sequence number.
  **************************************************/
-void Server::ReceiveMove(const httplib::Request &req)
+void Server::ReceiveMove(const httplib::Request &req, httplib::Response &resp)
 {
-    std::string move = req.body;
-    auto separator = move.find('-');
-    if (UNLIKELY(separator == std::string::npos)) {
+    Move move = NULL_MOVE;
+    uint64_t seq{ 0 };
+    if (UNLIKELY(!ParseMoveMessage(req.body, move, seq))) {
+        resp.status = STATUS_BAD_REQUEST;
+        return;
+    }
+    if (UNLIKELY(move == NULL_MOVE)) {
         return;
     }
-    auto src_sq_str = move.substr(0, separator);
-    auto dst_sq_str = move.substr(separator + 1);
-    if (UNLIKELY(src_sq_str == "null" || dst_sq_str == "null")) {
+    const ErrorCode err = m_games.SetLastMove(req.get_param_value("token"), move, seq);
+    m_metrics.CountMove(err);
+    if (UNLIKELY(err != SUCCESS)) {
+        resp.status = ErrorStatus(err, (err == INVALID_MOVE) ? STATUS_UNPROCESSABLE : STATUS_FORBIDDEN);
+        resp.body = "fail";
         return;
     }
-    m_lastMove.first = Square::GetSquareByName(src_sq_str);
-    m_lastMove.second = Square::GetSquareByName(dst_sq_str);
+    resp.body = std::to_string(seq);
+}
+
+/**************************************************
+ * @details
+ *      Gauges are read from the registry, the
+ *      WebSocket endpoint & the journal at scrape
+ *      time (each takes its locks briefly).
+ **************************************************/
+void Server::SendMetrics(const httplib::Request &, httplib::Response &resp)
+{
+    ServerGauges gauges;
+    gauges.games = m_games.NumGames();
+    gauges.sessions = m_games.NumSessions();
+    gauges.wsConnections = m_ws.NumConnections();
+    gauges.httpThreads = m_threads;
+    if (m_journal != nullptr) {
+        gauges.journalPending = m_journal->NumPendingRecords();
+    }
+    resp.set_content(m_metrics.Render(gauges), "text/plain; version=0.0.4");
 }
 
-} // namespace Shohih
\ No newline at end of file
+} // namespace Shohih
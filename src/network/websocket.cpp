@@ -0,0 +1,782 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   WebSocket push transport Implementation
+ **************************************************/
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <vector>
+#include "websocket.h"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace Shohih {
+
+namespace {
+
+// RFC 6455 handshake GUID
+const char WEBSOCKET_GUID[]{ "258EAFA5-E914-47DA-95CA-C5AB0DC85B11" };
+
+constexpr size_t MAX_HANDSHAKE_SIZE{ 8192 };
+constexpr std::chrono::milliseconds HANDSHAKE_TIMEOUT{ 5000 };
+// A stalled peer cannot block the thread pushing to it for longer
+constexpr std::chrono::milliseconds SEND_TIMEOUT{ 5000 };
+
+//--------------------------------------------------
+// SHA-1 digest (only used for the handshake)
+//--------------------------------------------------
+std::array<uint8_t, 20> Sha1(const std::string &data)
+{
+    auto rotl = [](uint32_t v, int n) { return (v << n) | (v >> (32 - n)); };
+    uint32_t h[5]{ 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+
+    std::string msg = data;
+    msg += static_cast<char>(0x80);
+    while (msg.size() % 64 != 56) {
+        msg += '\0';
+    }
+    const uint64_t bits = static_cast<uint64_t>(data.size()) * 8;
+    for (int i{ 7 }; i >= 0; i--) {
+        msg += static_cast<char>((bits >> (i * 8)) & 0xFF);
+    }
+
+    for (size_t chunk{ 0 }; chunk < msg.size(); chunk += 64) {
+        uint32_t w[80];
+        for (int i{ 0 }; i < 16; i++) {
+            w[i] = 0;
+            for (int b{ 0 }; b < 4; b++) {
+                w[i] = (w[i] << 8) | static_cast<uint8_t>(msg[chunk + 4 * i + b]);
+            }
+        }
+        for (int i{ 16 }; i < 80; i++) {
+            w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i{ 0 }; i < 80; i++) {
+            uint32_t f, k;
+            if (i < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            } else if (i < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (i < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+            const uint32_t temp = rotl(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotl(b, 30);
+            b = a;
+            a = temp;
+        }
+        h[0] += a;
+        h[1] += b;
+        h[2] += c;
+        h[3] += d;
+        h[4] += e;
+    }
+
+    std::array<uint8_t, 20> digest{};
+    for (size_t i{ 0 }; i < digest.size(); i++) {
+        digest[i] = static_cast<uint8_t>(h[i / 4] >> (24 - 8 * (i % 4)));
+    }
+    return digest;
+}
+
+std::string Base64(const uint8_t *data, size_t size)
+{
+    static const char CHARS[]{ "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/" };
+    std::string out;
+    for (size_t i{ 0 }; i < size; i += 3) {
+        uint32_t group = static_cast<uint32_t>(data[i]) << 16;
+        if (i + 1 < size) { group |= static_cast<uint32_t>(data[i + 1]) << 8; }
+        if (i + 2 < size) { group |= data[i + 2]; }
+        out += CHARS[(group >> 18) & 0x3F];
+        out += CHARS[(group >> 12) & 0x3F];
+        out += (i + 1 < size) ? CHARS[(group >> 6) & 0x3F] : '=';
+        out += (i + 2 < size) ? CHARS[group & 0x3F] : '=';
+    }
+    return out;
+}
+
+std::mt19937_64 &Rng()
+{
+    thread_local std::mt19937_64 rng{ std::random_device{}() };
+    return rng;
+}
+
+int64_t NowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void SetTimeout(int fd, int option, std::chrono::milliseconds timeout)
+{
+    timeval tv{};
+    tv.tv_sec = static_cast<time_t>(timeout.count() / 1000);
+    tv.tv_usec = static_cast<suseconds_t>((timeout.count() % 1000) * 1000);
+    setsockopt(fd, SOL_SOCKET, option, &tv, sizeof(tv));
+}
+
+bool SendAll(int fd, const std::string &data)
+{
+    size_t sent{ 0 };
+    while (sent < data.size()) {
+        const ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+//--------------------------------------------------
+// Read an HTTP header block. Bytes past its end are
+// returned in @param rest.
+//--------------------------------------------------
+bool ReadHttpHeader(int fd, std::string &header, std::string &rest)
+{
+    std::string data;
+    char chunk[1024];
+    size_t end{ std::string::npos };
+    while ((end = data.find("\r\n\r\n")) == std::string::npos) {
+        if (data.size() > MAX_HANDSHAKE_SIZE) {
+            return false;
+        }
+        const ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data.append(chunk, static_cast<size_t>(n));
+    }
+    header = data.substr(0, end + 2);
+    rest = data.substr(end + 4);
+    return true;
+}
+
+//--------------------------------------------------
+// Value of header @param name (lower case), or ""
+//--------------------------------------------------
+std::string HeaderValue(const std::string &header, const std::string &name)
+{
+    std::string lower = header;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    size_t pos = lower.find("\r\n" + name + ":");
+    if (pos == std::string::npos) {
+        return "";
+    }
+    pos += name.size() + 3;
+    const size_t end = header.find("\r\n", pos);
+    std::string value = header.substr(pos, end - pos);
+    value.erase(0, value.find_first_not_of(" \t"));
+    value.erase(value.find_last_not_of(" \t") + 1);
+    return value;
+}
+
+//--------------------------------------------------
+// ?token=<token> of a request target
+//--------------------------------------------------
+std::string TokenOf(const std::string &target)
+{
+    const size_t query = target.find('?');
+    if (query == std::string::npos) {
+        return "";
+    }
+    std::istringstream params(target.substr(query + 1));
+    std::string param;
+    while (std::getline(params, param, '&')) {
+        if (param.compare(0, 6, "token=") == 0) {
+            return param.substr(6);
+        }
+    }
+    return "";
+}
+
+} // namespace
+
+//--------------------------------------------------
+// Move messages
+//--------------------------------------------------
+std::string FormatMoveMessage(const Move &move, uint64_t seq)
+{
+    if (UNLIKELY(move.first == NULL_SQUARE || move.second == NULL_SQUARE)) {
+        return "null-null " + std::to_string(seq);
+    }
+    return move.first.GetSquareName() + "-" + move.second.GetSquareName() + " " + std::to_string(seq);
+}
+
+/**************************************************
+ * @details
+ *      The sequence number is optional (0 when
+ *      missing), so bare "e2-e4" bodies parse too.
+ **************************************************/
+bool ParseMoveMessage(const std::string &message, Move &move, uint64_t &seq)
+{
+    std::istringstream in(message);
+    std::string moveStr;
+    if (!(in >> moveStr)) {
+        return false;
+    }
+    if (!(in >> seq)) {
+        seq = 0;
+    }
+    const size_t separator = moveStr.find('-');
+    if (UNLIKELY(separator == std::string::npos)) {
+        return false;
+    }
+    const std::string src = moveStr.substr(0, separator);
+    const std::string dst = moveStr.substr(separator + 1);
+    if (src == "null" || dst == "null") {
+        move = NULL_MOVE;
+        return true;
+    }
+    if (UNLIKELY(src.size() != 2 || dst.size() != 2)) {
+        return false;
+    }
+    move = Move{ Square::GetSquareByName(src), Square::GetSquareByName(dst) };
+    return move.first.IsValid() && move.second.IsValid();
+}
+
+std::string FormatMoveList(const std::vector<Move> &moves, uint64_t seq)
+{
+    std::string message = std::to_string(seq);
+    message.reserve(message.size() + moves.size() * 6);
+    for (const Move &move : moves) {
+        message += ' ';
+        message += move.first.GetSquareName() + "-" + move.second.GetSquareName();
+    }
+    return message;
+}
+
+bool ParseMoveList(const std::string &message, std::vector<Move> &moves, uint64_t &seq)
+{
+    moves.clear();
+    std::istringstream in(message);
+    if (!(in >> seq)) {
+        return false;
+    }
+    std::string moveStr;
+    while (in >> moveStr) {
+        Move move = NULL_MOVE;
+        uint64_t unused{ 0 };
+        if (UNLIKELY(!ParseMoveMessage(moveStr, move, unused) || move == NULL_MOVE)) {
+            return false;
+        }
+        moves.push_back(move);
+    }
+    return moves.size() <= seq;
+}
+
+std::string WsAcceptKey(const std::string &key)
+{
+    const auto digest = Sha1(key + WEBSOCKET_GUID);
+    return Base64(digest.data(), digest.size());
+}
+
+//--------------------------------------------------
+// Frames
+//--------------------------------------------------
+std::string EncodeWsFrame(WsOpcode opcode, const std::string &payload, bool mask)
+{
+    std::string frame;
+    frame.reserve(payload.size() + 14);
+    frame += static_cast<char>(0x80 | static_cast<uint8_t>(opcode));   // FIN
+    const uint8_t maskBit = mask ? 0x80 : 0x00;
+    const uint64_t size = payload.size();
+    if (size < 126) {
+        frame += static_cast<char>(maskBit | size);
+    } else if (size <= 0xFFFF) {
+        frame += static_cast<char>(maskBit | 126);
+        frame += static_cast<char>((size >> 8) & 0xFF);
+        frame += static_cast<char>(size & 0xFF);
+    } else {
+        frame += static_cast<char>(maskBit | 127);
+        for (int i{ 7 }; i >= 0; i--) {
+            frame += static_cast<char>((size >> (i * 8)) & 0xFF);
+        }
+    }
+    if (!mask) {
+        return frame + payload;
+    }
+    const uint32_t key = static_cast<uint32_t>(Rng()());
+    char keyBytes[4];
+    for (int i{ 0 }; i < 4; i++) {
+        keyBytes[i] = static_cast<char>((key >> (8 * i)) & 0xFF);
+        frame += keyBytes[i];
+    }
+    for (size_t i{ 0 }; i < payload.size(); i++) {
+        frame += static_cast<char>(payload[i] ^ keyBytes[i % 4]);
+    }
+    return frame;
+}
+
+/**************************************************
+ * @details
+ *      Fragmented frames, reserved bits and payloads
+ *      above WEBSOCKET_MAX_PAYLOAD are rejected:
+ *      Shohih messages always fit in one small frame.
+ **************************************************/
+size_t DecodeWsFrame(const std::string &buffer, WsFrame &frame, bool fromClient)
+{
+    if (buffer.size() < 2) {
+        return 0;
+    }
+    const uint8_t b0 = static_cast<uint8_t>(buffer[0]);
+    const uint8_t b1 = static_cast<uint8_t>(buffer[1]);
+    if (UNLIKELY((b0 & 0x80) == 0 || (b0 & 0x70) != 0)) {
+        return std::string::npos;
+    }
+    const uint8_t opcode = b0 & 0x0F;
+    switch (static_cast<WsOpcode>(opcode)) {
+    case WsOpcode::TEXT:
+    case WsOpcode::BINARY:
+    case WsOpcode::CLOSE:
+    case WsOpcode::PING:
+    case WsOpcode::PONG:
+        break;
+    default:
+        return std::string::npos;
+    }
+
+    size_t pos{ 2 };
+    uint64_t size = b1 & 0x7F;
+    if (size == 126) {
+        if (buffer.size() < 4) { return 0; }
+        size = (static_cast<uint64_t>(static_cast<uint8_t>(buffer[2])) << 8) |
+            static_cast<uint8_t>(buffer[3]);
+        pos = 4;
+    } else if (size == 127) {
+        if (buffer.size() < 10) { return 0; }
+        size = 0;
+        for (size_t i{ 2 }; i < 10; i++) {
+            size = (size << 8) | static_cast<uint8_t>(buffer[i]);
+        }
+        pos = 10;
+    }
+    if (UNLIKELY(size > WEBSOCKET_MAX_PAYLOAD)) {
+        return std::string::npos;
+    }
+    const bool masked = (b1 & 0x80) != 0;
+    if (UNLIKELY(masked != fromClient)) {
+        return std::string::npos;
+    }
+    const size_t keyPos = pos;
+    if (masked) {
+        pos += 4;
+    }
+    if (buffer.size() < pos + size) {
+        return 0;
+    }
+
+    frame.opcode = static_cast<WsOpcode>(opcode);
+    frame.payload.assign(buffer, pos, static_cast<size_t>(size));
+    if (masked) {
+        for (size_t i{ 0 }; i < frame.payload.size(); i++) {
+            frame.payload[i] = static_cast<char>(frame.payload[i] ^ buffer[keyPos + i % 4]);
+        }
+    }
+    return pos + static_cast<size_t>(size);
+}
+
+//--------------------------------------------------
+// WsConnection
+//--------------------------------------------------
+WsConnection::WsConnection(int fd, bool client, std::string buffered) :
+    m_fd(fd), m_client(client), m_buffer(std::move(buffered)), m_lastSeen(NowMs())
+{
+    const int noDelay{ 1 };
+    setsockopt(m_fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+}
+
+WsConnection::~WsConnection()
+{
+    ::close(m_fd);
+}
+
+/**************************************************
+ * @details
+ *      Client side handshake. The socket times out
+ *      after @param timeout without any frame, so a
+ *      dead server is noticed (it pings more often).
+ **************************************************/
+std::shared_ptr<WsConnection> WsConnection::Connect(const std::string &host, int port,
+    const std::string &path, std::chrono::milliseconds timeout)
+{
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *addrs{ nullptr };
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addrs) != 0) {
+        return nullptr;
+    }
+    int fd{ -1 };
+    for (addrinfo *addr = addrs; addr != nullptr; addr = addr->ai_next) {
+        fd = ::socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        if (::connect(fd, addr->ai_addr, addr->ai_addrlen) == 0) {
+            break;
+        }
+        ::close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(addrs);
+    if (fd < 0) {
+        return nullptr;
+    }
+    SetTimeout(fd, SO_RCVTIMEO, std::min(timeout, HANDSHAKE_TIMEOUT));
+    SetTimeout(fd, SO_SNDTIMEO, SEND_TIMEOUT);
+
+    uint8_t nonce[16];
+    for (auto &byte : nonce) {
+        byte = static_cast<uint8_t>(Rng()());
+    }
+    const std::string key = Base64(nonce, sizeof(nonce));
+    const std::string request =
+        "GET " + path + " HTTP/1.1\r\n"
+        "Host: " + host + ":" + std::to_string(port) + "\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: Upgrade\r\n"
+        "Sec-WebSocket-Key: " + key + "\r\n"
+        "Sec-WebSocket-Version: 13\r\n\r\n";
+    std::string header, rest;
+    if (!SendAll(fd, request) || !ReadHttpHeader(fd, header, rest) ||
+        header.compare(0, 12, "HTTP/1.1 101") != 0 ||
+        HeaderValue(header, "sec-websocket-accept") != WsAcceptKey(key)) {
+        ::close(fd);
+        return nullptr;
+    }
+    SetTimeout(fd, SO_RCVTIMEO, timeout);
+    return std::make_shared<WsConnection>(fd, true, rest);
+}
+
+bool WsConnection::Send(WsOpcode opcode, const std::string &payload)
+{
+    const std::string frame = EncodeWsFrame(opcode, payload, m_client);
+    std::lock_guard<std::mutex> lock(m_sendMutex);
+    return SendAll(m_fd, frame);
+}
+
+/**************************************************
+ * @details
+ *      A close frame is answered and ends the
+ *      connection like any read error.
+ **************************************************/
+bool WsConnection::Receive(WsFrame &frame)
+{
+    char chunk[1024];
+    while (true) {
+        const size_t consumed = DecodeWsFrame(m_buffer, frame, !m_client);
+        if (UNLIKELY(consumed == std::string::npos)) {
+            Send(WsOpcode::CLOSE, "");
+            return false;
+        }
+        if (consumed > 0) {
+            m_buffer.erase(0, consumed);
+            m_lastSeen = NowMs();
+            if (frame.opcode == WsOpcode::CLOSE) {
+                Send(WsOpcode::CLOSE, "");
+                return false;
+            }
+            return true;
+        }
+        const ssize_t n = ::recv(m_fd, chunk, sizeof(chunk), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        m_buffer.append(chunk, static_cast<size_t>(n));
+    }
+}
+
+void WsConnection::Shutdown()
+{
+    ::shutdown(m_fd, SHUT_RDWR);
+}
+
+std::chrono::steady_clock::time_point WsConnection::LastSeen() const
+{
+    return std::chrono::steady_clock::time_point(std::chrono::milliseconds(m_lastSeen.load()));
+}
+
+//--------------------------------------------------
+// WsServer
+//--------------------------------------------------
+WsServer::WsServer(GameRegistry &games, std::chrono::milliseconds pingInterval, size_t maxConnections) :
+    m_games(games), m_pingInterval(pingInterval), m_maxConnections(maxConnections)
+{
+}
+
+WsServer::~WsServer()
+{
+    Stop();
+}
+
+bool WsServer::Start(int port)
+{
+    m_listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (UNLIKELY(m_listenFd < 0)) {
+        ERROR_LOG("Failed to create WebSocket server socket");
+        return false;
+    }
+    const int reuse{ 1 };
+    setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    socklen_t addrLen = sizeof(addr);
+    if (::bind(m_listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        ::listen(m_listenFd, SOMAXCONN) != 0 ||
+        ::getsockname(m_listenFd, reinterpret_cast<sockaddr*>(&addr), &addrLen) != 0) {
+        ERROR_LOG("Failed to listen on WebSocket port " << port);
+        ::close(m_listenFd);
+        m_listenFd = -1;
+        return false;
+    }
+    m_port = ntohs(addr.sin_port);
+    m_running = true;
+    m_acceptThread = std::thread(&WsServer::AcceptLoop, this);
+    m_pingThread = std::thread(&WsServer::PingLoop, this);
+    return true;
+}
+
+/**************************************************
+ * @details
+ *      Stops accepting, closes every connection and
+ *      waits for the connection threads to finish.
+ **************************************************/
+void WsServer::Stop()
+{
+    if (!m_running.exchange(false)) {
+        return;
+    }
+    ::shutdown(m_listenFd, SHUT_RDWR);
+    m_acceptThread.join();
+    ::close(m_listenFd);
+    m_listenFd = -1;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (auto &conn : m_connections) {
+        conn.second->Shutdown();
+    }
+    m_cv.notify_all();
+    lock.unlock();
+    m_pingThread.join();
+
+    lock.lock();
+    m_cv.wait(lock, [this]() { return m_numServing == 0; });
+    m_connections.clear();
+}
+
+/**************************************************
+ * @details
+ *      Connections over the limit are refused before
+ *      the handshake, so they cost no thread.
+ **************************************************/
+void WsServer::AcceptLoop()
+{
+    while (m_running) {
+        const int fd = ::accept(m_listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            if (!m_running) {
+                break;
+            }
+            if (errno != EINTR && errno != ECONNABORTED) {
+                // e.g. out of file descriptors: let connections close
+                WARNING_LOG("WebSocket accept failed (errno " << errno << ")");
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (UNLIKELY(m_numServing >= m_maxConnections)) {
+                SetTimeout(fd, SO_SNDTIMEO, HANDSHAKE_TIMEOUT);
+                SendAll(fd, "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n\r\n");
+                ::close(fd);
+                continue;
+            }
+            m_numServing++;
+        }
+        std::thread(&WsServer::Serve, this, fd).detach();
+    }
+}
+
+/**************************************************
+ * @details
+ *      One thread per connection: handshake, then
+ *      the current state of the game, then incoming
+ *      frames until the peer goes away. A second
+ *      connection with the same token replaces the
+ *      first one.
+ **************************************************/
+void WsServer::Serve(int fd)
+{
+    SetTimeout(fd, SO_RCVTIMEO, HANDSHAKE_TIMEOUT);
+    SetTimeout(fd, SO_SNDTIMEO, SEND_TIMEOUT);
+
+    std::string header, rest, token, key;
+    Session session;
+    bool accepted{ false };
+    if (ReadHttpHeader(fd, header, rest) && header.compare(0, 8, "GET /ws?") == 0) {
+        token = TokenOf(header.substr(4, header.find(' ', 4) - 4));
+        key = HeaderValue(header, "sec-websocket-key");
+        accepted = !key.empty() && m_games.FindSession(token, session);
+    }
+    std::shared_ptr<WsConnection> conn{ nullptr }, replaced{ nullptr };
+    if (!accepted) {
+        SendAll(fd, "HTTP/1.1 403 Forbidden\r\nContent-Length: 0\r\n\r\n");
+        ::close(fd);
+    } else if (SendAll(fd, "HTTP/1.1 101 Switching Protocols\r\n"
+                           "Upgrade: websocket\r\n"
+                           "Connection: Upgrade\r\n"
+                           "Sec-WebSocket-Accept: " + WsAcceptKey(key) + "\r\n\r\n")) {
+        SetTimeout(fd, SO_RCVTIMEO, std::chrono::milliseconds(0));
+        conn = std::make_shared<WsConnection>(fd, false, rest);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_running) {
+            auto &slot = m_connections[token];
+            replaced = slot;
+            slot = conn;
+        } else {
+            conn->Shutdown();
+        }
+    } else {
+        ::close(fd);
+    }
+
+    if (conn != nullptr) {
+        if (replaced != nullptr) {
+            replaced->Shutdown();
+        }
+        Move move = NULL_MOVE;
+        uint64_t seq{ 0 };
+        if (m_games.GetLastMove(token, move, seq) == SUCCESS) {
+            conn->Send(WsOpcode::TEXT, FormatMoveMessage(move, seq));
+        }
+        WsFrame frame;
+        while (conn->Receive(frame)) {
+            if (frame.opcode == WsOpcode::PING) {
+                conn->Send(WsOpcode::PONG, frame.payload);
+            } else if (frame.opcode == WsOpcode::TEXT) {
+                HandleMove(token, *conn, frame.payload);
+            }
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_connections.find(token);
+        if (it != m_connections.end() && it->second == conn) {
+            m_connections.erase(it);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_numServing--;
+    m_cv.notify_all();
+}
+
+void WsServer::HandleMove(const std::string &token, WsConnection &conn, const std::string &message)
+{
+    ServerMetrics::RequestTimer timer(m_metrics, Endpoint::WS_MOVE);
+    Move move = NULL_MOVE;
+    uint64_t seq{ 0 };
+    if (UNLIKELY(!ParseMoveMessage(message, move, seq) || move == NULL_MOVE)) {
+        timer.Fail();
+        conn.Send(WsOpcode::TEXT, "fail");
+        return;
+    }
+    const ErrorCode err = m_games.SetLastMove(token, move, seq);
+    if (m_metrics != nullptr) {
+        m_metrics->CountMove(err);
+    }
+    if (UNLIKELY(err != SUCCESS)) {
+        timer.Fail();
+        conn.Send(WsOpcode::TEXT, (err == FILE_OPEN_ERROR) ? "retry" : "fail");
+        return;
+    }
+    conn.Send(WsOpcode::TEXT, "ack " + std::to_string(seq));
+}
+
+/**************************************************
+ * @details
+ *      Every interval: ping each connection, or drop
+ *      it if nothing arrived for WEBSOCKET_PING_TIMEOUTS
+ *      intervals (pongs count).
+ **************************************************/
+void WsServer::PingLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_running) {
+        m_cv.wait_for(lock, m_pingInterval, [this]() { return !m_running; });
+        if (!m_running) {
+            break;
+        }
+        std::vector<std::shared_ptr<WsConnection>> conns;
+        conns.reserve(m_connections.size());
+        for (const auto &conn : m_connections) {
+            conns.push_back(conn.second);
+        }
+        lock.unlock();
+        const auto deadline = std::chrono::steady_clock::now() - m_pingInterval * WEBSOCKET_PING_TIMEOUTS;
+        for (const auto &conn : conns) {
+            if (conn->LastSeen() < deadline) {
+                conn->Shutdown();
+            } else {
+                conn->Send(WsOpcode::PING, "");
+            }
+        }
+        lock.lock();
+    }
+}
+
+void WsServer::Push(const std::string &token, const Move &move, uint64_t seq)
+{
+    std::shared_ptr<WsConnection> conn{ nullptr };
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_connections.find(token);
+        if (it == m_connections.end()) {
+            return;
+        }
+        conn = it->second;
+    }
+    conn->Send(WsOpcode::TEXT, FormatMoveMessage(move, seq));
+}
+
+size_t WsServer::NumConnections() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_connections.size();
+}
+
+} // namespace Shohih
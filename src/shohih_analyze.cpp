@@ -0,0 +1,144 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Batch position analysis to JSON lines
+ **************************************************/
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include "analyze.h"
+#include "bitbase.h"
+
+using namespace Shohih;
+
+namespace {
+
+void PrintUsage(const std::string &progName)
+{
+    std::cout << "Usage: " << progName << " [OPTIONS] FILE\n"
+              << "FILE holds one FEN or EPD per line, or 32-byte packed positions (.bin).\n"
+              << "Writes one JSON object per position, in input order.\n"
+              << "Options:\n"
+              << "-o, --output\tJSON lines file (default: stdout, shared with log messages)\n"
+              << "-n, --nodes\tNode budget per position (default 1000000)\n"
+              << "-T, --time\tTime budget per position in ms (replaces the node budget)\n"
+              << "-d, --depth\tDepth limit per position (alone: replaces the node budget)\n"
+              << "-t, --threads\tSearch workers (default: all cores)\n"
+              << "-H, --hash\tHash per worker in MB (default 16)\n"
+              << "-w, --window\tResults held back for an earlier position (default 4 per worker)\n"
+              << "--packed\tRead FILE as packed positions whatever its extension\n"
+              << "--pack OUT\tOnly convert the FEN/EPD lines of FILE to packed positions in OUT\n"
+              << "Example: " << progName << " -n 2000000 -o analysis.jsonl positions.epd" << std::endl;
+}
+
+bool HasExtension(const std::string &path, const std::string &extension)
+{
+    return path.size() >= extension.size() &&
+        path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+//--------------------------------------------------
+// FEN/EPD lines => packed records (invalid lines and
+// positions with more than 32 pieces are skipped)
+//--------------------------------------------------
+int PackFile(std::istream &in, const std::string &outPath)
+{
+    std::ofstream out(outPath, std::ios::binary);
+    if (UNLIKELY(!out.is_open())) {
+        ERROR_LOG("Could not open " << outPath);
+        return 1;
+    }
+    PositionReader reader(in, InputFormat::TEXT);
+    std::string input;
+    size_t packedCount{ 0 }, skipped{ 0 };
+    while (reader.Next(input)) {
+        Position pos;
+        PackedPosition packed;
+        if (pos.SetFEN(input) != SUCCESS || PackPosition(pos, packed) != SUCCESS) {
+            skipped++;
+            continue;
+        }
+        out.write(reinterpret_cast<const char *>(packed.data()), PACKED_POSITION_SIZE);
+        packedCount++;
+    }
+    INFO_LOG("Packed " << packedCount << " positions into " << outPath << " (" << skipped << " skipped)");
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    AnalyzeOptions options;
+    bool nodesSet{ false }, packed{ false };
+    std::string inPath, outPath, packPath;
+    for (int i{ 1 }; i < argc; i++) {
+        std::string flag(argv[i]);
+        const bool hasValue = i + 1 < argc;
+        if ((flag == "-o" || flag == "--output") && hasValue) {
+            outPath = argv[++i];
+        } else if ((flag == "-n" || flag == "--nodes") && hasValue) {
+            options.nodes = std::strtoull(argv[++i], nullptr, 10);
+            nodesSet = true;
+        } else if ((flag == "-T" || flag == "--time") && hasValue) {
+            options.timeMs = std::max(0LL, std::atoll(argv[++i]));
+        } else if ((flag == "-d" || flag == "--depth") && hasValue) {
+            options.depth = std::max(0, std::atoi(argv[++i]));
+        } else if ((flag == "-t" || flag == "--threads") && hasValue) {
+            options.threads = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if ((flag == "-H" || flag == "--hash") && hasValue) {
+            options.hashMb = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if ((flag == "-w" || flag == "--window") && hasValue) {
+            options.window = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (flag == "--packed") {
+            packed = true;
+        } else if (flag == "--pack" && hasValue) {
+            packPath = argv[++i];
+        } else if (!flag.empty() && flag[0] != '-' && inPath.empty()) {
+            inPath = flag;
+        } else {
+            PrintUsage(argv[0]);
+            return 0;
+        }
+    }
+    if (inPath.empty()) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+    // A time or depth budget alone replaces the default node budget
+    if (!nodesSet && (options.timeMs > 0 || options.depth > 0)) {
+        options.nodes = 0;
+    }
+
+    packed = packed || HasExtension(inPath, ".bin");
+    std::ifstream in(inPath, packed ? std::ios::binary : std::ios::in);
+    if (UNLIKELY(!in.is_open())) {
+        ERROR_LOG("Could not open " << inPath);
+        return 1;
+    }
+    if (!packPath.empty()) {
+        return PackFile(in, packPath);
+    }
+
+    std::ofstream outFile;
+    if (!outPath.empty()) {
+        outFile.open(outPath);
+        if (UNLIKELY(!outFile.is_open())) {
+            ERROR_LOG("Could not open " << outPath);
+            return 1;
+        }
+    }
+    std::ostream &out = outPath.empty() ? std::cout : outFile;
+    Kpk::Init();
+
+    PositionReader reader(in, packed ? InputFormat::PACKED : InputFormat::TEXT);
+    const AnalyzeStats stats = AnalyzePositions(reader, options, [&out](const AnalysisResult &result) {
+        out << FormatJson(result) << '\n';
+    });
+    out.flush();
+
+    INFO_LOG(stats.positions << " positions (" << stats.invalid << " invalid), " << stats.nodes
+             << " nodes, " << stats.elapsedMs << " ms on " << options.threads << " workers: "
+             << std::fixed << std::setprecision(0) << stats.PositionsPerHour() << " positions/hour");
+    return 0;
+}
@@ -0,0 +1,84 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Polyglot opening book builder
+ **************************************************/
+
+#include <chrono>
+#include <cstdlib>
+#include "book_builder.h"
+
+using namespace Shohih;
+
+namespace {
+
+// Approximate memory per in-memory (position, move)
+constexpr size_t BYTES_PER_ENTRY{ 64 };
+
+void PrintUsage(const std::string &progName)
+{
+    std::cout << "Usage: " << progName << " -o BOOK [OPTIONS] PGN...\n"
+              << "Options:\n"
+              << "-o, --output\tPolyglot book to write\n"
+              << "-t, --threads\tWorker threads (default: all cores)\n"
+              << "-p, --max-ply\tPlies per game to include (default 30)\n"
+              << "-g, --min-games\tGames a move needs to be kept (default 1)\n"
+              << "-m, --memory\tMemory budget in MB before spilling to disk (default 256)\n"
+              << "-d, --tmp\tDirectory for spilled runs (default .)\n"
+              << "Example: " << progName << " -o book.bin --max-ply 24 games.pgn" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    BookBuilder::Options options;
+    options.maxEntries = 256 * 1024 * 1024 / BYTES_PER_ENTRY;
+    std::string outPath;
+    std::vector<std::string> inputs;
+    for (int i{ 1 }; i < argc; i++) {
+        std::string flag(argv[i]);
+        const bool hasValue = i + 1 < argc;
+        if ((flag == "-o" || flag == "--output") && hasValue) {
+            outPath = argv[++i];
+        } else if ((flag == "-t" || flag == "--threads") && hasValue) {
+            options.threads = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if ((flag == "-p" || flag == "--max-ply") && hasValue) {
+            options.maxPly = std::max(1, std::atoi(argv[++i]));
+        } else if ((flag == "-g" || flag == "--min-games") && hasValue) {
+            options.minGames = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+        } else if ((flag == "-m" || flag == "--memory") && hasValue) {
+            options.maxEntries = static_cast<size_t>(std::max(1, std::atoi(argv[++i]))) *
+                1024 * 1024 / BYTES_PER_ENTRY;
+        } else if ((flag == "-d" || flag == "--tmp") && hasValue) {
+            options.tempDir = argv[++i];
+        } else if (!flag.empty() && flag[0] != '-') {
+            inputs.push_back(flag);
+        } else {
+            PrintUsage(argv[0]);
+            return 0;
+        }
+    }
+    if (outPath.empty() || inputs.empty()) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    BookBuilder builder(options);
+    for (const auto &input : inputs) {
+        if (builder.AddPgnFile(input) != SUCCESS) {
+            return 1;
+        }
+        INFO_LOG(input << ": " << builder.GetGames() << " games so far");
+    }
+    if (builder.Write(outPath) != SUCCESS) {
+        return 1;
+    }
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    INFO_LOG("Wrote " << builder.GetBookEntries() << " entries to " << outPath << " from "
+             << builder.GetGames() << " games (" << builder.GetSkippedGames() << " skipped, "
+             << builder.GetPositions() << " positions, " << builder.GetRuns() << " runs) in "
+             << ms << " ms");
+    return 0;
+}
@@ -0,0 +1,120 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Classical vs NNUE evaluation benchmark
+ **************************************************/
+
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+#include "evaluate.h"
+
+using namespace Shohih;
+
+namespace {
+
+const std::vector<std::string> BENCH_FENS{
+    STANDARD_POSITION_FEN,
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+};
+
+// Pawn terms cached as in the search
+PawnHashTable g_pawns{};
+
+int EvaluateClassicalCached(const Position &pos)
+{
+    return EvaluateClassical(pos, g_pawns);
+}
+
+//--------------------------------------------------
+// Make, evaluate and unmake every legal move two
+// plies deep; the incremental update is part of
+// what is being measured.
+//--------------------------------------------------
+uint64_t WalkTree(Position &pos, int (*evaluate)(const Position &), int depth, int64_t &checksum)
+{
+    MoveList list;
+    pos.GenerateLegalMoves(list);
+    uint64_t evals{ 0 };
+    for (const auto &item : list) {
+        pos.MakeMove(item.move);
+        checksum += evaluate(pos);
+        evals++;
+        if (depth > 1) {
+            evals += WalkTree(pos, evaluate, depth - 1, checksum);
+        }
+        pos.UnmakeMove(item.move);
+    }
+    return evals;
+}
+
+void RunBenchmark(const std::string &name, int (*evaluate)(const Position &), int iterations)
+{
+    uint64_t evals{ 0 };
+    int64_t checksum{ 0 };
+    auto start = std::chrono::steady_clock::now();
+    for (int i{ 0 }; i < iterations; i++) {
+        for (const auto &fen : BENCH_FENS) {
+            Position pos;
+            pos.SetFEN(fen);
+            evals += WalkTree(pos, evaluate, 2, checksum);
+        }
+    }
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    std::cout << name << ": " << evals << " evals, "
+              << static_cast<double>(ns) / static_cast<double>(evals) << " ns/eval, "
+              << static_cast<double>(evals) * 1e3 / static_cast<double>(ns) << " M evals/s"
+              << " (checksum " << checksum << ")" << std::endl;
+}
+
+void PrintUsage(const std::string &progName)
+{
+    std::cout << "Usage: " << progName << " [OPTIONS]\n"
+              << "Options:\n"
+              << "-n, --nnue\tNNUE weights file (random weights if omitted)\n"
+              << "-i, --iterations\tPasses over the benchmark positions (default 20)\n"
+              << "Example: " << progName << " --nnue shohih.nnue" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::string nnuePath;
+    int iterations{ 20 };
+    for (int i{ 1 }; i < argc; i++) {
+        std::string flag(argv[i]);
+        if ((flag == "-n" || flag == "--nnue") && i + 1 < argc) {
+            nnuePath = argv[++i];
+        } else if ((flag == "-i" || flag == "--iterations") && i + 1 < argc) {
+            iterations = std::max(1, std::atoi(argv[++i]));
+        } else {
+            PrintUsage(argv[0]);
+            return 0;
+        }
+    }
+
+    RunBenchmark("classical", EvaluateClassical, iterations);
+    RunBenchmark("classical/pawn hash", EvaluateClassicalCached, iterations);
+    INFO_LOG("Pawn hash hit rate: " << 100.0 * static_cast<double>(g_pawns.GetHits()) /
+             static_cast<double>(std::max<uint64_t>(g_pawns.GetProbes(), 1)) << "%");
+
+    if (nnuePath.empty()) {
+        INFO_LOG("No NNUE file given, using random weights");
+        Nnue::g_network.Randomize(1);
+        Nnue::SetEnabled(true);
+    } else if (Nnue::LoadNetwork(nnuePath) != SUCCESS) {
+        return 1;
+    }
+    const auto supported = static_cast<int>(Nnue::GetSupportedSimdLevel());
+    for (int level{ 0 }; level <= supported; level++) {
+        Nnue::SetSimdLevel(static_cast<Nnue::SimdLevel>(level));
+        RunBenchmark(std::string("nnue/") + Nnue::SimdLevelName(Nnue::GetSimdLevel()),
+                     EvaluateNnue, iterations);
+    }
+    return 0;
+}
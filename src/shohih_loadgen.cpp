@@ -0,0 +1,149 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Load generator: simulated players against
+ *          a local (or remote) Shohih server
+ **************************************************/
+
+#include <cstdlib>
+#include <iomanip>
+#include "bitbase.h"
+#include "loadgen.h"
+#include "server.h"
+
+using namespace Shohih;
+
+namespace {
+
+// Longest wait for the in-process server to come up
+constexpr int SERVER_START_ATTEMPTS{ 50 };
+constexpr std::chrono::milliseconds SERVER_START_DELAY{ 100 };
+
+void PrintUsage(const std::string &progName)
+{
+    std::cout << "Usage: " << progName << " [OPTIONS]\n"
+              << "Plays pairs of bot players against a Shohih server and reports request\n"
+              << "throughput and move latency percentiles.\n"
+              << "Options:\n"
+              << "-p, --players\tSimulated players, one thread each (default 1000)\n"
+              << "-r, --rate\tMoves per second per player (default 1; 0 = as fast as possible)\n"
+              << "-d, --duration\tLength of the run in seconds (default 30)\n"
+              << "-u, --host\tServer to load (default: start one in this process)\n"
+              << "--port\t\tHTTP port (default 8080)\n"
+              << "--ws-port\tWebSocket port (default " << WEBSOCKET_PORT << ")\n"
+              << "--http\t\tHTTP long polling only (no WebSocket)\n"
+              << "--engine\tPlay engine moves searched with this many nodes (default: random moves)\n"
+              << "--max-plies\tPlies per game before the pair starts a new one (default 120)\n"
+              << "-t, --threads\tHandler threads of the in-process server\n"
+              << "\t\t(default " << SERVER_THREADS << ", plus one per player with --http)\n"
+              << "Example: " << progName << " -p 4000 -r 2 -d 60" << std::endl;
+}
+
+void PrintLatency(const std::string &name, const LatencyHistogram &histogram)
+{
+    std::cout << std::setw(16) << std::left << name << std::right
+              << " p50 " << std::setw(8) << histogram.Percentile(0.50)
+              << " p99 " << std::setw(8) << histogram.Percentile(0.99)
+              << " p99.9 " << std::setw(8) << histogram.Percentile(0.999)
+              << " max " << std::setw(8) << histogram.Max()
+              << " mean " << std::fixed << std::setprecision(0) << histogram.Mean()
+              << " us (" << histogram.Count() << " samples)" << std::defaultfloat << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    LoadgenOptions options;
+    bool local{ true };
+    size_t threads{ 0 };
+    for (int i{ 1 }; i < argc; i++) {
+        std::string flag(argv[i]);
+        const bool hasValue = i + 1 < argc;
+        if ((flag == "-p" || flag == "--players") && hasValue) {
+            options.players = static_cast<size_t>(std::max(2, std::atoi(argv[++i])));
+        } else if ((flag == "-r" || flag == "--rate") && hasValue) {
+            options.rate = std::max(0.0, std::atof(argv[++i]));
+        } else if ((flag == "-d" || flag == "--duration") && hasValue) {
+            options.duration = std::chrono::seconds(std::max(1, std::atoi(argv[++i])));
+        } else if ((flag == "-u" || flag == "--host") && hasValue) {
+            options.host = argv[++i];
+            local = false;
+        } else if (flag == "--port" && hasValue) {
+            options.port = std::atoi(argv[++i]);
+        } else if (flag == "--ws-port" && hasValue) {
+            options.wsPort = std::atoi(argv[++i]);
+        } else if (flag == "--http") {
+            options.webSocket = false;
+        } else if (flag == "--engine" && hasValue) {
+            options.engineNodes = std::strtoull(argv[++i], nullptr, 10);
+        } else if (flag == "--max-plies" && hasValue) {
+            options.maxPlies = std::max(1, std::atoi(argv[++i]));
+        } else if ((flag == "-t" || flag == "--threads") && hasValue) {
+            threads = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else {
+            PrintUsage(argv[0]);
+            return 0;
+        }
+    }
+    if (options.engineNodes > 0) {
+        Kpk::Init();
+    }
+
+    //--------------------------------------------------
+    // In-process server. Every HTTP player waiting for
+    // a move holds a handler thread.
+    //--------------------------------------------------
+    std::unique_ptr<Server> server;
+    std::thread listener;
+    if (local) {
+        if (threads == 0) {
+            threads = SERVER_THREADS + (options.webSocket ? 0 : options.players);
+        }
+        server.reset(new Server(threads));
+        listener = std::thread([&server, &options]() { server->Listen(options.port, options.wsPort); });
+        const std::string addr = options.host + ":" + std::to_string(options.port);
+        bool up{ false };
+        for (int attempt{ 0 }; attempt < SERVER_START_ATTEMPTS && !up; attempt++) {
+            std::this_thread::sleep_for(SERVER_START_DELAY);
+            up = static_cast<bool>(httplib::Client(addr).Get("/exit"));
+        }
+        if (!up) {
+            ERROR_LOG("The in-process server did not start on port " << options.port);
+            server->stop();
+            listener.join();
+            return 1;
+        }
+    }
+
+    INFO_LOG("Loading " << options.host << ":" << options.port << " with " << options.players << " players ("
+             << (options.webSocket ? "WebSocket" : "HTTP long polling") << ", "
+             << (options.engineNodes > 0 ? "engine" : "random") << " moves) for "
+             << options.duration.count() << " s");
+    uint64_t lastMoves{ 0 }, lastRequests{ 0 };
+    const LoadReport report = RunLoad(options,
+        [&lastMoves, &lastRequests](double seconds, const LoadCounters &totals) {
+            std::cout << std::fixed << std::setprecision(0) << std::setw(4) << seconds << " s: "
+                      << totals.players << " players seated, "
+                      << totals.requests - lastRequests << " requests/s, "
+                      << totals.moves - lastMoves << " moves/s, "
+                      << totals.errors << " errors" << std::defaultfloat << std::endl;
+            lastMoves = totals.moves;
+            lastRequests = totals.requests;
+        });
+
+    if (local) {
+        server->stop();
+        listener.join();
+    }
+
+    const double seconds = std::max(report.seconds, 1e-3);
+    const LoadCounters &totals = report.totals;
+    std::cout << std::fixed << std::setprecision(1)
+              << "Requests: " << totals.requests << " (" << totals.requests / seconds << "/s), moves: "
+              << totals.moves << " (" << totals.moves / seconds << "/s), games: " << totals.games
+              << ", rejected moves: " << totals.rejected << ", errors: " << totals.errors
+              << std::defaultfloat << std::endl;
+    PrintLatency("Move delivery", report.delivery);
+    PrintLatency("Move round trip", report.roundTrip);
+    return 0;
+}
@@ -0,0 +1,96 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Batch forced-mate solver
+ **************************************************/
+
+#include <chrono>
+#include <cstdlib>
+#include "mate_solver.h"
+
+using namespace Shohih;
+
+namespace {
+
+void PrintUsage(const std::string &progName)
+{
+    std::cout << "Usage: " << progName << " [OPTIONS] FILE\n"
+              << "FILE holds one FEN or EPD position per line.\n"
+              << "Options:\n"
+              << "-m, --max-moves\tLongest mate searched for (default 8)\n"
+              << "-n, --nodes\tNode limit per position (default none)\n"
+              << "-T, --time\tTime limit per position in ms (default none)\n"
+              << "-t, --threads\tWorker threads (default: all cores)\n"
+              << "-H, --hash\tProof table per thread in MB (default 16)\n"
+              << "Example: " << progName << " -m 5 -T 2000 puzzles.epd" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    MateLimits limits;
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t megabytes{ 16 };
+    std::string inPath;
+    for (int i{ 1 }; i < argc; i++) {
+        std::string flag(argv[i]);
+        const bool hasValue = i + 1 < argc;
+        if ((flag == "-m" || flag == "--max-moves") && hasValue) {
+            limits.maxMoves = std::max(1, std::atoi(argv[++i]));
+        } else if ((flag == "-n" || flag == "--nodes") && hasValue) {
+            limits.nodes = std::strtoull(argv[++i], nullptr, 10);
+        } else if ((flag == "-T" || flag == "--time") && hasValue) {
+            limits.timeMs = std::max(0LL, std::atoll(argv[++i]));
+        } else if ((flag == "-t" || flag == "--threads") && hasValue) {
+            threads = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if ((flag == "-H" || flag == "--hash") && hasValue) {
+            megabytes = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if (!flag.empty() && flag[0] != '-' && inPath.empty()) {
+            inPath = flag;
+        } else {
+            PrintUsage(argv[0]);
+            return 0;
+        }
+    }
+    if (inPath.empty()) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::string> fens;
+    std::vector<MateResult> results;
+    if (SolveMateFile(inPath, limits, threads, megabytes, fens, results) != SUCCESS) {
+        return 1;
+    }
+
+    //--------------------------------------------------
+    // One line per position: input ; result ; pv ; nodes
+    //--------------------------------------------------
+    size_t mates{ 0 }, noMates{ 0 };
+    uint64_t nodes{ 0 };
+    for (size_t i{ 0 }; i < fens.size(); i++) {
+        const MateResult &r = results[i];
+        std::cout << fens[i] << " ; ";
+        if (r.status == MateStatus::MATE) {
+            std::cout << "mate " << r.mateIn << " ; pv";
+            for (const auto &move : r.line) {
+                std::cout << ' ' << move.ToUci();
+            }
+            mates++;
+        } else if (r.status == MateStatus::NO_MATE) {
+            std::cout << "nomate " << limits.maxMoves;
+            noMates++;
+        } else {
+            std::cout << "unknown";
+        }
+        std::cout << " ; nodes " << r.nodes << " ; ms " << r.elapsedMs << '\n';
+        nodes += r.nodes;
+    }
+    std::cout.flush();
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    INFO_LOG(fens.size() << " positions: " << mates << " mates, " << noMates << " without mate, "
+             << fens.size() - mates - noMates << " unknown (" << nodes << " nodes, " << ms << " ms)");
+    return 0;
+}
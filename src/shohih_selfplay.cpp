@@ -0,0 +1,202 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Self-play match runner
+ **************************************************/
+
+#include <cstdlib>
+#include <iomanip>
+#include "selfplay.h"
+#include "bitbase.h"
+
+using namespace Shohih;
+
+namespace {
+
+void PrintUsage(const std::string &progName)
+{
+    std::cout << "Usage: " << progName << " [OPTIONS]\n"
+              << "Plays the engine against itself; each side can switch off search features.\n"
+              << "Options:\n"
+              << "-g, --games\tNumber of games (default 100)\n"
+              << "-c, --concurrency\tGames played at once (default: all cores)\n"
+              << "-o, --openings\tEPD/FEN file, or a .pgn file (default: start position)\n"
+              << "--plies\tPlies taken from each PGN opening (default 8)\n"
+              << "--tc\tTime control in seconds, base+increment (default 10+0.1)\n"
+              << "--nodes\tFixed nodes per move instead of a clock\n"
+              << "--depth\tFixed depth per move instead of a clock\n"
+              << "-H, --hash\tHash per engine in MB (default 16)\n"
+              << "--first, --second\tFeatures switched off for an engine, comma separated:\n"
+              << "\t\tpvs, nullmove, lmr, aspiration, futility\n"
+              << "--sprt\tStop on an SPRT verdict: elo0 elo1 [alpha beta] (default 0 5 0.05 0.05)\n"
+              << "--max-plies\tAdjudicate a draw after this many plies (default 400, 0 = off)\n"
+              << "--resign\tResign adjudication: centipawns moves (default 1000 4, 0 = off)\n"
+              << "--draw\tDraw adjudication: centipawns moves from-ply (default 10 8 80, 0 = off)\n"
+              << "-p, --pgn\tAppend the games to this PGN file\n"
+              << "Example: " << progName << " -g 2000 --tc 5+0.05 --second lmr --sprt 0 5 -p games.pgn"
+              << std::endl;
+}
+
+//--------------------------------------------------
+// "lmr,nullmove" => those features off. @return
+// false on an unknown name.
+//--------------------------------------------------
+bool ParseDisabled(const std::string &list, EngineSpec &engine)
+{
+    std::istringstream names(list);
+    std::string name;
+    while (std::getline(names, name, ',')) {
+        if (name == "pvs") {
+            engine.config.pvs = false;
+        } else if (name == "nullmove") {
+            engine.config.nullMove = false;
+        } else if (name == "lmr") {
+            engine.config.lmr = false;
+        } else if (name == "aspiration") {
+            engine.config.aspiration = false;
+        } else if (name == "futility") {
+            engine.config.futility = false;
+        } else {
+            ERROR_LOG("Unknown search feature: " << name);
+            return false;
+        }
+        engine.name += "-no" + name;
+    }
+    return true;
+}
+
+bool ParseTimeControl(const std::string &text, TimeControl &tc)
+{
+    const size_t plus = text.find('+');
+    const double base = std::atof(text.substr(0, plus).c_str());
+    const double inc = (plus == std::string::npos) ? 0.0 : std::atof(text.substr(plus + 1).c_str());
+    if (base <= 0.0 || inc < 0.0) {
+        return false;
+    }
+    tc.baseMs = static_cast<int64_t>(base * 1000.0);
+    tc.incMs = static_cast<int64_t>(inc * 1000.0);
+    return true;
+}
+
+// Optional numeric arguments after a flag
+bool IsNumber(const char *arg)
+{
+    char *end{ nullptr };
+    std::strtod(arg, &end);
+    return end != arg && *end == '\0';
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    MatchOptions options;
+    options.engines[1].name = "Shohih";
+    std::string openingPath;
+    int plies{ 8 };
+    for (int i{ 1 }; i < argc; i++) {
+        std::string flag(argv[i]);
+        const bool hasValue = i + 1 < argc;
+        if ((flag == "-g" || flag == "--games") && hasValue) {
+            options.games = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if ((flag == "-c" || flag == "--concurrency") && hasValue) {
+            options.concurrency = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if ((flag == "-o" || flag == "--openings") && hasValue) {
+            openingPath = argv[++i];
+        } else if (flag == "--plies" && hasValue) {
+            plies = std::max(0, std::atoi(argv[++i]));
+        } else if (flag == "--tc" && hasValue) {
+            if (!ParseTimeControl(argv[++i], options.timeControl)) {
+                ERROR_LOG("Invalid time control: " << argv[i]);
+                return 1;
+            }
+        } else if (flag == "--nodes" && hasValue) {
+            options.timeControl.nodes = std::strtoull(argv[++i], nullptr, 10);
+        } else if (flag == "--depth" && hasValue) {
+            options.timeControl.depth = std::max(1, std::atoi(argv[++i]));
+        } else if ((flag == "-H" || flag == "--hash") && hasValue) {
+            const size_t hashMb = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+            options.engines[0].hashMb = options.engines[1].hashMb = hashMb;
+        } else if ((flag == "--first" || flag == "--second") && hasValue) {
+            if (!ParseDisabled(argv[++i], options.engines[flag == "--first" ? 0 : 1])) {
+                return 1;
+            }
+        } else if (flag == "--sprt" && i + 2 < argc) {
+            options.sprt.enabled = true;
+            options.sprt.elo0 = std::atof(argv[++i]);
+            options.sprt.elo1 = std::atof(argv[++i]);
+            if (i + 2 < argc && IsNumber(argv[i + 1]) && IsNumber(argv[i + 2])) {
+                options.sprt.alpha = std::atof(argv[++i]);
+                options.sprt.beta = std::atof(argv[++i]);
+            }
+        } else if (flag == "--max-plies" && hasValue) {
+            options.adjudication.maxPlies = std::max(0, std::atoi(argv[++i]));
+        } else if (flag == "--resign" && i + 2 < argc) {
+            options.adjudication.resignScore = std::atoi(argv[++i]);
+            options.adjudication.resignMoves = std::max(0, std::atoi(argv[++i]));
+        } else if (flag == "--draw" && i + 3 < argc) {
+            options.adjudication.drawScore = std::atoi(argv[++i]);
+            options.adjudication.drawMoves = std::max(0, std::atoi(argv[++i]));
+            options.adjudication.drawMinPly = std::max(0, std::atoi(argv[++i]));
+        } else if ((flag == "-p" || flag == "--pgn") && hasValue) {
+            options.pgnPath = argv[++i];
+        } else {
+            PrintUsage(argv[0]);
+            return 0;
+        }
+    }
+    if (options.engines[0].name == options.engines[1].name) {
+        options.engines[1].name += "-2";
+    }
+
+    std::vector<std::string> openings;
+    if (!openingPath.empty()) {
+        if (LoadOpenings(openingPath, plies, openings) != SUCCESS) {
+            return 1;
+        }
+        INFO_LOG("Loaded " << openings.size() << " openings from " << openingPath);
+    }
+    Kpk::Init();
+
+    //--------------------------------------------------
+    // One line per finished game, then the summary
+    //--------------------------------------------------
+    const auto start = std::chrono::steady_clock::now();
+    uint64_t nodes{ 0 };
+    const MatchStats stats = RunMatch(options, openings,
+        [&options, &nodes](const GameRecord &game, const MatchStats &current) {
+            nodes += game.nodes;
+            std::cout << "Game " << game.round + 1 << ": "
+                      << (game.firstEngineWhite ? options.engines[0].name : options.engines[1].name) << " - "
+                      << (game.firstEngineWhite ? options.engines[1].name : options.engines[0].name) << " "
+                      << (game.result == GameResult::WHITE_WIN ? "1-0" :
+                          game.result == GameResult::BLACK_WIN ? "0-1" : "1/2-1/2")
+                      << " {" << TerminationName(game.termination) << "}  "
+                      << "+" << current.wins << " =" << current.draws << " -" << current.losses
+                      << std::fixed << std::setprecision(1)
+                      << "  Elo " << current.Elo() << " +/- " << current.EloError();
+            if (options.sprt.enabled) {
+                std::cout << std::setprecision(2) << "  LLR " << current.Llr(options.sprt)
+                          << " [" << MatchStats::LowerBound(options.sprt) << ", "
+                          << MatchStats::UpperBound(options.sprt) << "]";
+            }
+            std::cout << std::defaultfloat << std::endl;
+        });
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(1)
+              << options.engines[0].name << " vs " << options.engines[1].name << ": "
+              << stats.Games() << " games, +" << stats.wins << " =" << stats.draws << " -" << stats.losses
+              << ", score " << 100.0 * stats.Score() << "%, Elo " << stats.Elo()
+              << " +/- " << stats.EloError() << " (95%)" << std::endl;
+    if (options.sprt.enabled) {
+        const SprtVerdict verdict = stats.Verdict(options.sprt);
+        std::cout << std::setprecision(2) << "SPRT elo0=" << options.sprt.elo0 << " elo1=" << options.sprt.elo1
+                  << ": LLR " << stats.Llr(options.sprt) << ", "
+                  << (verdict == SprtVerdict::ACCEPT_H1 ? "H1 accepted" :
+                      verdict == SprtVerdict::ACCEPT_H0 ? "H0 accepted" : "no verdict") << std::endl;
+    }
+    INFO_LOG(std::setprecision(1) << stats.Games() / std::max(seconds, 1e-3) * 3600.0 << " games/hour, "
+             << static_cast<double>(nodes) / std::max(seconds, 1e-3) / 1e6 << " M nodes/s over "
+             << options.concurrency << " workers");
+    return 0;
+}
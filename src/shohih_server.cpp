@@ -3,15 +3,47 @@
  * @brief   Shohih Server
  **************************************************/
 
+#include <cstdlib>
 #include "server.h"
 
 using namespace Shohih;
 
-int main()
+int main(int argc, char **argv)
 {
+    size_t threads{ SERVER_THREADS };
+    JournalOptions journal;
+    for (int i{ 1 }; i < argc; i++) {
+        std::string flag(argv[i]);
+        if ((flag == "-t" || flag == "--threads") && i + 1 < argc) {
+            threads = static_cast<size_t>(std::max(1, std::atoi(argv[++i])));
+        } else if ((flag == "-j" || flag == "--journal") && i + 1 < argc) {
+            journal.dir = argv[++i];
+        } else if (flag == "--sync-ms" && i + 1 < argc) {
+            journal.syncInterval = std::chrono::milliseconds(std::max(0, std::atoi(argv[++i])));
+        } else if (flag == "--snapshot-s" && i + 1 < argc) {
+            journal.snapshotInterval = std::chrono::seconds(std::max(0, std::atoi(argv[++i])));
+        } else {
+            std::cout << "Usage: " << argv[0] << " [OPTIONS]\n"
+                      << "Hosts any number of games; clients join rooms by ID.\n"
+                      << "Options:\n"
+                      << "-t, --threads\tRequest handler threads (default " << SERVER_THREADS << ")\n"
+                      << "-j, --journal\tJournal games in this directory and restore them on startup\n"
+                      << "--sync-ms\tfsync the journal every N ms (default " << JOURNAL_SYNC_INTERVAL.count()
+                      << "; 0 = before acknowledging each move)\n"
+                      << "--snapshot-s\tCompact the journal every N seconds (default "
+                      << JOURNAL_SNAPSHOT_INTERVAL.count() << "; 0 = never)"
+                      << std::endl;
+            return 0;
+        }
+    }
+
     //--------------------------------------------------
     // Server listens on 0.0.0.0:8080
     //--------------------------------------------------
-    Server server;
+    Server server(threads);
+    if (!journal.dir.empty() && server.EnableJournal(journal) != SUCCESS) {
+        ERROR_LOG("Cannot use journal directory " << journal.dir);
+        return 1;
+    }
     server.Listen();
-}
\ No newline at end of file
+}
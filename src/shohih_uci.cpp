@@ -0,0 +1,34 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Shohih UCI engine
+ **************************************************/
+
+#include "uci.h"
+#include "bitbase.h"
+
+using namespace Shohih;
+
+int main(int argc, char **argv)
+{
+    // stdout only carries answers to UCI commands
+    const int64_t kpkMs = Kpk::Init();
+    std::cerr << "KPK bitbase generated in " << kpkMs << " ms" << std::endl;
+
+    //--------------------------------------------------
+    // "shohih_uci bench [depth]" runs the benchmark and
+    // exits (same as the UCI "bench" command)
+    //--------------------------------------------------
+    if (argc > 1 && std::string(argv[1]) == "bench") {
+        std::istringstream in(std::string("bench ") + (argc > 2 ? argv[2] : "") + "\nquit\n");
+        Uci uci(in, std::cout);
+        uci.Loop();
+        return 0;
+    }
+
+    //--------------------------------------------------
+    // UCI over stdin/stdout, e.g. for cutechess-cli or
+    // any UCI-capable GUI
+    //--------------------------------------------------
+    Uci uci(std::cin, std::cout);
+    uci.Loop();
+}
@@ -0,0 +1,116 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for analyze.h & analyze.cpp
+ **************************************************/
+
+#include <sstream>
+#include <gtest/gtest.h>
+#include "analyze.h"
+#include "reorder_buffer.h"
+
+using namespace Shohih;
+
+TEST(TestAnalyze, PackedPositions)
+{
+    const std::vector<std::string> fens{
+        STANDARD_POSITION_FEN,
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3",
+        "8/8/8/4k3/8/8/4P3/4K3 b - - 37 300" };
+    std::string bytes;
+    for (const auto &fen : fens) {
+        Position pos;
+        ASSERT_EQ(pos.SetFEN(fen), SUCCESS);
+        PackedPosition packed;
+        ASSERT_EQ(PackPosition(pos, packed), SUCCESS);
+        Position unpacked;
+        ASSERT_EQ(UnpackPosition(packed, unpacked), SUCCESS);
+        EXPECT_EQ(unpacked.GetFEN(), fen);
+        EXPECT_EQ(unpacked.GetKey(), pos.GetKey());
+        bytes.append(reinterpret_cast<const char *>(packed.data()), PACKED_POSITION_SIZE);
+    }
+
+    // A stream of records, the last one cut short
+    std::istringstream in(bytes + "abc");
+    PositionReader reader(in, InputFormat::PACKED);
+    std::string input;
+    for (const auto &fen : fens) {
+        ASSERT_TRUE(reader.Next(input));
+        EXPECT_EQ(input, fen);
+    }
+    EXPECT_FALSE(reader.Next(input));
+
+    // No kings: unpacks to an invalid position
+    PackedPosition bad{};
+    bad[0] = 1;     // a1 occupied by a white pawn (code 0)
+    Position pos;
+    EXPECT_EQ(UnpackPosition(bad, pos), INVALID_FEN);
+}
+
+TEST(TestAnalyze, ReorderBuffer)
+{
+    ReorderBuffer<int> buffer(2);
+    EXPECT_TRUE(buffer.Put(1, 10));
+    int item{ 0 };
+
+    // Index 2 is outside the window until 0 is taken
+    std::thread late([&buffer]() { EXPECT_TRUE(buffer.Put(2, 20)); });
+    EXPECT_TRUE(buffer.Put(0, 0));
+    for (int expected : { 0, 10, 20 }) {
+        ASSERT_TRUE(buffer.Pop(item));
+        EXPECT_EQ(item, expected);
+    }
+    late.join();
+
+    buffer.Close();
+    EXPECT_FALSE(buffer.Pop(item));
+    EXPECT_FALSE(buffer.Put(3, 30));
+}
+
+TEST(TestAnalyze, InputOrder)
+{
+    std::ostringstream text;
+    text << "# comment\n"
+         << "6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1\n"       // mate in one
+         << "not a \"fen\"\n"
+         << "\n"
+         << "7k/5Q2/6K1/8/8/8/8/8 b - - 0 1\n";             // stalemate
+    for (int i{ 0 }; i < 12; i++) {
+        text << (i % 2 ? STANDARD_POSITION_FEN : "r1bqkbnr/pppp1ppp/2n5/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R w KQkq - 2 3")
+             << '\n';
+    }
+    std::istringstream in(text.str());
+    PositionReader reader(in, InputFormat::TEXT);
+
+    AnalyzeOptions options;
+    options.nodes = 3000;
+    options.threads = 3;
+    options.hashMb = 1;
+    options.window = 3;
+    std::vector<AnalysisResult> results;
+    const AnalyzeStats stats = AnalyzePositions(reader, options,
+        [&results](const AnalysisResult &result) { results.push_back(result); });
+
+    ASSERT_EQ(results.size(), 15u);
+    EXPECT_EQ(stats.positions, 15u);
+    EXPECT_EQ(stats.invalid, 1u);
+    for (size_t i{ 0 }; i < results.size(); i++) {
+        EXPECT_EQ(results[i].index, i);
+    }
+
+    EXPECT_EQ(results[0].bestMove.ToUci(), "d1d8");
+    EXPECT_EQ(FormatJson(results[0]).find("{\"index\":0,\"fen\":\"6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1\","
+        "\"bestmove\":\"d1d8\",\"score\":{\"mate\":1},"), 0u);
+    EXPECT_EQ(FormatJson(results[1]), "{\"index\":1,\"input\":\"not a \\\"fen\\\"\",\"error\":\"invalid position\"}");
+    EXPECT_NE(FormatJson(results[2]).find("\"bestmove\":null,\"score\":{\"cp\":0}"), std::string::npos);
+
+    for (size_t i{ 3 }; i < results.size(); i++) {
+        const AnalysisResult &result = results[i];
+        ASSERT_TRUE(result.IsValid());
+        ASSERT_FALSE(result.pv.empty());
+        EXPECT_EQ(result.pv[0], result.bestMove);
+        EXPECT_GT(result.depth, 0);
+        EXPECT_LE(result.nodes, options.nodes + 1024);
+    }
+    EXPECT_GT(stats.PositionsPerHour(), 0.0);
+}
@@ -0,0 +1,43 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for bench.h & bench.cpp
+ **************************************************/
+
+#include <gtest/gtest.h>
+#include "bench.h"
+
+using namespace Shohih;
+
+TEST(TestBench, Positions)
+{
+    const auto &fens = GetBenchFens();
+    EXPECT_EQ(fens.size(), 50u);
+    for (const auto &fen : fens) {
+        Position pos;
+        ASSERT_EQ(pos.SetFEN(fen), ErrorCode::SUCCESS) << fen;
+        MoveList list;
+        pos.GenerateLegalMoves(list);
+        EXPECT_GT(list.Size(), 0u) << fen;
+    }
+}
+
+TEST(TestBench, Deterministic)
+{
+    const BenchResult first = RunBench(4);
+    const BenchResult second = RunBench(4);
+    ASSERT_EQ(first.nodes.size(), GetBenchFens().size());
+    EXPECT_EQ(first.nodes, second.nodes);
+    EXPECT_EQ(first.totalNodes, second.totalNodes);
+    for (uint64_t nodes : first.nodes) {
+        EXPECT_GT(nodes, 0u);
+    }
+    EXPECT_GT(first.Nps(), 0u);
+}
+
+TEST(TestBench, HonorsSearchConfig)
+{
+    SearchConfig config;
+    config.nullMove = false;
+    config.lmr = false;
+    EXPECT_NE(RunBench(5, config).totalNodes, RunBench(5).totalNodes);
+}
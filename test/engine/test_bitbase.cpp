@@ -0,0 +1,83 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for bitbase.h & bitbase.cpp
+ **************************************************/
+
+#include <gtest/gtest.h>
+#include "bitbase.h"
+#include "evaluate.h"
+
+using namespace Shohih;
+
+namespace {
+
+bool ProbeFen(const std::string &fen)
+{
+    Position pos;
+    EXPECT_EQ(pos.SetFEN(fen), ErrorCode::SUCCESS) << fen;
+    return Kpk::Probe(pos);
+}
+
+std::vector<bool> Snapshot()
+{
+    std::vector<bool> wins;
+    for (SquareId pawn{ 8 }; pawn < 56; pawn++) {
+        if (FileOf(pawn) > 3) {
+            continue;
+        }
+        for (SquareId wk{ 0 }; wk < NUM_SQUARES; wk++) {
+            for (SquareId bk{ 0 }; bk < NUM_SQUARES; bk++) {
+                wins.push_back(Kpk::Probe(wk, pawn, bk, PieceColor::WHITE));
+                wins.push_back(Kpk::Probe(wk, pawn, bk, PieceColor::BLACK));
+            }
+        }
+    }
+    return wins;
+}
+
+} // namespace
+
+TEST(TestBitbase, KnownPositions)
+{
+    Kpk::Init();
+    ASSERT_TRUE(Kpk::IsReady());
+
+    // King on the sixth in front of the pawn wins either way
+    EXPECT_TRUE(ProbeFen("4k3/8/4K3/4P3/8/8/8/8 w - - 0 1"));
+    EXPECT_TRUE(ProbeFen("4k3/8/4K3/4P3/8/8/8/8 b - - 0 1"));
+    // On the fifth it depends on the opposition
+    EXPECT_FALSE(ProbeFen("8/4k3/8/4K3/4P3/8/8/8 w - - 0 1"));
+    EXPECT_TRUE(ProbeFen("8/4k3/8/4K3/4P3/8/8/8 b - - 0 1"));
+    // Rook pawn with the defender in the corner (both wings)
+    EXPECT_FALSE(ProbeFen("k7/8/8/8/8/8/P7/K7 w - - 0 1"));
+    EXPECT_FALSE(ProbeFen("7k/8/8/8/8/8/7P/7K w - - 0 1"));
+    // Black pawn outside the white king's square
+    EXPECT_TRUE(ProbeFen("K6k/8/8/8/8/3p4/8/8 b - - 0 1"));
+    EXPECT_TRUE(ProbeFen("K6k/8/8/8/8/3p4/8/8 w - - 0 1"));
+    // Undefended pawn is taken
+    EXPECT_FALSE(ProbeFen("8/8/8/8/8/8/3kP3/7K b - - 0 1"));
+}
+
+TEST(TestBitbase, ThreadCountIndependent)
+{
+    Kpk::Init(1);
+    const std::vector<bool> single = Snapshot();
+    Kpk::Init(4);
+    EXPECT_EQ(Snapshot(), single);
+}
+
+TEST(TestBitbase, Evaluate)
+{
+    Kpk::Init();
+    Position pos;
+    ASSERT_EQ(pos.SetFEN("k7/8/8/8/8/8/P7/K7 w - - 0 1"), ErrorCode::SUCCESS);
+    EXPECT_EQ(Evaluate(pos), 0);
+    ASSERT_EQ(pos.SetFEN("4k3/8/4K3/4P3/8/8/8/8 b - - 0 1"), ErrorCode::SUCCESS);
+    EXPECT_LT(Evaluate(pos), -400);
+    // Promoting must still look better than the won KPK position
+    ASSERT_EQ(pos.SetFEN("8/4P3/8/4K3/8/8/8/k7 w - - 0 1"), ErrorCode::SUCCESS);
+    const int before = Evaluate(pos);
+    EXPECT_GT(before, 400);
+    pos.MakeMove(pos.ParseUciMove("e7e8q"));
+    EXPECT_GT(-Evaluate(pos), before);
+}
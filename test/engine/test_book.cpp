@@ -0,0 +1,226 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for book.h & book.cpp
+ **************************************************/
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include "book.h"
+#include "book_builder.h"
+#include "uci.h"
+
+using namespace Shohih;
+
+namespace {
+
+const std::string BOOK_PATH{ "test_book.bin" };
+
+BookEntry MakeEntry(const Position &pos, const std::string &uci, uint16_t weight)
+{
+    return BookEntry{ OpeningBook::PolyglotKey(pos),
+        OpeningBook::EncodeMove(pos.ParseUciMove(uci)), weight, 0 };
+}
+
+//--------------------------------------------------
+// Start position: e2e4 (3), d2d4 (1), a bogus move
+// and one with weight 0. After 1.e4: c7c5.
+//--------------------------------------------------
+void WriteTestBook()
+{
+    Position pos;
+    std::vector<BookEntry> entries{
+        MakeEntry(pos, "d2d4", 1),
+        MakeEntry(pos, "e2e4", 3),
+        MakeEntry(pos, "g1f3", 0),
+        BookEntry{ OpeningBook::PolyglotKey(pos), 0x0FFF, 50, 0 },
+    };
+    pos.MakeMove(pos.ParseUciMove("e2e4"));
+    entries.push_back(MakeEntry(pos, "c7c5", 10));
+    // Unrelated keys around them
+    for (uint64_t key{ 1 }; key < 200; key++) {
+        entries.push_back(BookEntry{ key * 0x9E3779B97F4A7C15ULL, 0, 1, 0 });
+    }
+    ASSERT_EQ(OpeningBook::Write(BOOK_PATH, entries), SUCCESS);
+}
+
+} // namespace
+
+TEST(TestBook, PolyglotMoveEncoding)
+{
+    Position pos;
+    ASSERT_EQ(pos.SetFEN("r3k2r/1P6/8/8/8/8/8/R3K2R w KQkq - 0 1"), SUCCESS);
+    // Castling is king-takes-rook, promotion in bits 12-14
+    EXPECT_EQ(OpeningBook::EncodeMove(pos.ParseUciMove("e1g1")), (4 << 6) | 7);
+    EXPECT_EQ(OpeningBook::EncodeMove(pos.ParseUciMove("e1c1")), (4 << 6) | 0);
+    EXPECT_EQ(OpeningBook::EncodeMove(pos.ParseUciMove("b7a8q")), (4 << 12) | (49 << 6) | 56);
+    EXPECT_EQ(OpeningBook::EncodeMove(pos.ParseUciMove("b7b8n")), (1 << 12) | (49 << 6) | 57);
+    EXPECT_EQ(OpeningBook::DecodeMove(pos, (4 << 6) | 7).ToUci(), "e1g1");
+    EXPECT_EQ(OpeningBook::DecodeMove(pos, (4 << 6) | 0).ToUci(), "e1c1");
+    // Plain e1g1 is not how Polyglot writes castling
+    EXPECT_TRUE(OpeningBook::DecodeMove(pos, (4 << 6) | 6).IsNull());
+}
+
+TEST(TestBook, PolyglotKey)
+{
+    // Same position reached by different move orders, side to move matters
+    Position a, b;
+    for (const std::string uci : { "g1f3", "g8f6", "b1c3" }) {
+        a.MakeMove(a.ParseUciMove(uci));
+    }
+    for (const std::string uci : { "b1c3", "g8f6", "g1f3" }) {
+        b.MakeMove(b.ParseUciMove(uci));
+    }
+    EXPECT_EQ(OpeningBook::PolyglotKey(a), OpeningBook::PolyglotKey(b));
+    EXPECT_NE(OpeningBook::PolyglotKey(a), OpeningBook::PolyglotKey(Position{}));
+
+    // En passant only counts when a capture is possible
+    Position ep, noEp;
+    ASSERT_EQ(ep.SetFEN("4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1"), SUCCESS);
+    ASSERT_EQ(noEp.SetFEN("4k3/8/8/3pP3/8/8/8/4K3 w - - 0 1"), SUCCESS);
+    EXPECT_NE(OpeningBook::PolyglotKey(ep), OpeningBook::PolyglotKey(noEp));
+    ASSERT_EQ(ep.SetFEN("4k3/8/8/3p4/8/8/8/4K3 w - d6 0 1"), SUCCESS);
+    ASSERT_EQ(noEp.SetFEN("4k3/8/8/3p4/8/8/8/4K3 w - - 0 1"), SUCCESS);
+    EXPECT_EQ(OpeningBook::PolyglotKey(ep), OpeningBook::PolyglotKey(noEp));
+}
+
+TEST(TestBook, PolyglotReferenceKeys)
+{
+    // Test positions of the Polyglot book format spec
+    const std::vector<std::pair<std::vector<std::string>, uint64_t>> games{
+        { {}, 0x463B96181691FC9CULL },
+        { { "e2e4" }, 0x823C9B50FD114196ULL },
+        { { "e2e4", "d7d5" }, 0x0756B94461C50FB0ULL },
+        { { "e2e4", "d7d5", "e4e5" }, 0x662FAFB965DB29D4ULL },
+        { { "e2e4", "d7d5", "e4e5", "f7f5" }, 0x22A48B5A8E47FF78ULL },
+        { { "e2e4", "d7d5", "e4e5", "f7f5", "e1e2" }, 0x652A607CA3F242C1ULL },
+        { { "e2e4", "d7d5", "e4e5", "f7f5", "e1e2", "e8f7" }, 0x00FDD303C946BDD9ULL },
+        { { "a2a4", "b7b5", "h2h4", "b5b4", "c2c4" }, 0x3C8123EA7B067637ULL },
+        { { "a2a4", "b7b5", "h2h4", "b5b4", "c2c4", "b4c3", "a1a3" }, 0x5C3F9B829B279560ULL }
+    };
+    for (const auto &game : games) {
+        Position pos;
+        for (const auto &uci : game.first) {
+            pos.MakeMove(pos.ParseUciMove(uci));
+        }
+        EXPECT_EQ(OpeningBook::PolyglotKey(pos), game.second) << game.first.size() << " plies";
+    }
+}
+
+TEST(TestBook, Probe)
+{
+    WriteTestBook();
+    OpeningBook book;
+    ASSERT_EQ(book.Open(BOOK_PATH), SUCCESS);
+    EXPECT_EQ(book.Size(), 204u);
+
+    Position pos;
+    auto moves = book.GetMoves(pos);
+    ASSERT_EQ(moves.size(), 2u);    // illegal and zero-weight entries are dropped
+    EXPECT_EQ(moves[0].move.ToUci(), "e2e4");
+    EXPECT_EQ(moves[0].weight, 3);
+    EXPECT_EQ(moves[1].move.ToUci(), "d2d4");
+    EXPECT_EQ(book.Probe(pos, OpeningBook::Selection::BEST).ToUci(), "e2e4");
+
+    // Weighted selection only returns book moves and prefers e2e4
+    int e4{ 0 };
+    for (int i{ 0 }; i < 400; i++) {
+        std::string uci = book.Probe(pos).ToUci();
+        ASSERT_TRUE(uci == "e2e4" || uci == "d2d4");
+        e4 += (uci == "e2e4");
+    }
+    EXPECT_GT(e4, 200);
+
+    pos.MakeMove(pos.ParseUciMove("e2e4"));
+    EXPECT_EQ(book.Probe(pos).ToUci(), "c7c5");
+    pos.MakeMove(pos.ParseUciMove("c7c5"));
+    EXPECT_TRUE(book.Probe(pos).IsNull());
+
+    book.Close();
+    EXPECT_FALSE(book.IsOpen());
+    EXPECT_TRUE(book.Probe(Position{}).IsNull());
+    std::remove(BOOK_PATH.c_str());
+    EXPECT_EQ(book.Open(BOOK_PATH), FILE_OPEN_ERROR);
+}
+
+TEST(TestBook, UciOwnBook)
+{
+    WriteTestBook();
+    std::istringstream in(
+        "setoption name BookFile value " + BOOK_PATH + "\n"
+        "setoption name OwnBook value true\n"
+        "position startpos moves e2e4\n"
+        "go wtime 1000 btime 1000\n");
+    std::ostringstream out;
+    {
+        Uci uci(in, out);
+        uci.Loop();
+    }
+    EXPECT_NE(out.str().find("bestmove c7c5"), std::string::npos);
+    EXPECT_EQ(out.str().find("info depth"), std::string::npos);
+    std::remove(BOOK_PATH.c_str());
+}
+
+TEST(TestBook, BuildFromPgn)
+{
+    std::istringstream pgn(
+        "[Event \"a\"]\n[Result \"1-0\"]\n\n1. e4 e5 2. Nf3 1-0\n\n"
+        "[Result \"1/2-1/2\"]\n\n1. e4 c5 1/2-1/2\n\n"
+        "[Result \"0-1\"]\n\n1. d4 d5 0-1\n\n"
+        "[Result \"1-0\"]\n\n1. e4 {main} (1. d4) e5 $1 2. Nf3 Nc6 1-0\n\n"
+        "[Result \"*\"]\n\n1. Qh5 *\n\n"
+        "[Result \"1-0\"]\n\n1. e5 1-0\n");
+    BookBuilder::Options options;
+    options.threads = 3;
+    options.maxEntries = 2;     // force spilled runs
+    options.tempDir = ".";
+    {
+        BookBuilder builder(options);
+        ASSERT_EQ(builder.AddPgn(pgn), SUCCESS);
+        EXPECT_EQ(builder.GetGames(), 4u);
+        EXPECT_EQ(builder.GetSkippedGames(), 2u);
+        EXPECT_EQ(builder.GetPositions(), 11u);
+        EXPECT_GT(builder.GetRuns(), 0u);
+        ASSERT_EQ(builder.Write(BOOK_PATH), SUCCESS);
+    }
+
+    OpeningBook book;
+    ASSERT_EQ(book.Open(BOOK_PATH), SUCCESS);
+    // Weight = 2 * wins + draws; moves that never scored are dropped
+    Position pos;
+    auto moves = book.GetMoves(pos);
+    ASSERT_EQ(moves.size(), 1u);
+    EXPECT_EQ(moves[0].move.ToUci(), "e2e4");
+    EXPECT_EQ(moves[0].weight, 5);
+
+    pos.MakeMove(pos.ParseUciMove("e2e4"));
+    moves = book.GetMoves(pos);
+    ASSERT_EQ(moves.size(), 1u);
+    EXPECT_EQ(moves[0].move.ToUci(), "c7c5");
+    EXPECT_EQ(moves[0].weight, 1);
+
+    pos.MakeMove(pos.ParseUciMove("e7e5"));
+    moves = book.GetMoves(pos);
+    ASSERT_EQ(moves.size(), 1u);
+    EXPECT_EQ(moves[0].move.ToUci(), "g1f3");
+    EXPECT_EQ(moves[0].weight, 4);
+    book.Close();
+
+    // Entries are keyed like any Polyglot book: e2e4
+    // (0x031C) under the spec's start position key
+    std::ifstream file(BOOK_PATH, std::ios::binary);
+    unsigned char entry[16]{};
+    int startMove{ -1 };
+    while (file.read(reinterpret_cast<char*>(entry), sizeof(entry))) {
+        uint64_t key{ 0 };
+        for (size_t i{ 0 }; i < 8; i++) {
+            key = (key << 8) | entry[i];
+        }
+        if (key == 0x463B96181691FC9CULL) {
+            startMove = (entry[8] << 8) | entry[9];
+        }
+    }
+    EXPECT_EQ(startMove, 0x031C);
+    file.close();
+    std::remove(BOOK_PATH.c_str());
+}
@@ -0,0 +1,105 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for mate_solver.h & mate_solver.cpp
+ **************************************************/
+
+#include <gtest/gtest.h>
+#include "mate_solver.h"
+
+using namespace Shohih;
+
+namespace {
+
+// Plays @param line and checks that it ends in mate
+bool IsMatingLine(const std::string &fen, const std::vector<PackedMove> &line)
+{
+    Position pos;
+    EXPECT_EQ(pos.SetFEN(fen), SUCCESS);
+    for (const auto &move : line) {
+        MoveList moves;
+        pos.GenerateLegalMoves(moves);
+        if (!moves.Contains(move)) {
+            return false;
+        }
+        pos.MakeMove(move);
+    }
+    MoveList moves;
+    pos.GenerateLegalMoves(moves);
+    return pos.InCheck() && moves.Empty();
+}
+
+MateResult SolveFen(const std::string &fen, const MateLimits &limits)
+{
+    Position pos;
+    EXPECT_EQ(pos.SetFEN(fen), SUCCESS);
+    MateSolver solver(1);
+    return solver.Solve(pos, limits);
+}
+
+} // namespace
+
+TEST(TestMateSolver, MateInOne)
+{
+    const std::string fen{ "k7/8/1K6/8/8/8/7Q/8 w - - 0 1" };
+    MateResult result = SolveFen(fen, MateLimits{});
+    ASSERT_EQ(result.status, MateStatus::MATE);
+    EXPECT_EQ(result.mateIn, 1);
+    ASSERT_EQ(result.line.size(), 1U);
+    EXPECT_TRUE(IsMatingLine(fen, result.line));
+}
+
+TEST(TestMateSolver, QuietKeyMove)
+{
+    // Morphy: 1. Ra6! bxa6 2. b7#
+    const std::string fen{ "kbK5/pp6/1P6/8/8/8/8/R7 w - - 0 1" };
+    MateResult result = SolveFen(fen, MateLimits{});
+    ASSERT_EQ(result.status, MateStatus::MATE);
+    EXPECT_EQ(result.mateIn, 2);
+    ASSERT_EQ(result.line.size(), 3U);
+    EXPECT_EQ(result.line[0].ToUci(), "a1a6");
+    EXPECT_TRUE(IsMatingLine(fen, result.line));
+
+    // Not a mate in 1
+    MateLimits limits;
+    limits.maxMoves = 1;
+    EXPECT_EQ(SolveFen(fen, limits).status, MateStatus::NO_MATE);
+}
+
+TEST(TestMateSolver, NoMate)
+{
+    MateLimits limits;
+    limits.maxMoves = 2;
+    EXPECT_EQ(SolveFen(STANDARD_POSITION_FEN, limits).status, MateStatus::NO_MATE);
+    // Stalemate
+    EXPECT_EQ(SolveFen("k7/8/1Q6/8/8/8/8/K7 b - - 0 1", limits).status, MateStatus::NO_MATE);
+}
+
+TEST(TestMateSolver, Limits)
+{
+    MateLimits limits;
+    limits.maxMoves = 4;
+    limits.nodes = 50;
+    MateResult result = SolveFen(STANDARD_POSITION_FEN, limits);
+    EXPECT_EQ(result.status, MateStatus::UNKNOWN);
+    EXPECT_LE(result.nodes, 50U);
+    EXPECT_TRUE(result.line.empty());
+}
+
+TEST(TestMateSolver, Batch)
+{
+    const std::vector<std::string> fens{
+        "kbK5/pp6/1P6/8/8/8/8/R7 w - - 0 1",
+        "not a fen",
+        "k7/8/1K6/8/8/8/7Q/8 w - - 0 1 bm Qh8#; id \"epd\";",
+        "r1bqkb1r/pppp1ppp/2n2n2/4p2Q/2B1P3/8/PPPP1PPP/RNB1K1NR w KQkq - 4 4",
+    };
+    MateLimits limits;
+    limits.maxMoves = 3;
+    std::vector<MateResult> results = SolveMateBatch(fens, limits, 3, 1);
+    ASSERT_EQ(results.size(), fens.size());
+    EXPECT_EQ(results[0].mateIn, 2);
+    EXPECT_EQ(results[1].status, MateStatus::UNKNOWN);
+    EXPECT_EQ(results[2].mateIn, 1);
+    ASSERT_EQ(results[3].status, MateStatus::MATE);
+    EXPECT_EQ(results[3].line[0].ToUci(), "h5f7");
+}
@@ -0,0 +1,104 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for mcts.h & mcts.cpp
+ **************************************************/
+
+#include <gtest/gtest.h>
+#include "uci.h"
+
+using namespace Shohih;
+
+namespace {
+
+SearchLimits NodeLimit(uint64_t nodes)
+{
+    SearchLimits limits;
+    limits.nodes = nodes;
+    return limits;
+}
+
+} // namespace
+
+TEST(TestMcts, MateInOne)
+{
+    Position pos;
+    ASSERT_EQ(pos.SetFEN("k7/8/1K6/8/8/8/7Q/8 w - - 0 1"), SUCCESS);
+    MctsOptions options;
+    options.megabytes = 4;
+    Mcts mcts(options);
+    SearchResult result = mcts.Run(pos, NodeLimit(2000));
+    EXPECT_EQ(result.bestMove.ToUci(), "h2h8");
+    EXPECT_EQ(result.score, VALUE_MATE - 1);
+}
+
+TEST(TestMcts, WinsMaterial)
+{
+    // The rook can take the undefended queen (UCT and PUCT)
+    Position pos;
+    ASSERT_EQ(pos.SetFEN("4k3/8/8/3q4/8/8/8/3RK3 w - - 0 1"), SUCCESS);
+    for (bool puct : { true, false }) {
+        MctsOptions options;
+        options.megabytes = 4;
+        options.puct = puct;
+        Mcts mcts(options);
+        mcts.SetThreads(2);
+        SearchResult result = mcts.Run(pos, NodeLimit(3000));
+        EXPECT_EQ(result.bestMove.ToUci(), "d1d5") << "puct " << puct;
+        EXPECT_GT(result.score, 300);
+        EXPECT_GE(result.nodes, 3000U);
+    }
+}
+
+TEST(TestMcts, MemoryLimit)
+{
+    // Without node or time limits the full arena ends the search
+    Position pos;
+    ASSERT_EQ(pos.SetFEN(STANDARD_POSITION_FEN), SUCCESS);
+    MctsOptions options;
+    options.megabytes = 1;
+    Mcts mcts(options);
+    mcts.SetThreads(3);
+    SearchResult result = mcts.Run(pos, SearchLimits{});
+    EXPECT_FALSE(result.bestMove.IsNull());
+    EXPECT_GT(mcts.GetTreeSize(), 0U);
+    EXPECT_LT(mcts.GetTreeSize(), 1024U * 1024U / 16);
+}
+
+TEST(TestMcts, TreeReuse)
+{
+    Position pos;
+    ASSERT_EQ(pos.SetFEN(STANDARD_POSITION_FEN), SUCCESS);
+    MctsOptions options;
+    options.megabytes = 16;
+    Mcts mcts(options);
+    SearchResult result = mcts.Run(pos, NodeLimit(4000));
+    ASSERT_FALSE(result.ponderMove.IsNull());
+    const size_t treeSize = mcts.GetTreeSize();
+
+    // Our move and the expected reply: the subtree is kept
+    pos.MakeMove(result.bestMove);
+    pos.MakeMove(result.ponderMove);
+    mcts.Run(pos, NodeLimit(10));
+    EXPECT_GE(mcts.GetTreeSize(), treeSize);
+
+    // Unrelated position: new tree
+    ASSERT_EQ(pos.SetFEN("4k3/8/8/3q4/8/8/8/3RK3 w - - 0 1"), SUCCESS);
+    mcts.Run(pos, NodeLimit(10));
+    EXPECT_LT(mcts.GetTreeSize(), treeSize);
+}
+
+TEST(TestMcts, UciOption)
+{
+    std::istringstream in(
+        "setoption name UseMCTS value true\n"
+        "setoption name MCTSHash value 4\n"
+        "setoption name Threads value 2\n"
+        "position fen 4k3/8/8/3q4/8/8/8/3RK3 w - - 0 1\n"
+        "go nodes 3000\n");
+    std::ostringstream out;
+    {
+        Uci uci(in, out);
+        uci.Loop();
+    }
+    EXPECT_NE(out.str().find("bestmove d1d5"), std::string::npos);
+}
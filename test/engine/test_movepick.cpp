@@ -0,0 +1,108 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for movepick.h & movepick.cpp
+ **************************************************/
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include "movepick.h"
+
+using namespace Shohih;
+
+namespace {
+
+const std::vector<std::string> g_fens {
+    STANDARD_POSITION_FEN,
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+};
+
+std::vector<PackedMove> PickAll(MovePicker &picker)
+{
+    std::vector<PackedMove> moves;
+    for (PackedMove move = picker.NextMove(); !move.IsNull(); move = picker.NextMove()) {
+        moves.push_back(move);
+    }
+    return moves;
+}
+
+} // namespace
+
+TEST(TestMovePicker, YieldsEveryMoveOnce)
+{
+    HistoryTable history;
+    for (const auto &fen : g_fens) {
+        Position pos;
+        ASSERT_EQ(pos.SetFEN(fen), SUCCESS);
+        MoveList all;
+        pos.GenerateMoves(all, GenType::ALL);
+
+        // Use a quiet move as TT move and invalid moves as killers
+        KillerMoves killers{ { PackedMove(0, 63), all[all.Size() - 1].move } };
+        MovePicker picker(pos, all[0].move, killers, history);
+        auto picked = PickAll(picker);
+
+        EXPECT_EQ(picked.size(), all.Size()) << fen;
+        for (const auto &item : all) {
+            EXPECT_EQ(std::count(picked.begin(), picked.end(), item.move), 1)
+                << fen << " " << item.move.ToUci();
+        }
+    }
+}
+
+TEST(TestMovePicker, StageOrder)
+{
+    // White can capture the queen with the knight and the rook with two pawns
+    Position pos;
+    ASSERT_EQ(pos.SetFEN("4k3/8/8/3rq3/2P1P3/5N2/8/4K3 w - - 0 1"), SUCCESS);
+
+    HistoryTable history;
+    const PackedMove ttMove = pos.ParseUciMove("e1f2");
+    const PackedMove killer = pos.ParseUciMove("f3h4");
+    const PackedMove goodQuiet = pos.ParseUciMove("e1e2");
+    history.Update(PieceColor::WHITE, goodQuiet, 1000);
+
+    MovePicker picker(pos, ttMove, KillerMoves{ { killer, NULL_PACKED_MOVE } }, history);
+    auto picked = PickAll(picker);
+    ASSERT_GE(picked.size(), 6u);
+
+    // TT move first
+    EXPECT_EQ(picked[0], ttMove);
+    // Captures by MVV-LVA: queen first, then the rook
+    EXPECT_EQ(picked[1].ToUci(), "f3e5");
+    EXPECT_EQ(picked[2].ToUci().substr(1), "4d5");
+    EXPECT_EQ(picked[3].ToUci().substr(1), "4d5");
+    // Killer, then quiets sorted by history
+    EXPECT_EQ(picked[4], killer);
+    EXPECT_EQ(picked[5], goodQuiet);
+}
+
+TEST(TestMovePicker, QuiescenceOnlyCaptures)
+{
+    HistoryTable history;
+    Position pos;
+    ASSERT_EQ(pos.SetFEN(g_fens[1]), SUCCESS);
+    MoveList captures;
+    pos.GenerateMoves(captures, GenType::CAPTURES);
+
+    // Quiet TT moves are ignored in quiescence
+    MovePicker picker(pos, pos.ParseUciMove("a2a3"), history);
+    auto picked = PickAll(picker);
+    EXPECT_EQ(picked.size(), captures.Size());
+    for (const auto &move : picked) {
+        EXPECT_FALSE(move.IsQuiet()) << move.ToUci();
+    }
+}
+
+TEST(TestMovePicker, HistoryGravity)
+{
+    HistoryTable history;
+    const PackedMove move(12, 28, PackedMove::DOUBLE_PUSH);
+    for (int i{ 0 }; i < 1000; i++) {
+        history.Update(PieceColor::WHITE, move, 400);
+    }
+    EXPECT_LE(history.Get(PieceColor::WHITE, move), HistoryTable::MAX_SCORE);
+    EXPECT_GT(history.Get(PieceColor::WHITE, move), HistoryTable::MAX_SCORE / 2);
+    EXPECT_EQ(history.Get(PieceColor::BLACK, move), 0);
+}
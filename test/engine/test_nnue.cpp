@@ -0,0 +1,111 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for nnue.h & nnue.cpp
+ **************************************************/
+
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include "evaluate.h"
+
+using namespace Shohih;
+
+namespace {
+
+// Enables a random network for the duration of a test
+class NnueGuard {
+public:
+    NnueGuard()
+    {
+        Nnue::g_network.Randomize(20261019);
+        Nnue::SetEnabled(true);
+    }
+    ~NnueGuard()
+    {
+        Nnue::SetEnabled(false);
+        Nnue::SetSimdLevel(Nnue::GetSupportedSimdLevel());
+    }
+};
+
+const std::string TEST_FEN{
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1" };
+
+} // namespace
+
+TEST(TestNnue, IncrementalAccumulator)
+{
+    NnueGuard guard;
+    Position pos;
+    ASSERT_EQ(pos.SetFEN(TEST_FEN), SUCCESS);
+
+    MoveList list;
+    pos.GenerateLegalMoves(list);
+    for (const auto &item : list) {
+        pos.MakeMove(item.move);
+        Position fresh;
+        ASSERT_EQ(fresh.SetFEN(pos.GetFEN()), SUCCESS);
+        EXPECT_EQ(pos.GetAccumulator().values, fresh.GetAccumulator().values)
+            << item.move.ToUci();
+        EXPECT_EQ(Evaluate(pos), Evaluate(fresh));
+        pos.UnmakeMove(item.move);
+    }
+    Position fresh;
+    ASSERT_EQ(fresh.SetFEN(TEST_FEN), SUCCESS);
+    EXPECT_EQ(pos.GetAccumulator().values, fresh.GetAccumulator().values);
+}
+
+TEST(TestNnue, SimdMatchesScalar)
+{
+    NnueGuard guard;
+    Position pos;
+    ASSERT_EQ(pos.SetFEN(TEST_FEN), SUCCESS);
+    MoveList list;
+    pos.GenerateLegalMoves(list);
+
+    // Evaluate every child with each kernel set
+    std::vector<std::vector<int>> scores;
+    for (int level{ 0 }; level <= static_cast<int>(Nnue::GetSupportedSimdLevel()); level++) {
+        Nnue::SetSimdLevel(static_cast<Nnue::SimdLevel>(level));
+        Position copy = pos;
+        copy.RefreshAccumulator();
+        scores.emplace_back();
+        for (const auto &item : list) {
+            copy.MakeMove(item.move);
+            scores.back().push_back(Evaluate(copy));
+            copy.UnmakeMove(item.move);
+        }
+    }
+    for (const auto &levelScores : scores) {
+        EXPECT_EQ(levelScores, scores.front());
+    }
+}
+
+TEST(TestNnue, LoadWeights)
+{
+    const std::string path{ "test_nnue_weights.bin" };
+    Nnue::Network net;
+    net.Randomize(7);
+    ASSERT_EQ(net.Save(path), SUCCESS);
+
+    Nnue::Network loaded;
+    ASSERT_EQ(loaded.Load(path), SUCCESS);
+    EXPECT_TRUE(loaded.IsLoaded());
+    Nnue::Accumulator a{}, b{};
+    net.ResetAccumulator(a);
+    loaded.ResetAccumulator(b);
+    net.AddFeature(a, 1, 6);
+    loaded.AddFeature(b, 1, 6);
+    EXPECT_EQ(a.values, b.values);
+    EXPECT_EQ(net.Evaluate(a, PieceColor::BLACK), loaded.Evaluate(b, PieceColor::BLACK));
+
+    // Truncated file & missing file
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << "SHNN";
+    }
+    Nnue::Network bad;
+    EXPECT_EQ(bad.Load(path), INVALID_FILE_FORMAT);
+    EXPECT_FALSE(bad.IsLoaded());
+    std::remove(path.c_str());
+    EXPECT_EQ(bad.Load(path), FILE_OPEN_ERROR);
+}
@@ -0,0 +1,87 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for pawn_hash.h & pawn_hash.cpp
+ **************************************************/
+
+#include <gtest/gtest.h>
+#include "pawn_hash.h"
+
+using namespace Shohih;
+
+namespace {
+
+EvalScore PawnsOf(const std::string &fen)
+{
+    Position pos;
+    EXPECT_EQ(pos.SetFEN(fen), ErrorCode::SUCCESS) << fen;
+    return EvaluatePawns(pos);
+}
+
+void WalkTree(Position &pos, PawnHashTable &pawns, int depth)
+{
+    MoveList list;
+    pos.GenerateLegalMoves(list);
+    for (const auto &item : list) {
+        pos.MakeMove(item.move);
+        EXPECT_EQ(pawns.Evaluate(pos), EvaluatePawns(pos)) << pos.GetFEN();
+        if (depth > 1) {
+            WalkTree(pos, pawns, depth - 1);
+        }
+        pos.UnmakeMove(item.move);
+    }
+}
+
+} // namespace
+
+TEST(TestPawnHash, StructureTerms)
+{
+    EXPECT_EQ(PawnsOf(STANDARD_POSITION_FEN), EvalScore{});
+
+    // Passed pawn, more so when advanced; a pawn in front stops it
+    const EvalScore passed = PawnsOf("4k3/8/8/8/3P4/8/8/4K3 w - - 0 1");
+    EXPECT_GT(passed.eg, 0);
+    EXPECT_GT(PawnsOf("4k3/8/3P4/8/8/8/8/4K3 w - - 0 1").eg, passed.eg);
+    EXPECT_LT(PawnsOf("4k3/4p3/8/8/3P4/8/8/4K3 w - - 0 1").eg, passed.eg);
+
+    // Doubled & isolated vs healthy pawns on the same files
+    const EvalScore healthy = PawnsOf("4k3/8/8/8/8/8/2PP4/4K3 w - - 0 1");
+    EXPECT_LT(PawnsOf("4k3/8/8/8/8/2P5/2P5/4K3 w - - 0 1").eg, healthy.eg);
+    EXPECT_LT(PawnsOf("4k3/8/8/8/8/8/P2P4/4K3 w - - 0 1").eg, healthy.eg);
+
+    // Backward d3: the c-pawn went ahead and e5 guards d4
+    const EvalScore backward = PawnsOf("4k3/1p6/5p2/4p3/2P5/3P4/8/4K3 w - - 0 1");
+    const EvalScore supported = PawnsOf("4k3/1p6/5p2/4p3/8/2PP4/8/4K3 w - - 0 1");
+    EXPECT_LT(backward.mg, supported.mg);
+}
+
+TEST(TestPawnHash, KingShield)
+{
+    const EvalScore intact = PawnsOf("4k3/8/8/8/8/8/5PPP/6K1 w - - 0 1");
+    const EvalScore pushed = PawnsOf("4k3/8/8/8/5PPP/8/8/6K1 w - - 0 1");
+    const EvalScore open = PawnsOf("4k3/8/8/8/8/8/PPP5/6K1 w - - 0 1");
+    EXPECT_GT(intact.mg, pushed.mg);
+    EXPECT_GT(pushed.mg, open.mg);
+}
+
+TEST(TestPawnHash, CacheMatchesEvaluation)
+{
+    PawnHashTable pawns(1024);
+    for (const std::string fen : {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1" }) {
+        Position pos;
+        ASSERT_EQ(pos.SetFEN(fen), ErrorCode::SUCCESS);
+        WalkTree(pos, pawns, 2);
+    }
+    // Most moves leave the pawns alone
+    EXPECT_GT(pawns.GetHits() * 10, pawns.GetProbes() * 7);
+
+    pawns.Clear();
+    EXPECT_EQ(pawns.GetProbes(), 0u);
+    Position pos;
+    EXPECT_EQ(pawns.Evaluate(pos), EvaluatePawns(pos));
+    EXPECT_EQ(pawns.GetHits(), 0u);
+    EXPECT_EQ(pawns.Evaluate(pos), EvaluatePawns(pos));
+    EXPECT_EQ(pawns.GetHits(), 1u);
+}
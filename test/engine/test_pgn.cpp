@@ -0,0 +1,52 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for pgn.h & pgn.cpp
+ **************************************************/
+
+#include <sstream>
+#include <gtest/gtest.h>
+#include "pgn.h"
+
+using namespace Shohih;
+
+TEST(TestPgn, ReadGames)
+{
+    std::istringstream in(
+        "[Event \"Test\"]\n"
+        "[White \"A\"]\n"
+        "[Result \"0-1\"]\n"
+        "\n"
+        "1. f3 e5 2. g4 Qh4# 0-1\n"
+        "\n"
+        "[Event \"Second\"]\n"
+        "[FEN \"4k3/8/8/8/8/8/4P3/4K3 w - - 0 1\"]\n"
+        "[Result \"1/2-1/2\"]\n"
+        "1. e4 Kd7 1/2-1/2\n");
+    PgnReader reader(in);
+    PgnGame game;
+    ASSERT_TRUE(reader.NextGame(game));
+    EXPECT_EQ(game.GetTag("White"), "A");
+    EXPECT_EQ(game.GetTag("Black"), "");
+    EXPECT_EQ(game.GetResult(), GameResult::BLACK_WIN);
+    Position pos;
+    std::vector<PackedMove> moves;
+    ASSERT_EQ(game.ParseMoves(pos, moves), SUCCESS);
+    ASSERT_EQ(moves.size(), 4u);
+    EXPECT_EQ(moves[3].ToUci(), "d8h4");
+
+    ASSERT_TRUE(reader.NextGame(game));
+    EXPECT_EQ(game.GetTag("Event"), "Second");
+    EXPECT_EQ(game.GetResult(), GameResult::DRAW);
+    ASSERT_EQ(game.ParseMoves(pos, moves), SUCCESS);
+    EXPECT_EQ(pos.GetFEN(), "8/3k4/8/8/4P3/8/8/4K3 w - - 1 2");
+    EXPECT_FALSE(reader.NextGame(game));
+}
+
+TEST(TestPgn, Tokenize)
+{
+    auto tokens = PgnReader::Tokenize(
+        "1. e4 {best by test} e5 2. Nf3 (2. f4 exf4 (2... d5)) 2... Nc6! $1 ; rest of line\n"
+        "3. Bb5 a6?! 4. Ba4 1-0");
+    const std::vector<std::string> expected{ "e4", "e5", "Nf3", "Nc6!", "Bb5", "a6?!", "Ba4" };
+    EXPECT_EQ(tokens, expected);
+}
@@ -0,0 +1,261 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for position.h & position.cpp
+ **************************************************/
+
+#include <tuple>
+#include <gtest/gtest.h>
+#include "evaluate.h"
+
+using namespace Shohih;
+
+/**************************************************
+ * Reference perft counts:
+ *  https://www.chessprogramming.org/Perft_Results
+ **************************************************/
+TEST(TestPosition, Perft)
+{
+    static const std::vector<std::pair<std::string, std::vector<uint64_t>>> cases {
+        { STANDARD_POSITION_FEN, { 20, 400, 8902, 197281 } },
+        { "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+            { 48, 2039, 97862 } },
+        { "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", { 14, 191, 2812, 43238 } },
+        { "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+            { 6, 264, 9467 } },
+        { "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", { 44, 1486, 62379 } },
+    };
+    for (const auto &_case : cases) {
+        Position pos;
+        ASSERT_EQ(pos.SetFEN(_case.first), SUCCESS);
+        const std::string fen = pos.GetFEN();
+        for (size_t depth{ 0 }; depth < _case.second.size(); depth++) {
+            EXPECT_EQ(pos.Perft(static_cast<int>(depth + 1)), _case.second[depth])
+                << _case.first << " depth " << depth + 1;
+        }
+        // Make/unmake must restore the position
+        EXPECT_EQ(pos.GetFEN(), fen);
+    }
+}
+
+TEST(TestPosition, FEN)
+{
+    Position pos;
+    EXPECT_EQ(pos.GetFEN(), STANDARD_POSITION_FEN);
+
+    const std::string fen{ "r3k2r/8/8/1b6/6B1/8/8/R3K2R b Kq - 3 12" };
+    ASSERT_EQ(pos.SetFEN(fen), SUCCESS);
+    EXPECT_EQ(pos.GetFEN(), fen);
+    EXPECT_EQ(pos.GetSideToMove(), PieceColor::BLACK);
+    EXPECT_EQ(pos.GetCastlingRights(), WHITE_OO | BLACK_OOO);
+
+    // Invalid FENs
+    EXPECT_EQ(pos.SetFEN("8/8/8/8/8/8/8/8 w - - 0 1"), INVALID_FEN);
+    EXPECT_EQ(pos.SetFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP w KQkq - 0 1"), INVALID_FEN);
+    EXPECT_EQ(pos.SetFEN("rnbqkbnr/pppppppp/9/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"), INVALID_FEN);
+    EXPECT_EQ(pos.SetFEN("4k3/8/8/8/8/8/8/4K2r b - - 0 1"), INVALID_FEN);
+}
+
+TEST(TestPosition, MakeUnmakeRestoresKey)
+{
+    Position pos;
+    ASSERT_EQ(pos.SetFEN(
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"), SUCCESS);
+    const std::string fen = pos.GetFEN();
+    const uint64_t key = pos.GetKey();
+
+    MoveList list;
+    pos.GenerateLegalMoves(list);
+    for (const auto &item : list) {
+        pos.MakeMove(item.move);
+        // Incremental key must match a freshly parsed position
+        Position fresh;
+        ASSERT_EQ(fresh.SetFEN(pos.GetFEN()), SUCCESS);
+        EXPECT_EQ(pos.GetKey(), fresh.GetKey()) << item.move.ToUci();
+        EXPECT_EQ(pos.GetPawnKey(), fresh.GetPawnKey()) << item.move.ToUci();
+        pos.UnmakeMove(item.move);
+        EXPECT_EQ(pos.GetFEN(), fen);
+        EXPECT_EQ(pos.GetKey(), key);
+    }
+}
+
+TEST(TestPosition, PawnKey)
+{
+    // Promotions, pawn captures and en passant
+    Position pos;
+    ASSERT_EQ(pos.SetFEN(
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1"), SUCCESS);
+    const uint64_t pawnKey = pos.GetPawnKey();
+    MoveList list;
+    pos.GenerateLegalMoves(list);
+    for (const auto &item : list) {
+        pos.MakeMove(item.move);
+        Position fresh;
+        ASSERT_EQ(fresh.SetFEN(pos.GetFEN()), SUCCESS);
+        EXPECT_EQ(pos.GetPawnKey(), fresh.GetPawnKey()) << item.move.ToUci();
+        // Only pawn moves and pawn captures change the pawn key
+        const bool pawnsChanged = TypeOf(pos.GetPieceOn(item.move.To())) == PieceType::PAWN ||
+            item.move.IsPromotion() || (pos.GetCapturedPiece() != NO_PIECE &&
+            TypeOf(pos.GetCapturedPiece()) == PieceType::PAWN);
+        EXPECT_EQ(pos.GetPawnKey() != pawnKey, pawnsChanged) << item.move.ToUci();
+        pos.UnmakeMove(item.move);
+    }
+    EXPECT_EQ(pos.GetPawnKey(), pawnKey);
+
+    pos.MakeNullMove();
+    EXPECT_EQ(pos.GetPawnKey(), pawnKey);
+    pos.UnmakeNullMove();
+}
+
+TEST(TestPosition, PseudoLegal)
+{
+    Position pos;
+    MoveList list;
+    pos.GenerateMoves(list, GenType::ALL);
+    for (const auto &item : list) {
+        EXPECT_TRUE(pos.IsPseudoLegal(item.move)) << item.move.ToUci();
+    }
+    // Blocked, empty-source and wrongly-flagged moves
+    EXPECT_FALSE(pos.IsPseudoLegal(PackedMove(3, 27)));                         // d1d4
+    EXPECT_FALSE(pos.IsPseudoLegal(PackedMove(20, 28)));                        // e3e4
+    EXPECT_FALSE(pos.IsPseudoLegal(PackedMove(12, 28)));                        // e2e4 (no flag)
+    EXPECT_FALSE(pos.IsPseudoLegal(PackedMove(6, 21, PackedMove::CAPTURE)));    // g1xf3
+    EXPECT_FALSE(pos.IsPseudoLegal(NULL_PACKED_MOVE));
+}
+
+TEST(TestPosition, DrawDetection)
+{
+    Position pos;
+    for (const std::string uci : { "g1f3", "g8f6", "f3g1", "f6g8" }) {
+        EXPECT_FALSE(pos.IsRepetition());
+        pos.MakeMove(pos.ParseUciMove(uci));
+    }
+    EXPECT_TRUE(pos.IsRepetition());
+
+    ASSERT_EQ(pos.SetFEN("8/8/4k3/8/8/3NK3/8/8 w - - 0 1"), SUCCESS);
+    EXPECT_TRUE(pos.IsInsufficientMaterial());
+    ASSERT_EQ(pos.SetFEN("8/8/4k3/8/8/3RK3/8/8 w - - 0 1"), SUCCESS);
+    EXPECT_FALSE(pos.IsInsufficientMaterial());
+}
+
+TEST(TestPosition, StaticExchange)
+{
+    static const std::vector<std::tuple<std::string, std::string, int>> cases {
+        // Undefended pawn
+        { "1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1", "e1e5", 100 },
+        // Pawn takes pawn, pawn recaptures
+        { "4k3/8/2p5/3p4/4P3/8/8/4K3 w - - 0 1", "e4d5", 0 },
+        // Queen takes a defended pawn
+        { "4k3/8/2p5/3p4/8/8/8/3QK3 w - - 0 1", "d1d5", -800 },
+        // Long sequence with x-rays on both sides
+        { "1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1", "d3e5", -220 },
+        // King cannot recapture a defended piece
+        { "4k3/8/8/3r4/8/3R4/3R4/4K3 w - - 0 1", "d3d5", 500 },
+        // Quiet move to an attacked square
+        { "4k3/8/8/3p4/8/8/8/2N1K3 w - - 0 1", "c1b3", 0 },
+        { "4k3/8/8/3p4/8/8/8/4K1N1 w - - 0 1", "g1e2", 0 },
+        { "4k3/8/8/3p4/8/8/8/3NK3 w - - 0 1", "d1c3", 0 },
+        { "4k3/8/8/8/3p4/8/8/3NK3 w - - 0 1", "d1c3", -320 },
+    };
+    for (const auto &_case : cases) {
+        Position pos;
+        ASSERT_EQ(pos.SetFEN(std::get<0>(_case)), SUCCESS);
+        PackedMove move = pos.ParseUciMove(std::get<1>(_case));
+        ASSERT_FALSE(move.IsNull()) << std::get<1>(_case);
+        EXPECT_EQ(pos.See(move), std::get<2>(_case)) << std::get<0>(_case);
+        EXPECT_TRUE(pos.SeeGe(move, std::get<2>(_case)));
+        EXPECT_FALSE(pos.SeeGe(move, std::get<2>(_case) + 1));
+    }
+}
+
+TEST(TestPosition, IncrementalEvalTerms)
+{
+    Position pos;
+    ASSERT_EQ(pos.SetFEN(
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1"), SUCCESS);
+    const EvalScore psq = pos.GetPsqScore();
+    const int phase = pos.GetPhase();
+    EXPECT_EQ(psq, ComputePsqScore(pos));
+    EXPECT_EQ(phase, ComputePhase(pos));
+
+    // Promotions, castling, captures and en passant down to depth 2
+    MoveList list;
+    pos.GenerateLegalMoves(list);
+    for (const auto &item : list) {
+        pos.MakeMove(item.move);
+        EXPECT_EQ(pos.GetPsqScore(), ComputePsqScore(pos)) << item.move.ToUci();
+        EXPECT_EQ(pos.GetPhase(), ComputePhase(pos)) << item.move.ToUci();
+        MoveList replies;
+        pos.GenerateLegalMoves(replies);
+        for (const auto &reply : replies) {
+            pos.MakeMove(reply.move);
+            EXPECT_EQ(pos.GetPsqScore(), ComputePsqScore(pos));
+            pos.UnmakeMove(reply.move);
+        }
+        pos.UnmakeMove(item.move);
+    }
+    EXPECT_EQ(pos.GetPsqScore(), psq);
+    EXPECT_EQ(pos.GetPhase(), phase);
+}
+
+TEST(TestPosition, EvaluationSymmetry)
+{
+    Position pos;
+    EXPECT_EQ(pos.GetPhase(), MAX_PHASE);
+    EXPECT_EQ(Evaluate(pos), 0);
+
+    // Colour-flipped positions evaluate the same for the side to move
+    Position white, black;
+    ASSERT_EQ(white.SetFEN("r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4"), SUCCESS);
+    ASSERT_EQ(black.SetFEN("rnbqk2r/pppp1ppp/5n2/2b1p3/4P3/2N2N2/PPPP1PPP/R1BQKB1R b KQkq - 4 4"), SUCCESS);
+    EXPECT_EQ(Evaluate(white), Evaluate(black));
+}
+
+TEST(TestPosition, ParseSan)
+{
+    Position pos;
+    ASSERT_EQ(pos.SetFEN("r3k2r/1P1n4/8/8/8/2N3N1/8/R3K2R w KQkq - 0 1"), SUCCESS);
+    static const std::vector<std::pair<std::string, std::string>> cases {
+        { "O-O", "e1g1" }, { "0-0-0", "e1c1" }, { "Rb1", "a1b1" },
+        { "Nce4", "c3e4" }, { "Ng3e4+", "g3e4" }, { "bxa8=Q#", "b7a8q" },
+        { "b8N", "b7b8n" }, { "Nf5!?", "g3f5" },
+    };
+    for (const auto &_case : cases) {
+        EXPECT_EQ(pos.ParseSanMove(_case.first).ToUci(), _case.second) << _case.first;
+    }
+    // Ambiguous, illegal and malformed moves
+    for (const std::string san : { "Ne4", "Ke3", "b8", "Qd1", "Zf3", "e9", "" }) {
+        EXPECT_TRUE(pos.ParseSanMove(san).IsNull()) << san;
+    }
+}
+
+TEST(TestPosition, ToSan)
+{
+    Position pos;
+    ASSERT_EQ(pos.SetFEN("r3k2r/1P1n4/8/8/8/2N3N1/8/R3K2R w KQkq - 0 1"), SUCCESS);
+    static const std::vector<std::pair<std::string, std::string>> cases {
+        { "e1g1", "O-O" }, { "e1c1", "O-O-O" }, { "c3e4", "Nce4" }, { "g3e4", "Nge4" },
+        { "b7a8q", "bxa8=Q+" }, { "b7b8n", "b8=N" }, { "a1a8", "Rxa8+" },
+    };
+    for (const auto &_case : cases) {
+        EXPECT_EQ(pos.ToSan(pos.ParseUciMove(_case.first)), _case.second) << _case.first;
+    }
+    ASSERT_EQ(pos.SetFEN("6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1"), SUCCESS);
+    EXPECT_EQ(pos.ToSan(pos.ParseUciMove("d1d8")), "Rd8#");
+    ASSERT_EQ(pos.SetFEN("4k3/8/8/8/8/Q7/8/Q1Q1K3 w - - 0 1"), SUCCESS);
+    EXPECT_EQ(pos.ToSan(pos.ParseUciMove("a1b2")), "Qa1b2");
+    EXPECT_EQ(pos.ToSan(pos.ParseUciMove("a1a2")), "Q1a2");
+    EXPECT_EQ(pos.ToSan(pos.ParseUciMove("c1b2")), "Qcb2");
+
+    // Round trip through the SAN parser
+    for (const std::string fen : {
+        "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+        "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+        "4k3/8/8/8/8/Q7/8/Q1Q1K3 w - - 0 1" }) {
+        ASSERT_EQ(pos.SetFEN(fen), SUCCESS);
+        MoveList list;
+        pos.GenerateLegalMoves(list);
+        for (const auto &item : list) {
+            EXPECT_EQ(pos.ParseSanMove(pos.ToSan(item.move)), item.move) << pos.ToSan(item.move);
+        }
+    }
+}
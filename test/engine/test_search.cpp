@@ -0,0 +1,132 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for search.h & search.cpp
+ **************************************************/
+
+#include <gtest/gtest.h>
+#include "search.h"
+
+using namespace Shohih;
+
+namespace {
+
+SearchResult SearchFEN(const std::string &fen, int depth, const SearchConfig &config=SearchConfig{})
+{
+    TranspositionTable tt(1);
+    auto search = std::make_unique<Search>(tt);
+    search->SetConfig(config);
+    Position pos;
+    EXPECT_EQ(pos.SetFEN(fen), SUCCESS);
+    SearchLimits limits;
+    limits.depth = depth;
+    return search->Run(pos, limits);
+}
+
+} // namespace
+
+TEST(TestSearch, MateInOne)
+{
+    auto result = SearchFEN("6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1", 3);
+    EXPECT_EQ(result.bestMove.ToUci(), "d1d8");
+    EXPECT_EQ(result.score, VALUE_MATE - 1);
+}
+
+TEST(TestSearch, MateInTwo)
+{
+    auto result = SearchFEN("kbK5/pp6/1P6/8/8/8/8/R7 w - - 0 1", 4);
+    EXPECT_EQ(result.bestMove.ToUci(), "a1a6");
+    EXPECT_EQ(result.score, VALUE_MATE - 3);
+}
+
+TEST(TestSearch, NoLegalMoves)
+{
+    // Stalemate
+    auto result = SearchFEN("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1", 3);
+    EXPECT_TRUE(result.bestMove.IsNull());
+    EXPECT_EQ(result.score, VALUE_DRAW);
+
+    // Checkmate
+    result = SearchFEN("7k/6Q1/6K1/8/8/8/8/8 b - - 0 1", 3);
+    EXPECT_TRUE(result.bestMove.IsNull());
+    EXPECT_EQ(result.score, -VALUE_MATE);
+}
+
+TEST(TestSearch, WinsMaterial)
+{
+    // Free queen on d5
+    auto result = SearchFEN("4k3/8/8/3q4/8/2N5/8/4K3 w - - 0 1", 3);
+    EXPECT_EQ(result.bestMove.ToUci(), "c3d5");
+}
+
+TEST(TestSearch, NodeLimit)
+{
+    TranspositionTable tt(1);
+    auto search = std::make_unique<Search>(tt);
+    Position pos;
+    SearchLimits limits;
+    limits.nodes = 5000;
+    auto result = search->Run(pos, limits);
+    EXPECT_FALSE(result.bestMove.IsNull());
+    EXPECT_LE(result.nodes, limits.nodes);
+}
+
+TEST(TestSearch, InfoCallback)
+{
+    TranspositionTable tt(1);
+    auto search = std::make_unique<Search>(tt);
+    std::vector<SearchInfo> infos;
+    search->SetInfoCallback([&infos](const SearchInfo &info) { infos.push_back(info); });
+
+    Position pos;
+    SearchLimits limits;
+    limits.depth = 4;
+    auto result = search->Run(pos, limits);
+    ASSERT_EQ(infos.size(), 4u);
+    for (size_t i{ 0 }; i < infos.size(); i++) {
+        EXPECT_EQ(infos[i].depth, static_cast<int>(i + 1));
+        EXPECT_FALSE(infos[i].pv.empty());
+    }
+    EXPECT_EQ(infos.back().pv.front(), result.bestMove);
+}
+
+TEST(TestSearch, QuiescenceAvoidsDefendedPawn)
+{
+    // Qxd5 wins a pawn at depth 1 but loses the queen to cxd5
+    auto result = SearchFEN("4k3/8/2p5/3p4/8/8/8/3QK3 w - - 0 1", 1);
+    EXPECT_NE(result.bestMove.ToUci(), "d1d5");
+    EXPECT_GT(result.score, 0);
+
+    // A hanging piece is still taken
+    result = SearchFEN("4k3/8/8/3p4/8/8/8/3QK3 w - - 0 1", 1);
+    EXPECT_EQ(result.bestMove.ToUci(), "d1d5");
+}
+
+TEST(TestSearch, ConfigToggles)
+{
+    // Every feature switched off on its own still solves the tactics
+    for (int feature{ 0 }; feature < 6; feature++) {
+        SearchConfig config;
+        config.pvs = (feature != 0);
+        config.nullMove = (feature != 1);
+        config.lmr = (feature != 2);
+        config.aspiration = (feature != 3);
+        config.futility = (feature != 4);
+        if (feature == 5) {
+            config = SearchConfig{ false, false, false, false, false };
+        }
+        auto result = SearchFEN("kbK5/pp6/1P6/8/8/8/8/R7 w - - 0 1", 4, config);
+        EXPECT_EQ(result.bestMove.ToUci(), "a1a6") << "feature " << feature;
+        EXPECT_EQ(result.score, VALUE_MATE - 3) << "feature " << feature;
+        result = SearchFEN("4k3/8/8/3q4/8/2N5/8/4K3 w - - 0 1", 3, config);
+        EXPECT_EQ(result.bestMove.ToUci(), "c3d5") << "feature " << feature;
+    }
+}
+
+TEST(TestSearch, PruningSavesNodes)
+{
+    const std::string fen{ "r1bqkb1r/pppp1ppp/2n2n2/4p3/2B1P3/5N2/PPPP1PPP/RNBQK2R w KQkq - 4 4" };
+    const auto pruned = SearchFEN(fen, 7);
+    const auto plain = SearchFEN(fen, 7, SearchConfig{ false, false, false, false, false });
+    EXPECT_FALSE(pruned.bestMove.IsNull());
+    EXPECT_LT(pruned.nodes, plain.nodes);
+}
@@ -0,0 +1,198 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for selfplay.h & selfplay.cpp
+ **************************************************/
+
+#include <cstdio>
+#include <algorithm>
+#include <fstream>
+#include <gtest/gtest.h>
+#include "selfplay.h"
+
+using namespace Shohih;
+
+namespace {
+
+GameRecord PlayFixedDepth(const std::string &fen, int depth, const Adjudication &adjudication=Adjudication{})
+{
+    TranspositionTable tt(1);
+    auto white = std::make_unique<Search>(tt);
+    auto black = std::make_unique<Search>(tt);
+    TimeControl tc;
+    tc.depth = depth;
+    return PlayGame(fen, *white, *black, tc, adjudication);
+}
+
+} // namespace
+
+TEST(TestSelfPlay, Statistics)
+{
+    MatchStats even;
+    even.wins = 30;
+    even.draws = 40;
+    even.losses = 30;
+    EXPECT_DOUBLE_EQ(even.Score(), 0.5);
+    EXPECT_NEAR(even.Elo(), 0.0, 1e-9);
+    EXPECT_GT(even.EloError(), 0.0);
+
+    MatchStats strong;
+    strong.wins = 240;
+    strong.draws = 80;
+    strong.losses = 80;
+    EXPECT_NEAR(strong.Elo(), 147.2, 0.1);     // 70%
+    EXPECT_NEAR(MatchStats::EloToScore(strong.Elo()), 0.7, 1e-9);
+
+    SprtOptions sprt;
+    sprt.elo0 = 0.0;
+    sprt.elo1 = 10.0;
+    EXPECT_EQ(strong.Verdict(sprt), SprtVerdict::ACCEPT_H1);
+    MatchStats weak;
+    weak.wins = 80;
+    weak.draws = 80;
+    weak.losses = 240;
+    EXPECT_EQ(weak.Verdict(sprt), SprtVerdict::ACCEPT_H0);
+    MatchStats few;
+    few.wins = 2;
+    few.losses = 1;
+    EXPECT_EQ(few.Verdict(sprt), SprtVerdict::CONTINUE);
+    EXPECT_LT(MatchStats::LowerBound(sprt), 0.0);
+    EXPECT_GT(MatchStats::UpperBound(sprt), 0.0);
+}
+
+TEST(TestSelfPlay, Terminations)
+{
+    GameRecord game = PlayFixedDepth("6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1", 3);
+    EXPECT_EQ(game.result, GameResult::WHITE_WIN);
+    EXPECT_EQ(game.termination, Termination::CHECKMATE);
+    ASSERT_EQ(game.moves.size(), 1u);
+    EXPECT_EQ(game.moves[0].ToUci(), "d1d8");
+
+    game = PlayFixedDepth("4k3/8/8/8/8/8/8/4K3 w - - 0 1", 1);
+    EXPECT_EQ(game.result, GameResult::DRAW);
+    EXPECT_EQ(game.termination, Termination::INSUFFICIENT_MATERIAL);
+
+    game = PlayFixedDepth("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1", 1);
+    EXPECT_EQ(game.termination, Termination::STALEMATE);
+
+    Adjudication adjudication;
+    adjudication.maxPlies = 6;
+    game = PlayFixedDepth(STANDARD_POSITION_FEN, 1, adjudication);
+    EXPECT_EQ(game.result, GameResult::DRAW);
+    EXPECT_EQ(game.termination, Termination::MAX_PLIES);
+    EXPECT_EQ(game.moves.size(), 6u);
+
+    // A queen up: the loser resigns once both engines agree
+    adjudication = Adjudication{};
+    adjudication.resignScore = 500;
+    adjudication.resignMoves = 2;
+    game = PlayFixedDepth("4k3/8/8/8/8/8/3QPPP1/4K3 b - - 0 1", 3, adjudication);
+    EXPECT_EQ(game.result, GameResult::WHITE_WIN);
+    EXPECT_EQ(game.termination, Termination::RESIGN_ADJUDICATION);
+}
+
+TEST(TestSelfPlay, ClockForfeit)
+{
+    TranspositionTable tt(1);
+    auto white = std::make_unique<Search>(tt);
+    auto black = std::make_unique<Search>(tt);
+    TimeControl tc;
+    tc.baseMs = 200;
+    tc.incMs = 0;
+    Adjudication adjudication;
+    adjudication.maxPlies = 0;
+    adjudication.resignMoves = 0;
+    adjudication.drawMoves = 0;
+    const GameRecord game = PlayGame(STANDARD_POSITION_FEN, *white, *black, tc, adjudication);
+    // Either side may lose on time, but a game is always finished by the rules or the clock
+    EXPECT_NE(game.result, GameResult::UNKNOWN);
+    EXPECT_NE(game.termination, Termination::MAX_PLIES);
+}
+
+TEST(TestSelfPlay, Pgn)
+{
+    GameRecord game = PlayFixedDepth("6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1", 3);
+    game.round = 4;
+    game.firstEngineWhite = false;
+    MatchOptions options;
+    options.engines[0].name = "First";
+    options.engines[1].name = "Second";
+    const std::string pgn = FormatPgn(game, options);
+    EXPECT_NE(pgn.find("[Round \"5\"]"), std::string::npos);
+    EXPECT_NE(pgn.find("[White \"Second\"]"), std::string::npos);
+    EXPECT_NE(pgn.find("[Black \"First\"]"), std::string::npos);
+    EXPECT_NE(pgn.find("[FEN \"6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1\"]"), std::string::npos);
+    EXPECT_NE(pgn.find("1. Rd8# {checkmate} 1-0"), std::string::npos);
+
+    // The games read back with the PGN reader
+    std::istringstream in(pgn + pgn);
+    PgnReader reader(in);
+    PgnGame parsed;
+    int games{ 0 };
+    while (reader.NextGame(parsed)) {
+        Position pos;
+        std::vector<PackedMove> moves;
+        EXPECT_EQ(parsed.ParseMoves(pos, moves), SUCCESS);
+        EXPECT_EQ(moves, game.moves);
+        EXPECT_EQ(parsed.GetResult(), GameResult::WHITE_WIN);
+        games++;
+    }
+    EXPECT_EQ(games, 2);
+}
+
+TEST(TestSelfPlay, LoadOpenings)
+{
+    const std::string epdPath{ "test_openings.epd" };
+    const std::string pgnPath{ "test_openings.pgn" };
+    {
+        std::ofstream epd(epdPath);
+        epd << "# comment\n"
+            << "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - bm e5;\n"
+            << "not a fen\n"
+            << "\n"
+            << "7k/5Q2/6K1/8/8/8/8/8 b - - 0 1\n";     // stalemate: skipped
+        std::ofstream pgn(pgnPath);
+        pgn << "[Event \"a\"]\n\n1. e4 e5 2. Nf3 Nc6 3. Bb5 *\n\n"
+            << "[Event \"b\"]\n\n1. d4 *\n";
+    }
+    std::vector<std::string> fens;
+    ASSERT_EQ(LoadOpenings(epdPath, 0, fens), SUCCESS);
+    ASSERT_EQ(fens.size(), 1u);
+    EXPECT_EQ(fens[0], "rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq - 0 1");
+
+    ASSERT_EQ(LoadOpenings(pgnPath, 3, fens), SUCCESS);
+    ASSERT_EQ(fens.size(), 2u);
+    EXPECT_EQ(fens[0], "rnbqkbnr/pppp1ppp/8/4p3/4P3/5N2/PPPP1PPP/RNBQKB1R b KQkq - 1 2");
+    EXPECT_EQ(fens[1], "rnbqkbnr/pppppppp/8/8/3P4/8/PPP1PPPP/RNBQKBNR b KQkq - 0 1");
+
+    EXPECT_EQ(LoadOpenings("missing_openings.epd", 0, fens), FILE_OPEN_ERROR);
+    std::remove(epdPath.c_str());
+    std::remove(pgnPath.c_str());
+}
+
+TEST(TestSelfPlay, RunMatch)
+{
+    MatchOptions options;
+    options.games = 6;
+    options.concurrency = 3;
+    options.timeControl.depth = 2;
+    options.engines[0].hashMb = options.engines[1].hashMb = 1;
+    options.adjudication.maxPlies = 40;
+    const std::vector<std::string> openings{
+        STANDARD_POSITION_FEN,
+        "rnbqkbnr/pppp1ppp/8/4p3/4P3/8/PPPP1PPP/RNBQKBNR w KQkq - 0 2" };
+
+    std::vector<size_t> rounds;
+    const MatchStats stats = RunMatch(options, openings,
+        [&rounds, &openings](const GameRecord &game, const MatchStats &current) {
+            rounds.push_back(game.round);
+            EXPECT_EQ(current.Games(), rounds.size());
+            EXPECT_EQ(game.firstEngineWhite, game.round % 2 == 0);
+            EXPECT_EQ(game.startFen, openings[(game.round / 2) % openings.size()]);
+        });
+    EXPECT_EQ(stats.Games(), 6u);
+    std::sort(rounds.begin(), rounds.end());
+    EXPECT_EQ(rounds, (std::vector<size_t>{ 0, 1, 2, 3, 4, 5 }));
+
+    // Same engines, fixed depth: colour-reversed pairs cancel out
+    EXPECT_EQ(stats.wins, stats.losses);
+}
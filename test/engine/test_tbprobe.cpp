@@ -0,0 +1,152 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for tbprobe.h & tbprobe.cpp
+ **************************************************/
+
+#include <cstdio>
+#include <algorithm>
+#include <fstream>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include "search.h"
+
+using namespace Shohih;
+using namespace Shohih::Tablebases;
+
+namespace {
+
+const std::string TB_DIR{ "test_syzygy" };
+
+void WriteFile(const std::string &name, const std::vector<uint8_t> &bytes)
+{
+    std::ofstream file(TB_DIR + "/" + name, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+//--------------------------------------------------
+// Hand-made KQvK tables using the single-value
+// encoding: white to move wins, black to move loses,
+// DTZ (white to move) 9 moves. File sizes are 16 mod
+// 64 like real tables. KRvK has a broken header.
+//--------------------------------------------------
+void WriteTestTables()
+{
+    mkdir(TB_DIR.c_str(), 0755);
+    WriteFile("KQvK.rtbw", {
+        0x71, 0xE8, 0x23, 0x5D,     // magic
+        0x01,                       // split (both sides to move), no pawns
+        0x00,                       // group order
+        0x66, 0x55, 0xEE,           // K, Q, k for both sides
+        0x00,                       // alignment
+        0x80, 0x04,                 // white to move: single value WDL + 2 = win
+        0x80, 0x00,                 // black to move: loss
+        0x00, 0x00,
+    });
+    WriteFile("KQvK.rtbz", {
+        0xD7, 0x66, 0x0C, 0xA5,
+        0x01,
+        0x00,
+        0x06, 0x05, 0x0E,
+        0x00,
+        0x80, 0x09,                 // white to move, 9 moves
+        0x00, 0x00, 0x00, 0x00,
+    });
+    WriteFile("KRvK.rtbw", std::vector<uint8_t>(16, 0));
+    WriteFile("notatable.rtbw", std::vector<uint8_t>(16, 0));
+}
+
+void RemoveTestTables()
+{
+    for (const std::string name : { "KQvK.rtbw", "KQvK.rtbz", "KRvK.rtbw", "notatable.rtbw" }) {
+        std::remove((TB_DIR + "/" + name).c_str());
+    }
+    rmdir(TB_DIR.c_str());
+    Init("");
+}
+
+} // namespace
+
+TEST(TestTablebases, NoTables)
+{
+    EXPECT_EQ(Init("does/not/exist"), 0u);
+    EXPECT_EQ(MaxPieces(), 0);
+    Position pos;
+    ASSERT_EQ(pos.SetFEN("4k3/8/8/8/8/8/8/4KQ2 w - - 0 1"), SUCCESS);
+    ProbeState state;
+    ProbeWdl(pos, state);
+    EXPECT_EQ(state, ProbeState::FAIL);
+    RootProbe probe;
+    EXPECT_FALSE(ProbeRoot(pos, probe));
+}
+
+TEST(TestTablebases, ProbeSingleValueTables)
+{
+    WriteTestTables();
+    ASSERT_EQ(Init("does/not/exist:" + TB_DIR), 2u);
+    EXPECT_EQ(MaxPieces(), 3);
+
+    ProbeState state;
+    Position pos;
+    ASSERT_EQ(pos.SetFEN("4k3/8/8/8/8/8/8/4KQ2 w - - 0 1"), SUCCESS);
+    const std::string fen = pos.GetFEN();
+    EXPECT_EQ(ProbeWdl(pos, state), WDL_WIN);
+    EXPECT_EQ(state, ProbeState::OK);
+    EXPECT_EQ(ProbeDtz(pos, state), 19);    // 9 moves -> plies + 1
+    EXPECT_EQ(pos.GetFEN(), fen);
+
+    // DTZ only stores white to move: found by a 1-ply search
+    ASSERT_EQ(pos.SetFEN("4k3/8/8/8/8/8/8/3QK3 b - - 0 1"), SUCCESS);
+    EXPECT_EQ(ProbeWdl(pos, state), WDL_LOSS);
+    EXPECT_EQ(ProbeDtz(pos, state), -20);
+
+    // Black as the stronger side is probed colour-flipped
+    ASSERT_EQ(pos.SetFEN("4kq2/8/8/8/8/8/8/4K3 b - - 0 1"), SUCCESS);
+    EXPECT_EQ(ProbeWdl(pos, state), WDL_WIN);
+    ASSERT_EQ(pos.SetFEN("4kq2/8/8/8/8/8/8/4K3 w - - 0 1"), SUCCESS);
+    EXPECT_EQ(ProbeWdl(pos, state), WDL_LOSS);
+
+    // KQvKQ is missing, but capturing the queen wins
+    ASSERT_EQ(pos.SetFEN("4k3/8/8/8/8/8/3q4/3QK3 w - - 0 1"), SUCCESS);
+    EXPECT_EQ(ProbeWdl(pos, state), WDL_WIN);
+    EXPECT_EQ(state, ProbeState::ZEROING_BEST_MOVE);
+    ASSERT_EQ(pos.SetFEN("4k3/8/8/8/8/2q5/8/3QK3 w - - 0 1"), SUCCESS);
+    ProbeWdl(pos, state);
+    EXPECT_EQ(state, ProbeState::FAIL);
+
+    // Broken header
+    ASSERT_EQ(pos.SetFEN("4k3/8/8/8/8/8/8/4KR2 w - - 0 1"), SUCCESS);
+    ProbeWdl(pos, state);
+    EXPECT_EQ(state, ProbeState::FAIL);
+    RemoveTestTables();
+}
+
+TEST(TestTablebases, RootMoveFilter)
+{
+    WriteTestTables();
+    ASSERT_EQ(Init(TB_DIR), 2u);
+    Position pos;
+    ASSERT_EQ(pos.SetFEN("4k3/8/8/8/8/8/8/4KQ2 w - - 0 1"), SUCCESS);
+    RootProbe probe;
+    ASSERT_TRUE(ProbeRoot(pos, probe));
+    EXPECT_TRUE(probe.dtz);
+    EXPECT_EQ(probe.rank, 1000);
+    ASSERT_FALSE(probe.moves.empty());
+    MoveList legal;
+    pos.GenerateLegalMoves(legal);
+    EXPECT_LT(probe.moves.size(), legal.Size());
+    // Moves that hang the queen draw
+    for (const std::string uci : { "f1f7", "f1f8" }) {
+        EXPECT_EQ(std::find(probe.moves.begin(), probe.moves.end(), pos.ParseUciMove(uci)),
+                  probe.moves.end()) << uci;
+    }
+
+    // The search only plays one of the kept moves
+    TranspositionTable tt(1);
+    auto search = std::make_unique<Search>(tt);
+    SearchLimits limits;
+    limits.depth = 3;
+    auto result = search->Run(pos, limits);
+    EXPECT_NE(std::find(probe.moves.begin(), probe.moves.end(), result.bestMove), probe.moves.end());
+    RemoveTestTables();
+}
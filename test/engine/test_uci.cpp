@@ -0,0 +1,120 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for uci.h & uci.cpp
+ **************************************************/
+
+#include <gtest/gtest.h>
+#include "uci.h"
+
+using namespace Shohih;
+
+namespace {
+
+std::string RunSession(const std::string &commands)
+{
+    std::istringstream in(commands);
+    std::ostringstream out;
+    Uci uci(in, out);
+    uci.Loop();
+    return out.str();
+}
+
+} // namespace
+
+TEST(TestUci, Handshake)
+{
+    std::string out = RunSession("uci\nisready\nfoo\nquit\n");
+    EXPECT_NE(out.find("id name Shohih"), std::string::npos);
+    EXPECT_NE(out.find("option name Hash"), std::string::npos);
+    EXPECT_NE(out.find("uciok"), std::string::npos);
+    EXPECT_NE(out.find("readyok"), std::string::npos);
+    EXPECT_NE(out.find("Unknown command: foo"), std::string::npos);
+}
+
+TEST(TestUci, GoDepth)
+{
+    std::string out = RunSession(
+        "setoption name Hash value 4\n"
+        "position fen 6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1\n"
+        "go depth 3\n");
+    EXPECT_NE(out.find("info depth 3"), std::string::npos);
+    EXPECT_NE(out.find("score mate 1"), std::string::npos);
+    EXPECT_NE(out.find("bestmove d1d8"), std::string::npos);
+}
+
+TEST(TestUci, StopInfiniteSearch)
+{
+    std::string out = RunSession(
+        "setoption name Threads value 2\n"
+        "position startpos moves e2e4 e7e5\n"
+        "go infinite\n"
+        "isready\n"
+        "stop\n");
+    EXPECT_NE(out.find("readyok"), std::string::npos);
+    ASSERT_NE(out.find("bestmove "), std::string::npos);
+    // Exactly one bestmove, after stop
+    EXPECT_EQ(out.find("bestmove "), out.rfind("bestmove "));
+}
+
+TEST(TestUci, ParsePosition)
+{
+    Position pos;
+    std::istringstream startpos("startpos moves e2e4 c7c5 g1f3");
+    ASSERT_EQ(Uci::ParsePosition(startpos, pos), SUCCESS);
+    EXPECT_EQ(pos.GetFEN(), "rnbqkbnr/pp1ppppp/8/2p5/4P3/5N2/PPPP1PPP/RNBQKB1R b KQkq - 1 2");
+
+    std::istringstream fen("fen 4k3/8/8/8/8/8/8/4K2R w K - 0 1 moves e1g1");
+    ASSERT_EQ(Uci::ParsePosition(fen, pos), SUCCESS);
+    EXPECT_EQ(pos.GetFEN(), "4k3/8/8/8/8/8/8/5RK1 b - - 1 1");
+
+    // Errors leave the position unchanged
+    std::istringstream illegal("startpos moves e2e5");
+    EXPECT_EQ(Uci::ParsePosition(illegal, pos), INVALID_MOVE);
+    std::istringstream garbage("nonsense");
+    EXPECT_EQ(Uci::ParsePosition(garbage, pos), INVALID_FEN);
+    EXPECT_EQ(pos.GetFEN(), "4k3/8/8/8/8/8/8/5RK1 b - - 1 1");
+}
+
+TEST(TestUci, ParseGo)
+{
+    std::istringstream args("wtime 60000 btime 30000 winc 1000 binc 500 movestogo 20 ponder");
+    SearchLimits limits = Uci::ParseGo(args);
+    EXPECT_EQ(limits.time[0], 60000);
+    EXPECT_EQ(limits.time[1], 30000);
+    EXPECT_EQ(limits.inc[0], 1000);
+    EXPECT_EQ(limits.inc[1], 500);
+    EXPECT_EQ(limits.movesToGo, 20);
+    EXPECT_TRUE(limits.ponder);
+    EXPECT_FALSE(limits.infinite);
+    EXPECT_EQ(limits.depth, MAX_DEPTH);
+
+    EXPECT_EQ(Uci::FormatScore(VALUE_MATE - 3), "mate 2");
+    EXPECT_EQ(Uci::FormatScore(-VALUE_MATE + 2), "mate -1");
+    EXPECT_EQ(Uci::FormatScore(-35), "cp -35");
+}
+
+TEST(TestUci, SearchFeatureOptions)
+{
+    std::string out = RunSession("uci\nquit\n");
+    for (const char *name : { "PVS", "NullMove", "LMR", "AspirationWindows", "Futility" }) {
+        EXPECT_NE(out.find(std::string("option name ") + name + " type check default true"), std::string::npos);
+    }
+
+    out = RunSession(
+        "setoption name PVS value false\n"
+        "setoption name NullMove value false\n"
+        "setoption name LMR value false\n"
+        "setoption name AspirationWindows value false\n"
+        "setoption name Futility value false\n"
+        "position fen 6k1/5ppp/8/8/8/8/5PPP/3R2K1 w - - 0 1\n"
+        "go depth 3\n");
+    EXPECT_NE(out.find("bestmove d1d8"), std::string::npos);
+}
+
+TEST(TestUci, Bench)
+{
+    std::string out = RunSession("bench 2\n");
+    EXPECT_NE(out.find("info string position 50/50 nodes "), std::string::npos);
+    EXPECT_NE(out.find("Nodes searched  : "), std::string::npos);
+    EXPECT_NE(out.find("Nodes/second    : "), std::string::npos);
+}
@@ -4,6 +4,7 @@
  **************************************************/
 
 #include <gtest/gtest.h>
+#include "board.h"
 #include "client.h"
 
 using namespace Shohih;
@@ -17,7 +18,7 @@ int main(int argc, char **argv)
 TEST(TestShohihClient, GetAndPostRequests)
 {
     Client client("localhost:8080");
-    Client client2("localhost:8080");
+    Client client2("localhost:8080", client.GetRoom());
     EXPECT_EQ(client.GetPlayerColor(), PieceColor::WHITE);
     EXPECT_EQ(client2.GetPlayerColor(), PieceColor::BLACK);
 
@@ -37,4 +38,47 @@ TEST(TestShohihClient, GetAndPostRequests)
     move = client.GetMove();
     EXPECT_EQ(move.first, Square::GetSquareByName("e2"));
     EXPECT_EQ(move.second, Square::GetSquareByName("e4"));
-}
\ No newline at end of file
+
+    // The opponent catches up on the whole game
+    std::vector<Move> moves;
+    ASSERT_EQ(client2.GetMoves(moves), SUCCESS);
+    ASSERT_EQ(moves.size(), 1u);
+    EXPECT_EQ(moves[0].first, Square::GetSquareByName("e2"));
+    EXPECT_EQ(moves[0].second, Square::GetSquareByName("e4"));
+}
+
+TEST(TestShohihClient, ReplayAfterRejectedMove)
+{
+    auto client = std::make_shared<Client>("localhost:8080");
+    auto client2 = std::make_shared<Client>("localhost:8080", client->GetRoom());
+    std::shared_ptr<Board> board;
+    ASSERT_EQ(Board::BuildBoardByFEN(board, STANDARD_POSITION_FEN, GameMode::ONLINE, client2), SUCCESS);
+
+    // 1. e4 f6 2. Qh5+
+    auto play = [](Client &player, const char *from, const char *to) {
+        return player.SendMove(Move{ Square::GetSquareByName(from), Square::GetSquareByName(to) });
+    };
+    ASSERT_EQ(play(*client, "e2", "e4"), SUCCESS);
+    ASSERT_EQ(play(*client2, "f7", "f6"), SUCCESS);
+    ASSERT_EQ(play(*client, "d1", "h5"), SUCCESS);
+    std::vector<Move> moves;
+    ASSERT_EQ(client2->GetAllMoves(moves), SUCCESS);
+    ASSERT_EQ(board->ReplayGame(moves), SUCCESS);
+    EXPECT_EQ(board->GetPlayerTurn(), PieceColor::BLACK);
+
+    // The board does not see the check, the server does
+    ASSERT_EQ(board->MovePiece(Square::GetSquareByName("a7"), Square::GetSquareByName("a6")), SUCCESS);
+    ASSERT_EQ(client2->SendMove(board->GetLastMove()), INVALID_MOVE);
+
+    // Back in sync: the move is taken back and it is black's turn again
+    ASSERT_EQ(client2->GetAllMoves(moves), SUCCESS);
+    ASSERT_EQ(moves.size(), 3u);
+    ASSERT_EQ(board->ReplayGame(moves), SUCCESS);
+    EXPECT_EQ(board->GetPlayerTurn(), PieceColor::BLACK);
+    EXPECT_EQ(board->GetLastMove().second, Square::GetSquareByName("h5"));
+    EXPECT_FALSE(board->IsEmptySquare(Square::GetSquareByName("a7")));
+    EXPECT_TRUE(board->IsEmptySquare(Square::GetSquareByName("a6")));
+    EXPECT_TRUE(board->IsEmptySquare(Square::GetSquareByName("d1")));
+    ASSERT_EQ(board->MovePiece(Square::GetSquareByName("g7"), Square::GetSquareByName("g6")), SUCCESS);
+    EXPECT_EQ(client2->SendMove(board->GetLastMove()), SUCCESS);
+}
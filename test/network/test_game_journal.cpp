@@ -0,0 +1,319 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for game_journal.h & game_journal.cpp
+ **************************************************/
+
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <thread>
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include "game_journal.h"
+#include "game_registry.h"
+
+using namespace Shohih;
+
+namespace {
+
+//--------------------------------------------------
+// Fresh journal directory, deleted with its files
+//--------------------------------------------------
+class TempDir {
+public:
+    TempDir()
+    {
+        char path[]{ "/tmp/shohih_journal_XXXXXX" };
+        m_path = ::mkdtemp(path);
+    }
+    ~TempDir()
+    {
+        for (const auto &file : Files("")) {
+            ::unlink(file.c_str());
+        }
+        ::rmdir(m_path.c_str());
+    }
+    const std::string &Path() const { return m_path; }
+
+    std::vector<std::string> Files(const std::string &prefix) const
+    {
+        std::vector<std::string> files;
+        DIR *dir = ::opendir(m_path.c_str());
+        while (const dirent *entry = ::readdir(dir)) {
+            const std::string name(entry->d_name);
+            if (name != "." && name != ".." && name.compare(0, prefix.size(), prefix) == 0) {
+                files.push_back(m_path + "/" + name);
+            }
+        }
+        ::closedir(dir);
+        return files;
+    }
+
+private:
+    std::string m_path;
+};
+
+Move MakeMove(const char *from, const char *to)
+{
+    return Move{ Square::GetSquareByName(from), Square::GetSquareByName(to) };
+}
+
+JournalOptions Options(const TempDir &dir)
+{
+    JournalOptions options;
+    options.dir = dir.Path();
+    options.syncInterval = std::chrono::milliseconds(0);
+    options.snapshotInterval = std::chrono::seconds(0);
+    return options;
+}
+
+} // namespace
+
+TEST(TestGameJournal, Recovery)
+{
+    TempDir dir;
+    std::string room{ "journaled" }, other{ "left" }, white, black, leaver;
+    PieceColor color;
+    {
+        GameRegistry registry;
+        GameJournal journal(Options(dir));
+        RecoveryStats stats;
+        ASSERT_EQ(journal.Open(registry, stats), SUCCESS);
+        EXPECT_EQ(stats.games, 0u);
+
+        ASSERT_EQ(registry.Join(room, white, color), SUCCESS);
+        ASSERT_EQ(registry.Join(room, black, color), SUCCESS);
+        uint64_t seq{ 0 };
+        ASSERT_EQ(registry.SetLastMove(white, MakeMove("e2", "e4"), seq), SUCCESS);
+        ASSERT_EQ(registry.SetLastMove(black, MakeMove("e7", "e5"), seq), SUCCESS);
+        EXPECT_EQ(registry.SetLastMove(black, MakeMove("d7", "d5"), seq), INVALID_MOVE);
+
+        // A game both players left is not restored
+        ASSERT_EQ(registry.Join(other, leaver, color), SUCCESS);
+        ASSERT_EQ(registry.Leave(leaver), SUCCESS);
+        journal.Close();
+    }
+
+    GameRegistry registry;
+    GameJournal journal(Options(dir));
+    RecoveryStats stats;
+    ASSERT_EQ(journal.Open(registry, stats), SUCCESS);
+    EXPECT_EQ(stats.games, 1u);
+    EXPECT_EQ(stats.moves, 2u);
+    EXPECT_EQ(registry.NumGames(), 1u);
+    EXPECT_EQ(registry.NumSessions(), 2u);
+
+    Session session;
+    EXPECT_FALSE(registry.FindSession(leaver, session));
+    ASSERT_TRUE(registry.FindSession(black, session));
+    EXPECT_EQ(session.game->room, room);
+    EXPECT_EQ(session.color, PieceColor::BLACK);
+
+    std::vector<Move> moves;
+    uint64_t seq{ 0 };
+    ASSERT_EQ(registry.WaitForMoves(white, 0, std::chrono::milliseconds(0), moves, seq), SUCCESS);
+    EXPECT_EQ(seq, 2u);
+    ASSERT_EQ(moves.size(), 2u);
+    EXPECT_EQ(moves[1], MakeMove("e7", "e5"));
+
+    // The board is restored too: the game goes on
+    EXPECT_EQ(registry.SetLastMove(black, MakeMove("d7", "d5"), seq), INVALID_MOVE);
+    ASSERT_EQ(registry.SetLastMove(white, MakeMove("g1", "f3"), seq), SUCCESS);
+    EXPECT_EQ(seq, 3u);
+}
+
+TEST(TestGameJournal, Snapshot)
+{
+    TempDir dir;
+    std::string room{ "snap" }, white, black;
+    PieceColor color;
+    const std::vector<Move> game{ MakeMove("d2", "d4"), MakeMove("d7", "d5"),
+                                  MakeMove("c2", "c4"), MakeMove("e7", "e6") };
+    {
+        GameRegistry registry;
+        GameJournal journal(Options(dir));
+        RecoveryStats stats;
+        ASSERT_EQ(journal.Open(registry, stats), SUCCESS);
+        ASSERT_EQ(registry.Join(room, white, color), SUCCESS);
+        ASSERT_EQ(registry.Join(room, black, color), SUCCESS);
+        uint64_t seq{ 0 };
+        ASSERT_EQ(registry.SetLastMove(white, game[0], seq), SUCCESS);
+        ASSERT_EQ(registry.SetLastMove(black, game[1], seq), SUCCESS);
+
+        // Compacted segments are deleted
+        ASSERT_EQ(journal.Snapshot(), SUCCESS);
+        EXPECT_EQ(dir.Files("snapshot-").size(), 1u);
+        for (const auto &segment : dir.Files("journal-")) {
+            std::ifstream file(segment, std::ios::ate | std::ios::binary);
+            EXPECT_EQ(file.tellg(), 0) << segment;
+        }
+
+        ASSERT_EQ(registry.SetLastMove(white, game[2], seq), SUCCESS);
+        ASSERT_EQ(registry.SetLastMove(black, game[3], seq), SUCCESS);
+        journal.Close();
+    }
+
+    GameRegistry registry;
+    GameJournal journal(Options(dir));
+    RecoveryStats stats;
+    ASSERT_EQ(journal.Open(registry, stats), SUCCESS);
+    EXPECT_EQ(stats.games, 1u);
+    EXPECT_EQ(stats.records, 2u);   // the moves after the snapshot
+    std::vector<Move> moves;
+    uint64_t seq{ 0 };
+    ASSERT_EQ(registry.WaitForMoves(black, 0, std::chrono::milliseconds(0), moves, seq), SUCCESS);
+    EXPECT_EQ(moves, game);
+
+    // Snapshots of recovered journals fold the old segments
+    ASSERT_EQ(journal.Snapshot(), SUCCESS);
+    journal.Close();
+    GameRegistry restarted;
+    GameJournal again(Options(dir));
+    ASSERT_EQ(again.Open(restarted, stats), SUCCESS);
+    EXPECT_EQ(stats.records, 0u);
+    EXPECT_EQ(stats.moves, game.size());
+}
+
+TEST(TestGameJournal, TornTail)
+{
+    TempDir dir;
+    std::string room{ "torn" }, white, black;
+    PieceColor color;
+    {
+        GameRegistry registry;
+        JournalOptions options = Options(dir);
+        options.syncInterval = std::chrono::milliseconds(5);
+        GameJournal journal(options);
+        RecoveryStats stats;
+        ASSERT_EQ(journal.Open(registry, stats), SUCCESS);
+        ASSERT_EQ(registry.Join(room, white, color), SUCCESS);
+        ASSERT_EQ(registry.Join(room, black, color), SUCCESS);
+        uint64_t seq{ 0 };
+        ASSERT_EQ(registry.SetLastMove(white, MakeMove("e2", "e4"), seq), SUCCESS);
+        journal.Sync();
+        journal.Close();
+    }
+
+    // A record cut short by a crash: its length runs
+    // past the end of the file
+    for (const auto &segment : dir.Files("journal-")) {
+        std::ofstream file(segment, std::ios::app | std::ios::binary);
+        file.write("\x40\x00\x00\x00\x12\x34", 6);
+    }
+
+    GameRegistry registry;
+    GameJournal journal(Options(dir));
+    RecoveryStats stats;
+    ASSERT_EQ(journal.Open(registry, stats), SUCCESS);
+    EXPECT_EQ(stats.games, 1u);
+    EXPECT_EQ(stats.records, 3u);
+    Move move = NULL_MOVE;
+    uint64_t seq{ 0 };
+    ASSERT_EQ(registry.GetLastMove(black, move, seq), SUCCESS);
+    EXPECT_EQ(move, MakeMove("e2", "e4"));
+    EXPECT_EQ(seq, 1u);
+}
+
+TEST(TestGameJournal, WriteFailure)
+{
+    TempDir dir;
+    std::string room{ "full" }, white, black, rejoined;
+    PieceColor color;
+    std::vector<std::string> links;
+    {
+        GameRegistry registry;
+        GameJournal journal(Options(dir));
+        RecoveryStats stats;
+        ASSERT_EQ(journal.Open(registry, stats), SUCCESS);
+        // Segments 2 & 4 of every shard are on a full disk
+        for (size_t shard{ 0 }; shard < JOURNAL_SHARDS; shard++) {
+            for (const int segment : { 2, 4 }) {
+                links.push_back(dir.Path() + "/journal-" + std::to_string(shard) + "-" +
+                    std::to_string(segment) + ".log");
+                ASSERT_EQ(::symlink("/dev/full", links.back().c_str()), 0);
+            }
+        }
+        ASSERT_EQ(registry.Join(room, white, color), SUCCESS);
+        ASSERT_EQ(registry.Join(room, black, color), SUCCESS);
+        uint64_t seq{ 0 };
+        ASSERT_EQ(registry.SetLastMove(white, MakeMove("e2", "e4"), seq), SUCCESS);
+        ASSERT_EQ(journal.Snapshot(), SUCCESS);
+
+        // The move is refused and the game left as it was
+        EXPECT_EQ(registry.SetLastMove(black, MakeMove("e7", "e5"), seq), FILE_OPEN_ERROR);
+        Move move = NULL_MOVE;
+        ASSERT_EQ(registry.GetLastMove(black, move, seq), SUCCESS);
+        EXPECT_EQ(move, MakeMove("e2", "e4"));
+        EXPECT_EQ(seq, 1u);
+
+        // The next write goes to a new segment
+        ASSERT_EQ(registry.SetLastMove(black, MakeMove("e7", "e5"), seq), SUCCESS);
+        EXPECT_EQ(seq, 2u);
+        ASSERT_EQ(registry.Leave(black), SUCCESS);
+        ASSERT_EQ(journal.Snapshot(), SUCCESS);
+
+        // A refused seat stays free
+        EXPECT_EQ(registry.Join(room, rejoined, color), FILE_OPEN_ERROR);
+        EXPECT_EQ(registry.NumSessions(), 1u);
+        ASSERT_EQ(registry.Join(room, rejoined, color), SUCCESS);
+        EXPECT_EQ(color, PieceColor::BLACK);
+        journal.Close();
+    }
+    for (const auto &link : links) {
+        ::unlink(link.c_str());
+    }
+
+    GameRegistry registry;
+    GameJournal journal(Options(dir));
+    RecoveryStats stats;
+    ASSERT_EQ(journal.Open(registry, stats), SUCCESS);
+    EXPECT_EQ(stats.moves, 2u);
+    EXPECT_EQ(registry.NumSessions(), 2u);
+    Session session;
+    EXPECT_FALSE(registry.FindSession(black, session));
+    EXPECT_TRUE(registry.FindSession(rejoined, session));
+}
+
+TEST(TestGameJournal, ConcurrentGames)
+{
+    constexpr size_t NUM_THREADS{ 8 };
+    constexpr size_t GAMES_PER_THREAD{ 25 };
+    const std::vector<Move> game{ MakeMove("e2", "e4"), MakeMove("e7", "e5"),
+                                  MakeMove("g1", "f3"), MakeMove("b8", "c6") };
+    TempDir dir;
+    {
+        // Writers waiting for durability share fsyncs
+        GameRegistry registry;
+        GameJournal journal(Options(dir));
+        RecoveryStats stats;
+        ASSERT_EQ(journal.Open(registry, stats), SUCCESS);
+        std::vector<std::thread> threads;
+        for (size_t t{ 0 }; t < NUM_THREADS; t++) {
+            threads.emplace_back([&registry, &game, t]() {
+                for (size_t i{ 0 }; i < GAMES_PER_THREAD; i++) {
+                    std::string room = "game-" + std::to_string(t) + "-" + std::to_string(i);
+                    std::string tokens[2];
+                    PieceColor color;
+                    registry.Join(room, tokens[0], color);
+                    registry.Join(room, tokens[1], color);
+                    uint64_t seq{ 0 };
+                    for (size_t ply{ 0 }; ply < game.size(); ply++) {
+                        registry.SetLastMove(tokens[ply % 2], game[ply], seq);
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        journal.Close();
+    }
+
+    GameRegistry registry;
+    GameJournal journal(Options(dir));
+    RecoveryStats stats;
+    ASSERT_EQ(journal.Open(registry, stats), SUCCESS);
+    EXPECT_EQ(stats.games, NUM_THREADS * GAMES_PER_THREAD);
+    EXPECT_EQ(stats.moves, NUM_THREADS * GAMES_PER_THREAD * game.size());
+    EXPECT_EQ(registry.NumSessions(), 2 * NUM_THREADS * GAMES_PER_THREAD);
+}
@@ -0,0 +1,410 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for game_registry.h & game_registry.cpp
+ **************************************************/
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+#include <gtest/gtest.h>
+#include "game_registry.h"
+
+using namespace Shohih;
+
+TEST(TestGameRegistry, Rooms)
+{
+    GameRegistry registry;
+    std::string room{ "room-1" }, white, black, extra;
+    PieceColor color;
+    ASSERT_EQ(registry.Join(room, white, color), SUCCESS);
+    EXPECT_EQ(color, PieceColor::WHITE);
+    ASSERT_EQ(registry.Join(room, black, color), SUCCESS);
+    EXPECT_EQ(color, PieceColor::BLACK);
+    EXPECT_NE(white, black);
+    EXPECT_EQ(registry.Join(room, extra, color), ROOM_FULL);
+
+    // No room: a new one with a generated ID
+    std::string newRoom, other;
+    ASSERT_EQ(registry.Join(newRoom, other, color), SUCCESS);
+    EXPECT_FALSE(newRoom.empty());
+    EXPECT_NE(newRoom, room);
+    EXPECT_EQ(color, PieceColor::WHITE);
+    EXPECT_EQ(registry.NumGames(), 2u);
+    EXPECT_EQ(registry.NumSessions(), 3u);
+
+    std::string bad{ "no spaces" };
+    EXPECT_EQ(registry.Join(bad, extra, color), INVALID_ROOM);
+    bad = std::string(MAX_ROOM_ID_LENGTH + 1, 'a');
+    EXPECT_EQ(registry.Join(bad, extra, color), INVALID_ROOM);
+
+    Session session;
+    ASSERT_TRUE(registry.FindSession(black, session));
+    EXPECT_EQ(session.game->room, room);
+    EXPECT_EQ(session.color, PieceColor::BLACK);
+    EXPECT_FALSE(registry.FindSession("unknown", session));
+}
+
+TEST(TestGameRegistry, MovesStayInTheirGame)
+{
+    GameRegistry registry;
+    std::string roomA{ "a" }, roomB{ "b" }, a1, a2, b1;
+    PieceColor color;
+    ASSERT_EQ(registry.Join(roomA, a1, color), SUCCESS);
+    ASSERT_EQ(registry.Join(roomA, a2, color), SUCCESS);
+    ASSERT_EQ(registry.Join(roomB, b1, color), SUCCESS);
+
+    const Move e2e4{ Square::GetSquareByName("e2"), Square::GetSquareByName("e4") };
+    uint64_t seq{ 0 };
+    ASSERT_EQ(registry.SetLastMove(a1, e2e4, seq), SUCCESS);
+    EXPECT_EQ(seq, 1u);
+    Move move;
+    ASSERT_EQ(registry.GetLastMove(a2, move, seq), SUCCESS);
+    EXPECT_EQ(move, e2e4);
+    EXPECT_EQ(seq, 1u);
+    ASSERT_EQ(registry.GetLastMove(b1, move, seq), SUCCESS);
+    EXPECT_EQ(move, NULL_MOVE);
+    EXPECT_EQ(seq, 0u);
+    EXPECT_EQ(registry.SetLastMove("unknown", e2e4, seq), INVALID_SESSION);
+    EXPECT_EQ(registry.GetLastMove("unknown", move, seq), INVALID_SESSION);
+}
+
+TEST(TestGameRegistry, RejectsIllegalMoves)
+{
+    GameRegistry registry;
+    std::string room{ "legal" }, white, black;
+    PieceColor color;
+    ASSERT_EQ(registry.Join(room, white, color), SUCCESS);
+    ASSERT_EQ(registry.Join(room, black, color), SUCCESS);
+    auto move = [](const char *src, const char *dst) {
+        return Move{ Square::GetSquareByName(src), Square::GetSquareByName(dst) };
+    };
+    uint64_t seq{ 0 };
+
+    // Out of turn, illegal, off the board
+    EXPECT_EQ(registry.SetLastMove(black, move("e7", "e5"), seq), INVALID_MOVE);
+    EXPECT_EQ(registry.SetLastMove(white, move("e2", "e5"), seq), INVALID_MOVE);
+    EXPECT_EQ(registry.SetLastMove(white, Move{ Square{ 4, 1 }, Square{ 4, 9 } }, seq), INVALID_MOVE);
+    EXPECT_EQ(registry.SetLastMove(white, NULL_MOVE, seq), INVALID_MOVE);
+
+    // Italian game, then castling short
+    const std::vector<Move> moves{
+        move("e2", "e4"), move("e7", "e5"), move("g1", "f3"), move("b8", "c6"),
+        move("f1", "c4"), move("f8", "c5"), move("e1", "g1")
+    };
+    for (size_t i{ 0 }; i < moves.size(); i++) {
+        ASSERT_EQ(registry.SetLastMove(i % 2 == 0 ? white : black, moves[i], seq), SUCCESS) << i;
+        EXPECT_EQ(seq, i + 1);
+    }
+    // Check must be answered; rejected moves are not stored
+    EXPECT_EQ(registry.SetLastMove(black, move("d7", "d6"), seq), SUCCESS);
+    EXPECT_EQ(registry.SetLastMove(white, move("c4", "f7"), seq), SUCCESS);
+    EXPECT_EQ(registry.SetLastMove(black, move("a7", "a6"), seq), INVALID_MOVE);
+    Move last;
+    ASSERT_EQ(registry.GetLastMove(black, last, seq), SUCCESS);
+    EXPECT_EQ(last, move("c4", "f7"));
+    EXPECT_EQ(seq, moves.size() + 2);
+}
+
+TEST(TestGameRegistry, Leave)
+{
+    GameRegistry registry;
+    std::string room{ "r" }, white, black, again;
+    PieceColor color;
+    ASSERT_EQ(registry.Join(room, white, color), SUCCESS);
+    ASSERT_EQ(registry.Join(room, black, color), SUCCESS);
+
+    // A free seat can be taken again
+    ASSERT_EQ(registry.Leave(white), SUCCESS);
+    EXPECT_EQ(registry.Leave(white), INVALID_SESSION);
+    ASSERT_EQ(registry.Join(room, again, color), SUCCESS);
+    EXPECT_EQ(color, PieceColor::WHITE);
+    Move move;
+    uint64_t seq{ 0 };
+    EXPECT_EQ(registry.GetLastMove(white, move, seq), INVALID_SESSION);
+
+    ASSERT_EQ(registry.Leave(black), SUCCESS);
+    ASSERT_EQ(registry.Leave(again), SUCCESS);
+    EXPECT_EQ(registry.NumGames(), 0u);
+    EXPECT_EQ(registry.NumSessions(), 0u);
+}
+
+TEST(TestGameRegistry, ConcurrentGames)
+{
+    constexpr size_t NUM_THREADS{ 8 };
+    constexpr size_t GAMES_PER_THREAD{ 1500 };
+    GameRegistry registry;
+    std::vector<std::vector<std::string>> tokens(NUM_THREADS);
+    std::vector<std::thread> threads;
+    for (size_t t{ 0 }; t < NUM_THREADS; t++) {
+        threads.emplace_back([&registry, &tokens, t]() {
+            for (size_t i{ 0 }; i < GAMES_PER_THREAD; i++) {
+                std::string room = std::to_string(t) + "_" + std::to_string(i);
+                std::string white, black;
+                PieceColor color;
+                EXPECT_EQ(registry.Join(room, white, color), SUCCESS);
+                EXPECT_EQ(registry.Join(room, black, color), SUCCESS);
+                const uint8_t file = static_cast<uint8_t>((i + t) % 8);
+                const Move move{ Square{ file, 1 }, Square{ file, 3 } };
+                uint64_t seq{ 0 };
+                EXPECT_EQ(registry.SetLastMove(white, move, seq), SUCCESS);
+                tokens[t].push_back(black);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(registry.NumGames(), NUM_THREADS * GAMES_PER_THREAD);
+    EXPECT_EQ(registry.NumSessions(), 2 * NUM_THREADS * GAMES_PER_THREAD);
+
+    std::set<std::string> unique;
+    for (size_t t{ 0 }; t < NUM_THREADS; t++) {
+        for (size_t i{ 0 }; i < GAMES_PER_THREAD; i++) {
+            Move move;
+            uint64_t seq{ 0 };
+            ASSERT_EQ(registry.GetLastMove(tokens[t][i], move, seq), SUCCESS);
+            EXPECT_EQ(move.first, (Square{ static_cast<uint8_t>((i + t) % 8), 1 }));
+            EXPECT_EQ(move.second, (Square{ static_cast<uint8_t>((i + t) % 8), 3 }));
+            unique.insert(tokens[t][i]);
+        }
+    }
+    EXPECT_EQ(unique.size(), NUM_THREADS * GAMES_PER_THREAD);
+}
+
+TEST(TestGameRegistry, LongPoll)
+{
+    using namespace std::chrono;
+    GameRegistry registry;
+    std::string room{ "poll" }, white, black;
+    PieceColor color;
+    ASSERT_EQ(registry.Join(room, white, color), SUCCESS);
+    ASSERT_EQ(registry.Join(room, black, color), SUCCESS);
+    const Move e2e4{ Square::GetSquareByName("e2"), Square::GetSquareByName("e4") };
+
+    // Nothing new: the request times out with the same sequence number
+    Move move;
+    uint64_t seq{ 0 };
+    ASSERT_EQ(registry.WaitForMove(black, 0, milliseconds(20), move, seq), SUCCESS);
+    EXPECT_EQ(seq, 0u);
+    EXPECT_EQ(move, NULL_MOVE);
+
+    // A move from the other thread wakes the waiting request
+    std::thread mover([&registry, &white, &e2e4]() {
+        std::this_thread::sleep_for(milliseconds(50));
+        uint64_t sent{ 0 };
+        EXPECT_EQ(registry.SetLastMove(white, e2e4, sent), SUCCESS);
+    });
+    const auto start = steady_clock::now();
+    ASSERT_EQ(registry.WaitForMove(black, 0, MAX_MOVE_WAIT, move, seq), SUCCESS);
+    mover.join();
+    EXPECT_LT(steady_clock::now() - start, MAX_MOVE_WAIT / 2);
+    EXPECT_EQ(seq, 1u);
+    EXPECT_EQ(move, e2e4);
+
+    // Already behind: answered at once
+    ASSERT_EQ(registry.WaitForMove(white, 0, MAX_MOVE_WAIT, move, seq), SUCCESS);
+    EXPECT_EQ(move, e2e4);
+
+    // Leaving ends the player's own request; the game is kept
+    std::thread leaver([&registry, &black]() {
+        std::this_thread::sleep_for(milliseconds(50));
+        EXPECT_EQ(registry.Leave(black), SUCCESS);
+    });
+    const auto leaveStart = steady_clock::now();
+    ASSERT_EQ(registry.WaitForMove(black, 1, MAX_MOVE_WAIT, move, seq), SUCCESS);
+    leaver.join();
+    EXPECT_LT(steady_clock::now() - leaveStart, MAX_MOVE_WAIT / 2);
+    EXPECT_EQ(seq, 1u);
+    EXPECT_EQ(move, e2e4);
+}
+
+TEST(TestGameRegistry, MoveLog)
+{
+    GameRegistry registry;
+    std::string room{ "log" }, white, black;
+    PieceColor color;
+    ASSERT_EQ(registry.Join(room, white, color), SUCCESS);
+    ASSERT_EQ(registry.Join(room, black, color), SUCCESS);
+    auto move = [](const char *src, const char *dst) {
+        return Move{ Square::GetSquareByName(src), Square::GetSquareByName(dst) };
+    };
+    const std::vector<Move> played{ move("d2", "d4"), move("d7", "d5"), move("c2", "c4"), move("e7", "e6") };
+    uint64_t seq{ 0 };
+    for (size_t i{ 0 }; i < played.size(); i++) {
+        ASSERT_EQ(registry.SetLastMove(i % 2 == 0 ? white : black, played[i], seq), SUCCESS);
+    }
+
+    std::vector<Move> moves;
+    ASSERT_EQ(registry.WaitForMoves(white, 0, std::chrono::milliseconds(0), moves, seq), SUCCESS);
+    EXPECT_EQ(moves, played);
+    EXPECT_EQ(seq, played.size());
+    ASSERT_EQ(registry.WaitForMoves(white, 3, std::chrono::milliseconds(0), moves, seq), SUCCESS);
+    EXPECT_EQ(moves, std::vector<Move>{ played[3] });
+    ASSERT_EQ(registry.WaitForMoves(white, 4, std::chrono::milliseconds(10), moves, seq), SUCCESS);
+    EXPECT_TRUE(moves.empty());
+    EXPECT_EQ(seq, 4u);
+
+    // A player who left rejoins the game in progress and catches up
+    ASSERT_EQ(registry.Leave(black), SUCCESS);
+    std::string again;
+    ASSERT_EQ(registry.Join(room, again, color), SUCCESS);
+    EXPECT_EQ(color, PieceColor::BLACK);
+    ASSERT_EQ(registry.WaitForMoves(again, 0, std::chrono::milliseconds(0), moves, seq), SUCCESS);
+    EXPECT_EQ(moves, played);
+    ASSERT_EQ(registry.SetLastMove(white, move("b1", "c3"), seq), SUCCESS);
+    ASSERT_EQ(registry.SetLastMove(again, move("g8", "f6"), seq), SUCCESS);
+    EXPECT_EQ(seq, 6u);
+
+    // Once both players are gone the game is dropped
+    ASSERT_EQ(registry.Leave(white), SUCCESS);
+    ASSERT_EQ(registry.Leave(again), SUCCESS);
+    EXPECT_EQ(registry.NumGames(), 0u);
+    EXPECT_EQ(registry.WaitForMoves(again, 0, std::chrono::milliseconds(0), moves, seq), INVALID_SESSION);
+}
+
+//--------------------------------------------------
+// Readers, long polls and writers on the same games
+// at once. Build with -DSANITIZE_THREAD=ON to have
+// ThreadSanitizer check the lock-free read path.
+//--------------------------------------------------
+TEST(TestGameRegistry, ConcurrentReadersAndWriters)
+{
+    constexpr size_t NUM_GAMES{ 4 };
+    constexpr size_t NUM_READERS{ 6 };
+    constexpr uint64_t NUM_MOVES{ 4000 };
+    auto move = [](const char *src, const char *dst) {
+        return Move{ Square::GetSquareByName(src), Square::GetSquareByName(dst) };
+    };
+    // Knights out and back: move <seq> is CYCLE[(seq - 1) % 4]
+    const std::array<Move, 4> CYCLE{
+        move("g1", "f3"), move("g8", "f6"), move("f3", "g1"), move("f6", "g8")
+    };
+
+    GameRegistry registry;
+    std::array<std::array<std::string, NUM_PIECE_COLORS>, NUM_GAMES> tokens;
+    for (size_t g{ 0 }; g < NUM_GAMES; g++) {
+        std::string room = "stress-" + std::to_string(g);
+        PieceColor color;
+        ASSERT_EQ(registry.Join(room, tokens[g][0], color), SUCCESS);
+        ASSERT_EQ(registry.Join(room, tokens[g][1], color), SUCCESS);
+    }
+
+    std::atomic<bool> done{ false };
+    std::vector<std::thread> threads;
+    // One writer per seat: each plays when it is its turn
+    for (size_t g{ 0 }; g < NUM_GAMES; g++) {
+        for (size_t c{ 0 }; c < NUM_PIECE_COLORS; c++) {
+            threads.emplace_back([&registry, &tokens, &CYCLE, g, c]() {
+                uint64_t seq{ 0 };
+                Move last;
+                while (seq < NUM_MOVES) {
+                    ASSERT_EQ(registry.WaitForMove(tokens[g][c], seq, std::chrono::milliseconds(100), last, seq),
+                        SUCCESS);
+                    if (seq % 2 == c && seq < NUM_MOVES) {
+                        uint64_t sent{ 0 };
+                        ASSERT_EQ(registry.SetLastMove(tokens[g][c], CYCLE[seq % 4], sent), SUCCESS);
+                        EXPECT_EQ(sent, seq + 1);
+                    }
+                }
+            });
+        }
+    }
+    // Readers never see a move that does not belong to its sequence number
+    std::atomic<uint64_t> reads{ 0 };
+    for (size_t r{ 0 }; r < NUM_READERS; r++) {
+        threads.emplace_back([&registry, &tokens, &CYCLE, &done, &reads, r]() {
+            std::array<uint64_t, NUM_GAMES> lastSeq{};
+            while (!done) {
+                for (size_t g{ 0 }; g < NUM_GAMES; g++) {
+                    Move last;
+                    uint64_t seq{ 0 };
+                    ASSERT_EQ(registry.GetLastMove(tokens[g][r % 2], last, seq), SUCCESS);
+                    ASSERT_GE(seq, lastSeq[g]);
+                    if (seq > 0) {
+                        ASSERT_EQ(last, CYCLE[(seq - 1) % 4]);
+                    }
+                    lastSeq[g] = seq;
+                    reads++;
+                }
+            }
+        });
+    }
+    for (size_t i{ 0 }; i < NUM_GAMES * NUM_PIECE_COLORS; i++) {
+        threads[i].join();
+    }
+    done = true;
+    for (size_t i{ NUM_GAMES * NUM_PIECE_COLORS }; i < threads.size(); i++) {
+        threads[i].join();
+    }
+    for (size_t g{ 0 }; g < NUM_GAMES; g++) {
+        Move last;
+        uint64_t seq{ 0 };
+        ASSERT_EQ(registry.GetLastMove(tokens[g][0], last, seq), SUCCESS);
+        EXPECT_EQ(seq, NUM_MOVES);
+    }
+    EXPECT_GT(reads.load(), 0u);
+}
+
+//--------------------------------------------------
+// Seats taken and freed while GetLastMove() reads:
+// freed slots are reused, yet a token that left never
+// reads another player's game
+//--------------------------------------------------
+TEST(TestGameRegistry, SlotReuse)
+{
+    constexpr size_t NUM_CHURNERS{ 4 };
+    constexpr size_t NUM_ROUNDS{ 2000 };
+
+    GameRegistry registry;
+    std::string room = "moved";
+    std::string white, black;
+    PieceColor color;
+    ASSERT_EQ(registry.Join(room, white, color), SUCCESS);
+    ASSERT_EQ(registry.Join(room, black, color), SUCCESS);
+    uint64_t seq{ 0 };
+    ASSERT_EQ(registry.SetLastMove(white,
+        Move{ Square::GetSquareByName("e2"), Square::GetSquareByName("e4") }, seq), SUCCESS);
+
+    std::atomic<bool> done{ false };
+    std::vector<std::thread> threads;
+    // Churners join empty rooms and leave them again; a
+    // token that left stays invalid afterwards
+    for (size_t t{ 0 }; t < NUM_CHURNERS; t++) {
+        threads.emplace_back([&registry, t]() {
+            for (size_t i{ 0 }; i < NUM_ROUNDS; i++) {
+                std::string churnRoom = "churn-" + std::to_string(t);
+                std::string token;
+                PieceColor seat;
+                ASSERT_EQ(registry.Join(churnRoom, token, seat), SUCCESS);
+                Move last;
+                uint64_t churnSeq{ 0 };
+                ASSERT_EQ(registry.GetLastMove(token, last, churnSeq), SUCCESS);
+                EXPECT_EQ(churnSeq, 0u);
+                ASSERT_EQ(registry.Leave(token), SUCCESS);
+                EXPECT_EQ(registry.GetLastMove(token, last, churnSeq), INVALID_SESSION);
+            }
+        });
+    }
+    // Readers of the stable game always see its move
+    for (size_t r{ 0 }; r < NUM_PIECE_COLORS; r++) {
+        threads.emplace_back([&registry, &done, &white, &black, r]() {
+            while (!done) {
+                Move last;
+                uint64_t lastSeq{ 0 };
+                ASSERT_EQ(registry.GetLastMove(r == 0 ? white : black, last, lastSeq), SUCCESS);
+                ASSERT_EQ(lastSeq, 1u);
+            }
+        });
+    }
+    for (size_t i{ 0 }; i < NUM_CHURNERS; i++) {
+        threads[i].join();
+    }
+    done = true;
+    for (size_t i{ NUM_CHURNERS }; i < threads.size(); i++) {
+        threads[i].join();
+    }
+    EXPECT_EQ(registry.NumSessions(), 2u);
+    EXPECT_EQ(registry.NumGames(), 1u);
+}
@@ -0,0 +1,54 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for loadgen.h & loadgen.cpp
+ **************************************************/
+
+#include <gtest/gtest.h>
+#include "loadgen.h"
+
+using namespace Shohih;
+
+TEST(TestLoadgen, Percentiles)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.Percentile(0.99), 0u);
+
+    // Small values are exact
+    for (uint64_t micros{ 1 }; micros <= 10; micros++) {
+        histogram.Record(micros);
+    }
+    EXPECT_EQ(histogram.Count(), 10u);
+    EXPECT_EQ(histogram.Percentile(0.5), 5u);
+    EXPECT_EQ(histogram.Percentile(1.0), 10u);
+    EXPECT_DOUBLE_EQ(histogram.Mean(), 5.5);
+
+    // Large values are within 1/16
+    LatencyHistogram slow;
+    for (uint64_t i{ 0 }; i < 990; i++) {
+        slow.Record(std::chrono::milliseconds(1));
+    }
+    for (uint64_t i{ 0 }; i < 10; i++) {
+        slow.Record(std::chrono::milliseconds(250));
+    }
+    EXPECT_NEAR(static_cast<double>(slow.Percentile(0.5)), 1000.0, 1000.0 / 16);
+    EXPECT_NEAR(static_cast<double>(slow.Percentile(0.99)), 1000.0, 1000.0 / 16);
+    EXPECT_NEAR(static_cast<double>(slow.Percentile(0.999)), 250000.0, 250000.0 / 16);
+    EXPECT_EQ(slow.Max(), 250000u);
+
+    // Out of range values land in the last bucket
+    slow.Record(std::chrono::hours(24 * 365 * 100));
+    EXPECT_EQ(slow.Percentile(1.0), (1ull << LatencyHistogram::LATENCY_MAX_BITS) - 1);
+}
+
+TEST(TestLoadgen, Merge)
+{
+    LatencyHistogram a, b;
+    for (uint64_t micros{ 0 }; micros < 1000; micros++) {
+        (micros % 2 == 0 ? a : b).Record(micros * 100);
+    }
+    a.Merge(b);
+    EXPECT_EQ(a.Count(), 1000u);
+    EXPECT_EQ(a.Max(), 99900u);
+    EXPECT_NEAR(static_cast<double>(a.Percentile(0.5)), 50000.0, 50000.0 / 16);
+    EXPECT_NEAR(static_cast<double>(a.Percentile(0.9)), 90000.0, 90000.0 / 16);
+}
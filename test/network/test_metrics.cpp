@@ -0,0 +1,87 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for metrics.h & metrics.cpp
+ **************************************************/
+
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "metrics.h"
+
+using namespace Shohih;
+
+namespace {
+
+bool Contains(const std::string &text, const std::string &line)
+{
+    return text.find(line + "\n") != std::string::npos;
+}
+
+} // namespace
+
+TEST(TestMetrics, ShardedCounter)
+{
+    constexpr size_t NUM_THREADS{ METRIC_SHARDS + 4 };
+    constexpr uint64_t ADDS_PER_THREAD{ 10000 };
+    ShardedCounter counter;
+    std::vector<std::thread> threads;
+    for (size_t t{ 0 }; t < NUM_THREADS; t++) {
+        threads.emplace_back([&counter]() {
+            for (uint64_t i{ 0 }; i < ADDS_PER_THREAD; i++) {
+                counter.Add();
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    counter.Add(5);
+    EXPECT_EQ(counter.Value(), NUM_THREADS * ADDS_PER_THREAD + 5);
+}
+
+TEST(TestMetrics, LatencyBuckets)
+{
+    LatencyBuckets buckets;
+    buckets.Observe(std::chrono::microseconds(50));     // <= 100 us
+    buckets.Observe(std::chrono::microseconds(100));    // bounds are inclusive
+    buckets.Observe(std::chrono::milliseconds(3));      // <= 5 ms
+    buckets.Observe(std::chrono::seconds(60));          // +Inf
+    const LatencyBuckets::Totals totals = buckets.Collect();
+    EXPECT_EQ(totals.count, 4u);
+    EXPECT_EQ(totals.counts[0], 2u);
+    EXPECT_EQ(totals.counts[5], 1u);
+    EXPECT_EQ(totals.counts[LatencyBuckets::NUM_BOUNDS], 1u);
+    EXPECT_NEAR(totals.sum, 60.00315, 1e-9);
+}
+
+TEST(TestMetrics, Render)
+{
+    ServerMetrics metrics;
+    {
+        ServerMetrics::RequestTimer timer(&metrics, Endpoint::SEND_MOVE);
+        metrics.CountMove(SUCCESS);
+    }
+    {
+        ServerMetrics::RequestTimer timer(&metrics, Endpoint::SEND_MOVE);
+        metrics.CountMove(INVALID_MOVE);
+        timer.Fail();
+    }
+    ServerMetrics::RequestTimer held(&metrics, Endpoint::GET_MOVE);
+    ServerMetrics::RequestTimer ignored(nullptr, Endpoint::GET_MOVE);
+
+    ServerGauges gauges;
+    gauges.games = 3;
+    gauges.sessions = 5;
+    const std::string text = metrics.Render(gauges);
+    EXPECT_TRUE(Contains(text, "# TYPE shohih_request_duration_seconds histogram"));
+    EXPECT_TRUE(Contains(text, "shohih_requests_total{endpoint=\"/sendmove\"} 2"));
+    EXPECT_TRUE(Contains(text, "shohih_request_errors_total{endpoint=\"/sendmove\"} 1"));
+    EXPECT_TRUE(Contains(text, "shohih_requests_in_flight{endpoint=\"/getmove\"} 1"));
+    EXPECT_TRUE(Contains(text, "shohih_requests_total{endpoint=\"/getmove\"} 0"));
+    EXPECT_TRUE(Contains(text, "shohih_request_duration_seconds_bucket{endpoint=\"/sendmove\",le=\"+Inf\"} 2"));
+    EXPECT_TRUE(Contains(text, "shohih_request_duration_seconds_count{endpoint=\"/sendmove\"} 2"));
+    EXPECT_TRUE(Contains(text, "shohih_moves_total 1"));
+    EXPECT_TRUE(Contains(text, "shohih_rejected_moves_total 1"));
+    EXPECT_TRUE(Contains(text, "shohih_games 3"));
+    EXPECT_TRUE(Contains(text, "shohih_players 5"));
+}
@@ -0,0 +1,186 @@
+/**************************************************
+ * @date    2026-10-19
+ * @brief   Tests for websocket.h & websocket.cpp
+ **************************************************/
+
+#include <gtest/gtest.h>
+#include "websocket.h"
+
+using namespace Shohih;
+
+namespace {
+
+//--------------------------------------------------
+// Next text frame (answers pings on the way)
+//--------------------------------------------------
+std::string ReceiveText(WsConnection &conn)
+{
+    WsFrame frame;
+    while (conn.Receive(frame)) {
+        if (frame.opcode == WsOpcode::PING) {
+            conn.Send(WsOpcode::PONG, frame.payload);
+        } else if (frame.opcode == WsOpcode::TEXT) {
+            return frame.payload;
+        }
+    }
+    return "<closed>";
+}
+
+} // namespace
+
+TEST(TestWebSocket, Handshake)
+{
+    // Example of RFC 6455, section 1.3
+    EXPECT_EQ(WsAcceptKey("dGhlIHNhbXBsZSBub25jZQ=="), "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+}
+
+TEST(TestWebSocket, Frames)
+{
+    for (const bool mask : { false, true }) {
+        for (const size_t size : { size_t(0), size_t(5), size_t(125), size_t(126), size_t(3000) }) {
+            const std::string payload(size, 'x');
+            const std::string encoded = EncodeWsFrame(WsOpcode::TEXT, payload, mask);
+            WsFrame frame;
+            // Incomplete frames wait for more bytes
+            EXPECT_EQ(DecodeWsFrame(encoded.substr(0, encoded.size() - 1), frame, mask), 0u);
+            ASSERT_EQ(DecodeWsFrame(encoded + "next", frame, mask), encoded.size());
+            EXPECT_EQ(frame.opcode, WsOpcode::TEXT);
+            EXPECT_EQ(frame.payload, payload);
+            // Only clients mask their frames
+            EXPECT_EQ(DecodeWsFrame(encoded, frame, !mask), std::string::npos);
+        }
+    }
+    WsFrame frame;
+    const std::string tooLarge = EncodeWsFrame(WsOpcode::BINARY, std::string(WEBSOCKET_MAX_PAYLOAD + 1, 'x'), true);
+    EXPECT_EQ(DecodeWsFrame(tooLarge, frame, true), std::string::npos);
+    // Fragments are not supported
+    std::string fragment = EncodeWsFrame(WsOpcode::TEXT, "e2", false);
+    fragment[0] = static_cast<char>(fragment[0] & 0x7F);
+    EXPECT_EQ(DecodeWsFrame(fragment, frame, false), std::string::npos);
+}
+
+TEST(TestWebSocket, MoveMessages)
+{
+    const Move e2e4{ Square::GetSquareByName("e2"), Square::GetSquareByName("e4") };
+    EXPECT_EQ(FormatMoveMessage(e2e4, 7), "e2-e4 7");
+    EXPECT_EQ(FormatMoveMessage(NULL_MOVE, 0), "null-null 0");
+    Move move;
+    uint64_t seq{ 0 };
+    ASSERT_TRUE(ParseMoveMessage("e2-e4 7", move, seq));
+    EXPECT_EQ(move, e2e4);
+    EXPECT_EQ(seq, 7u);
+    ASSERT_TRUE(ParseMoveMessage("e2-e4", move, seq));
+    EXPECT_EQ(seq, 0u);
+    ASSERT_TRUE(ParseMoveMessage("null-null 3", move, seq));
+    EXPECT_EQ(move, NULL_MOVE);
+    EXPECT_FALSE(ParseMoveMessage("e2e4", move, seq));
+    EXPECT_FALSE(ParseMoveMessage("e2-z9", move, seq));
+
+    const std::vector<Move> moves{ e2e4, Move{ Square::GetSquareByName("e7"), Square::GetSquareByName("e5") } };
+    EXPECT_EQ(FormatMoveList(moves, 9), "9 e2-e4 e7-e5");
+    EXPECT_EQ(FormatMoveList({}, 9), "9");
+    std::vector<Move> parsed;
+    ASSERT_TRUE(ParseMoveList("9 e2-e4 e7-e5", parsed, seq));
+    EXPECT_EQ(parsed, moves);
+    EXPECT_EQ(seq, 9u);
+    ASSERT_TRUE(ParseMoveList("0", parsed, seq));
+    EXPECT_TRUE(parsed.empty());
+    EXPECT_FALSE(ParseMoveList("1 e2-e4 e7-e5", parsed, seq));
+    EXPECT_FALSE(ParseMoveList("fail", parsed, seq));
+}
+
+TEST(TestWebSocket, PushedMoves)
+{
+    GameRegistry registry;
+    WsServer ws(registry);
+    registry.SetMoveListener([&ws](const std::string &token, const Move &move, uint64_t seq) {
+        ws.Push(token, move, seq);
+    });
+    ASSERT_TRUE(ws.Start(0));
+    std::string room{ "ws" }, white, black;
+    PieceColor color;
+    ASSERT_EQ(registry.Join(room, white, color), SUCCESS);
+    ASSERT_EQ(registry.Join(room, black, color), SUCCESS);
+
+    EXPECT_EQ(WsConnection::Connect("127.0.0.1", ws.GetPort(), "/ws?token=unknown"), nullptr);
+    auto whiteConn = WsConnection::Connect("127.0.0.1", ws.GetPort(), "/ws?token=" + white);
+    auto blackConn = WsConnection::Connect("127.0.0.1", ws.GetPort(), "/ws?token=" + black);
+    ASSERT_NE(whiteConn, nullptr);
+    ASSERT_NE(blackConn, nullptr);
+
+    // Current state first
+    EXPECT_EQ(ReceiveText(*whiteConn), "null-null 0");
+    EXPECT_EQ(ReceiveText(*blackConn), "null-null 0");
+
+    // A move over the socket is acked and pushed to the opponent
+    ASSERT_TRUE(whiteConn->Send(WsOpcode::TEXT, "e2-e4"));
+    EXPECT_EQ(ReceiveText(*whiteConn), "ack 1");
+    EXPECT_EQ(ReceiveText(*blackConn), "e2-e4 1");
+    ASSERT_TRUE(whiteConn->Send(WsOpcode::TEXT, "garbage"));
+    EXPECT_EQ(ReceiveText(*whiteConn), "fail");
+
+    // Moves stored through HTTP are pushed as well
+    uint64_t seq{ 0 };
+    ASSERT_EQ(registry.SetLastMove(black, Move{ Square::GetSquareByName("e7"), Square::GetSquareByName("e5") }, seq),
+        SUCCESS);
+    EXPECT_EQ(ReceiveText(*whiteConn), "e7-e5 2");
+    EXPECT_EQ(ws.NumConnections(), 2u);
+
+    ws.Stop();
+    EXPECT_EQ(ReceiveText(*whiteConn), "<closed>");
+    EXPECT_EQ(ws.NumConnections(), 0u);
+}
+
+TEST(TestWebSocket, Liveness)
+{
+    GameRegistry registry;
+    WsServer ws(registry, std::chrono::milliseconds(20));
+    ASSERT_TRUE(ws.Start(0));
+    std::string room, token;
+    PieceColor color;
+    ASSERT_EQ(registry.Join(room, token, color), SUCCESS);
+    auto conn = WsConnection::Connect("127.0.0.1", ws.GetPort(), "/ws?token=" + token);
+    ASSERT_NE(conn, nullptr);
+
+    // Answered pings keep the connection open...
+    WsFrame frame;
+    int pings{ 0 };
+    while (pings < 5 && conn->Receive(frame)) {
+        if (frame.opcode == WsOpcode::PING) {
+            pings++;
+            conn->Send(WsOpcode::PONG, "");
+        }
+    }
+    EXPECT_EQ(pings, 5);
+
+    // ...a peer that stops answering is dropped
+    while (conn->Receive(frame)) {}
+    for (int i{ 0 }; i < 100 && ws.NumConnections() != 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(ws.NumConnections(), 0u);
+}
+
+TEST(TestWebSocket, ConnectionLimit)
+{
+    GameRegistry registry;
+    WsServer ws(registry, WEBSOCKET_PING_INTERVAL, 1);
+    ASSERT_TRUE(ws.Start(0));
+    std::string room, white, black;
+    PieceColor color;
+    ASSERT_EQ(registry.Join(room, white, color), SUCCESS);
+    ASSERT_EQ(registry.Join(room, black, color), SUCCESS);
+    const std::string path = "/ws?token=";
+    auto conn = WsConnection::Connect("127.0.0.1", ws.GetPort(), path + white);
+    ASSERT_NE(conn, nullptr);
+    EXPECT_EQ(WsConnection::Connect("127.0.0.1", ws.GetPort(), path + black), nullptr);
+
+    // A closed connection frees its place
+    conn.reset();
+    for (int i{ 0 }; i < 100 && conn == nullptr; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        conn = WsConnection::Connect("127.0.0.1", ws.GetPort(), path + black);
+    }
+    EXPECT_NE(conn, nullptr);
+    ws.Stop();
+}